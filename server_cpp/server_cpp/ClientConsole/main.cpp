@@ -1,3 +1,4 @@
+#include <chrono>
 #include <iostream>
 #include <WinSock2.h>
 #include <ws2tcpip.h>
@@ -5,6 +6,7 @@
 
 #include "common/ByteIO.h"
 #include "common/Types.h"
+#include "proto/Codec.h"
 
 static bool SendAll(SOCKET s, const Byte* data, size_t len)
 {
@@ -32,36 +34,69 @@ static bool RecvExact(SOCKET s, Byte* out, size_t len)
 
 static bool SendPing(SOCKET s, uint32 seq)
 {
-    ByteWriter w;
-    w.WriteU32LE(seq);
-
-    ByteBuffer frame = BuildFrame(/*C_Ping=*/1101, w.buf.data(), w.buf.size());
+    ByteBuffer frame = BuildFrame(C_Ping{ seq });
     return SendAll(s, frame.data(), frame.size());
 }
 
-static bool RecvPong(SOCKET s, uint32& outSeq)
+static uint64 ClientTimeUs()
 {
-    // length(2)
-    Byte hdr[2];
-    if (!RecvExact(s, hdr, 2))
+    return (uint64)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// 서버 ping은 받자마자 C_Pong (서버 RTT/시계 오프셋 추정용)
+static bool AnswerServerPing(SOCKET s, const ByteBuffer& rest)
+{
+    S_Ping ping;
+    if (!Codec<S_Ping>::Decode(rest.data() + 2, rest.size() - 2, ping))
         return false;
 
-    uint16 len = (uint16)hdr[0] | ((uint16)hdr[1] << 8);
-    if (len < 2)
+    const uint64 now = ClientTimeUs();
+    ByteBuffer frame = BuildFrame(C_Pong{ ping.seq, ping.serverTimeUs, now });
+    if (!SendAll(s, frame.data(), frame.size()))
         return false;
 
-    // [msgId(2) + payload]
-    ByteBuffer rest(len);
-    if (!RecvExact(s, rest.data(), rest.size()))
+    if (ping.srttUs != 0)
+        std::cout << "S_Ping seq=" << ping.seq << " srttUs=" << ping.srttUs << " rttVarUs=" << ping.rttVarUs
+            << " clockOffsetUs=" << ping.clockOffsetUs << "\n";
+    return true;
+}
+
+static bool RecvPong(SOCKET s, uint32& outSeq)
+{
+    ByteBuffer rest;
+    MsgId msgId = 0;
+    for (;;)
+    {
+        // length(2)
+        Byte hdr[2];
+        if (!RecvExact(s, hdr, 2))
+            return false;
+
+        uint16 len = (uint16)hdr[0] | ((uint16)hdr[1] << 8);
+        if (len < 2)
+            return false;
+
+        // [msgId(2) + payload]
+        rest.resize(len);
+        if (!RecvExact(s, rest.data(), rest.size()))
+            return false;
+
+        msgId = (MsgId)rest[0] | ((MsgId)rest[1] << 8);
+        if (msgId != S_Ping::ID)
+            break;
+        if (!AnswerServerPing(s, rest))
+            return false;
+    }
+
+    if (msgId != S_Pong::ID)
         return false;
 
-    MsgId msgId = (MsgId)rest[0] | ((MsgId)rest[1] << 8);
-    if (msgId != /*S_Pong=*/1102)
+    S_Pong pong;
+    if (!Codec<S_Pong>::Decode(rest.data() + 2, rest.size() - 2, pong))
         return false;
 
-    // payload = u32 seq
-    ByteReader br(rest.data() + 2, rest.size() - 2);
-    return br.ReadU32LE(outSeq);
+    outSeq = pong.seq;
+    return true;
 }
 
 int main()
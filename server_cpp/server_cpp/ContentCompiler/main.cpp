@@ -0,0 +1,530 @@
+// ContentCompiler: 기획 테이블(JSON/CSV) -> 서버용 바이너리 (GameServer/inc/game/ContentFormat.h)
+//
+// usage: ContentCompiler --skills <file> --enemies <file> --out <file> [--data-version N] [--bench]
+//  - 입력 형식은 확장자로 판단 (.csv: 첫 줄 헤더 / .json: 평평한 객체 배열)
+//  - --bench: 같은 입력으로 "시작 시 파싱" vs "바이너리 매핑" 로드 시간/lookup 비용 비교
+
+#include "game/ContentFormat.h"
+#include "game/ContentTables.h"
+#include "game/HitResolver.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using Row = std::unordered_map<std::string, std::string>;
+
+static bool ReadTextFile(const std::string& path, std::string& out)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open())
+        return false;
+
+    std::ostringstream ss;
+    ss << in.rdbuf();
+    out = ss.str();
+    return true;
+}
+
+static std::string Trim(const std::string& s)
+{
+    const size_t b = s.find_first_not_of(" \t\r\n");
+    if (b == std::string::npos)
+        return "";
+    const size_t e = s.find_last_not_of(" \t\r\n");
+    return s.substr(b, e - b + 1);
+}
+
+static bool EndsWith(const std::string& s, const std::string& suffix)
+{
+    return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+// ---- CSV ------------------------------------------------------------------
+// 따옴표/이스케이프 없음 (테이블 값은 숫자/식별자만), '#' 시작 줄은 주석
+
+static std::vector<std::string> SplitComma(const std::string& line)
+{
+    std::vector<std::string> cols;
+    std::string cur;
+    std::istringstream ss(line);
+    while (std::getline(ss, cur, ','))
+        cols.push_back(Trim(cur));
+    return cols;
+}
+
+static bool ParseCsv(const std::string& text, std::vector<Row>& rows, std::string& err)
+{
+    std::istringstream in(text);
+    std::string line;
+    std::vector<std::string> header;
+    int lineNo = 0;
+
+    while (std::getline(in, line))
+    {
+        ++lineNo;
+        line = Trim(line);
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        std::vector<std::string> cols = SplitComma(line);
+        if (header.empty())
+        {
+            header = cols;
+            continue;
+        }
+
+        if (cols.size() != header.size())
+        {
+            err = "line " + std::to_string(lineNo) + ": expected " + std::to_string(header.size()) + " columns";
+            return false;
+        }
+
+        Row row;
+        for (size_t i = 0; i < cols.size(); ++i)
+            row[header[i]] = cols[i];
+        rows.push_back(std::move(row));
+    }
+    return true;
+}
+
+// ---- JSON -----------------------------------------------------------------
+// [ { "key": number|string|bool, ... }, ... ] 만 지원 (중첩 없음)
+
+struct JsonCursor
+{
+    const std::string& s;
+    size_t pos = 0;
+
+    void SkipWs()
+    {
+        while (pos < s.size() && (s[pos] == ' ' || s[pos] == '\t' || s[pos] == '\r' || s[pos] == '\n'))
+            ++pos;
+    }
+
+    bool Eat(char c)
+    {
+        SkipWs();
+        if (pos < s.size() && s[pos] == c)
+        {
+            ++pos;
+            return true;
+        }
+        return false;
+    }
+
+    bool String(std::string& out)
+    {
+        SkipWs();
+        if (pos >= s.size() || s[pos] != '"')
+            return false;
+        ++pos;
+
+        out.clear();
+        while (pos < s.size() && s[pos] != '"')
+        {
+            if (s[pos] == '\\' && pos + 1 < s.size())
+                ++pos;
+            out.push_back(s[pos++]);
+        }
+        return pos < s.size() && s[pos++] == '"';
+    }
+
+    bool Scalar(std::string& out)
+    {
+        SkipWs();
+        if (pos < s.size() && s[pos] == '"')
+            return String(out);
+
+        const size_t b = pos;
+        while (pos < s.size() && s[pos] != ',' && s[pos] != '}' && s[pos] != ']'
+            && s[pos] != ' ' && s[pos] != '\t' && s[pos] != '\r' && s[pos] != '\n')
+            ++pos;
+        out = s.substr(b, pos - b);
+        return !out.empty();
+    }
+};
+
+static bool ParseJson(const std::string& text, std::vector<Row>& rows, std::string& err)
+{
+    JsonCursor c{ text };
+
+    if (!c.Eat('['))
+    {
+        err = "expected '['";
+        return false;
+    }
+    if (c.Eat(']'))
+        return true;
+
+    do
+    {
+        if (!c.Eat('{'))
+        {
+            err = "expected '{' at offset " + std::to_string(c.pos);
+            return false;
+        }
+
+        Row row;
+        if (!c.Eat('}'))
+        {
+            do
+            {
+                std::string key;
+                std::string value;
+                if (!c.String(key) || !c.Eat(':') || !c.Scalar(value))
+                {
+                    err = "bad key/value at offset " + std::to_string(c.pos);
+                    return false;
+                }
+                row[key] = value;
+            } while (c.Eat(','));
+
+            if (!c.Eat('}'))
+            {
+                err = "expected '}' at offset " + std::to_string(c.pos);
+                return false;
+            }
+        }
+        rows.push_back(std::move(row));
+    } while (c.Eat(','));
+
+    if (!c.Eat(']'))
+    {
+        err = "expected ']' at offset " + std::to_string(c.pos);
+        return false;
+    }
+    return true;
+}
+
+static bool LoadRows(const std::string& path, std::vector<Row>& rows, std::string& err)
+{
+    std::string text;
+    if (!ReadTextFile(path, text))
+    {
+        err = "cannot read";
+        return false;
+    }
+
+    if (EndsWith(path, ".csv"))
+        return ParseCsv(text, rows, err);
+    if (EndsWith(path, ".json"))
+        return ParseJson(text, rows, err);
+
+    err = "unknown extension (use .csv or .json)";
+    return false;
+}
+
+// ---- 레코드 변환 ----------------------------------------------------------
+
+static bool GetUInt(const Row& row, const char* key, uint32 maxValue, uint32& out, std::string& err)
+{
+    auto it = row.find(key);
+    if (it == row.end())
+    {
+        err = std::string("missing '") + key + "'";
+        return false;
+    }
+
+    char* end = nullptr;
+    const unsigned long v = std::strtoul(it->second.c_str(), &end, 10);
+    if (end == it->second.c_str() || *end != '\0' || v > maxValue)
+    {
+        err = std::string("bad '") + key + "': " + it->second;
+        return false;
+    }
+    out = (uint32)v;
+    return true;
+}
+
+static bool GetFloat(const Row& row, const char* key, float& out, std::string& err)
+{
+    auto it = row.find(key);
+    if (it == row.end())
+    {
+        err = std::string("missing '") + key + "'";
+        return false;
+    }
+
+    char* end = nullptr;
+    out = std::strtof(it->second.c_str(), &end);
+    if (end == it->second.c_str() || *end != '\0' || out < 0.f)
+    {
+        err = std::string("bad '") + key + "': " + it->second;
+        return false;
+    }
+    return true;
+}
+
+template <typename Def>
+static bool SortAndCheckIds(std::vector<Def>& defs, std::string& err)
+{
+    std::sort(defs.begin(), defs.end(), [](const Def& a, const Def& b) { return a.id < b.id; });
+    for (size_t i = 1; i < defs.size(); ++i)
+    {
+        if (defs[i - 1].id == defs[i].id)
+        {
+            err = "duplicate id " + std::to_string(defs[i].id);
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool BuildSkills(const std::vector<Row>& rows, std::vector<SkillDef>& out, std::string& err)
+{
+    for (size_t i = 0; i < rows.size(); ++i)
+    {
+        SkillDef d{};
+        uint32 id, damage, cooldown;
+        if (!GetUInt(rows[i], "id", 0xFFFF, id, err) || !GetUInt(rows[i], "damage", 0xFFFF, damage, err)
+            || !GetUInt(rows[i], "cooldown_ms", 0xFFFF, cooldown, err)
+            || !GetFloat(rows[i], "radius", d.radius, err) || !GetFloat(rows[i], "range", d.range, err))
+        {
+            err = "skill row " + std::to_string(i + 1) + ": " + err;
+            return false;
+        }
+        d.id = (uint16)id;
+        d.damage = (uint16)damage;
+        d.cooldownMs = (uint16)cooldown;
+
+        // shape는 선택 열 (없거나 비었으면 circle)
+        auto shape = rows[i].find("shape");
+        if (shape != rows[i].end() && !shape->second.empty() && shape->second != "circle")
+        {
+            if (shape->second != "box")
+            {
+                err = "skill row " + std::to_string(i + 1) + ": bad 'shape': " + shape->second + " (circle|box)";
+                return false;
+            }
+            d.shape = (uint8)HitShape::Box;
+        }
+        out.push_back(d);
+    }
+    return SortAndCheckIds(out, err);
+}
+
+static bool BuildEnemies(const std::vector<Row>& rows, std::vector<EnemyDef>& out, std::string& err)
+{
+    for (size_t i = 0; i < rows.size(); ++i)
+    {
+        EnemyDef d{};
+        uint32 id, maxHp, attackDamage, attackInterval;
+        if (!GetUInt(rows[i], "id", 0xFFFF, id, err) || !GetUInt(rows[i], "max_hp", 0xFFFF, maxHp, err)
+            || !GetUInt(rows[i], "attack_damage", 0xFFFF, attackDamage, err)
+            || !GetUInt(rows[i], "attack_interval_ms", 0xFFFF, attackInterval, err)
+            || !GetFloat(rows[i], "move_speed", d.moveSpeed, err) || !GetFloat(rows[i], "radius", d.radius, err))
+        {
+            err = "enemy row " + std::to_string(i + 1) + ": " + err;
+            return false;
+        }
+        if (maxHp == 0)
+        {
+            err = "enemy row " + std::to_string(i + 1) + ": max_hp must be > 0";
+            return false;
+        }
+        d.id = (uint16)id;
+        d.maxHp = (uint16)maxHp;
+        d.attackDamage = (uint16)attackDamage;
+        d.attackIntervalMs = (uint16)attackInterval;
+        out.push_back(d);
+    }
+    return SortAndCheckIds(out, err);
+}
+
+// ---- 출력 -----------------------------------------------------------------
+
+static void AlignTo(ByteBuffer& buf, size_t align)
+{
+    while (buf.size() % align != 0)
+        buf.push_back(0);
+}
+
+template <typename Def>
+static ContentTableDesc AppendTable(ByteBuffer& buf, ContentTableId id, const std::vector<Def>& defs)
+{
+    AlignTo(buf, CONTENT_TABLE_ALIGN);
+
+    ContentTableDesc d{};
+    d.tableId = (uint32)id;
+    d.recordSize = sizeof(Def);
+    d.count = (uint32)defs.size();
+    d.offset = (uint32)buf.size();
+
+    // LE 호스트 전제 (ContentFormat.h static_assert) -> 레코드 메모리 그대로가 파일 포맷
+    const Byte* bytes = (const Byte*)defs.data();
+    buf.insert(buf.end(), bytes, bytes + defs.size() * sizeof(Def));
+    return d;
+}
+
+static bool WriteContent(const std::string& path, uint32 dataVersion, const std::vector<SkillDef>& skills, const std::vector<EnemyDef>& enemies)
+{
+    constexpr uint16 TABLE_COUNT = 2;
+
+    ByteBuffer buf(sizeof(ContentFileHeader) + TABLE_COUNT * sizeof(ContentTableDesc), 0);
+
+    ContentTableDesc descs[TABLE_COUNT];
+    descs[0] = AppendTable(buf, ContentTableId::Skill, skills);
+    descs[1] = AppendTable(buf, ContentTableId::Enemy, enemies);
+
+    ContentFileHeader header{};
+    header.magic = CONTENT_MAGIC;
+    header.formatVersion = CONTENT_FORMAT_VERSION;
+    header.tableCount = TABLE_COUNT;
+    header.dataVersion = dataVersion;
+    header.fileSize = (uint32)buf.size();
+
+    std::memcpy(buf.data(), &header, sizeof(header));
+    std::memcpy(buf.data() + sizeof(header), descs, sizeof(descs));
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open())
+        return false;
+
+    out.write((const char*)buf.data(), (std::streamsize)buf.size());
+    return out.good();
+}
+
+// ---- 벤치 -----------------------------------------------------------------
+
+static double ElapsedUs(std::chrono::steady_clock::time_point t0)
+{
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+}
+
+static void RunBench(const std::string& skillsPath, const std::string& enemiesPath, const std::string& outPath)
+{
+    constexpr int LOAD_RUNS = 20;
+    constexpr int LOOKUPS = 1000000;
+
+    // 1) 시작 시 파싱: 텍스트 읽기 + 파싱 + 레코드 변환 + id 맵 구성
+    double parseUs = 0.0;
+    std::unordered_map<uint16, SkillDef> skillMap;
+    for (int run = 0; run < LOAD_RUNS; ++run)
+    {
+        const auto t0 = std::chrono::steady_clock::now();
+
+        std::vector<Row> skillRows, enemyRows;
+        std::vector<SkillDef> skills;
+        std::vector<EnemyDef> enemies;
+        std::string err;
+        LoadRows(skillsPath, skillRows, err);
+        LoadRows(enemiesPath, enemyRows, err);
+        BuildSkills(skillRows, skills, err);
+        BuildEnemies(enemyRows, enemies, err);
+
+        skillMap.clear();
+        for (const SkillDef& d : skills)
+            skillMap[d.id] = d;
+
+        parseUs += ElapsedUs(t0);
+    }
+
+    // 2) 바이너리 매핑: 열기 + 헤더 검증만
+    double mapUs = 0.0;
+    std::unique_ptr<ContentTables> tables;
+    for (int run = 0; run < LOAD_RUNS; ++run)
+    {
+        const auto t0 = std::chrono::steady_clock::now();
+        tables = ContentTables::Load(outPath);
+        mapUs += ElapsedUs(t0);
+    }
+    if (!tables || tables->SkillCount() == 0)
+    {
+        std::cout << "bench: no skills to look up\n";
+        return;
+    }
+
+    // lookup: 실제 id + 없는 id 섞어서
+    std::vector<uint16> keys(LOOKUPS);
+    std::mt19937 rng(1234);
+    for (int i = 0; i < LOOKUPS; ++i)
+    {
+        keys[i] = (i % 8 == 0) ? (uint16)rng() : tables->Skills()[rng() % tables->SkillCount()].id;
+    }
+
+    uint64 sink = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint16 k : keys)
+    {
+        auto it = skillMap.find(k);
+        if (it != skillMap.end()) sink += it->second.damage;
+    }
+    const double mapLookupNs = ElapsedUs(t0) * 1000.0 / LOOKUPS;
+
+    t0 = std::chrono::steady_clock::now();
+    for (uint16 k : keys)
+    {
+        if (const SkillDef* d = tables->FindSkill(k)) sink += d->damage;
+    }
+    const double mmapLookupNs = ElapsedUs(t0) * 1000.0 / LOOKUPS;
+
+    std::cout << "load  parse-at-startup=" << parseUs / LOAD_RUNS << "us  mapped=" << mapUs / LOAD_RUNS << "us\n";
+    std::cout << "skill lookup  unordered_map=" << mapLookupNs << "ns  mapped=" << mmapLookupNs << "ns"
+        << "  (" << tables->SkillCount() << " skills, sink=" << sink << ")\n";
+}
+
+int main(int argc, char* argv[])
+{
+    std::string skillsPath, enemiesPath, outPath;
+    uint32 dataVersion = 1;
+    bool bench = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if (arg == "--skills" && hasValue) skillsPath = argv[++i];
+        else if (arg == "--enemies" && hasValue) enemiesPath = argv[++i];
+        else if (arg == "--out" && hasValue) outPath = argv[++i];
+        else if (arg == "--data-version" && hasValue) dataVersion = (uint32)std::strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--bench") bench = true;
+        else
+        {
+            std::cout << "unknown argument: " << arg << "\n";
+            return 1;
+        }
+    }
+
+    if (skillsPath.empty() || enemiesPath.empty() || outPath.empty())
+    {
+        std::cout << "usage: ContentCompiler --skills <csv|json> --enemies <csv|json> --out <file> [--data-version N] [--bench]\n";
+        return 1;
+    }
+
+    std::vector<Row> skillRows, enemyRows;
+    std::vector<SkillDef> skills;
+    std::vector<EnemyDef> enemies;
+    std::string err;
+
+    if (!LoadRows(skillsPath, skillRows, err) || !BuildSkills(skillRows, skills, err))
+    {
+        std::cout << skillsPath << ": " << err << "\n";
+        return 1;
+    }
+    if (!LoadRows(enemiesPath, enemyRows, err) || !BuildEnemies(enemyRows, enemies, err))
+    {
+        std::cout << enemiesPath << ": " << err << "\n";
+        return 1;
+    }
+
+    if (!WriteContent(outPath, dataVersion, skills, enemies))
+    {
+        std::cout << outPath << ": write failed\n";
+        return 1;
+    }
+
+    std::cout << "wrote " << outPath << " (data v" << dataVersion << ", skills=" << skills.size() << ", enemies=" << enemies.size() << ")\n";
+
+    if (bench)
+        RunBench(skillsPath, enemiesPath, outPath);
+    return 0;
+}
\ No newline at end of file
@@ -1,24 +1,169 @@
 #pragma once
 
 #include "common/Types.h"
+#include <cstring>
+#include <string>
+#include <type_traits>
 #include <vector>
 
+// wire는 LE 고정. LE 호스트(x86/x64/ARM64 Windows)면 memcpy 한 번으로 저장/읽기
+#if defined(_WIN32) || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+constexpr bool HOST_LITTLE_ENDIAN = true;
+#else
+constexpr bool HOST_LITTLE_ENDIAN = false;
+#endif
+
+template <size_t N> struct UIntOfSize;
+template <> struct UIntOfSize<1> { using type = uint8; };
+template <> struct UIntOfSize<2> { using type = uint16; };
+template <> struct UIntOfSize<4> { using type = uint32; };
+template <> struct UIntOfSize<8> { using type = uint64; };
+
+// wire 기본 타입(u8/i8/u16/i16/u32/i32/u64/f32) LE 저장/읽기
+// 호출부에서 길이 확인을 보장한다고 가정 (bounds check 없음)
+template <typename T>
+inline void StoreLE(Byte* out, T v)
+{
+    static_assert(std::is_arithmetic<T>::value, "wire type must be arithmetic");
+
+    if constexpr (HOST_LITTLE_ENDIAN)
+    {
+        std::memcpy(out, &v, sizeof(T));
+        return;
+    }
+
+    using U = typename UIntOfSize<sizeof(T)>::type;
+    U u;
+    std::memcpy(&u, &v, sizeof(T));
+    for (size_t i = 0; i < sizeof(T); ++i)
+        out[i] = (Byte)(u >> (8 * i));
+}
+
+template <typename T>
+inline T LoadLE(const Byte* in)
+{
+    static_assert(std::is_arithmetic<T>::value, "wire type must be arithmetic");
+
+    T v;
+    if constexpr (HOST_LITTLE_ENDIAN)
+    {
+        std::memcpy(&v, in, sizeof(T));
+        return v;
+    }
+
+    using U = typename UIntOfSize<sizeof(T)>::type;
+    U u = 0;
+    for (size_t i = 0; i < sizeof(T); ++i)
+        u |= (U)((U)in[i] << (8 * i));
+    std::memcpy(&v, &u, sizeof(T));
+    return v;
+}
+
+// 가변 크기 writer (vector 소유)
+// - 크기를 알면 Reserve로 한 번만 할당
+// - 값마다 push_back 대신 resize 후 포인터로 기록
 struct ByteWriter
 {
     ByteBuffer buf;
 
-    void WriteU16LE(uint16 v)
+    ByteWriter() = default;
+    explicit ByteWriter(size_t reserveBytes) { buf.reserve(reserveBytes); }
+
+    void Reserve(size_t n) { buf.reserve(buf.size() + n); }
+    void Clear() { buf.clear(); }
+    size_t Size() const { return buf.size(); }
+
+    // n 바이트 확보 후 시작 포인터 반환 (다음 Grow 전까지만 유효)
+    Byte* Grow(size_t n)
+    {
+        const size_t at = buf.size();
+        buf.resize(at + n);
+        return buf.data() + at;
+    }
+
+    template <typename T>
+    void Write(T v) { StoreLE(Grow(sizeof(T)), v); }
+
+    void WriteU8(uint8 v) { buf.push_back(v); }
+    void WriteI8(int8 v) { buf.push_back((Byte)v); }
+    void WriteU16LE(uint16 v) { Write(v); }
+    void WriteI16LE(int16 v) { Write(v); }
+    void WriteU32LE(uint32 v) { Write(v); }
+    void WriteI32LE(int32 v) { Write(v); }
+    void WriteU64LE(uint64 v) { Write(v); }
+    void WriteF32LE(float v) { Write(v); }
+
+    void WriteBytes(const Byte* data, size_t len)
+    {
+        if (len > 0)
+            std::memcpy(Grow(len), data, len);
+    }
+
+    // uint16 length + UTF-8 bytes (65535 초과분은 잘림)
+    void WriteString(const char* s, size_t len)
+    {
+        if (len > 0xFFFF) len = 0xFFFF;
+        WriteU16LE((uint16)len);
+        WriteBytes((const Byte*)s, len);
+    }
+
+    void WriteString(const std::string& s) { WriteString(s.data(), s.size()); }
+};
+
+// 고정 용량 writer (외부 버퍼, 할당 없음)
+// - 용량 초과 시 이후 쓰기는 모두 무시되고 Ok() == false (sticky)
+struct FixedByteWriter
+{
+    Byte* p;
+    size_t cap;
+    size_t pos{ 0 };
+    bool overflow{ false };
+
+    FixedByteWriter(Byte* data, size_t capacity) : p(data), cap(capacity) {}
+
+    bool Ok() const { return !overflow; }
+    size_t Size() const { return pos; }
+
+    Byte* Grow(size_t n)
     {
-        buf.push_back((Byte)(v & 0xFF));
-        buf.push_back((Byte)((v >> 8) & 0xFF));
+        if (overflow || pos + n > cap)
+        {
+            overflow = true;
+            return nullptr;
+        }
+        Byte* at = p + pos;
+        pos += n;
+        return at;
     }
 
-    void WriteU32LE(uint32 v)
+    template <typename T>
+    void Write(T v)
     {
-        buf.push_back((Byte)(v & 0xFF));
-        buf.push_back((Byte)((v >> 8) & 0xFF));
-        buf.push_back((Byte)((v >> 16) & 0xFF));
-        buf.push_back((Byte)((v >> 24) & 0xFF));
+        if (Byte* at = Grow(sizeof(T)))
+            StoreLE(at, v);
+    }
+
+    void WriteU8(uint8 v) { Write(v); }
+    void WriteI8(int8 v) { Write(v); }
+    void WriteU16LE(uint16 v) { Write(v); }
+    void WriteI16LE(int16 v) { Write(v); }
+    void WriteU32LE(uint32 v) { Write(v); }
+    void WriteI32LE(int32 v) { Write(v); }
+    void WriteU64LE(uint64 v) { Write(v); }
+    void WriteF32LE(float v) { Write(v); }
+
+    void WriteBytes(const Byte* data, size_t len)
+    {
+        if (len == 0) return;
+        if (Byte* at = Grow(len))
+            std::memcpy(at, data, len);
+    }
+
+    void WriteString(const char* s, size_t len)
+    {
+        if (len > 0xFFFF) len = 0xFFFF;
+        WriteU16LE((uint16)len);
+        WriteBytes((const Byte*)s, len);
     }
 };
 
@@ -31,15 +176,45 @@ struct ByteReader
     ByteReader(const Byte* data, size_t size) : p(data), len(size) {}
 
     bool CanRead(size_t n) const { return pos + n <= len; }
+    size_t Remaining() const { return len - pos; }
+
+    template <typename T>
+    bool Read(T& out)
+    {
+        if (!CanRead(sizeof(T))) return false;
+        out = LoadLE<T>(p + pos);
+        pos += sizeof(T);
+        return true;
+    }
+
+    bool ReadU8(uint8& out) { return Read(out); }
+    bool ReadI8(int8& out) { return Read(out); }
+    bool ReadU16LE(uint16& out) { return Read(out); }
+    bool ReadI16LE(int16& out) { return Read(out); }
+    bool ReadU32LE(uint32& out) { return Read(out); }
+    bool ReadI32LE(int32& out) { return Read(out); }
+    bool ReadU64LE(uint64& out) { return Read(out); }
+    bool ReadF32LE(float& out) { return Read(out); }
 
-    bool ReadU32LE(uint32& out)
+    // 복사 없이 payload 내부를 가리킴 (원본 버퍼 수명 동안만 유효)
+    bool ReadBytes(size_t n, const Byte*& out)
     {
-        if (!CanRead(4)) return false;
-        out = (uint32)p[pos]
-            | ((uint32)p[pos + 1] << 8)
-            | ((uint32)p[pos + 2] << 16)
-            | ((uint32)p[pos + 3] << 24);
-        pos += 4;
+        if (!CanRead(n)) return false;
+        out = p + pos;
+        pos += n;
+        return true;
+    }
+
+    bool ReadString(const char*& outData, uint16& outLen)
+    {
+        const size_t save = pos;
+        const Byte* bytes = nullptr;
+        if (!ReadU16LE(outLen) || !ReadBytes(outLen, bytes))
+        {
+            pos = save;
+            return false;
+        }
+        outData = (const char*)bytes;
         return true;
     }
 };
@@ -49,20 +224,14 @@ inline ByteBuffer BuildFrame(MsgId msgId, const Byte* payload, size_t payloadLen
 {
     const uint16 length = (uint16)(2 + payloadLen);
 
-    ByteBuffer out;
-    out.reserve((size_t)2 + (size_t)length);
-
-    // length LE
-    out.push_back((Byte)(length & 0xFF));
-    out.push_back((Byte)((length >> 8) & 0xFF));
+    // 할당 1번 + 헤더/페이로드 memcpy
+    ByteBuffer out((size_t)2 + (size_t)length);
 
-    // msg_id LE
-    out.push_back((Byte)(msgId & 0xFF));
-    out.push_back((Byte)((msgId >> 8) & 0xFF));
+    StoreLE<uint16>(out.data(), length);
+    StoreLE<uint16>(out.data() + 2, msgId);
 
-    // payload
     if (payloadLen > 0)
-        out.insert(out.end(), payload, payload + payloadLen);
+        std::memcpy(out.data() + 4, payload, payloadLen);
 
     return out;
-}
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "common/Types.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Epoch 기반 지연 회수 (EBR)
+// - reader(tick/I-O 스레드)는 Enter~Leave 구간 동안 raw 포인터를 refcount 없이 사용
+// - writer는 컨테이너에서 뺀 객체를 Retire로 넘기기만 함
+// - 모든 활성 reader가 현재 epoch을 본 뒤 2번 전진하면 그 전에 retire된 객체는
+//   더 이상 아무도 볼 수 없으므로 Collect에서 해제
+class EpochManager
+{
+public:
+    using ParticipantId = uint32;
+
+    static constexpr uint32 MAX_PARTICIPANTS = 64;
+    static constexpr ParticipantId INVALID_PARTICIPANT = 0xFFFFFFFFu;
+
+public:
+    EpochManager() = default;
+    ~EpochManager();
+
+    EpochManager(const EpochManager&) = delete;
+    EpochManager& operator=(const EpochManager&) = delete;
+
+    // reader 스레드가 시작 시 1회 등록 (실패 시 INVALID_PARTICIPANT)
+    ParticipantId Register();
+    void Unregister(ParticipantId pid);
+
+    // 임계 구간 진입/이탈 (락 없음, 할당 없음)
+    void Enter(ParticipantId pid);
+    void Leave(ParticipantId pid);
+
+    // 컨테이너에서 이미 빠진 객체를 넘김 (마지막 참조 해제는 Collect에서)
+    void Retire(std::shared_ptr<void> obj);
+
+    // 안전해진 객체만 해제. 어떤 스레드에서 호출해도 됨
+    void Collect();
+
+    // 종료 시: reader가 더 없다는 전제에서 전부 해제
+    void DrainAll();
+
+    size_t PendingCount() const { return _pending.load(std::memory_order_relaxed); }
+    uint64 CurrentEpoch() const { return _globalEpoch.load(std::memory_order_relaxed); }
+
+private:
+    bool TryAdvance();
+
+private:
+    // state: 0 = 비활성, (epoch << 1) | 1 = epoch에서 활성
+    struct alignas(64) Participant
+    {
+        std::atomic<uint64> state{ 0 };
+        std::atomic<bool> used{ false };
+    };
+
+    struct Retired
+    {
+        uint64 epoch;
+        std::shared_ptr<void> obj;
+    };
+
+    std::atomic<uint64> _globalEpoch{ 0 };
+    Participant _participants[MAX_PARTICIPANTS];
+
+    std::mutex _limboMtx;
+    std::vector<Retired> _limbo;
+    std::atomic<size_t> _pending{ 0 };
+};
+
+// RAII 임계 구간
+class EpochGuard
+{
+public:
+    EpochGuard(EpochManager& mgr, EpochManager::ParticipantId pid) : _mgr(mgr), _pid(pid)
+    {
+        _mgr.Enter(_pid);
+    }
+
+    ~EpochGuard()
+    {
+        _mgr.Leave(_pid);
+    }
+
+    EpochGuard(const EpochGuard&) = delete;
+    EpochGuard& operator=(const EpochGuard&) = delete;
+
+private:
+    EpochManager& _mgr;
+    EpochManager::ParticipantId _pid;
+};
\ No newline at end of file
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "common/Types.h"
+
+#include <string>
+
+// 읽기 전용 파일 매핑 (RAII)
+// - 페이지는 처음 접근할 때 OS가 올림 -> 로드 시간은 파일 크기와 거의 무관
+// - 매핑된 동안 파일 핸들 유지 (다른 프로세스 읽기/삭제는 허용)
+// - windows.h는 cpp에서만 (winsock2.h보다 먼저 들어가면 winsock.h 충돌)
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool Open(const std::string& path);
+    void Close();
+
+    const Byte* Data() const { return _data; }
+    size_t Size() const { return _size; }
+    bool IsOpen() const { return _data != nullptr; }
+
+private:
+    void* _file{ nullptr };       // HANDLE
+    void* _mapping{ nullptr };    // HANDLE
+    const Byte* _data{ nullptr };
+    size_t _size{ 0 };
+};
\ No newline at end of file
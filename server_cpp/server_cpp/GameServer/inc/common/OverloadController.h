@@ -0,0 +1,121 @@
+#pragma once
+
+#include "common/Types.h"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// 과부하 단계 (높을수록 많이 버림, 아래 단계 조치를 모두 포함)
+enum class LoadLevel : uint8
+{
+    Normal = 0,
+    ReduceSnapshots = 1,    // 방 스냅샷 주기를 늘림
+    ShedOptional = 2,       // 주기 체크포인트/replay checksum 같은 미뤄도 되는 일 생략
+    RejectRooms = 3,        // 새 방 안 만듦 (자리 있는 방에만 입장) + accept 지연
+    RejectAccepts = 4       // 새 접속은 S_Disconnect(Overloaded) 후 바로 닫음
+};
+
+const char* LoadLevelName(LoadLevel level);
+
+// tick 시간 분포 / send 큐 적체 / 프로세스 CPU를 창(OVERLOAD_WINDOW_MS)마다 보고 단계를 정함
+// - 올릴 땐 창마다 한 단계씩 (순간 튐에 바로 접속 거절까지 가지 않게)
+// - 내릴 땐 목표 단계가 OVERLOAD_CALM_WINDOWS 창 연속 낮아야 한 단계 (단계 사이를 오가며 떨지 않게)
+// - 판단은 자체 감시 스레드에서. tick 스레드는 RecordTick(원자 연산 1번)만, 나머지는 Level() 읽기만
+class OverloadController
+{
+public:
+    static constexpr uint32 OVERLOAD_WINDOW_MS = 1000;
+    static constexpr uint32 OVERLOAD_CALM_WINDOWS = 5;
+    static constexpr uint32 OVERLOAD_TICK_BUCKETS = 40;            // tick 예산 2배까지 예산/20 단위 + 초과 1칸
+    static constexpr size_t OVERLOAD_BACKLOG_BYTES = MAX_SEND_QUEUE_BYTES / 4;  // 이보다 큐가 쌓인 세션을 적체로 셈
+
+    // 단계별 진입 기준 [ReduceSnapshots, ShedOptional, RejectRooms, RejectAccepts], 하나라도 넘으면 그 단계
+    static constexpr std::array<uint32, 4> TICK_P95_PERMILLE = { 600, 750, 900, 1000 };   // tick 예산 대비
+    static constexpr std::array<uint32, 4> CPU_PERMILLE = { 700, 800, 900, 970 };         // 전체 코어 대비
+    static constexpr std::array<uint32, 4> BACKLOG_PERMILLE = { 20, 50, 100, 200 };       // 세션 대비 적체 세션
+
+    // 감시 스레드에서 창마다 호출
+    // - QueueSampler: 세션 수와 적체 세션 수 (세션이 없는 프로세스면 안 둠)
+    // - ExternalSampler: 다른 프로세스가 알려 온 단계 (게이트웨이: 게임 프로세스들) -> 자기 단계와 큰 쪽
+    using QueueSampler = std::function<void(uint32& sessions, uint32& backlogged)>;
+    using ExternalSampler = std::function<LoadLevel()>;
+
+    struct Sample
+    {
+        uint32 ticks = 0;
+        uint32 tickP50Us = 0;
+        uint32 tickP95Us = 0;
+        uint32 tickP99Us = 0;
+        uint32 cpuPermille = 0;
+        uint32 sessions = 0;
+        uint32 backlogged = 0;
+        LoadLevel external = LoadLevel::Normal;
+        LoadLevel target = LoadLevel::Normal;
+    };
+
+public:
+    // tickBudgetUs: tick 1번 예산 (tick 기준표가 이 값 대비)
+    explicit OverloadController(uint32 tickBudgetUs);
+    ~OverloadController();
+
+    OverloadController(const OverloadController&) = delete;
+    OverloadController& operator=(const OverloadController&) = delete;
+
+    // Start 전에 (이후 변경 금지)
+    void SetQueueSampler(QueueSampler sampler) { _queueSampler = std::move(sampler); }
+    void SetExternalSampler(ExternalSampler sampler) { _externalSampler = std::move(sampler); }
+
+    bool Start();
+    void Stop();
+
+    // tick 스레드: 이번 tick에 일한 시간 (깨어나서 다음 sleep 직전까지)
+    void RecordTick(uint64 workUs);
+
+    LoadLevel Level() const { return (LoadLevel)_level.load(std::memory_order_relaxed); }
+    bool AtLeast(LoadLevel level) const { return _level.load(std::memory_order_relaxed) >= (uint8)level; }
+
+    // 매칭 쪽에 알릴 값: 새 방을 받을 수 있는가
+    bool AcceptingRooms() const { return !AtLeast(LoadLevel::RejectRooms); }
+
+private:
+    void MonitorLoop();
+    void Evaluate();
+    Sample TakeSample();
+    uint32 TickPercentileUs(const std::array<uint32, OVERLOAD_TICK_BUCKETS + 1>& counts, uint32 total, uint32 permille) const;
+    uint32 SampleCpuPermille();
+    void LogStats();
+
+    // 기준표에서 value가 넘은 가장 높은 단계
+    static LoadLevel LevelFor(const std::array<uint32, 4>& thresholds, uint32 value);
+
+private:
+    std::atomic<uint8> _level{ (uint8)LoadLevel::Normal };
+
+    // tick 시간 히스토그램 (tick 스레드가 더하고 감시 스레드가 창마다 비움)
+    std::array<std::atomic<uint32>, OVERLOAD_TICK_BUCKETS + 1> _tickBuckets{};
+    const uint32 _tickBudgetUs;
+    const uint32 _bucketUs;
+
+    QueueSampler _queueSampler;
+    ExternalSampler _externalSampler;
+
+    std::atomic<bool> _running{ false };
+    std::thread _thread;
+    std::mutex _waitMutex;
+    std::condition_variable _waitCv;
+
+    // 아래는 감시 스레드 전용
+    uint32 _calmWindows{ 0 };
+    uint64 _lastCpuNs{ 0 };
+    uint64 _lastWallNs{ 0 };
+    Sample _last;
+    uint32 _maxLevel{ 0 };          // LogStats 구간 최고 단계
+    uint32 _changes{ 0 };           // LogStats 구간 단계 변경 수
+
+    std::string _tag;
+};
\ No newline at end of file
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "common/Types.h"
+
+#include <chrono>
+
+// 서버 시계 (us): steady_clock 그대로 -> 벽시계 보정에 안 흔들리고, Windows는 QPC라 인계받은 프로세스와도 같은 축
+// S_Ping 타임스탬프와 스냅샷 tick 시각(tickOriginUs)이 이 시계 기준
+inline uint64 ServerTimeUs(std::chrono::steady_clock::time_point t)
+{
+    return (uint64)std::chrono::duration_cast<std::chrono::microseconds>(t.time_since_epoch()).count();
+}
+
+inline uint64 ServerTimeUs()
+{
+    return ServerTimeUs(std::chrono::steady_clock::now());
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "common/Types.h"
+
+#include <string>
+
+// 이름 있는 공유 메모리 (페이지 파일 기반, RAII)
+// - Create: 새로 만들고 0으로 채워진 상태. 같은 이름이 이미 있으면 실패 (다른 프로세스가 쓰는 중)
+// - Open: 다른 프로세스가 만든 것을 통째로 매핑 (크기는 만든 쪽 기준, 페이지 단위로 올림됨)
+// - 이름은 "Local\" 네임스페이스 -> 같은 로그온 세션 프로세스끼리만
+// - windows.h는 cpp에서만 (MappedFile과 같음)
+class SharedMemory
+{
+public:
+    SharedMemory() = default;
+    ~SharedMemory();
+
+    SharedMemory(const SharedMemory&) = delete;
+    SharedMemory& operator=(const SharedMemory&) = delete;
+
+    bool Create(const std::string& name, size_t size);
+    bool Open(const std::string& name);
+    void Close();
+
+    Byte* Data() const { return _data; }
+    size_t Size() const { return _size; }
+    bool IsOpen() const { return _data != nullptr; }
+
+private:
+    void* _mapping{ nullptr };    // HANDLE
+    Byte* _data{ nullptr };
+    size_t _size{ 0 };
+};
+
+// 이름 있는 auto-reset 이벤트 (다른 프로세스의 링 소비자 깨우기)
+// 양쪽 모두 Create (이미 있으면 그걸 엶)
+class NamedEvent
+{
+public:
+    NamedEvent() = default;
+    ~NamedEvent();
+
+    NamedEvent(const NamedEvent&) = delete;
+    NamedEvent& operator=(const NamedEvent&) = delete;
+
+    bool Create(const std::string& name);
+    void Close();
+
+    void Signal();
+    bool Wait(uint32 timeoutMs);    // true = 신호 받음, false = timeout
+
+private:
+    void* _event{ nullptr };      // HANDLE
+};
\ No newline at end of file
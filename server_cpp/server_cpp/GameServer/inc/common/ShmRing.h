@@ -0,0 +1,180 @@
+#pragma once
+
+#include "common/ByteIO.h"
+#include "common/Types.h"
+
+#include <atomic>
+#include <new>
+
+// 공유 메모리 위 SPSC 레코드 링 (락 없음, 프로세스 간)
+// - 레코드: [u32 len][payload][8바이트 정렬 패딩]. 끝에 안 들어가면 WRAP 표시 후 처음부터
+//   -> 레코드는 항상 연속 구간이라 생산자는 제자리에 쓰고(Reserve/Commit) 소비자는 제자리에서 읽음 (Peek/Pop)
+// - head/tail은 계속 증가하는 바이트 위치 (capacity는 2의 거듭제곱). 각자 캐시 라인 분리
+// - 상대 위치는 각자 캐시해 두고 링이 차/비어 보일 때만 공유 라인을 다시 읽음
+// - 생산자 스레드 1개, 소비자 스레드 1개 (둘은 다른 프로세스여도 됨). 여럿이면 호출부가 직렬화
+// - std::atomic<uint64>는 lock-free라 주소 무관 -> 프로세스마다 매핑 주소가 달라도 됨
+class ShmRing
+{
+public:
+    static constexpr uint32 WRAP = 0xFFFFFFFF;
+    static constexpr size_t RECORD_HEADER = 4;
+    static constexpr size_t RECORD_ALIGN = 8;
+
+    struct Control
+    {
+        alignas(64) std::atomic<uint64> tail;   // 생산자만 씀
+        alignas(64) std::atomic<uint64> head;   // 소비자만 씀
+        alignas(64) uint64 capacity;
+    };
+    static_assert(std::atomic<uint64>::is_always_lock_free, "shared memory atomics must be lock-free");
+
+    static constexpr size_t BytesFor(size_t capacity) { return sizeof(Control) + capacity; }
+
+    // 레코드 하나의 payload 상한 (WRAP으로 버리는 자투리를 감안해 절반)
+    static constexpr size_t MaxRecord(size_t capacity) { return capacity / 2 - RECORD_HEADER; }
+
+    // 공유 메모리를 만든 쪽만 1회 (capacity는 2의 거듭제곱, 8 이상)
+    static void Init(Byte* mem, size_t capacity)
+    {
+        Control* ctl = new (mem) Control;
+        ctl->tail.store(0, std::memory_order_relaxed);
+        ctl->head.store(0, std::memory_order_relaxed);
+        ctl->capacity = capacity;
+    }
+
+public:
+    // 양쪽 모두: Init된 메모리에 붙음 (프로세스마다 자기 ShmRing 객체)
+    void Bind(Byte* mem)
+    {
+        _ctl = (Control*)mem;
+        _data = mem + sizeof(Control);
+        _capacity = (size_t)_ctl->capacity;
+        _mask = _capacity - 1;
+        _headCache = _ctl->head.load(std::memory_order_acquire);
+        _tailCache = _ctl->tail.load(std::memory_order_acquire);
+    }
+
+    bool IsBound() const { return _ctl != nullptr; }
+    size_t Capacity() const { return _capacity; }
+
+    // ---- 생산자 -------------------------------------------------------------
+
+    // len 바이트 자리를 잡고 payload 위치 반환 (자리가 없으면 nullptr, 기다리지 않음)
+    // 다음 Reserve 전에 Commit해야 소비자에게 보임
+    Byte* Reserve(size_t len)
+    {
+        if (len > MaxRecord(_capacity))
+            return nullptr;
+
+        const size_t need = AlignUp(RECORD_HEADER + len);
+        uint64 tail = _ctl->tail.load(std::memory_order_relaxed);
+        size_t off = (size_t)(tail & _mask);
+        const size_t toEnd = _capacity - off;
+        const size_t total = need <= toEnd ? need : toEnd + need;
+
+        if (tail + total - _headCache > _capacity)
+        {
+            _headCache = _ctl->head.load(std::memory_order_acquire);
+            if (tail + total - _headCache > _capacity)
+                return nullptr;
+        }
+
+        // 끝 자투리는 건너뜀 (off는 8 정렬이라 WRAP 4바이트는 항상 들어감)
+        if (need > toEnd)
+        {
+            StoreLE<uint32>(_data + off, WRAP);
+            tail += toEnd;
+            off = 0;
+        }
+
+        StoreLE<uint32>(_data + off, (uint32)len);
+        _pendingTail = tail + need;
+        return _data + off + RECORD_HEADER;
+    }
+
+    void Commit()
+    {
+        _ctl->tail.store(_pendingTail, std::memory_order_release);
+    }
+
+    // ---- 소비자 -------------------------------------------------------------
+
+    // 가장 오래된 레코드 (없으면 nullptr). Pop 전까지 포인터 유효
+    const Byte* Peek(size_t& len)
+    {
+        uint64 head = _ctl->head.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            if (head == _tailCache)
+            {
+                _tailCache = _ctl->tail.load(std::memory_order_acquire);
+                if (head == _tailCache)
+                    return nullptr;
+            }
+
+            const size_t off = (size_t)(head & _mask);
+            const uint32 n = LoadLE<uint32>(_data + off);
+            if (n == WRAP)
+            {
+                head += _capacity - off;
+                _ctl->head.store(head, std::memory_order_release);
+                continue;
+            }
+
+            // 상대가 깨진 값을 썼으면 더 읽지 않음 (링크를 다시 붙여야 함)
+            if (RECORD_HEADER + (size_t)n > _capacity - off)
+            {
+                _broken = true;
+                return nullptr;
+            }
+
+            _pendingHead = head + AlignUp(RECORD_HEADER + n);
+            len = n;
+            return _data + off + RECORD_HEADER;
+        }
+    }
+
+    void Pop()
+    {
+        _ctl->head.store(_pendingHead, std::memory_order_release);
+    }
+
+    bool Empty() const
+    {
+        return _ctl->head.load(std::memory_order_relaxed) == _ctl->tail.load(std::memory_order_acquire);
+    }
+
+    // 소비자: 지금 쌓인 것을 전부 버림 (상대가 바뀐 뒤 이전 상대가 남긴 레코드)
+    void SkipAll()
+    {
+        _tailCache = _ctl->tail.load(std::memory_order_acquire);
+        _ctl->head.store(_tailCache, std::memory_order_release);
+        _broken = false;
+    }
+
+    bool Broken() const { return _broken; }
+
+    // 대략적인 적재량 (통계용, 어느 쪽에서든)
+    size_t Used() const
+    {
+        return (size_t)(_ctl->tail.load(std::memory_order_relaxed) - _ctl->head.load(std::memory_order_relaxed));
+    }
+
+private:
+    static constexpr size_t AlignUp(size_t n) { return (n + RECORD_ALIGN - 1) & ~(RECORD_ALIGN - 1); }
+
+private:
+    Control* _ctl{ nullptr };
+    Byte* _data{ nullptr };
+    size_t _capacity{ 0 };
+    size_t _mask{ 0 };
+
+    // 생산자 쪽
+    uint64 _headCache{ 0 };
+    uint64 _pendingTail{ 0 };
+
+    // 소비자 쪽
+    uint64 _tailCache{ 0 };
+    uint64 _pendingHead{ 0 };
+    bool _broken{ false };
+};
\ No newline at end of file
@@ -0,0 +1,182 @@
+#pragma once
+
+#include "common/Types.h"
+
+#include <utility>
+#include <vector>
+
+// 세대(generation) 기반 슬롯맵
+// - 핸들 = (slot, gen): 해시 없이 slot 인덱스로 O(1) 조회
+// - 제거 시 gen이 증가하므로 이전 핸들(stale)은 조회/제거 모두 거부됨
+// - 값은 dense 배열에 모여 있음 -> 순회는 연속 메모리 접근
+// - 스레드 안전하지 않음 (호출부에서 락 담당)
+template <typename T>
+class SlotMap
+{
+public:
+    static constexpr uint32 INVALID_INDEX = 0xFFFFFFFFu;
+
+    struct Handle
+    {
+        uint32 slot = INVALID_INDEX;
+        uint32 gen = 0;
+
+        bool IsValid() const { return slot != INVALID_INDEX; }
+    };
+
+public:
+    explicit SlotMap(uint32 maxSlots = INVALID_INDEX) : _maxSlots(maxSlots) {}
+
+    // 실패(maxSlots 초과) 시 IsValid() == false
+    Handle Insert(T value)
+    {
+        uint32 slot = _freeHead;
+        if (slot != INVALID_INDEX)
+        {
+            _freeHead = _slots[slot].nextFree;
+        }
+        else
+        {
+            if (_slots.size() >= _maxSlots)
+                return Handle{};
+
+            slot = (uint32)_slots.size();
+            _slots.emplace_back();
+        }
+
+        Slot& s = _slots[slot];
+        s.denseIdx = (uint32)_dense.size();
+        s.nextFree = INVALID_INDEX;
+
+        _dense.push_back(std::move(value));
+        _denseToSlot.push_back(slot);
+
+        return Handle{ slot, s.gen };
+    }
+
+    // 지정한 핸들 그대로 넣기 (hot restart 인계: 이전 프로세스의 id 유지)
+    // 비어 있는 슬롯이어야 함. free list를 훑으므로 O(빈 슬롯 수) -> 시작 시점 전용
+    bool InsertAt(Handle h, T value)
+    {
+        if (!h.IsValid() || h.gen == 0 || h.slot >= _maxSlots)
+            return false;
+
+        while (_slots.size() <= h.slot)
+        {
+            const uint32 slot = (uint32)_slots.size();
+            _slots.emplace_back();
+            _slots[slot].nextFree = _freeHead;
+            _freeHead = slot;
+        }
+
+        Slot& s = _slots[h.slot];
+        if (s.denseIdx != INVALID_INDEX)
+            return false;
+
+        // free list에서 빼기
+        uint32* link = &_freeHead;
+        while (*link != h.slot)
+        {
+            if (*link == INVALID_INDEX)
+                return false;
+            link = &_slots[*link].nextFree;
+        }
+        *link = s.nextFree;
+
+        s.gen = h.gen;
+        s.denseIdx = (uint32)_dense.size();
+        s.nextFree = INVALID_INDEX;
+
+        _dense.push_back(std::move(value));
+        _denseToSlot.push_back(h.slot);
+        return true;
+    }
+
+    // 마지막 원소를 빈 자리로 옮기는 swap-and-pop
+    bool Remove(Handle h, T* outValue = nullptr)
+    {
+        Slot* s = Resolve(h);
+        if (!s) return false;
+
+        const uint32 idx = s->denseIdx;
+        const uint32 last = (uint32)_dense.size() - 1;
+
+        if (outValue)
+            *outValue = std::move(_dense[idx]);
+
+        if (idx != last)
+        {
+            _dense[idx] = std::move(_dense[last]);
+            _denseToSlot[idx] = _denseToSlot[last];
+            _slots[_denseToSlot[idx]].denseIdx = idx;
+        }
+        _dense.pop_back();
+        _denseToSlot.pop_back();
+
+        // gen 증가 (0은 "한 번도 안 쓴 핸들"과 구분하려고 건너뜀)
+        if (++s->gen == 0) s->gen = 1;
+        s->denseIdx = INVALID_INDEX;
+        s->nextFree = _freeHead;
+        _freeHead = h.slot;
+        return true;
+    }
+
+    T* Get(Handle h)
+    {
+        Slot* s = Resolve(h);
+        return s ? &_dense[s->denseIdx] : nullptr;
+    }
+
+    const T* Get(Handle h) const
+    {
+        const Slot* s = const_cast<SlotMap*>(this)->Resolve(h);
+        return s ? &_dense[s->denseIdx] : nullptr;
+    }
+
+    size_t Size() const { return _dense.size(); }
+    bool Empty() const { return _dense.empty(); }
+
+    // 순회용 dense 배열 (순서는 보장 안됨)
+    std::vector<T>& Values() { return _dense; }
+    const std::vector<T>& Values() const { return _dense; }
+
+    void Clear()
+    {
+        // 살아있는 슬롯 전부 무효화 + free list 재구성
+        for (uint32 slot : _denseToSlot)
+        {
+            Slot& s = _slots[slot];
+            if (++s.gen == 0) s.gen = 1;
+            s.denseIdx = INVALID_INDEX;
+            s.nextFree = _freeHead;
+            _freeHead = slot;
+        }
+        _dense.clear();
+        _denseToSlot.clear();
+    }
+
+private:
+    struct Slot
+    {
+        uint32 gen = 1;
+        uint32 denseIdx = INVALID_INDEX;
+        uint32 nextFree = INVALID_INDEX;
+    };
+
+    Slot* Resolve(Handle h)
+    {
+        if (h.slot >= _slots.size()) return nullptr;
+
+        Slot& s = _slots[h.slot];
+        if (s.gen != h.gen || s.denseIdx == INVALID_INDEX)
+            return nullptr;
+        return &s;
+    }
+
+private:
+    std::vector<Slot> _slots;
+    std::vector<T> _dense;
+    std::vector<uint32> _denseToSlot;
+    uint32 _freeHead = INVALID_INDEX;
+    uint32 _maxSlots;
+};
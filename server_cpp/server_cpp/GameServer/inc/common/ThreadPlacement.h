@@ -0,0 +1,57 @@
+#pragma once
+
+#include "common/Types.h"
+
+#include <string>
+
+// 스레드 역할 (토폴로지 설정 키)
+enum class ThreadRole : uint8
+{
+    Tick,           // tick
+    RoomWorker,     // workers (RoomWorkers lane 1..)
+    Encoder,        // encoders (스냅샷 인코더)
+    SessionIo,      // io (세션 I/O 완료 스레드, SessionIo 스레드 번호 순)
+    Accept,         // accept
+    Helper,         // helpers (체크포인트 직렬화/업로드, 입력 기록)
+    Relay,          // relays (관전 릴레이 lane)
+
+    Count
+};
+
+// 스레드 고정 + NUMA 노드 메모리 (--topology <file>)
+// 설정 파일: 줄마다 "key = value", '#' 뒤는 주석
+//   tick = 2
+//   workers = 3,4
+//   encoders = 5-6
+//   io = 8-15
+//   accept = 1
+//   helpers = 0
+//   relays = 7
+//   largePages = 1     # tick arena chunk를 large page로 (SeLockMemoryPrivilege 없으면 일반 페이지)
+// - 값은 논리 코어 번호 (processor group 순서대로 이어서 셈: group 1의 0번 = group 0 코어 수)
+// - index번째 스레드는 목록[index % 개수] 코어 1개에 고정. 목록이 없는 역할은 OS 기본 배치
+// - 파일은 스레드 시작 전에 1번만 Load (이후 읽기 전용 -> 잠금 없음)
+// - windows.h는 cpp에서만 (MappedFile과 같은 이유)
+class ThreadPlacement
+{
+public:
+    static bool Load(const std::string& path);
+
+    // 현재 스레드를 역할의 index번째 코어에 고정 (설정 없으면 역할만 기록)
+    static void Pin(ThreadRole role, uint64 index);
+
+    // 현재 스레드가 Pin한 역할 (Pin 안 한 스레드는 Count, --bench-arena 역할별 할당 수)
+    static ThreadRole CurrentRole();
+
+    // 현재 스레드의 NUMA 노드 (고정된 코어, 아니면 지금 도는 코어 기준)
+    static uint32 CurrentNode();
+
+    // node에 페이지 단위로 할당 (bytes는 페이지 크기로 올림). large = large page로 잡았는지
+    static void* AllocPages(size_t& bytes, uint32 node, bool& large);
+    static void FreePages(void* p);
+
+    static bool LargePages();
+
+    // 로그용 요약 ("tick=2 workers=3,4 ...")
+    static std::string Describe();
+};
\ No newline at end of file
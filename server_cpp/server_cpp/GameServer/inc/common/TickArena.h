@@ -0,0 +1,184 @@
+#pragma once
+
+#include "common/Types.h"
+
+#include <cstddef>
+#include <vector>
+
+// 디버그 빌드 기본 on: arena 메모리가 tick 밖으로 새는지 검사
+#ifndef TICK_ARENA_CHECKS
+#ifdef _DEBUG
+#define TICK_ARENA_CHECKS 1
+#else
+#define TICK_ARENA_CHECKS 0
+#endif
+#endif
+
+// tick 동안만 쓰는 임시 메모리 (스레드별 bump 할당)
+// - tick 스레드/RoomWorkers lane이 tick 끝에 Reset으로 통째로 비움 (개별 해제 없음)
+// - 모자라면 chunk를 더 붙이고, Reset 때 하나로 합침 -> 피크 뒤로는 tick당 malloc 0
+// - chunk는 주인 스레드의 NUMA 노드 페이지 (ThreadPlacement, largePages 설정 시 large page)
+// - 여기서 받은 메모리(ArenaVector 등)는 tick 안에서만: 멤버/세션 큐로 넘기면 안 됨
+// - TICK_ARENA_CHECKS: Reset 때 아직 살아 있는 할당(= tick 밖으로 샌 컨테이너)을 보고,
+//   비운 메모리는 0xCD로 덮고, 이전 tick에 만든 allocator로 할당/해제하면 중단
+class TickArena
+{
+public:
+    static constexpr size_t DEFAULT_CHUNK_BYTES = 64 * 1024;
+
+    struct Stats
+    {
+        uint64 resets = 0;
+        uint64 chunkAllocs = 0;     // 실제 페이지 할당 횟수 (안정 상태면 0)
+        size_t highWater = 0;       // tick 1번 최대 사용량
+        size_t capacity = 0;
+    };
+
+public:
+    explicit TickArena(size_t chunkBytes = DEFAULT_CHUNK_BYTES);
+    ~TickArena();
+
+    TickArena(const TickArena&) = delete;
+    TickArena& operator=(const TickArena&) = delete;
+
+    void* Allocate(size_t bytes, size_t align)
+    {
+        const uintptr_t p = ((uintptr_t)_cur + (align - 1)) & ~(uintptr_t)(align - 1);
+        if (p + bytes > (uintptr_t)_end)
+            return AllocateSlow(bytes, align);
+
+        _cur = (Byte*)(p + bytes);
+#if TICK_ARENA_CHECKS
+        ++_live;
+#endif
+        return (void*)p;
+    }
+
+    // 메모리는 Reset까지 그대로 (검사용 카운트만)
+    void Deallocate(void* p, size_t bytes)
+    {
+        (void)p;
+        (void)bytes;
+#if TICK_ARENA_CHECKS
+        --_live;
+#endif
+    }
+
+    // tick 끝: 전부 비움. 이 arena의 메모리를 가진 컨테이너가 남아 있으면 안 됨
+    void Reset();
+
+    // Reset마다 증가 (allocator가 자기 tick 것인지 확인)
+    uint32 Generation() const { return _generation; }
+    size_t Used() const { return _usedBefore + (size_t)(_cur - _begin); }
+
+    // LogStats에서 읽고 리셋 (arena 주인 스레드가 쉬는 동안만)
+    Stats TakeStats();
+
+    // 현재 스레드의 arena (Bind 없으면 스레드별 기본 arena)
+    static TickArena& ForThread();
+
+    // 작업 스레드가 시작 시 자기 arena를 지정 (통계를 바깥에서 모으려고)
+    static void Bind(TickArena* arena);
+
+private:
+    void* AllocateSlow(size_t bytes, size_t align);
+    void AddChunk(size_t bytes);
+
+private:
+    struct Chunk
+    {
+        Byte* data;
+        size_t size;
+    };
+
+    size_t _chunkBytes;
+    std::vector<Chunk> _chunks;     // [0] = 기본, 나머지는 이번 tick 넘침 (Reset 때 합침)
+    Byte* _begin{ nullptr };        // 현재 chunk
+    Byte* _cur{ nullptr };
+    Byte* _end{ nullptr };
+    size_t _usedBefore{ 0 };        // 앞 chunk들에서 쓴 양
+
+    uint32 _generation{ 0 };
+    Stats _stats;
+
+#if TICK_ARENA_CHECKS
+    int64 _live{ 0 };
+#endif
+};
+
+// std 컨테이너용 allocator (기본 생성 = 현재 스레드 arena)
+// 컨테이너는 tick 안에서 만들고 tick 안에서 버림 (지역 변수로만)
+template <typename T>
+class ArenaAllocator
+{
+public:
+    using value_type = T;
+
+    template <typename U>
+    friend class ArenaAllocator;
+
+public:
+    ArenaAllocator() : ArenaAllocator(TickArena::ForThread()) {}
+
+    explicit ArenaAllocator(TickArena& arena)
+        : _arena(&arena)
+#if TICK_ARENA_CHECKS
+        , _generation(arena.Generation())
+#endif
+    {
+    }
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other)
+        : _arena(other._arena)
+#if TICK_ARENA_CHECKS
+        , _generation(other._generation)
+#endif
+    {
+    }
+
+    T* allocate(size_t n)
+    {
+        CheckGeneration();
+        return static_cast<T*>(_arena->Allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, size_t n)
+    {
+        CheckGeneration();
+        _arena->Deallocate(p, n * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const { return _arena == other._arena; }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const { return _arena != other._arena; }
+
+private:
+#if TICK_ARENA_CHECKS
+    void CheckGeneration() const;
+#else
+    void CheckGeneration() const {}
+#endif
+
+private:
+    TickArena* _arena;
+#if TICK_ARENA_CHECKS
+    uint32 _generation;
+#endif
+};
+
+#if TICK_ARENA_CHECKS
+// 지난 tick에 만든 컨테이너를 이번 tick에 씀 (Reset된 메모리 재사용 중)
+void TickArenaEscaped(uint32 madeAt, uint32 now);
+
+template <typename T>
+void ArenaAllocator<T>::CheckGeneration() const
+{
+    if (_generation != _arena->Generation())
+        TickArenaEscaped(_generation, _arena->Generation());
+}
+#endif
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
\ No newline at end of file
@@ -17,9 +17,36 @@ using Byte = uint8;
 using ByteBuffer = std::vector<Byte>;
 
 using MsgId = uint16;
+using SessionId = uint64;
 
 constexpr size_t MAX_FRAME_TOTAL = 4096;
-constexpr size_t MAX_RECV_BUFFER = 64 * 1024;
+
+// 세션 수신 블록 (RecvBlockPool): 덜 된 프레임(< MAX_FRAME_TOTAL)을 앞으로 당겨도 recv 자리가 프레임 1개 이상 남게
+constexpr size_t RECV_BLOCK_BYTES = 2 * MAX_FRAME_TOTAL;
+
+// 세션 I/O 완료 스레드 수 (SessionIo, 세션 수와 무관)
+constexpr uint32 SESSION_IO_THREADS = 4;
+constexpr uint32 SESSION_RECV_ROUNDS = 4;      // 수신 완료 1번에 읽는 블록 수 상한 (바쁜 세션이 완료 스레드를 오래 잡지 않게)
+
+// 조용한 세션 1개의 상주 메모리 목표 (Session 객체 + 풀/슬롯 몫, 큐/수신 블록 제외) -> --bench-idle로 확인
+constexpr size_t SESSION_IDLE_BUDGET_BYTES = 2048;
+
+// 세션별 send 예산 (느린 클라 대비)
+constexpr size_t MAX_SEND_QUEUE_BYTES = 256 * 1024;
+constexpr size_t MAX_SEND_QUEUE_FRAMES = 512;
+constexpr uint32 SEND_OVERFLOW_DISCONNECT_MS = 3000;  // 예산 초과가 이만큼 지속되면 disconnect
+constexpr size_t SEND_QUEUE_HARD_LIMIT_BYTES = 4 * MAX_SEND_QUEUE_BYTES; // 초과 즉시 disconnect
+constexpr uint32 DISCONNECT_LINGER_MS = 1000;         // S_Disconnect가 이 안에 안 나가면(받지 않는 클라) 그냥 끊음
+constexpr uint32 SHUTDOWN_FLUSH_MS = 500;             // 서버 종료: S_Disconnect(ServerShutdown)가 나가길 기다리는 최대 시간
+
+// 세션 TCP RTT 조회 주기 (SessionIo 타이머, C_Pong을 안 보내는 클라만)
+constexpr uint32 RTT_SAMPLE_INTERVAL_MS = 1000;
+
+// 서버 ping (S_Ping/C_Pong): 세션별 SRTT/RTTVAR + 클라 시계 오프셋
+constexpr uint32 PING_INTERVAL_MS = 1000;
+constexpr uint32 PING_RING_SIZE = 4;            // 검증 가능한 미응답 ping 수 (더 늦은 pong은 버림)
+constexpr uint32 PING_MAX_RTT_MS = 5000;        // 넘는 표본은 버림
+constexpr uint32 RTT_REPORT_MIN_DELTA_MS = 2;   // 게임 레이어로 다시 알리는 최소 변화 (RoomManager 큐 락 횟수 제한)
 
 enum class PopResult
 {
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "common/Types.h"
+#include "proto/Protocol.h"
+
+#include <vector>
+
+// 체크포인트 blob 포맷 (Go 서비스로 올리는 방 진행 상태, LE)
+// header: [u32 magic][u16 version][u32 roomId][u32 serverTick][u8 segmentState][u8 flags][u16 playerCount][u32 enemyCount]
+// player: [u64 playerId][f32 x][f32 y][u16 hp][u8 state]
+// enemy:  [u32 id][u16 defId][u16 hp][u8 state]  (배열 순서 = 방 안의 적 순서)
+// - 적 위치는 넣지 않음 (복구 시 스폰 위치에서 다시 시작) -> 적 dirty는 hp/state 변화뿐
+constexpr uint32 CHECKPOINT_MAGIC = 0x50435347; // "GSCP"
+constexpr uint16 CHECKPOINT_VERSION = 1;
+
+constexpr size_t CHECKPOINT_HEADER_SIZE = 4 + 2 + 4 + 4 + 1 + 1 + 2 + 4;
+constexpr size_t CHECKPOINT_PLAYER_SIZE = 8 + 4 + 4 + 2 + 1;
+constexpr size_t CHECKPOINT_ENEMY_SIZE = 4 + 2 + 2 + 1;
+
+constexpr uint8 CHECKPOINT_FLAG_FINAL = 0x01;  // 방 종료 시점 (마지막 체크포인트)
+
+struct CheckpointPlayer
+{
+    uint64 playerId = 0;
+    float x = 0.f;
+    float y = 0.f;
+    uint16 hp = 0;
+    uint8 state = 0;
+};
+
+struct CheckpointEnemy
+{
+    uint32 index = 0;   // 방 안의 적 배열 위치 (blob에는 안 씀)
+    uint32 id = 0;
+    uint16 defId = 0;
+    uint16 hp = 0;
+    uint8 state = 0;
+};
+
+// tick 스레드가 뽑는 변경분 (지난 체크포인트 이후 dirty인 적만)
+// - 플레이어는 방당 몇 명뿐이라 매번 전부
+// - 전체 상태 조립/직렬화는 CheckpointService 스레드가 방별 사본에 합쳐서 함
+struct CheckpointDelta
+{
+    uint32 roomId = 0;
+    uint32 serverTick = 0;
+    SegmentState segmentState = SegmentState::InSegment;
+    uint8 flags = 0;
+    uint32 enemyCount = 0;
+
+    std::vector<CheckpointPlayer> players;
+    std::vector<CheckpointEnemy> dirtyEnemies;
+
+    void Clear()
+    {
+        players.clear();
+        dirtyEnemies.clear();
+        flags = 0;
+    }
+};
\ No newline at end of file
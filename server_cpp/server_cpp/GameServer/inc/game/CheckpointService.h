@@ -0,0 +1,79 @@
+#pragma once
+
+#include "common/ByteIO.h"
+#include "game/Checkpoint.h"
+#include "net/HttpUploader.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// 방 체크포인트 -> Go 서비스 저장
+// tick 스레드: Acquire -> Room::CaptureCheckpoint(dirty만) -> Submit
+// 직렬화 스레드: 방별 사본에 변경분을 합치고 전체 blob 직렬화 -> HttpUploader (POST /internal/rooms/{id}/checkpoint)
+// - tick 스레드 비용은 dirty 수에 비례 (전체 복사/직렬화/소켓 I/O 없음)
+// - 업로드가 밀리면 방별 최신 blob만 남음 (HttpUploader coalescing)
+class CheckpointService
+{
+public:
+    struct Stats
+    {
+        uint64 submitted = 0;
+        uint64 dirtyEnemies = 0;    // 변경분에 실린 적 수 합
+        uint64 blobBytes = 0;
+        uint64 serializeNs = 0;     // 직렬화 스레드에서 쓴 시간 합
+        HttpUploader::Stats upload;
+    };
+
+public:
+    CheckpointService();
+    ~CheckpointService();
+
+    bool Start(const std::string& host, uint16 port);
+
+    // 남은 변경분을 모두 직렬화하고 업로드를 잠깐 기다린 뒤 종료
+    void Stop();
+
+    // tick 스레드 전용 (버퍼는 직렬화 스레드가 쓰고 돌려줌 -> capacity 재사용)
+    std::unique_ptr<CheckpointDelta> Acquire();
+    void Submit(std::unique_ptr<CheckpointDelta> delta);
+
+    Stats TakeStats();
+
+private:
+    struct RoomShadow
+    {
+        std::vector<CheckpointPlayer> players;
+        std::vector<CheckpointEnemy> enemies;   // 방의 적 배열과 같은 순서
+    };
+
+    void SerializeLoop();
+
+    // 변경분을 방별 사본에 합침 -> 사본 전체를 blob으로
+    static void Merge(const CheckpointDelta& delta, RoomShadow& shadow);
+    static void Serialize(const CheckpointDelta& delta, const RoomShadow& shadow, ByteWriter& out);
+
+private:
+    std::atomic<bool> _running{ false };
+    std::thread _worker;
+
+    HttpUploader _uploader;
+
+    // 아래는 _mutex 보호
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    std::vector<std::unique_ptr<CheckpointDelta>> _queue;
+    std::vector<std::unique_ptr<CheckpointDelta>> _free;
+    bool _stopping{ false };
+    Stats _stats;
+
+    // 직렬화 스레드 전용
+    std::unordered_map<uint32, RoomShadow> _shadows;
+
+    std::string _tag;
+};
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "common/ByteIO.h"
+
+#include <type_traits>
+
+// 컨텐츠 테이블 바이너리 포맷 (ContentCompiler가 생성, 서버는 매핑해서 그대로 읽음)
+// [ContentFileHeader][ContentTableDesc x tableCount][table data...]
+// - 모든 값 LE, 레코드는 id 오름차순 (lookup = 이진 탐색)
+// - 테이블 시작은 CONTENT_TABLE_ALIGN 정렬 -> 매핑 주소에서 바로 레코드 포인터로 사용
+// - formatVersion: 레이아웃 변경 시 올림 (불일치면 로드 거부)
+// - dataVersion: 기획 데이터 리비전 (로그/리로드 확인용)
+constexpr uint32 CONTENT_MAGIC = 0x54435347; // "GSCT"
+constexpr uint16 CONTENT_FORMAT_VERSION = 1;
+constexpr uint32 CONTENT_TABLE_ALIGN = 16;
+
+static_assert(HOST_LITTLE_ENDIAN, "content tables are read in place; LE host required");
+
+enum class ContentTableId : uint32
+{
+    Skill = 1,
+    Enemy = 2
+};
+
+struct ContentFileHeader
+{
+    uint32 magic;
+    uint16 formatVersion;
+    uint16 tableCount;
+    uint32 dataVersion;
+    uint32 fileSize;
+};
+
+struct ContentTableDesc
+{
+    uint32 tableId;     // ContentTableId
+    uint32 recordSize;  // sizeof(record), 로드 시 검증
+    uint32 count;
+    uint32 offset;      // 파일 시작 기준
+};
+
+struct SkillDef
+{
+    uint16 id;
+    uint16 damage;
+    uint16 cooldownMs;
+    uint8 shape;        // HitShape (0 = 원, 1 = 축 정렬 정사각형). 예전 파일은 reserved 0 -> 원
+    uint8 reserved;
+    float radius;       // 타격 반경 (target 중심), 사각형이면 반변
+    float range;        // 시전자 -> target 최대 거리
+};
+
+struct EnemyDef
+{
+    uint16 id;
+    uint16 maxHp;
+    uint16 attackDamage;
+    uint16 attackIntervalMs;
+    float moveSpeed;
+    float radius;       // 피격 반경
+};
+
+static_assert(sizeof(ContentFileHeader) == 16 && sizeof(ContentTableDesc) == 16, "content header layout");
+static_assert(sizeof(SkillDef) == 16 && sizeof(EnemyDef) == 16, "content record layout");
+static_assert(std::is_trivially_copyable<SkillDef>::value && std::is_trivially_copyable<EnemyDef>::value, "records must be POD");
\ No newline at end of file
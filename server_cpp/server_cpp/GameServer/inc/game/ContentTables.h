@@ -0,0 +1,80 @@
+#pragma once
+
+#include "common/MappedFile.h"
+#include "game/ContentFormat.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+
+// 매핑된 컨텐츠 파일 1개 (로드 후 불변)
+// - 파싱/레코드별 할당 없음: 헤더 검증 후 매핑 주소를 레코드 배열로 그대로 사용
+class ContentTables
+{
+public:
+    // 실패 시 nullptr (원인은 로그)
+    static std::unique_ptr<ContentTables> Load(const std::string& path);
+
+    uint32 DataVersion() const { return _dataVersion; }
+
+    const SkillDef* FindSkill(uint16 id) const;
+    const EnemyDef* FindEnemy(uint16 id) const;
+
+    const SkillDef* Skills() const { return _skills; }
+    uint32 SkillCount() const { return _skillCount; }
+    const EnemyDef* Enemies() const { return _enemies; }
+    uint32 EnemyCount() const { return _enemyCount; }
+
+private:
+    ContentTables() = default;
+
+    // 헤더/테이블 범위/정렬 검증 후 포인터 설정
+    bool Bind(std::string& outError);
+
+private:
+    MappedFile _file;
+    uint32 _dataVersion{ 0 };
+
+    const SkillDef* _skills{ nullptr };
+    uint32 _skillCount{ 0 };
+    const EnemyDef* _enemies{ nullptr };
+    uint32 _enemyCount{ 0 };
+
+    // id가 연속이면 이진 탐색 대신 직접 인덱싱
+    bool _skillsDense{ false };
+    bool _enemiesDense{ false };
+};
+
+// 현재 테이블 + hot reload
+// - 읽기는 tick 스레드에서만 (Current 포인터는 tick 안에서만 유지)
+// - 리로드: 호출 스레드에서 매핑/검증까지 끝내고 pending에 atomic 교체
+//   -> tick 시작 시 ApplyPendingReload가 current와 바꿈 (tick 사이라 옛 테이블을 보는 reader 없음)
+class ContentManager
+{
+public:
+    ContentManager() = default;
+    ~ContentManager();
+
+    ContentManager(const ContentManager&) = delete;
+    ContentManager& operator=(const ContentManager&) = delete;
+
+    // 시작 시 1회 (tick 시작 전). 실패하면 GameConfig 기본값으로 동작
+    bool LoadInitial(const std::string& path);
+
+    // 임의 스레드 (tick 스레드 제외). path가 비어 있으면 마지막 경로 재사용
+    // 매핑 중인 파일은 덮어쓸 수 없으므로 보통 새 이름으로 출력 후 경로 지정
+    bool RequestReload(const std::string& path = "");
+
+    // tick 스레드: tick 시작 시 호출 (교체됐으면 true)
+    bool ApplyPendingReload();
+
+    const ContentTables* Current() const { return _current.get(); }
+
+private:
+    std::mutex _pathMutex;
+    std::string _path;
+
+    std::unique_ptr<ContentTables> _current;
+    std::atomic<ContentTables*> _pending{ nullptr };
+};
\ No newline at end of file
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "common/TickArena.h"
+#include "common/Types.h"
+#include "game/GameConfig.h"
+
+#include <array>
+#include <vector>
+
+struct ByteWriter;
+struct ByteReader;
+
+// 적 행동 (버킷 = 같은 행동끼리 연속 배열)
+enum class AiBehavior : uint8
+{
+    Idle,       // 제자리 대기, 시간 분할로 대상 탐색
+    Chase,      // 대상에게 이동
+    Attack,     // 사거리 안, 주기마다 타격
+    Dead,
+
+    Count
+};
+
+// AI가 보는 플레이어 (Room이 tick마다 살아 있는 플레이어로 채움)
+struct AiTarget
+{
+    uint64 playerId = 0;
+    float x = 0.f;
+    float y = 0.f;
+
+    bool operator==(const AiTarget& o) const { return playerId == o.playerId && x == o.x && y == o.y; }
+    bool operator!=(const AiTarget& o) const { return !(*this == o); }
+};
+
+// 이번 tick 적 공격 결과 (Room이 플레이어에 반영)
+struct AiHit
+{
+    uint64 playerId = 0;
+    uint16 damage = 0;
+};
+
+// 적 1마리 AI 상태: 버킷 루프가 건드리는 값만 (hp/이력 등 나머지는 Room::Enemy)
+struct AiAgent
+{
+    uint32 enemy = 0;           // Room 적 index
+    float x = 0.f;
+    float y = 0.f;
+    float speed = 0.f;          // units/s
+    uint64 targetId = 0;        // Chase/Attack 대상 playerId
+    uint32 readyTick = 0;       // Attack: 이 tick부터 타격
+    uint16 damage = 0;
+    uint16 intervalTicks = 0;
+};
+
+static_assert(sizeof(AiAgent) == 32, "AiAgent should stay half a cache line");
+
+// 방 1개의 적 AI (tick 스레드 전용)
+// - 적마다 가상 Update 대신 행동별 버킷을 통째로 처리 (버킷마다 분기 없는 연속 루프)
+// - 버킷 이동은 swap-remove + push (적 index -> 버킷 위치는 _slotOf로 O(1))
+// - 대상 탐색(가장 가까운 플레이어)은 tick당 예산만큼만: 버킷을 커서로 돌면서 AI_SCAN_PERIOD_TICKS 안에 한 번씩
+// - 행동 전이는 루프가 끝난 뒤 한꺼번에 (루프 도중 배열이 안 바뀜)
+class EnemyAi
+{
+public:
+    void Clear();
+
+    // 새 적을 Idle 버킷에 (enemy는 0부터 연속으로 추가)
+    void Add(uint32 enemy, float x, float y, float speed, uint16 damage, uint16 intervalTicks);
+
+    void Kill(uint32 enemy);
+
+    const AiAgent& Agent(uint32 enemy) const;
+    AiBehavior BehaviorOf(uint32 enemy) const { return (AiBehavior)(_slotOf[enemy] >> SLOT_POS_BITS); }
+
+    const std::vector<AiAgent>& Bucket(AiBehavior b) const { return _buckets[(size_t)b]; }
+    size_t Count(AiBehavior b) const { return _buckets[(size_t)b].size(); }
+
+    // 지금 있는 적 중 가장 빠른 이동 속도 (tick당 이동 상한 = MaxSpeed * dt)
+    float MaxSpeed() const { return _maxSpeed; }
+
+    // 1 tick: 대상 탐색(예산) -> Chase 이동 -> Attack 타격 -> 전이 반영
+    // targets는 살아 있는 플레이어만, 타격은 outHits에 추가
+    void Update(uint32 tick, float dt, const ArenaVector<AiTarget>& targets, ArenaVector<AiHit>& outHits);
+
+    // 움직이는 적이 없고, 지금 대상 위치로 Idle 전원이 한 번씩 탐색해서 못 찾은 상태
+    // -> 대상이 그대로인 동안은 Update해도 탐색 커서만 돎 (Skip으로 대체 가능)
+    bool Settled() const;
+
+    // Settled 상태에서 ticks번 Update한 것과 같게 커서/카운터만 전진
+    void Skip(uint32 ticks);
+
+    // hot restart 인계: 버킷 순서/커서까지 그대로 (탐색 순서가 같아야 이어서 돌린 결과가 같음)
+    // _slotOf는 버킷에서 다시 만듦
+    void SaveState(ByteWriter& w) const;
+    bool LoadState(ByteReader& r);
+
+    // 누적 탐색 수 (LogStats에서 읽고 리셋)
+    uint64 TakeScans() { uint64 v = _scans; _scans = 0; return v; }
+
+private:
+    static constexpr uint32 SLOT_POS_BITS = 24;
+    static constexpr uint32 SLOT_POS_MASK = (1u << SLOT_POS_BITS) - 1;
+
+    struct Transition
+    {
+        uint32 enemy;
+        AiBehavior to;
+    };
+
+    std::vector<AiAgent>& BucketOf(AiBehavior b) { return _buckets[(size_t)b]; }
+
+    void Move(uint32 enemy, AiBehavior to);
+
+    // tick당 탐색 수 (버킷 크기 / 주기, 최소 AI_SCAN_MIN_PER_TICK, 버킷 크기 이하)
+    static uint32 ScanBudget(size_t count);
+
+    // radius 안에서 가장 가까운 대상 (없으면 nullptr)
+    static const AiTarget* FindNearest(float x, float y, float radius, const ArenaVector<AiTarget>& targets);
+    static const AiTarget* FindTarget(uint64 playerId, const ArenaVector<AiTarget>& targets);
+
+    // 행동 전이는 transitions(이번 tick 목록, tick arena)에 모았다가 Update 끝에 반영
+    void ScanIdle(const ArenaVector<AiTarget>& targets, ArenaVector<Transition>& transitions);
+    void RetargetChase(const ArenaVector<AiTarget>& targets);
+    void UpdateChase(uint32 tick, float dt, const ArenaVector<AiTarget>& targets, ArenaVector<Transition>& transitions);
+    void UpdateAttack(uint32 tick, const ArenaVector<AiTarget>& targets, ArenaVector<AiHit>& outHits, ArenaVector<Transition>& transitions);
+
+private:
+    std::array<std::vector<AiAgent>, (size_t)AiBehavior::Count> _buckets;
+    std::vector<uint32> _slotOf;    // 적 index -> (버킷 << 24) | 버킷 안 위치
+
+    uint32 _idleCursor{ 0 };
+    uint32 _chaseCursor{ 0 };
+
+    // 대상/Idle 구성이 바뀐 뒤 연속으로 허탕 친 Idle 탐색 수 (Idle 수 이상이면 전원 확인 끝)
+    uint64 _cleanScans{ 0 };
+    std::vector<AiTarget> _lastTargets;
+
+    uint64 _scans{ 0 };
+    float _maxSpeed{ 0.f };
+};
\ No newline at end of file
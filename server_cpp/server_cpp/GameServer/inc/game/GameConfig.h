@@ -0,0 +1,96 @@
+#pragma once
+
+#include "common/Types.h"
+
+// 시뮬레이션/스냅샷 기본값 (protocol_v0.md §7.1)
+constexpr uint32 TICK_HZ = 30;
+constexpr float TICK_DT = 1.f / (float)TICK_HZ;     // Update마다 같은 값 (replay가 같은 결과)
+constexpr uint32 TICK_INTERVAL_US = 1000000 / TICK_HZ;  // tick 스케줄 + 클라 tick 시각 대응 (S_Ping.tickUs)
+constexpr uint32 SNAPSHOT_EVERY_TICKS = 3;      // 30Hz 중 3틱마다 = 10Hz
+
+// 방별 스냅샷 주기 범위 (활동량/RTT로 조정, 값은 S_Snapshot으로 클라에 알림)
+constexpr uint32 SNAPSHOT_MIN_EVERY_TICKS = 2;      // 15Hz: 전투 중 + 방 전원 RTT 낮음
+constexpr uint32 SNAPSHOT_QUIET_EVERY_TICKS = 6;    // 5Hz: 전원 정지 (적 AI Settled, 방도 이 주기로만 시뮬레이션)
+constexpr uint32 SNAPSHOT_MAX_EVERY_TICKS = 9;      // ~3.3Hz: dormant 구간
+constexpr uint32 SNAPSHOT_COMBAT_WINDOW_TICKS = TICK_HZ * 2;    // 마지막 시전 후 이만큼은 전투 중으로 봄
+constexpr uint32 SNAPSHOT_FAST_RTT_MS = 80;         // 방 최대 RTT가 이하일 때만 15Hz
+constexpr uint32 SNAPSHOT_SLOW_RTT_MS = 250;        // 방 최대 RTT가 이상이면 한 단계 늦춤
+
+static_assert(SNAPSHOT_MIN_EVERY_TICKS >= 1 && SNAPSHOT_MIN_EVERY_TICKS <= SNAPSHOT_EVERY_TICKS
+    && SNAPSHOT_EVERY_TICKS < SNAPSHOT_QUIET_EVERY_TICKS && SNAPSHOT_QUIET_EVERY_TICKS <= SNAPSHOT_MAX_EVERY_TICKS
+    && SNAPSHOT_MAX_EVERY_TICKS <= 255, "snapshot interval bounds (wire uint8)");
+
+// 과부하(LoadLevel::ReduceSnapshots 이상): 방 주기를 곱하되 정지 방 주기까지만 (보간 지연이 되감기 범위 안에 남게)
+constexpr uint32 SNAPSHOT_OVERLOAD_FACTOR = 2;
+constexpr uint32 SNAPSHOT_OVERLOAD_MAX_EVERY_TICKS = SNAPSHOT_QUIET_EVERY_TICKS;
+
+// 클라 1명이 받는 스냅샷 대역폭 예산: 방 전체 스냅샷이 (주기만큼의) 예산을 넘으면 적을 우선순위 순으로 골라 담음 (SnapshotPriority)
+constexpr uint32 SNAPSHOT_CLIENT_BYTES_PER_SEC = 8 * 1024;
+
+// Go 매칭(CreateRoom) 연동 전까지 임시 배정 기준
+constexpr uint32 MAX_PLAYERS_PER_ROOM = 4;
+constexpr uint32 ENEMIES_PER_SEGMENT = 8;
+
+constexpr uint16 PLAYER_MAX_HP = 100;
+constexpr uint16 ENEMY_MAX_HP = 50;
+
+// 스냅샷 인코더 스레드 수 / 동시에 인코딩 대기할 수 있는 world state 버퍼 수
+constexpr uint32 SNAPSHOT_ENCODER_THREADS = 2;
+constexpr uint32 SNAPSHOT_MAX_IN_FLIGHT = 512;
+
+// 관전 (SpectatorRelay): 인코딩된 방 스냅샷을 그대로 늦춰서 뿌림 (관전 화면으로 실시간 정보를 넘겨주지 못하게)
+constexpr uint32 SPECTATOR_DELAY_MS = 3000;
+constexpr uint32 SPECTATOR_RELAY_THREADS = 2;
+constexpr uint32 SPECTATOR_ROOM_IDLE_MS = 5000;     // 이만큼 프레임이 없으면 방이 닫힌 것으로 보고 관전자를 끊음 (dormant 주기보다 충분히 김)
+
+// 방 Update를 나눠 맡는 추가 스레드 수 (tick 스레드 포함 +1) / 한 번에 가져가는 방 수
+// 방이 ROOM_UPDATE_CHUNK 이하면 tick 스레드 혼자 (fork-join 비용이 더 큼)
+constexpr uint32 ROOM_UPDATE_THREADS = 2;
+constexpr uint32 ROOM_UPDATE_CHUNK = 8;
+
+constexpr float PLAYER_MOVE_SPEED = 5.f;        // units/s (서버가 속도 결정, 클라 dt_ms는 무시)
+constexpr float PLAYER_RADIUS = 0.5f;           // 적 몸체(EnemyDef radius)와 겹치면 밀어냄
+constexpr float COLLISION_SLOP = 0.001f;        // 밀어낸 뒤 간격 (다음 tick에 다시 겹침 판정 안 나게)
+
+// 적 AI (EnemyAi.h). 속도/공격력/공격 주기는 EnemyDef, 테이블 없으면 아래 임시값
+constexpr float ENEMY_AGGRO_RADIUS = 8.f;       // Idle -> Chase
+constexpr float ENEMY_LEASH_RADIUS = 16.f;      // 대상이 이보다 멀어지면 Idle
+constexpr float ENEMY_ATTACK_RANGE = 1.5f;      // Chase -> Attack
+constexpr uint32 ENEMY_ATTACK_WINDUP_TICKS = 3; // Attack 진입 후 첫 타격까지
+constexpr float ENEMY_MOVE_SPEED = 3.f;         // units/s
+constexpr uint16 ENEMY_ATTACK_DAMAGE = 5;
+constexpr uint16 ENEMY_ATTACK_INTERVAL_TICKS = (uint16)TICK_HZ;
+
+// 대상 탐색 시간 분할: 버킷의 적은 이 주기 안에 한 번씩 탐색 (tick당 최소 AI_SCAN_MIN_PER_TICK)
+constexpr uint32 AI_SCAN_PERIOD_TICKS = 10;
+constexpr uint32 AI_SCAN_MIN_PER_TICK = 4;
+
+constexpr uint8 ENTITY_STATE_ALIVE = 0;
+constexpr uint8 ENTITY_STATE_DEAD = 1;
+
+// lag compensation: 엔티티별 위치 이력 길이 / 최대 되감기
+// 16 tick(30Hz 기준 ~533ms) x 12B = 엔티티당 192B
+constexpr uint32 LAG_COMP_HISTORY_TICKS = 16;
+constexpr uint32 LAG_COMP_MAX_REWIND_TICKS = LAG_COMP_HISTORY_TICKS - 1;
+
+// viewTick 허용 범위 = RTT + 지터 여유(RTTVAR x 이 값) + 보간 지연(스냅샷 2개분) + 1 (RTT를 모르면 이력 길이까지)
+constexpr uint32 LAG_COMP_RTTVAR_MARGIN = 4;
+
+// 정지 방 클라도 보간 지연(스냅샷 2개분) 안쪽은 되감을 수 있어야 함
+static_assert(SNAPSHOT_QUIET_EVERY_TICKS * 2 <= LAG_COMP_MAX_REWIND_TICKS, "quiet snapshot interval exceeds rewind window");
+
+// 스킬 테이블 들어오기 전 임시 판정값
+constexpr float SKILL_HIT_RADIUS = 1.5f;
+constexpr uint16 SKILL_DAMAGE = 10;
+
+// 체크포인트 주기 (방 id로 엇갈려서 같은 tick에 몰리지 않게)
+constexpr uint32 CHECKPOINT_EVERY_TICKS = TICK_HZ * 10;
+
+// 구간 FSM 상태 시간 (SegmentFsm.h 표에서 사용)
+constexpr uint32 SEGMENT_CLEAR_TICKS = TICK_HZ * 2;
+constexpr uint32 SEGMENT_CHOICE_TIMEOUT_TICKS = TICK_HZ * 15;
+constexpr uint32 SEGMENT_TRANSITION_TICKS = TICK_HZ * 3;
+constexpr uint8 SEGMENT_CHOICE_OPTIONS = 3;
+
+// dormant 방(CHOICE/TRANSITION)은 이 간격으로만 깨움 (깰 때마다 스냅샷)
+constexpr uint32 SEGMENT_DORMANT_TICK_STRIDE = SNAPSHOT_MAX_EVERY_TICKS;
\ No newline at end of file
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "common/TickArena.h"
+#include "common/Types.h"
+
+#include <vector>
+
+// 판정 모양 (SkillDef::shape와 같은 값)
+enum class HitShape : uint8
+{
+    Circle,     // extent = 반지름
+    Box         // 축 정렬 정사각형, extent = 반변
+};
+
+// 판정 1건 (스킬 타격 범위 / 플레이어 몸체)
+struct HitQuery
+{
+    HitShape shape = HitShape::Circle;
+    float x = 0.f;
+    float y = 0.f;
+    float extent = 0.f;
+    float margin = 0.f;     // broadphase만 이만큼 넓힘 (되감기 동안 몸체가 움직였을 수 있는 거리)
+};
+
+// query가 body와 겹침 (query 순서 -> body index 순으로 정렬해서 돌려줌)
+struct HitPair
+{
+    uint32 query = 0;
+    uint32 body = 0;
+};
+
+// 방 1개의 적 몸체(원) 대 판정 묶음 broadphase (tick 스레드 전용)
+// - sort-and-sweep: 몸체와 query를 x 구간 시작점으로 정렬해서 x축만 한 번 훑고 y 구간으로 거름
+// - 몸체 순서는 호출 간 유지: 적은 tick마다 조금씩만 움직여서 거의 정렬된 상태 -> 삽입 정렬이 사실상 O(n)
+// - 결과 순서는 입력 순서에만 의존 (정렬 동률/스레드와 무관) -> replay와 같은 순서로 적용 가능
+// - 되감기 판정은 현재 위치로 1번 훑고(margin으로 넓혀서) 후보만 되감은 위치로 narrowphase
+class HitResolver
+{
+public:
+    // 몸체 수 지정 (바뀌면 순서를 처음부터), 이후 SetBody로 전부 채움
+    void BeginBodies(uint32 count);
+    void SetBody(uint32 index, float x, float y, float radius, bool active);
+
+    // broadphase만: 구간(+margin)이 겹치는 후보. out은 비우고 채움
+    void Sweep(const ArenaVector<HitQuery>& queries, ArenaVector<HitPair>& out);
+
+    // broadphase + 채운 위치로 narrowphase
+    void Query(const ArenaVector<HitQuery>& queries, ArenaVector<HitPair>& out);
+
+    // narrowphase: q 모양과 원(x, y, radius)이 겹치는가 (경계 포함, margin 무시)
+    static bool Overlaps(const HitQuery& q, float x, float y, float radius);
+
+    // 누적 broadphase 후보 수 (LogStats에서 읽고 리셋)
+    uint64 TakeCandidates() { uint64 v = _candidates; _candidates = 0; return v; }
+
+private:
+    struct Body
+    {
+        float x;
+        float y;
+        float radius;
+        bool active;
+    };
+
+    // sweep용 정렬 사본 (정렬 순서로 연속 배치 -> 정렬/훑기 모두 캐시 순차 접근)
+    // 죽은 몸체도 자리는 유지 (다음 호출에도 순서가 거의 그대로)
+    struct SweepBody
+    {
+        float minX;
+        float maxX;
+        float x;
+        float y;
+        float radius;
+        uint32 index;
+        bool active;
+    };
+
+    // 직전 순서로 sweep에 옮겨 담고 정렬, _order 갱신
+    void SortBodies(ArenaVector<SweepBody>& sweep);
+
+private:
+    std::vector<Body> _bodies;
+    std::vector<uint32> _order;         // 직전 정렬 결과 몸체 index (호출 간 유지, sweep 사본은 tick arena)
+    float _maxRadius{ 0.f };
+
+    uint64 _candidates{ 0 };
+};
\ No newline at end of file
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "common/Types.h"
+#include "proto/Protocol.h"
+
+#include <array>
+
+struct ByteWriter;
+struct ByteReader;
+
+enum class InputKind : uint8
+{
+    Move,
+    CastSkill,
+    ChoiceVote
+};
+
+// C_MoveInput / C_CastSkill / C_ChoiceVote는 같은 seq 공간을 씀 (클라 입력 순서 = seq 순서)
+struct PlayerInput
+{
+    InputKind kind = InputKind::Move;
+    uint32 seq = 0;
+    C_MoveInput move;
+    C_CastSkill cast;
+    C_ChoiceVote vote;
+};
+
+// 플레이어별 입력 jitter buffer (tick 스레드 전용)
+// - seq 기준 고정 링: 몰려온 입력은 tick마다 나눠서 소비, 늦게 온 입력은 빈 seq를 잠깐 기다림
+// - 이미 처리한 seq / 버퍼에 있는 seq는 중복으로 버림 (재전송 dedup)
+// - 빈 seq를 INPUT_GAP_WAIT_TICKS 동안 못 채우면 유실로 보고 다음 seq로 넘어감
+class InputJitterBuffer
+{
+public:
+    static constexpr uint32 CAPACITY = 32;              // 30Hz 기준 ~1초 분량
+    static constexpr uint32 MAX_POP_PER_TICK = 4;       // 몰려온 입력을 한 tick에 다 쓰지 않음
+    static constexpr uint32 INPUT_GAP_WAIT_TICKS = 3;   // 빈 seq 대기 한도 (~100ms)
+
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "capacity must be a power of two");
+
+    enum class PushResult : uint8
+    {
+        Ok,
+        Duplicate,  // 이미 처리했거나 버퍼에 있음
+        TooFar      // 링 범위 밖 (비정상 seq)
+    };
+
+    struct Stats
+    {
+        uint64 accepted = 0;
+        uint64 duplicates = 0;
+        uint64 tooFar = 0;
+        uint64 skipped = 0;     // 끝내 안 온 seq 수
+    };
+
+public:
+    PushResult Push(const PlayerInput& in);
+
+    // 이번 tick에 처리할 입력을 seq 순서대로 out에 채움 (반환: 개수)
+    uint32 PopReady(std::array<PlayerInput, MAX_POP_PER_TICK>& out);
+
+    // 스냅샷에 echo할 값 (아직 처리 전이면 첫 seq - 1)
+    uint32 LastProcessedSeq() const { return _lastProcessed; }
+
+    uint32 Buffered() const { return _buffered; }
+    const Stats& GetStats() const { return _stats; }
+
+    // hot restart 인계: 링/seq 상태만 (통계는 새 프로세스에서 0부터)
+    void SaveState(ByteWriter& w) const;
+    bool LoadState(ByteReader& r);
+
+private:
+    struct Slot
+    {
+        bool filled = false;
+        PlayerInput input;
+    };
+
+    Slot& SlotOf(uint32 seq) { return _slots[seq & (CAPACITY - 1)]; }
+
+    // 버퍼에 있는 가장 작은 seq (_buffered > 0 전제)
+    uint32 LowestBufferedSeq() const;
+
+private:
+    std::array<Slot, CAPACITY> _slots{};
+
+    bool _started{ false };     // 첫 입력 seq를 기준점으로 삼음
+    uint32 _lastProcessed{ 0 };
+    uint32 _buffered{ 0 };
+    uint32 _gapWaitTicks{ 0 };
+
+    Stats _stats;
+};
\ No newline at end of file
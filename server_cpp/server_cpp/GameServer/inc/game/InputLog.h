@@ -0,0 +1,30 @@
+#pragma once
+
+#include "common/Types.h"
+
+// 입력 기록 파일 포맷 (append-only, LE)
+// header: [u32 magic][u16 version][u16 tickHz]
+// record: [u8 type][u32 roomId][u32 tick][u64 sessionId][u16 bodyLen][body...]
+// - tick = 이벤트가 반영될 때의 room ServerTick (그 다음 Update 전에 적용)
+// - 같은 방의 레코드는 tick 순서로만 쌓임 -> replay는 파일 순서대로 적용하면 됨
+// - RoomState는 버전 1에 추가 (이전 파일엔 없을 뿐 그대로 읽힘)
+constexpr uint32 INPUT_LOG_MAGIC = 0x4C525347; // "GSRL"
+constexpr uint16 INPUT_LOG_VERSION = 1;
+
+constexpr size_t INPUT_LOG_HEADER_SIZE = 4 + 2 + 2;
+constexpr size_t INPUT_LOG_RECORD_HEADER_SIZE = 1 + 4 + 4 + 8 + 2;
+constexpr size_t INPUT_LOG_MAX_BODY = 0xFFFF;   // bodyLen이 u16
+
+// 상태 해시 기록 주기 (replay에서 desync 지점 찾기용)
+constexpr uint32 INPUT_LOG_CHECKSUM_EVERY_TICKS = 30;
+
+enum class InputLogRecord : uint8
+{
+    RoomOpen = 1,
+    RoomClose = 2,
+    PlayerJoin = 3,
+    PlayerLeave = 4,
+    Input = 5,      // body: [u16 msgId][payload] (C_MoveInput / C_CastSkill / C_ChoiceVote)
+    Checksum = 6,   // body: [u64 Room::StateHash()] (Update 직후 값)
+    RoomState = 7   // body: Room::SaveState (hot restart로 넘겨받은 방, RoomOpen 바로 뒤 -> replay는 이 상태부터)
+};
\ No newline at end of file
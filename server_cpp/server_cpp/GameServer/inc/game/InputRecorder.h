@@ -0,0 +1,64 @@
+#pragma once
+
+#include "common/ByteIO.h"
+#include "game/InputLog.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct PlayerInput;
+
+// 방별 입력/입퇴장 기록기
+// - tick 스레드: Record* 는 메모리 버퍼에 append만 (syscall 없음), tick 끝에 Flush로 버퍼 교체
+// - writer 스레드: 넘겨받은 버퍼를 파일에 씀 (tick 루프에서 파일 I/O 금지)
+// - 버퍼는 두 개를 번갈아 재사용 -> capacity 유지
+class InputRecorder
+{
+public:
+    InputRecorder();
+    ~InputRecorder();
+
+    bool Start(const std::string& path, uint16 tickHz);
+    void Stop();   // 남은 버퍼까지 쓰고 닫음
+
+    // 아래는 tick 스레드 전용
+    void RecordRoomOpen(uint32 roomId, uint32 tick);
+    void RecordRoomClose(uint32 roomId, uint32 tick);
+    void RecordPlayerJoin(uint32 roomId, uint32 tick, SessionId sid);
+    void RecordPlayerLeave(uint32 roomId, uint32 tick, SessionId sid);
+    void RecordInput(uint32 roomId, uint32 tick, SessionId sid, const PlayerInput& in);
+    void RecordChecksum(uint32 roomId, uint32 tick, uint64 hash);
+    void RecordRoomState(uint32 roomId, uint32 tick, const ByteBuffer& state);  // state.size() <= INPUT_LOG_MAX_BODY
+
+    // tick 끝에 호출: 모은 레코드를 writer로 넘김 (writer가 밀려 있으면 다음 tick에 합쳐서)
+    void Flush();
+
+    uint64 WrittenBytes() const { return _written.load(std::memory_order_relaxed); }
+
+private:
+    void WriteRecordHeader(InputLogRecord type, uint32 roomId, uint32 tick, SessionId sid, uint16 bodyLen);
+    void WriterLoop();
+
+private:
+    std::atomic<bool> _running{ false };
+    std::thread _writer;
+    std::ofstream _file;
+
+    // tick 스레드가 채우는 버퍼
+    ByteWriter _active{ 64 * 1024 };
+
+    // writer에 넘긴 버퍼 (_mutex 보호)
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    ByteBuffer _pending;
+    bool _stopping{ false };
+
+    std::atomic<uint64> _written{ 0 };
+
+    std::string _tag;
+};
\ No newline at end of file
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "common/ByteIO.h"
+#include "common/Types.h"
+
+#include <array>
+
+// 엔티티별 위치 이력 링 (lag compensation 되감기용)
+// - tick % N 슬롯에 덮어씀 -> 할당 없음, 기록 O(1), 조회 O(1)
+// - 슬롯의 tick이 다르면 이미 덮어쓴(너무 오래된) 기록
+template <uint32 N>
+class PositionHistory
+{
+    static_assert(N > 0 && (N & (N - 1)) == 0, "history length must be a power of two");
+
+public:
+    struct Sample
+    {
+        uint32 tick = 0;
+        float x = 0.f;
+        float y = 0.f;
+    };
+
+    static constexpr uint32 LENGTH = N;
+
+public:
+    void Record(uint32 tick, float x, float y)
+    {
+        Sample& s = _samples[tick & (N - 1)];
+        s.tick = tick;
+        s.x = x;
+        s.y = y;
+        _hasAny = true;
+    }
+
+    // tick 시점 위치 (기록이 없으면 false)
+    bool At(uint32 tick, float& outX, float& outY) const
+    {
+        if (!_hasAny)
+            return false;
+
+        const Sample& s = _samples[tick & (N - 1)];
+        if (s.tick != tick)
+            return false;
+
+        outX = s.x;
+        outY = s.y;
+        return true;
+    }
+
+    // hot restart 인계 (링 통째로)
+    void SaveState(ByteWriter& w) const
+    {
+        w.WriteU8(_hasAny ? 1 : 0);
+        for (const Sample& s : _samples)
+        {
+            w.WriteU32LE(s.tick);
+            w.WriteF32LE(s.x);
+            w.WriteF32LE(s.y);
+        }
+    }
+
+    bool LoadState(ByteReader& r)
+    {
+        uint8 hasAny = 0;
+        if (!r.ReadU8(hasAny))
+            return false;
+        _hasAny = hasAny != 0;
+
+        for (Sample& s : _samples)
+        {
+            if (!r.ReadU32LE(s.tick) || !r.ReadF32LE(s.x) || !r.ReadF32LE(s.y))
+                return false;
+        }
+        return true;
+    }
+
+private:
+    std::array<Sample, N> _samples{};
+    bool _hasAny{ false };
+};
\ No newline at end of file
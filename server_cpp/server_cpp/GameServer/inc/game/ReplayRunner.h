@@ -0,0 +1,49 @@
+#pragma once
+
+#include "common/Types.h"
+#include "game/ContentTables.h"
+
+#include <memory>
+#include <string>
+
+// 입력 기록(InputLog) headless 재시뮬레이션
+// - 소켓/스레드/sleep 없이 파일 순서대로 Room을 최대 속도로 돌림
+// - Checksum 레코드와 StateHash를 비교해서 desync 지점 보고
+// - ticks/s = 결정론적 시뮬레이션 벤치마크 값 (실제 매치 기록 기준)
+class ReplayRunner
+{
+public:
+    struct Result
+    {
+        uint64 records = 0;
+        uint64 rooms = 0;
+        uint64 importedRooms = 0;   // RoomState로 시작한 방 (hot restart 뒤 기록)
+        uint64 roomTicks = 0;       // 모든 방의 Update 호출 수 합
+        uint64 inputs = 0;
+        uint64 checksums = 0;
+        uint64 mismatches = 0;
+        uint64 badRecords = 0;      // 모르는 방 / tick 역행 / decode 실패
+        bool truncated = false;     // 마지막 레코드가 잘림 (기록 중 비정상 종료)
+        double seconds = 0.0;
+    };
+
+public:
+    ReplayRunner();
+
+    // 파일 전체를 메모리로 읽음 (시간 측정에서 제외)
+    bool Load(const std::string& path);
+
+    // 기록 당시와 같은 테이블 파일 (없으면 GameConfig 임시값, 기록도 그랬어야 해시가 맞음)
+    // 기록 중 리로드가 있었다면 그 이후 구간은 desync로 보일 수 있음
+    bool LoadContent(const std::string& path);
+
+    bool Run(Result& out);
+
+private:
+    ByteBuffer _data;
+    uint16 _tickHz{ 0 };
+
+    std::unique_ptr<ContentTables> _content;
+
+    std::string _tag;
+};
\ No newline at end of file
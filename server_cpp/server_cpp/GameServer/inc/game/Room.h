@@ -0,0 +1,239 @@
+#pragma once
+
+#include "common/Types.h"
+#include "game/EnemyAi.h"
+#include "game/GameConfig.h"
+#include "game/HitResolver.h"
+#include "game/InputJitterBuffer.h"
+#include "game/PositionHistory.h"
+#include "game/SegmentFsm.h"
+#include "game/SnapshotPriority.h"
+#include "proto/Protocol.h"
+
+#include <vector>
+
+struct WorldState;
+struct CheckpointDelta;
+class ContentTables;
+
+struct Player
+{
+    SessionId sessionId = 0;
+    uint64 playerId = 0;
+    float x = 0.f;
+    float y = 0.f;
+    uint16 hp = 0;
+    uint8 state = 0;
+
+    // 마지막 이동 입력 방향 (tick마다 서버 속도로 적분)
+    float moveDirX = 0.f;
+    float moveDirY = 0.f;
+
+    // 스킬 공용 쿨다운 (이 tick부터 시전 가능)
+    uint32 skillReadyTick = 0;
+
+    // CHOICE 투표 (-1 = 아직 안 함)
+    int8 vote = -1;
+
+    // 세션 RTT 추정값 (0 = 아직 모름, 스냅샷 주기/viewTick 검사에만 씀 -> 시뮬레이션/해시와 무관)
+    uint32 rttMs = 0;
+    uint32 rttVarMs = 0;
+
+    InputJitterBuffer inputs;
+
+    // 이 플레이어 스냅샷에 담을 적 우선순위 (예산 초과 방만, 시뮬레이션/해시와 무관)
+    SnapshotPriority snapshotPriority;
+};
+
+// 위치/행동은 EnemyAi 버킷에 (AI 루프가 이 구조체를 안 건드리게)
+struct Enemy
+{
+    uint32 id = 0;
+    uint16 hp = 0;
+    uint8 state = 0;
+
+    uint16 defId = 0;           // EnemyDef id (테이블 없으면 0)
+    float hitRadius = 0.f;
+
+    // tick 끝 위치 기록 (스킬 판정 시 클라가 보던 tick으로 되감기)
+    PositionHistory<LAG_COMP_HISTORY_TICKS> history;
+
+    // 지난 체크포인트 이후 hp/state가 바뀜 (Room::_checkpointDirty에 들어 있음)
+    bool checkpointDirty = false;
+};
+
+// RoomManager가 쓰는 방 스케줄 상태 (전역 tick 기준, tick 스레드 전용)
+// - 잠든 방은 Update를 건너뛰고, 깨울 때 Room::Skip으로 따라잡음
+struct RoomSchedule
+{
+    bool sleeping = false;
+    uint64 lastUpdateTick = 0;  // 마지막으로 Update(또는 Skip으로 따라잡은) 전역 tick
+    uint64 wakeTick = 0;        // 잠든 방을 다시 Update할 전역 tick
+
+    uint64 nextSnapshotTick = 0;    // 이 전역 tick에 스냅샷 (깨어 있으면)
+    uint32 snapshotEvery = SNAPSHOT_EVERY_TICKS;    // 마지막 스냅샷에 실어 보낸 주기
+};
+
+// 방 1개의 authoritative 상태
+// - tick 스레드 전용 (락 없음). 외부 스레드는 RoomManager 큐를 거쳐서만 접근
+class Room
+{
+public:
+    // content: 테이블이 없으면(nullptr) GameConfig 임시값 사용
+    explicit Room(uint32 id, const ContentTables* content = nullptr);
+
+    uint32 Id() const { return _id; }
+    uint32 ServerTick() const { return _tick; }
+
+    SegmentState Segment() const { return _segment; }
+    uint32 SegmentIndex() const { return _segmentIndex; }
+
+    bool AddPlayer(SessionId sid);
+    void RemovePlayer(SessionId sid);
+
+    // 입력을 해당 플레이어 jitter buffer에 넣음 (방에 없는 세션이면 false)
+    bool PushInput(SessionId sid, const PlayerInput& in, InputJitterBuffer::PushResult& outResult);
+
+    // 세션 RTT 추정값 반영 (방에 없는 세션이면 무시)
+    void SetRtt(SessionId sid, uint32 rttMs, uint32 rttVarMs);
+
+    // lag compensation 입력 검사: RTT로 설명되는 것보다 과거인 viewTick은 허용 한도로 당김 (당겼으면 true)
+    // 라이브 입력만 (RoomManager가 jitter buffer에 넣기 전에 -> 기록되는 입력은 이미 당긴 값이라 replay와 무관)
+    bool ClampViewTick(SessionId sid, C_CastSkill& cast);
+
+    size_t PlayerCount() const { return _players.size(); }
+    SessionId SessionAt(size_t i) const { return _players[i].sessionId; }
+    const Player& PlayerAt(size_t i) const { return _players[i]; }
+    bool IsFull() const;
+    bool IsEmpty() const { return _players.empty(); }
+
+    // 1 tick 시뮬레이션: 입력 소비 -> 시전 일괄 판정 -> 이동/적 AI -> 충돌 -> tick 증가 -> 위치 이력 기록 -> 구간 타이머
+    // dormant 구간이면 입력 소비와 타이머만 (이동/이력 없음)
+    // content는 이번 tick 동안만 사용 (리로드로 바뀔 수 있으므로 보관 금지)
+    void Update(float dt, const ContentTables* content = nullptr);
+
+    // 재워도 되는가: 처리 대기 입력 없음 + (dormant 구간 또는 살아 있는 플레이어 전원 정지 + 적 AI Settled + 직전 tick 충돌 없음)
+    // (버퍼에 입력이 남아 있으면 jitter buffer가 tick마다 상태를 바꾸므로 깨어 있어야 함)
+    // 정지 방은 아무것도 안 움직이고 AI 탐색 커서만 돎 -> Skip으로 몰아서 돌려도 결과가 같음
+    bool CanSleep() const;
+
+    // 다음 구간 타이머까지 남은 Update 수 (그 Update에서 발화, 0 = 타이머 없음)
+    uint32 TicksUntilTimer() const;
+
+    // 잠든 동안 건너뛴 Update를 한 번에 반영 (CanSleep 상태에서 ticks번 Update한 것과 같음)
+    // - 위치 이력은 다음 Update에서 되감기 범위만 복원
+    // - 타이머 tick은 넘지 않음 (타이머는 실제 Update에서 발화)
+    void Skip(uint32 ticks);
+
+    // 다음 스냅샷까지 tick 수: dormant/정지/전투 + 방 최대 RTT(+지터) 기준 (GameConfig SNAPSHOT_* 범위)
+    uint32 SnapshotEveryTicks() const;
+
+    // 누적 되감기 통계 (LogStats에서 읽고 리셋)
+    uint64 TakeRewindTicks() { uint64 v = _rewindTicks; _rewindTicks = 0; return v; }
+    uint64 TakeSkillCasts() { uint64 v = _skillCasts; _skillCasts = 0; return v; }
+    uint64 TakeRejectedCasts() { uint64 v = _rejectedCasts; _rejectedCasts = 0; return v; }
+    uint64 TakeSegmentTransitions() { uint64 v = _segmentTransitions; _segmentTransitions = 0; return v; }
+    uint64 TakeEnemyHits() { uint64 v = _enemyHits; _enemyHits = 0; return v; }
+    uint64 TakeAiScans() { return _ai.TakeScans(); }
+    uint64 TakeHitCandidates() { return _hits.TakeCandidates(); }
+
+    const EnemyAi& Ai() const { return _ai; }
+
+    RoomSchedule& Schedule() { return _schedule; }
+
+    // 시뮬레이션 상태 해시 (replay desync 확인용, FNV-1a)
+    uint64 StateHash() const;
+
+    // 스냅샷용 상태 복사 (out의 capacity 재사용)
+    // 방 전체가 클라 예산(snapshotEvery 주기 기준)을 넘으면 플레이어마다 적을 골라 out.enemySel에 (반환: 빠진 적 수 합)
+    uint32 Capture(WorldState& out, uint32 snapshotEvery);
+
+    // 체크포인트 변경분 (플레이어 전부 + dirty 적만, O(dirty)) 후 dirty 목록 비움
+    void CaptureCheckpoint(CheckpointDelta& out);
+
+    // hot restart 인계: 시뮬레이션 상태 전부 (통계 카운터 제외, 스케줄은 RoomManager가 따로)
+    // 불러오면 적 전부 체크포인트 dirty -> 새 프로세스의 첫 체크포인트는 완전본
+    void SaveState(ByteWriter& w) const;
+    bool LoadState(ByteReader& r);
+
+private:
+    // 구간 시작: 이전 구간 적을 치우고 새로 스폰
+    void BeginSegment(const ContentTables* content);
+    void SpawnSegmentEnemies(const ContentTables* content);
+
+    // 표(SegmentFsm.h)에 있는 전이만 일어남. content는 InSegment 진입(스폰)에만 씀
+    void FireSegmentEvent(SegmentEvent ev, const ContentTables* content);
+    void EnterSegmentState(SegmentState next, const ContentTables* content);
+
+    void ApplyVote(Player& p, const C_ChoiceVote& vote, const ContentTables* content);
+    bool AllVoted() const;
+    uint8 TallyVotes() const;
+
+    Player* FindPlayer(SessionId sid);
+
+    void MarkCheckpointDirty(uint32 enemyIndex);
+
+    // Skip으로 밀린 위치 이력을 현재 tick까지 채움 (되감기 범위만 기록, 자는 동안 적은 안 움직임)
+    void RestoreHistory();
+
+    // 적 AI 1 tick: 살아 있는 플레이어를 대상으로 넘기고 공격 결과를 플레이어에 반영
+    void UpdateEnemies(float dt);
+
+    // 이번 tick 시전 묶음 (queries와 같은 index, Update 지역 변수 -> tick arena)
+    struct PendingCast
+    {
+        uint32 atTick;  // 되감은 tick
+        uint16 damage;
+    };
+
+    struct CastBatch
+    {
+        ArenaVector<PendingCast> casts;
+        ArenaVector<HitQuery> queries;
+    };
+
+    void ApplyInput(Player& p, const PlayerInput& in, const ContentTables* content, CastBatch& batch);
+
+    // 시전 검증(쿨다운/사거리/구간)만 하고 판정은 이번 tick 묶음으로 미룸
+    void QueueSkill(Player& caster, const C_CastSkill& cast, const ContentTables* content, CastBatch& batch);
+
+    // 이번 tick 시전을 한꺼번에 판정: 현재 위치로 broadphase 1번 (되감은 만큼 넓힘) -> 후보만 되감은 위치로 narrowphase
+    // 타격은 시전 입력 순서 -> 적 index 순으로 적용 (앞선 시전이 죽인 적은 뒤 시전이 못 때림)
+    void ResolveSkills(float dt, const ContentTables* content, CastBatch& batch);
+
+    // 살아 있는 플레이어를 겹친 적 몸체 밖으로 밀어냄 (적은 안 밀림)
+    void ResolveCollisions();
+
+private:
+    uint32 _id{ 0 };
+    uint32 _tick{ 0 };
+    SegmentState _segment{ SegmentState::InSegment };
+    uint32 _segmentIndex{ 0 };
+    uint32 _segmentTimerTick{ 0 };  // 이 tick에 TimerFired (0 = 없음)
+    uint32 _aliveEnemies{ 0 };      // 0이 되는 순간 AllEnemiesDead
+    uint8 _lastChoice{ 0 };         // 직전 CHOICE 결과 (구간 구성 데이터 생기면 다음 구간 선택에 사용)
+    uint32 _historyTick{ 0 };       // 위치 이력이 이 tick까지 기록됨 (< _tick이면 Skip으로 밀린 상태)
+    uint32 _lastCastTick{ 0 };      // 마지막으로 시전이 판정된 tick (스냅샷 주기 조정용)
+
+    std::vector<Player> _players;
+    std::vector<Enemy> _enemies;
+
+    EnemyAi _ai;
+
+    // tick 안에서만 쓰는 목록(AI 대상/타격, 시전 묶음, 판정 쌍)은 멤버 대신 tick arena 지역 변수
+    HitResolver _hits;
+    uint32 _contacts{ 0 };                  // 직전 시뮬레이션 tick에 밀어낸 수
+
+    uint32 _nextEnemyId{ 1 };
+
+    // 지난 체크포인트 이후 바뀐 적 index (중복 없음, Enemy::checkpointDirty로 거름)
+    std::vector<uint32> _checkpointDirty;
+
+    uint64 _rewindTicks{ 0 };
+    uint64 _skillCasts{ 0 };
+    uint64 _rejectedCasts{ 0 };     // 모르는 skillId / 사거리 밖 / 쿨다운 / 전투 없는 구간
+    uint64 _segmentTransitions{ 0 };
+    uint64 _enemyHits{ 0 };         // 적이 플레이어를 때린 수
+
+    RoomSchedule _schedule;
+};
\ No newline at end of file
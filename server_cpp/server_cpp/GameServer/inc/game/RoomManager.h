@@ -0,0 +1,226 @@
+#pragma once
+
+#include "common/OverloadController.h"
+#include "game/CheckpointService.h"
+#include "game/ContentTables.h"
+#include "game/GameConfig.h"
+#include "game/InputRecorder.h"
+#include "game/Room.h"
+#include "game/RoomWorkers.h"
+#include "game/SnapshotPipeline.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class SessionManager;
+class SpectatorRelay;
+
+// 방 목록 + 고정 tick 루프 (단일 tick 스레드)
+// - 방 상태는 tick 스레드만 건드림. 세션 입/퇴장은 명령 큐로 받아서 tick 시작 시 반영
+// - 방 Update만 RoomWorkers로 나눠 돌림 (tick 스레드가 끝날 때까지 기다림 -> 그 밖은 여전히 단일 스레드)
+// - 스냅샷은 capture만 tick 스레드에서, 인코딩/전송은 SnapshotPipeline 인코더 스레드에서
+class RoomManager
+{
+public:
+    explicit RoomManager(SessionManager* mgr);
+    ~RoomManager();
+
+    // Start 전에 호출: 방별 입력/입퇴장을 path에 기록 (replay용)
+    bool EnableRecording(const std::string& path);
+
+    // Start 전에 호출: 방 체크포인트를 주기적으로 Go 서비스(host:port)에 올림
+    bool EnableCheckpoints(const std::string& host, uint16 port);
+
+    // Start 전에 호출: 분리 배포(--link)에서 스냅샷을 세션 대신 게이트웨이 링크로
+    void SetGameLink(GameLink* link) { _link = link; _pipeline.SetGameLink(link); }
+
+    // Start 전에 호출: tick 시간을 알리고 과부하 단계에 따라 스냅샷 주기/부가 작업/새 방을 줄임
+    void SetOverload(OverloadController* overload) { _overload = overload; }
+
+    // Start 전에 호출: 인코딩된 방 스냅샷을 관전 릴레이에도 (--spectate, tick 스레드 일은 안 늘어남)
+    void SetSpectatorRelay(SpectatorRelay* relay) { _relay = relay; _pipeline.SetSpectatorRelay(relay); }
+
+    // Start 전에 호출: false면 방을 재우지 않음 (매 tick Update, --bench-segments/--bench-rates 비교용)
+    void SetRoomSleep(bool enabled) { _roomSleep = enabled; }
+
+    // Start 전에 호출: false면 모든 방 스냅샷 주기 SNAPSHOT_EVERY_TICKS 고정 (--bench-rates 비교용)
+    void SetAdaptiveSnapshots(bool enabled) { _adaptiveSnapshots = enabled; }
+
+    // 관전 기본 방 (C_SpectateReq.roomId = 0): 인원이 가장 많은 방, 같으면 먼저 만든 방 (0 = 방 없음, 임의 스레드)
+    uint32 FeaturedRoom() const { return _featuredRoom.load(std::memory_order_relaxed); }
+
+    // tick 1번 작업 시간 (깨어나서 다음 sleep 직전까지, --bench-spectators 같은 외부 측정용, 읽고 리셋)
+    struct TickCost
+    {
+        uint64 ticks = 0;
+        uint64 workUsSum = 0;
+        uint64 workUsMax = 0;
+        uint64 updateNsSum = 0;     // 그중 방 Update (RoomWorkers) 부분
+        uint64 captureNsSum = 0;    // 그중 스냅샷 capture/publish 부분
+        uint64 snapshots = 0;       // capture한 방 스냅샷 수 (인코딩 1번씩)
+    };
+    TickCost TakeTickCost();
+
+    bool Start();
+    void Stop();
+
+    // hot restart 인계 (HotRestart 전용)
+    // - Freeze: tick 스레드만 멈춤 (따라잡기/기록 마감/FINAL 체크포인트 없음). 실패하면 Resume으로 재개
+    // - ExportState: 멈춘 상태에서 대기 명령까지 반영한 뒤 전역 tick + 방 상태/스케줄 전부 기록
+    // - ImportState: Start 전에. 세션 id는 인계 전과 같음 (SessionManager::Adopt)
+    // - DiscardRooms: 넘긴 뒤 방을 버림 (Stop이 새 프로세스 소유 방을 닫거나 체크포인트하지 않게)
+    bool Freeze();
+    void Resume();
+    void ExportState(ByteWriter& w);
+    bool ImportState(ByteReader& r);
+    void DiscardRooms();
+
+    // 스킬/적 테이블 (초기 로드는 Start 전, 리로드 요청은 아무 스레드에서)
+    ContentManager& Content() { return _content; }
+
+    // SessionManager 훅에서 호출 (임의 스레드)
+    void OnSessionOpened(SessionId sid);
+    void OnSessionClosed(SessionId sid);
+
+    // Session 입력 훅에서 호출 (SessionIo 완료 스레드)
+    void OnMoveInput(SessionId sid, const C_MoveInput& msg);
+    void OnCastSkill(SessionId sid, const C_CastSkill& msg);
+    void OnChoiceVote(SessionId sid, const C_ChoiceVote& msg);
+
+    // Session RTT 훅에서 호출 (C_Pong이면 수신 완료, TCP 표본이면 SessionIo 타이머)
+    void OnRttSample(SessionId sid, uint32 rttMs, uint32 rttVarMs);
+
+private:
+    void TickLoop();
+    void ApplyPendingCommands();
+    void PublishSnapshots();
+
+    // 스냅샷을 막 보낸 방이 재워도 되면(dormant 구간 / 전원 정지) 다음 스냅샷 tick까지 재움
+    // (깨는 tick에 따라잡고 스냅샷 -> 바뀐 상태는 항상 한 번 나감)
+    // 스냅샷 사이에 조용해진 방은 다음 스냅샷 때 재움 (매 tick 전체 방을 보지 않음)
+    void SleepIfIdle(Room& room);
+
+    // 방 하나의 이번 tick (잠든 방은 깨울지 판단). 방 하나만 건드림 -> RoomWorkers lane에서 호출
+    // 반환: 따라잡느라 건너뛴 Update 수
+    uint64 UpdateRoom(Room& room, const ContentTables* content);
+
+    // 잠든 방을 throughTick까지 따라잡고 깨움 (명령 반영/기록 전에 tick을 맞춰야 replay와 같음)
+    static uint64 CatchUpRoom(Room& room, uint64 throughTick);
+    void CatchUp(Room& room, uint64 throughTick) { _skippedRoomTicks += CatchUpRoom(room, throughTick); }
+    void WakeRoom(Room& room) { CatchUp(room, _tickCount - 1); }
+    void SubmitCheckpoints();
+    void SubmitCheckpoint(Room& room, uint8 flags);
+    void LogStats();
+
+    // 자리 있는 방 -> 없으면 새 방 (새 방을 못 만드는 단계면 nullptr)
+    Room* AssignRoom();
+
+    Room* NewRoom();
+
+    // 방 배정 거절: S_Disconnect(Overloaded). 게이트웨이 세션이면 링크로 보내서 게이트웨이가 끊음 (못 보내면 false)
+    bool RejectSession(SessionId sid);
+
+private:
+    enum class CommandKind : uint8
+    {
+        Open,
+        Close,
+        Input,
+        Rtt
+    };
+
+    struct Command
+    {
+        CommandKind kind = CommandKind::Open;
+        SessionId sid = 0;
+        PlayerInput input;  // kind == Input
+        uint32 rttMs = 0;   // kind == Rtt
+        uint32 rttVarMs = 0;
+    };
+
+    void PushCommand(const Command& cmd);
+
+    SessionManager* _sessionMgr{ nullptr }; // 소유 X
+
+    std::atomic<bool> _running{ false };
+    std::atomic<bool> _frozen{ false };     // hot restart 인계 중 (tick 스레드 멈춤)
+    std::thread _tickThread;
+
+    std::mutex _cmdMutex;
+    std::vector<Command> _pending;
+    std::vector<Command> _applying; // tick 스레드 전용 (swap으로 재사용)
+
+    // 아래는 tick 스레드 전용
+    std::vector<std::unique_ptr<Room>> _rooms;
+    std::unordered_map<SessionId, Room*> _roomOfSession;
+    uint32 _nextRoomId{ 1 };
+    uint64 _tickCount{ 0 };
+    uint64 _tickStartUs{ 0 };       // 이번 tick 예정 시각 (ServerTimeUs, 스냅샷 tickOriginUs 기준)
+    uint64 _captureNs{ 0 };
+    uint64 _updateNs{ 0 };
+
+    // 예정 tick 시각보다 늦게 깬 시간 (스케줄링/코어 이주 지터, LogStats에서 리셋)
+    uint64 _tickLateNsSum{ 0 };
+    uint64 _tickLateNsMax{ 0 };
+    uint64 _tickLateCount{ 0 };
+
+    RoomWorkers _workers;
+    std::vector<uint64> _laneSkipped;   // Run 동안 lane별 건너뛴 Update 수 (끝나고 _skippedRoomTicks에 합침)
+
+    // 입력 통계 (tick 스레드 전용, LogStats에서 리셋)
+    uint64 _inputsAccepted{ 0 };
+    uint64 _inputsDuplicate{ 0 };
+    uint64 _inputsRejected{ 0 };    // 링 범위 밖 / 방 없음
+    uint64 _castsRejected{ 0 };
+    uint64 _viewTicksClamped{ 0 };  // RTT로 설명 안 되는 과거 viewTick을 당긴 수
+
+    // 잠든 방 때문에 건너뛴 Update 수 (tick 스레드 전용, LogStats에서 리셋)
+    uint64 _skippedRoomTicks{ 0 };
+
+    // 방 스냅샷 주기 합 / capture 수 (평균 주기, tick 스레드 전용, LogStats에서 리셋)
+    uint64 _snapshotEverySum{ 0 };
+    uint64 _snapshotsCaptured{ 0 };
+
+    // 과부하 조치 (tick 스레드 전용, LogStats에서 리셋)
+    uint64 _roomsRejected{ 0 };         // 새 방이 필요했는데 거절한 입장
+    uint64 _shedTicks{ 0 };             // 부가 작업(주기 체크포인트/checksum)을 건너뛴 tick
+    uint64 _stretchedSnapshots{ 0 };    // 주기를 늘려서 보낸 스냅샷
+
+    // 클라 예산 초과로 적을 골라 담은 스냅샷 (tick 스레드 전용, LogStats에서 리셋)
+    uint64 _budgetedSnapshots{ 0 };
+    uint64 _omittedEnemies{ 0 };        // 수신자별로 빠진 적 수 합
+
+    // 체크포인트 capture로 tick 스레드가 멈춘 시간 (tick 스레드 전용, LogStats에서 리셋)
+    uint64 _checkpointNs{ 0 };
+    uint64 _checkpointMaxNs{ 0 };
+
+    SnapshotPipeline _pipeline;
+
+    ContentManager _content;
+
+    OverloadController* _overload{ nullptr };   // 소유 X, 없으면 항상 Normal
+    GameLink* _link{ nullptr };                 // 소유 X, 있으면 세션은 전부 게이트웨이 쪽
+    SpectatorRelay* _relay{ nullptr };          // 소유 X, 통계 로그만
+    bool _roomSleep{ true };
+    bool _adaptiveSnapshots{ true };
+
+    std::atomic<uint32> _featuredRoom{ 0 };     // tick 스레드가 빈 방 정리 때 갱신
+
+    // TakeTickCost (tick 스레드가 더하고 임의 스레드가 비움)
+    std::atomic<uint64> _costTicks{ 0 };
+    std::atomic<uint64> _costWorkUsSum{ 0 };
+    std::atomic<uint64> _costWorkUsMax{ 0 };
+    std::atomic<uint64> _costUpdateNsSum{ 0 };
+    std::atomic<uint64> _costCaptureNsSum{ 0 };
+    std::atomic<uint64> _costSnapshots{ 0 };
+
+    std::unique_ptr<InputRecorder> _recorder;   // 기록 안 하면 nullptr
+    std::unique_ptr<CheckpointService> _checkpoints;    // 체크포인트 안 하면 nullptr
+
+    std::string _tag;
+};
\ No newline at end of file
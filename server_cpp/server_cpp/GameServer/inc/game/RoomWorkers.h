@@ -0,0 +1,76 @@
+#pragma once
+
+#include "common/TickArena.h"
+#include "common/Types.h"
+#include "game/GameConfig.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// tick마다 방 Update를 나눠 돌리는 고정 스레드 (fork-join)
+// - Run을 부른 tick 스레드도 같이 일하고, 전부 끝나야 리턴 (tick 경계는 그대로)
+// - chunk마다 주인 lane이 있음 (chunk % lanes): 자기 몫부터 하고 끝나면 남의 몫을 가져감
+//   -> 방 수가 그대로면 같은 방은 매 tick 같은 스레드(= 같은 코어/NUMA 노드 캐시)에서 돌고,
+//      방마다 비용이 달라도 한 스레드에 몰리지 않음
+// - 방끼리 공유 상태가 없으므로 결과는 어느 스레드가 돌렸는지와 무관 (replay 그대로)
+// - 작업 스레드마다 TickArena 1개: 자기 몫이 끝나면 Reset (lane 0 = 호출 스레드 arena는 호출 측이 tick 끝에)
+class RoomWorkers
+{
+public:
+    // lane: 0 = 호출 스레드, 1.. = 작업 스레드 (lane별 누적값을 잠금 없이 모을 때 씀)
+    using Job = std::function<void(uint32 begin, uint32 end, uint32 lane)>;
+
+public:
+    RoomWorkers();
+    ~RoomWorkers();
+
+    bool Start(uint32 threads = ROOM_UPDATE_THREADS);
+    void Stop();
+
+    // 호출 스레드 포함 스레드 수
+    uint32 Lanes() const { return (uint32)_threads.size() + 1; }
+
+    // [0, count)를 chunk개씩 job에 넘김. 모두 끝날 때까지 블록
+    void Run(uint32 count, uint32 chunk, const Job& job);
+
+    // lane 0(호출 스레드) 포함 arena 통계 합 (Run 밖에서만)
+    TickArena::Stats TakeArenaStats();
+
+private:
+    void WorkLoop(uint32 lane);
+
+    // 자기 몫 -> 다른 lane 몫 순으로 남은 chunk가 없을 때까지 처리
+    void Drain(uint32 lane);
+
+    // lane별 다음 chunk 순번 (lane 몫의 n번째 chunk = lane + n * lanes)
+    struct alignas(64) LaneCursor
+    {
+        std::atomic<uint32> next{ 0 };
+    };
+
+private:
+    std::vector<std::thread> _threads;
+    std::vector<std::unique_ptr<TickArena>> _arenas;   // lane - 1
+
+    std::mutex _mutex;
+    std::condition_variable _startCv;
+    std::condition_variable _doneCv;
+    uint64 _generation{ 0 };    // Run마다 증가 (작업 스레드가 새 작업인지 구분)
+    uint32 _busy{ 0 };          // 이번 Run을 아직 끝내지 않은 작업 스레드 수
+    bool _stopping{ false };
+
+    // 이번 Run (Run 동안만 유효)
+    const Job* _job{ nullptr };
+    uint32 _count{ 0 };
+    uint32 _chunk{ 1 };
+    uint32 _chunks{ 0 };
+    std::unique_ptr<LaneCursor[]> _cursors;     // Lanes()개
+
+    std::string _tag;
+};
\ No newline at end of file
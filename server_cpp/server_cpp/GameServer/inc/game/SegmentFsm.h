@@ -0,0 +1,114 @@
+#pragma once
+
+#include "common/Types.h"
+#include "game/GameConfig.h"
+#include "proto/Protocol.h"
+
+// 구간 FSM (방 단위)
+// - 전이는 이벤트로만 일어남 (tick마다 조건 재검사 없음)
+//   AllEnemiesDead: 마지막 적이 죽는 순간 / VoteComplete: 마지막 투표가 들어오는 순간 / TimerFired: 상태 타이머 만료
+// - 표에 없는 (상태, 이벤트)는 무시
+// - dormant 상태(CHOICE/TRANSITION)는 시뮬레이션 없음 -> RoomManager가 방을 재우고 낮은 주기로만 깨움
+enum class SegmentEvent : uint8
+{
+    AllEnemiesDead,
+    TimerFired,
+    VoteComplete,
+
+    Count
+};
+
+struct SegmentTransition
+{
+    SegmentState from;
+    SegmentEvent on;
+    SegmentState to;
+};
+
+inline constexpr SegmentTransition SEGMENT_TRANSITIONS[] = {
+    { SegmentState::InSegment,  SegmentEvent::AllEnemiesDead, SegmentState::Clear },
+    { SegmentState::Clear,      SegmentEvent::TimerFired,     SegmentState::Choice },
+    { SegmentState::Choice,     SegmentEvent::VoteComplete,   SegmentState::Transition },
+    { SegmentState::Choice,     SegmentEvent::TimerFired,     SegmentState::Transition },  // 투표 시간 초과 -> 받은 표로 결정
+    { SegmentState::Transition, SegmentEvent::TimerFired,     SegmentState::InSegment },
+};
+
+// 상태별 진입 타이머 / 시뮬레이션 여부
+struct SegmentStateInfo
+{
+    uint32 timerTicks;  // 0 = 타이머 없음
+    bool dormant;
+};
+
+inline constexpr SegmentStateInfo SEGMENT_STATE_INFO[] = {
+    { 0,                            false },    // InSegment
+    { SEGMENT_CLEAR_TICKS,          false },    // Clear (남은 플레이어 이동은 계속)
+    { SEGMENT_CHOICE_TIMEOUT_TICKS, true },     // Choice
+    { SEGMENT_TRANSITION_TICKS,     true },     // Transition
+};
+
+constexpr size_t SEGMENT_STATE_COUNT = sizeof(SEGMENT_STATE_INFO) / sizeof(SEGMENT_STATE_INFO[0]);
+constexpr size_t SEGMENT_EVENT_COUNT = (size_t)SegmentEvent::Count;
+
+static_assert(SEGMENT_STATE_COUNT == (size_t)SegmentState::Transition + 1, "state info must cover every SegmentState");
+
+// 전이 목록 -> (상태 x 이벤트) 직접 조회 표 (컴파일 타임에 1회 생성)
+struct SegmentTable
+{
+    SegmentState next[SEGMENT_STATE_COUNT][SEGMENT_EVENT_COUNT]{};
+    bool valid[SEGMENT_STATE_COUNT][SEGMENT_EVENT_COUNT]{};
+    bool duplicate = false;
+};
+
+constexpr SegmentTable BuildSegmentTable()
+{
+    SegmentTable t{};
+    for (const SegmentTransition& tr : SEGMENT_TRANSITIONS)
+    {
+        const size_t s = (size_t)tr.from;
+        const size_t e = (size_t)tr.on;
+        if (t.valid[s][e])
+            t.duplicate = true;
+
+        t.valid[s][e] = true;
+        t.next[s][e] = tr.to;
+    }
+    return t;
+}
+
+inline constexpr SegmentTable SEGMENT_TABLE = BuildSegmentTable();
+
+static_assert(!SEGMENT_TABLE.duplicate, "segment transition table has a duplicate (state, event)");
+
+constexpr bool NextSegmentState(SegmentState from, SegmentEvent ev, SegmentState& out)
+{
+    if (!SEGMENT_TABLE.valid[(size_t)from][(size_t)ev])
+        return false;
+
+    out = SEGMENT_TABLE.next[(size_t)from][(size_t)ev];
+    return true;
+}
+
+constexpr const SegmentStateInfo& SegmentInfo(SegmentState s)
+{
+    return SEGMENT_STATE_INFO[(size_t)s];
+}
+
+constexpr bool IsDormantSegment(SegmentState s)
+{
+    return SegmentInfo(s).dormant;
+}
+
+// 타이머로 빠져나갈 수 없는 상태에 타이머가 걸리면 방이 멈춤 -> 표 수정 시 같이 확인
+constexpr bool TimersMatchTransitions()
+{
+    for (size_t s = 0; s < SEGMENT_STATE_COUNT; ++s)
+    {
+        const bool hasTimer = SEGMENT_STATE_INFO[s].timerTicks > 0;
+        if (hasTimer != SEGMENT_TABLE.valid[s][(size_t)SegmentEvent::TimerFired])
+            return false;
+    }
+    return true;
+}
+
+static_assert(TimersMatchTransitions(), "every timed segment state needs exactly a TimerFired transition");
\ No newline at end of file
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "game/GameConfig.h"
+#include "game/WorldState.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class GameLink;
+class SessionManager;
+class SpectatorRelay;
+
+// 스냅샷 인코딩/전송 파이프라인
+// tick 스레드: Acquire -> Room::Capture -> Publish (복사만 하고 바로 다음 방으로)
+// 인코더 스레드: WorldState -> S_Snapshot 프레임 1회 인코딩 -> 수신 세션 큐에 enqueue -> 버퍼 반납
+// - 인코딩은 방(= 관심 그룹) 단위 1회. 같은 방 세션들은 같은 바이트를 받음
+//   (클라 예산을 넘어 적을 수신자마다 고른 방만 수신자별 인코딩, WorldState::partial)
+// - 관전 릴레이가 있으면 인코딩된 프레임을 그대로 넘김 (관전자 몫 인코딩 없음)
+// - 버퍼가 모두 인코딩 대기 중이면 Acquire가 nullptr -> 이번 스냅샷은 버림 (tick은 절대 안 기다림)
+class SnapshotPipeline
+{
+public:
+    struct Stats
+    {
+        uint64 published = 0;
+        uint64 dropped = 0;         // 버퍼 부족으로 capture 생략
+        uint64 encodeFailed = 0;    // 프레임 상한 초과
+        uint64 framesSent = 0;      // 세션 큐에 넣은 프레임 수
+        uint64 bytesSent = 0;       // 세션 큐에 넣은 바이트 합 (스냅샷 egress)
+        uint64 perClientFrames = 0; // 수신자별로 따로 인코딩한 프레임 수 (예산 초과 방)
+        uint64 encodeNs = 0;        // 인코더 스레드에서 쓴 시간 합 (= tick 스레드에서 빠진 시간)
+        uint64 latencyNsSum = 0;    // capture -> 마지막 세션 enqueue
+        uint64 latencyNsMax = 0;
+    };
+
+public:
+    explicit SnapshotPipeline(SessionManager* mgr);
+    ~SnapshotPipeline();
+
+    bool Start(uint32 encoderThreads = SNAPSHOT_ENCODER_THREADS);
+
+    // 남은 작업은 버리지 않고 모두 처리한 뒤 종료
+    void Stop();
+
+    // tick 스레드 전용
+    WorldState* Acquire();
+    void Publish(WorldState* ws);
+
+    // 누적값을 읽고 0으로 리셋 (주기 로그용)
+    Stats TakeStats();
+
+    // 분리 배포 (--link): 세션 대신 게이트웨이 링크로 (인코더 i -> outbound 링 i). Start 전에
+    void SetGameLink(GameLink* link) { _link = link; }
+
+    // 관전 (--spectate): 방마다 인코딩한 프레임을 SpectatorRelay에도. Start 전에
+    void SetSpectatorRelay(SpectatorRelay* relay) { _relay = relay; }
+
+private:
+    void EncodeLoop(uint32 index);
+    void EncodeAndSend(const WorldState& ws, ByteBuffer& frame, std::vector<SnapshotEnemy>& picked, uint32 index, uint32 pid);
+
+    // 인코딩된 프레임을 수신자들에게 (링크면 레코드 1개), 반환: 넣은 수신자 수
+    uint64 Deliver(const WorldState& ws, const ByteBuffer& frame, const SessionId* recipients, size_t count, uint32 index, uint32 pid);
+    void Release(WorldState* ws);
+
+private:
+    SessionManager* _sessionMgr{ nullptr }; // 소유 X
+    GameLink* _link{ nullptr };             // 소유 X (있으면 세션 조회 없이 링크로)
+    SpectatorRelay* _relay{ nullptr };      // 소유 X
+
+    std::atomic<bool> _running{ false };
+    std::vector<std::thread> _encoders;
+
+    // 작업 큐: 고정 크기 ring (대기 버퍼는 풀 상한 이하 -> 넘칠 일 없음, tick 스레드 Publish에서 할당 없음)
+    std::mutex _jobMutex;
+    std::condition_variable _jobCv;
+    std::vector<WorldState*> _jobs;     // SNAPSHOT_MAX_IN_FLIGHT
+    size_t _jobHead{ 0 };
+    size_t _jobCount{ 0 };
+    bool _stopping{ false };
+
+    // 버퍼 풀 (상한 SNAPSHOT_MAX_IN_FLIGHT, 필요할 때만 늘어남)
+    std::mutex _poolMutex;
+    std::vector<std::unique_ptr<WorldState>> _owned;
+    std::vector<WorldState*> _free;
+
+    std::atomic<uint64> _published{ 0 };
+    std::atomic<uint64> _dropped{ 0 };
+    std::atomic<uint64> _encodeFailed{ 0 };
+    std::atomic<uint64> _framesSent{ 0 };
+    std::atomic<uint64> _bytesSent{ 0 };
+    std::atomic<uint64> _perClientFrames{ 0 };
+    std::atomic<uint64> _encodeNs{ 0 };
+    std::atomic<uint64> _latencyNsSum{ 0 };
+    std::atomic<uint64> _latencyNsMax{ 0 };
+
+    std::string _tag;
+};
\ No newline at end of file
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "common/Types.h"
+#include "proto/Protocol.h"
+
+#include <vector>
+
+// 스냅샷 적 선택용 우선순위 누적기 (플레이어 1명 시점, Room의 Player가 소유, tick 스레드 전용)
+// - 방 전체 스냅샷이 클라 예산(EnemyBudget)을 넘을 때만 고름. 안 넘으면 MarkAllSent로 보낸 값만 맞춰 둠
+// - 안 보낸 tick마다 누적: BASE + 가까울수록 NEAR + 마지막으로 보낸 값에서 바뀐 만큼 CHANGE
+//   -> 가깝고 많이 바뀐 적이 먼저, 멀고 가만히 있는 적도 결국 차례가 옴
+// - 보낸 적은 누적 0. 처음 보는 적(구간이 바뀌어 id가 다름)은 바로 보냄
+// - 죽음까지 보낸 적은 더 안 보냄 (클라가 마지막 상태를 유지)
+class SnapshotPriority
+{
+public:
+    static constexpr float BASE = 1.f;
+    static constexpr float NEAR = 4.f;              // 거리 0에서, FAR_RADIUS에서 0
+    static constexpr float FAR_RADIUS = 24.f;
+    static constexpr float CHANGE = 2.f;            // 바뀐 양 1당 (이동 1 unit / 최대 hp의 10% / state 변화 4)
+    static constexpr float CHANGE_CAP = 8.f;
+    static constexpr float NEW_ENTITY = 1.0e6f;     // 처음 보는 적
+
+public:
+    // 이 인원/주기로 스냅샷 1개에 담을 수 있는 적 수 (SNAPSHOT_CLIENT_BYTES_PER_SEC + 프레임 한도 + wire u8)
+    static uint32 EnemyBudget(uint32 playerCount, uint32 snapshotEvery);
+
+    // tick까지 누적하고 높은 순으로 maxCount개를 골라 적 index를 오름차순으로 out에 붙임 (반환: 고른 수)
+    uint32 Select(uint32 tick, float viewX, float viewY, const SnapshotEnemy* enemies, uint32 count, uint32 maxCount, std::vector<uint16>& out);
+
+    // 전부 보냄 (예산 안쪽 스냅샷)
+    void MarkAllSent(uint32 tick, const SnapshotEnemy* enemies, uint32 count);
+
+private:
+    struct Entry
+    {
+        uint32 id = 0;          // 0 = 아직 안 보냄
+        float priority = 0.f;
+        float sentX = 0.f;
+        float sentY = 0.f;
+        uint16 sentHp = 0;
+        uint8 sentState = 0;
+    };
+
+    void Resize(uint32 count);
+    static void MarkSent(Entry& e, const SnapshotEnemy& se);
+
+private:
+    std::vector<Entry> _entries;    // 적 index 순
+    std::vector<uint16> _order;     // Select 작업용 (재사용)
+    uint32 _lastTick = 0;
+};
\ No newline at end of file
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "common/Types.h"
+#include "game/GameConfig.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class SessionManager;
+
+// 관전 릴레이: 방의 인코딩된 스냅샷 스트림을 관전 세션들에 SPECTATOR_DELAY_MS 늦게 뿌림
+// - 인코더 스레드(Offer): 관전자가 있는 방이면 이미 인코딩된 프레임을 공유 사본 1개로 -> lane마다 참조만 넘김
+// - lane 스레드(SPECTATOR_RELAY_THREADS): 관전자는 세션 id로 lane에 나뉨 (한 방 관전자 수백 명도 lane들에 퍼짐)
+//   지연이 지난 프레임을 자기 관전자들 send 큐에 참조로 넣음 (관전자 수와 무관하게 방 스냅샷당 복사 1번, 인코딩 0번)
+// - tick 스레드는 관여 안 함 (capture/인코딩 비용이 관전자 수와 무관)
+// - 느린 관전자: 못 보내고 있던 이전 프레임은 새 프레임으로 대체 (Session::SendSharedFrame), 계속 못 따라오면 세션 예산대로 끊김
+// - 예산 초과 방(WorldState::partial)은 첫 수신자 시점으로 인코딩된 프레임을 씀
+// - 관전 세션은 별도 SessionManager 소속 (방에 안 들어감, 입력 메시지는 훅이 없어서 무시)
+class SpectatorRelay
+{
+public:
+    static constexpr uint32 LANE_MAX_FRAMES = 4096;    // lane별 지연 대기 프레임 상한 (넘으면 버림)
+    static constexpr uint32 IDLE_CHECK_MS = 500;        // 닫힌 방 확인 주기
+
+    struct Stats
+    {
+        uint64 framesIn = 0;        // 보관한 방 프레임 (관전자가 있는 방만)
+        uint64 framesDropped = 0;   // lane 대기 상한 초과로 버린 프레임
+        uint64 sends = 0;           // 관전 세션 큐에 넣은 참조 수
+        uint64 skipped = 0;         // 느린 관전자라 못 보낸 이전 프레임을 대체한 수
+        uint64 gone = 0;            // 끊긴 관전자 정리 + 방이 닫혀 끊은 관전자
+        uint64 relayNs = 0;         // lane 스레드 fan-out 시간 합
+    };
+
+public:
+    explicit SpectatorRelay(SessionManager* spectators);
+    ~SpectatorRelay();
+
+    bool Start(uint32 laneThreads = SPECTATOR_RELAY_THREADS);
+
+    // 대기 중인 프레임은 버림 (관전 세션은 SessionManager가 정리)
+    void Stop();
+
+    // 관전 세션 훅 (그 세션의 I/O 스레드): roomId 방 구독 + S_SpectateRes (0 = 볼 방 없음 -> ok=0)
+    // 같은 세션이 다시 요청하면 방만 바꿈
+    void Subscribe(SessionId sid, uint32 roomId);
+
+    // 인코더 스레드: 방 프레임 (관전자 없는 방이면 atomic 읽기 + 맵 조회만)
+    void Offer(uint32 roomId, const ByteBuffer& frame, uint64 tickOriginUs);
+
+    uint32 Spectators() const { return _spectators.load(std::memory_order_relaxed); }
+
+    // 누적값을 읽고 0으로 리셋 (주기 로그용)
+    Stats TakeStats();
+
+private:
+    struct Frame
+    {
+        uint32 roomId = 0;
+        uint64 dueUs = 0;           // 이 시각(ServerTimeUs) 이후 보냄
+        uint64 tickOriginUs = 0;
+        std::shared_ptr<const ByteBuffer> bytes;
+    };
+
+    struct Watchers
+    {
+        std::vector<SessionId> sids;
+        uint64 lastFrameUs = 0;     // 마지막 프레임 (또는 첫 구독) 시각
+    };
+
+    struct Lane
+    {
+        std::mutex mtx;
+        std::condition_variable cv;
+        std::deque<Frame> frames;       // Offer 순 (= dueUs 순)
+        std::vector<std::pair<SessionId, uint32>> subscribes;
+        bool stopping = false;
+        std::thread thread;
+
+        // 아래는 lane 스레드 전용
+        std::unordered_map<SessionId, uint32> roomOf;
+        std::unordered_map<uint32, Watchers> rooms;
+    };
+
+    void LaneLoop(uint32 index);
+    void ApplySubscribe(Lane& lane, SessionId sid, uint32 roomId, uint64 nowUs);
+    void FanOut(Lane& lane, const Frame& frame, uint64 nowUs);
+
+    // SPECTATOR_ROOM_IDLE_MS 동안 프레임이 없는 방 관전자는 S_Disconnect(RoomClosed)
+    void CloseIdleRooms(Lane& lane, uint64 nowUs);
+
+    // 방별 관전자 수 (Offer가 보관 여부를 봄)
+    void Watch(uint32 roomId, int32 delta);
+
+private:
+    SessionManager* _sessions{ nullptr };   // 소유 X (관전 세션 전용 매니저)
+
+    std::atomic<bool> _running{ false };
+    std::vector<std::unique_ptr<Lane>> _lanes;
+
+    std::mutex _watchMutex;
+    std::unordered_map<uint32, uint32> _watchCount;
+    std::atomic<uint32> _spectators{ 0 };
+
+    std::atomic<uint64> _framesIn{ 0 };
+    std::atomic<uint64> _framesDropped{ 0 };
+    std::atomic<uint64> _sends{ 0 };
+    std::atomic<uint64> _skipped{ 0 };
+    std::atomic<uint64> _gone{ 0 };
+    std::atomic<uint64> _relayNs{ 0 };
+
+    std::string _tag;
+};
\ No newline at end of file
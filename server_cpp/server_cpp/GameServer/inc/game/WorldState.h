@@ -0,0 +1,51 @@
+#pragma once
+
+#include "game/GameConfig.h"
+#include "proto/Protocol.h"
+
+#include <chrono>
+#include <vector>
+
+// tick 스레드가 publish하는 room 상태 사본 (publish 이후 불변)
+// - 인코더 스레드는 이 사본만 읽으므로 시뮬레이션과 락 없이 겹쳐서 돌 수 있음
+// - 버퍼는 파이프라인이 재사용 -> vector capacity 유지, warm-up 이후 할당 없음
+struct WorldState
+{
+    uint32 roomId = 0;
+    uint32 serverTick = 0;
+    SegmentState segmentState = SegmentState::InSegment;
+
+    // 이 방에 지금 쓰는 주기 (tick 단위, S_Snapshot으로 그대로 나감)
+    uint8 tickInterval = 1;
+    uint8 snapshotInterval = SNAPSHOT_EVERY_TICKS;
+
+    std::vector<SnapshotPlayer> players;
+    std::vector<SnapshotEnemy> enemies;
+
+    // 이 스냅샷을 받을 세션들
+    std::vector<SessionId> recipients;
+
+    // 예산 초과 방 (SnapshotPriority): 수신자마다 적 일부만 -> 인코더가 수신자별로 인코딩
+    // recipients[i]의 적 index = enemySel[(i == 0 ? 0 : selEnd[i - 1]) .. selEnd[i])
+    // partial이 아니면 비어 있음 (방 전체를 1번 인코딩해서 공유)
+    bool partial = false;
+    std::vector<uint16> enemySel;
+    std::vector<uint32> selEnd;
+
+    // end-to-end 지연 측정용 (capture 시점)
+    std::chrono::steady_clock::time_point capturedAt{};
+
+    // 방 tick 0의 서버 시각 (ServerTimeUs, 이번 tick 예정 시각 - serverTick * TICK_INTERVAL_US)
+    // 인코더가 수신 세션에 넘겨 S_Ping으로 나감 -> 클라가 스냅샷 tick을 자기 시계로 옮김
+    uint64 tickOriginUs = 0;
+
+    void Clear()
+    {
+        players.clear();
+        enemies.clear();
+        recipients.clear();
+        partial = false;
+        enemySel.clear();
+        selEnd.clear();
+    }
+};
\ No newline at end of file
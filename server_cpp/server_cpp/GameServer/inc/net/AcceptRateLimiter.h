@@ -0,0 +1,43 @@
+#pragma once
+
+#include "common/Types.h"
+
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
+
+// IP별 token bucket
+// - 접속 1회 = 토큰 1개, 초당 ratePerSec개 충전, 최대 burst개까지 저장
+// - 재접속 폭주 때 한 IP(봇/NAT 뒤 대량 접속)가 accept를 독점하지 못하게 막는 용도
+class AcceptRateLimiter
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+public:
+    AcceptRateLimiter(double ratePerSec, double burst);
+
+    // 토큰이 있으면 소비하고 true
+    bool Allow(uint32 ipv4, Clock::time_point now);
+
+    // 한동안 안 쓰인(토큰이 가득 찬) 버킷 정리
+    void Prune(Clock::time_point now);
+
+    size_t TrackedCount() const;
+
+private:
+    struct Bucket
+    {
+        double tokens;
+        Clock::time_point last;
+    };
+
+    void Refill(Bucket& b, Clock::time_point now) const;
+
+private:
+    const double _ratePerSec;
+    const double _burst;
+
+    mutable std::mutex _mtx;
+    std::unordered_map<uint32, Bucket> _buckets;
+};
\ No newline at end of file
@@ -2,36 +2,79 @@
 #include <winsock2.h>
 #include <ws2tcpip.h>
 
+#include "common/OverloadController.h"
+#include "net/AcceptRateLimiter.h"
+
 #include <atomic>
 #include <memory>
 #include <thread>
 #include <string>
+#include <vector>
 
 class SessionManager;
 
 class Acceptor
 {
+public:
+    static constexpr int ACCEPT_BACKLOG = 4096;         // 재접속 폭주 대비 (SOMAXCONN 기본값은 200 수준)
+    static constexpr int ACCEPT_BATCH = 64;             // 한 번 깨어났을 때 최대 accept 수
+    static constexpr int ACCEPT_POLL_TIMEOUT_MS = 100;  // Stop 감지 주기
+    static constexpr double ACCEPT_RATE_PER_IP = 20.0;  // IP당 초당 허용 접속
+    static constexpr double ACCEPT_BURST_PER_IP = 40.0;
+    static constexpr int ACCEPT_BATCH_OVERLOADED = 4;           // RejectRooms: 깨어날 때마다 이만큼만 받고
+    static constexpr int ACCEPT_OVERLOAD_DELAY_MS = 50;         // 나머지는 backlog에 둔 채 쉼 (접속 지연)
+
 public:
     explicit Acceptor(SessionManager* mgr);
     ~Acceptor();
 
-    // port listen  ( true)
-    bool Start(uint16_t port);
+    // Start/Adopt 전에: 과부하 단계에 따라 accept를 늦추거나 거절 (없으면 항상 받음)
+    void SetOverload(const OverloadController* overload) { _overload = overload; }
 
-    // listen ߴ + accept   +  
+    // port로 listen 시작 (성공 true)
+    // acceptThreads개 스레드가 같은 listen 소켓에서 backlog를 나눠서 비움
+    bool Start(uint16_t port, uint32_t acceptThreads = 2);
+
+    // listen 중단 + accept 스레드 종료 + 세션 정리
     void Stop();
 
+    // hot restart 인계 (HotRestart 전용)
+    // - Pause: accept 스레드만 멈춤 (listen 소켓 유지 -> 그동안 온 접속은 backlog에 쌓임)
+    // - Resume: 인계 실패 시 다시 accept
+    // - Adopt: Start 대신, 이전 프로세스에서 복제받은 listen 소켓으로 시작
+    bool Pause();
+    void Resume();
+    bool Adopt(SOCKET listenSock, uint16_t port, uint32_t acceptThreads = 2);
+    SOCKET ListenSocket() const { return _listenSock; }
+
+    uint64_t AcceptedCount() const { return _accepted.load(std::memory_order_relaxed); }
+    uint64_t RejectedCount() const { return _rejected.load(std::memory_order_relaxed); }
+    uint64_t OverloadRejectedCount() const { return _overloadRejected.load(std::memory_order_relaxed); }
+
 private:
-    void AcceptLoop();
+    void AcceptLoop(uint32_t index);
     bool OpenListenSocket(uint16_t port);
+    void StartThreads();
+
+    // accept된 소켓 1개 처리 (rate limit -> 과부하 -> 세션 생성/시작). 세션이 만들어지면 true
+    bool HandleAccepted(SOCKET clientSock, const sockaddr_in& caddr, AcceptRateLimiter::Clock::time_point now);
 
 private:
     std::atomic<bool> _running{ false };
 
     SOCKET _listenSock{ INVALID_SOCKET };
-    std::thread _acceptThread;
+    std::vector<std::thread> _acceptThreads;
+    uint32_t _threadCount{ 1 };
+
+    AcceptRateLimiter _rateLimiter{ ACCEPT_RATE_PER_IP, ACCEPT_BURST_PER_IP };
+
+    std::atomic<uint64_t> _accepted{ 0 };
+    std::atomic<uint64_t> _rejected{ 0 };
+    std::atomic<uint64_t> _overloadRejected{ 0 };   // _rejected 중 과부하로 거절한 수
+
+    const OverloadController* _overload{ nullptr };    // 소유 X
 
-    SessionManager* _sessionMgr{ nullptr }; //  X, 
+    SessionManager* _sessionMgr{ nullptr }; // 소유 X, 참조만
 
     uint16_t _port{ 0 };
 
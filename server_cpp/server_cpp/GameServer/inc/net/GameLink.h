@@ -0,0 +1,111 @@
+#pragma once
+
+#include "common/OverloadController.h"
+#include "net/GatewayLink.h"
+#include "net/Session.h"
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+// 게임 프로세스 쪽 게이트웨이 링크 (--link <name>): 소켓/세션 없이 방만 돌림
+// - 수신 스레드 1개: inbound 링 -> 세션 입/퇴장/입력/RTT 훅
+//   (SessionManager에 거는 것과 같은 훅 -> RoomManager는 세션이 어느 프로세스에 있는지 모름)
+// - 스냅샷: 인코더 i가 outbound 링 i에 방 단위로 수신자 목록 + 프레임 1개 (링마다 생산자 1개)
+// - 방 배정 거절: tick 스레드가 마지막 outbound 링(인코더 링 뒤 1개)에 Reject 레코드 -> 게이트웨이가 끊음
+// - 게이트웨이가 LINK_PEER_TIMEOUT_MS 동안 조용하면 그쪽 세션을 모두 closed 처리하고
+//   LINK_RESET_GRACE_MS 뒤에 다음 게이트웨이를 받음 (이전 id가 방에서 빠진 뒤라 새 게이트웨이 id와 안 섞임)
+class GameLink
+{
+public:
+    using SessionEventFn = std::function<void(SessionId)>;
+
+    struct Stats
+    {
+        uint64 recordsIn = 0;
+        uint64 badRecords = 0;          // 모르는 종류/짧은 레코드/decode 실패
+        uint64 snapshotsOut = 0;        // 링에 넣은 방 스냅샷 수
+        uint64 snapshotsDropped = 0;    // 링이 차서/게이트웨이가 없어서 버림
+        uint64 bytesOut = 0;
+        uint64 ringLatencyUsSum = 0;    // inbound 레코드: 게이트웨이 Commit -> 여기서 꺼낸 시각
+        uint64 ringLatencyUsMax = 0;
+    };
+
+public:
+    GameLink();
+    ~GameLink();
+
+    GameLink(const GameLink&) = delete;
+    GameLink& operator=(const GameLink&) = delete;
+
+    // Start 전에 한 번 (이후 변경 금지)
+    void SetHooks(SessionEventFn onOpened, SessionEventFn onClosed, SessionInputHooks inputHooks);
+
+    // Start 전에: 과부하 단계를 링크 헤더로 게이트웨이에 알림 (게이트웨이가 새 세션 배정/accept에 씀)
+    void SetOverload(const OverloadController* overload) { _overload = overload; }
+
+    // outRings = 스냅샷 인코더 스레드 수 (tick 스레드 링 1개는 따로 더함). createWaitMs: 이전 게임 프로세스 매핑이 풀릴 때까지
+    bool Start(const std::string& name, uint32 outRings, uint32 createWaitMs);
+    void Stop();
+
+    bool IsRunning() const { return _running.load(std::memory_order_relaxed); }
+    uint32 OutRings() const { return _outRings; }
+
+    // 인코더 스레드 ring 전용 (같은 ring을 두 스레드가 쓰면 안 됨)
+    // 수신자마다 다른 프레임(예산 초과 방)이면 수신자 1명씩 레코드 1개
+    bool SendSnapshot(uint32 ring, const SessionId* recipients, size_t count, const ByteBuffer& frame,
+        uint64 tickOriginUs, uint32 tickUs);
+
+    // tick 스레드 전용: 방을 못 준 세션을 게이트웨이가 reason으로 끊게 함 (게이트웨이 없음/링 가득이면 false)
+    bool RejectSession(SessionId sid, DisconnectReason reason);
+
+    Stats TakeStats();
+
+    // 입력 프레임 decode 후 훅 호출 (Session과 같은 Dispatcher, 수신 스레드 전용)
+    struct InputHandler
+    {
+        GameLink* link;
+        SessionId sid;
+
+        void On(const C_MoveInput& msg);
+        void On(const C_CastSkill& msg);
+        void On(const C_ChoiceVote& msg);
+    };
+
+private:
+    void RecvLoop();
+    size_t Drain();
+    void Handle(const GatewayLink::Record& rec, const Byte* body, size_t bodyLen);
+    void DropGateway();
+    void LogStats();
+
+private:
+    GatewayLink _link;
+    uint32 _outRings{ 0 };
+
+    SessionEventFn _onOpened;
+    SessionEventFn _onClosed;
+    SessionInputHooks _inputHooks;
+    const OverloadController* _overload{ nullptr };    // 소유 X
+
+    std::atomic<bool> _running{ false };
+    std::atomic<bool> _attached{ false };      // 인코더가 보고 버릴지 결정 (수신 스레드가 씀)
+    std::thread _recvThread;
+
+    // 수신 스레드 전용: 지금 게이트웨이가 열어 둔 세션 (게이트웨이를 잃으면 전부 closed)
+    std::unordered_set<SessionId> _open;
+    uint64 _resetUntilMs{ 0 };
+
+    std::atomic<uint64> _recordsIn{ 0 };
+    std::atomic<uint64> _badRecords{ 0 };
+    std::atomic<uint64> _snapshotsOut{ 0 };
+    std::atomic<uint64> _snapshotsDropped{ 0 };
+    std::atomic<uint64> _bytesOut{ 0 };
+    std::atomic<uint64> _ringLatencyUsSum{ 0 };
+    std::atomic<uint64> _ringLatencyUsMax{ 0 };
+
+    std::string _tag;
+};
\ No newline at end of file
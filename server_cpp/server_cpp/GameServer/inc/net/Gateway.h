@@ -0,0 +1,114 @@
+#pragma once
+
+#include "common/OverloadController.h"
+#include "net/GatewayLink.h"
+#include "net/Session.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class SessionManager;
+
+// 게이트웨이 프로세스 (--gateway <link,link,...>): 클라 TCP/UDP 종단만 하고 시뮬레이션은 게임 프로세스(--link)가
+// - 세션/프레이밍은 지금과 같음 (Acceptor/Session/PacketFramer). SessionManager 훅만 방 대신 링크 inbound 링으로
+// - 세션은 열릴 때 붙어 있는 게임 프로세스에 라운드로빈 배정 (끝날 때까지 고정). 없으면 바로 끊음
+//   새 방을 못 받는 단계(LoadLevel::RejectRooms 이상)를 알린 게임 프로세스는 건너뜀. 전부 그러면 S_Disconnect(Overloaded)
+// - inbound 링은 SPSC인데 세션 수신 완료 스레드가 여럿 -> 게임 프로세스별 생산자 락 (링에 직접 인코딩하는 구간만)
+// - 게임 프로세스마다 수신 스레드 1개: outbound 링들 -> 세션 Lookup (epoch) -> SendSnapshotFrame (TCP/UDP 선택은 세션이)
+// - 게임 프로세스가 LINK_PEER_TIMEOUT_MS 동안 조용하면 배정된 세션을 끊고, LINK_ATTACH_RETRY_MS마다 다시 붙어 봄
+// - hot restart(handoff)는 단일 프로세스 모드 전용
+class Gateway
+{
+public:
+    static constexpr uint32 LINK_ATTACH_RETRY_MS = 1000;
+
+    struct Stats
+    {
+        uint64 recordsOut = 0;          // inbound 링에 넣은 레코드 (입장/퇴장/입력/RTT)
+        uint64 recordsDropped = 0;      // inbound 링이 차서 버림
+        uint64 snapshotsIn = 0;         // outbound 링에서 꺼낸 방 스냅샷
+        uint64 framesDelivered = 0;     // 세션에 넘긴 스냅샷 프레임 (방 스냅샷 x 수신자)
+        uint64 ringLatencyUsSum = 0;    // outbound 레코드: 게임 프로세스 Commit -> 여기서 꺼낸 시각
+        uint64 ringLatencyUsMax = 0;
+        uint64 kicked = 0;              // 게임 프로세스가 없거나 죽어서 끊은 세션
+        uint64 overloaded = 0;          // 붙은 게임 프로세스가 모두 새 방을 못 받아서 S_Disconnect(Overloaded)
+    };
+
+public:
+    explicit Gateway(SessionManager* mgr);
+    ~Gateway();
+
+    Gateway(const Gateway&) = delete;
+    Gateway& operator=(const Gateway&) = delete;
+
+    // 세션이 생기기 전에. 게임 프로세스가 하나라도 attachWaitMs 안에 붙어야 true
+    bool Start(const std::vector<std::string>& links, uint32 attachWaitMs);
+
+    // 수신 스레드가 세션에 접근하므로 SessionManager::StopAll 전에 (이후 퇴장 레코드는 버림 -> 게임 쪽은 heartbeat 0으로 정리)
+    void Stop();
+
+    // SessionManager 훅 (main에서 연결)
+    void OnSessionOpened(SessionId sid);
+    void OnSessionClosed(SessionId sid);
+    SessionInputHooks MakeInputHooks();
+
+    // 붙은 게임 프로세스 중 가장 여유 있는 쪽의 과부하 단계 (게이트웨이 OverloadController의 바닥값)
+    LoadLevel MinBackendLoad() const;
+
+    Stats TakeStats();
+
+private:
+    struct Backend
+    {
+        std::string name;
+        std::unique_ptr<GatewayLink> link;  // produceMutex 보호 (수신 스레드가 붙이고/떼고)
+        std::mutex produceMutex;            // inbound 링 생산자 직렬화
+        std::atomic<bool> attached{ false };
+        std::atomic<uint32> load{ 0 };      // 게임 프로세스가 알린 LoadLevel (수신 스레드가 갱신)
+        std::thread thread;
+    };
+
+    // inbound 레코드 1개: 머리 + bodyLen 바이트 (write가 링 자리에 직접 씀)
+    template <typename WriteFn>
+    bool Post(uint32 backend, GatewayLink::Record& rec, size_t bodyLen, WriteFn&& write);
+    bool PostSimple(uint32 backend, GatewayLink::RecordKind kind, SessionId sid, uint64 arg64 = 0, uint32 arg32 = 0);
+
+    template <typename Msg>
+    void PostInput(SessionId sid, const Msg& msg);
+
+    bool BackendOf(SessionId sid, uint32& out);
+
+    void RecvLoop(uint32 index);
+    size_t Drain(GatewayLink& link, ByteBuffer& frame, uint32 pid);
+    bool TryAttach(Backend& b);
+    void LoseBackend(uint32 index);
+    void Kick(SessionId sid, DisconnectReason reason = DisconnectReason::None);
+    void LogStats();
+
+private:
+    SessionManager* _sessionMgr{ nullptr };    // 소유 X
+
+    std::vector<std::unique_ptr<Backend>> _backends;
+    std::atomic<bool> _running{ false };
+
+    // 세션 -> 게임 프로세스 배정
+    std::mutex _assignMutex;
+    std::unordered_map<SessionId, uint32> _assigned;
+    uint32 _nextBackend{ 0 };
+
+    std::atomic<uint64> _recordsOut{ 0 };
+    std::atomic<uint64> _recordsDropped{ 0 };
+    std::atomic<uint64> _snapshotsIn{ 0 };
+    std::atomic<uint64> _framesDelivered{ 0 };
+    std::atomic<uint64> _ringLatencyUsSum{ 0 };
+    std::atomic<uint64> _ringLatencyUsMax{ 0 };
+    std::atomic<uint64> _kicked{ 0 };
+    std::atomic<uint64> _overloaded{ 0 };
+
+    std::string _tag;
+};
\ No newline at end of file
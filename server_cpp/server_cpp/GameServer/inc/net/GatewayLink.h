@@ -0,0 +1,160 @@
+#pragma once
+
+#include "common/SharedMemory.h"
+#include "common/ShmRing.h"
+#include "common/Types.h"
+
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <string>
+
+// 게이트웨이 프로세스 <-> 게임 프로세스 공유 메모리 링크 (분리 배포, Gateway / GameLink가 사용)
+// - 게임 프로세스가 만들고(Create) 게이트웨이가 붙음(Open + Attach). 한 게임 프로세스에 게이트웨이 1개
+// - 레이아웃: [Header][inbound 링: 게이트웨이 -> 게임][outbound 링 x outRings: 게임 인코더 i -> 게이트웨이, 마지막은 게임 tick 스레드]
+//   링마다 생산자/소비자 스레드가 1개씩이라 SPSC 그대로 (ShmRing)
+// - 소비자가 비어서 잠들 때만 이름 있는 이벤트로 깨움 (바쁠 땐 시스템 콜 없음)
+// - 상대 생존은 heartbeat(ms, ServerTimeUs 축)로만 봄: LINK_PEER_TIMEOUT_MS 넘게 멈추면 죽은 것으로 처리
+// - 두 프로세스는 같은 빌드여야 함 (Header/Record를 그대로 memcpy, magic/version/크기로 확인)
+class GatewayLink
+{
+public:
+    static constexpr uint32 LINK_MAGIC = 0x4B4E4C47;               // "GLNK"
+    static constexpr uint16 LINK_VERSION = 3;                      // Header/Record 레이아웃(또는 레코드 종류)이 바뀌면 올림
+    static constexpr size_t LINK_IN_RING_BYTES = 4u << 20;         // 입력/입퇴장
+    static constexpr size_t LINK_OUT_RING_BYTES = 8u << 20;        // 스냅샷 (인코더마다)
+    static constexpr uint32 LINK_MAX_OUT_RINGS = 8;
+    static constexpr uint32 LINK_PEER_TIMEOUT_MS = 3000;
+    static constexpr uint32 LINK_RESET_GRACE_MS = 500;             // 게이트웨이를 잃은 뒤 방에서 세션이 빠질 시간 (다음 게이트웨이 id와 안 섞이게)
+    static constexpr uint32 LINK_ATTACH_TIMEOUT_MS = 1000;         // 게임 프로세스가 붙기 요청을 받아줄 때까지
+    static constexpr uint32 LINK_WAIT_MS = 1;                      // 소비자가 비었을 때 한 번에 자는 한도 (heartbeat/정지 확인 주기)
+    static constexpr uint32 LINK_SPIN = 256;                       // 잠들기 전에 빈 링을 다시 보는 횟수
+    static constexpr size_t LINK_DRAIN_BATCH = 1024;               // 링 하나에서 연달아 꺼내는 한도 (그 사이 heartbeat/생존 확인)
+
+    enum class Side : uint32
+    {
+        Game = 0,
+        Gateway = 1
+    };
+
+    enum class State : uint32
+    {
+        Idle = 0,               // 게이트웨이 없음
+        AttachRequested = 1,    // 게이트웨이가 붙기 요청 (게임 쪽이 이전 잔여물을 치우고 Attached로)
+        Attached = 2
+    };
+
+    enum class RecordKind : uint8
+    {
+        Opened = 1,     // G->S: 세션 입장
+        Closed,         // G->S: 세션 퇴장
+        Input,          // G->S: 게임 입력 프레임 ([len][msgId][payload], 게이트웨이 세션이 이미 decode 검증함)
+        Rtt,            // G->S: RTT 추정값 변화
+        Snapshot,       // S->G: [SessionId x count][S_Snapshot 프레임] (방 단위 1개, 게이트웨이가 세션별로 복사)
+        Reject          // S->G: 세션 방 배정 거절 (arg32 = DisconnectReason, 게이트웨이가 S_Disconnect 후 끊음)
+    };
+
+    // 모든 레코드의 머리 (링 레코드 payload 앞부분)
+    struct Record
+    {
+        RecordKind kind = RecordKind::Opened;
+        uint8 reserved = 0;
+        uint16 count = 0;       // Snapshot: 뒤따르는 SessionId 수
+        uint32 arg32 = 0;       // Rtt: rttVarMs / Snapshot: tickUs / Reject: reason
+        SessionId sid = 0;      // Snapshot은 0
+        uint64 arg64 = 0;       // Rtt: rttMs / Snapshot: tickOriginUs
+        uint64 sentUs = 0;      // 링에 넣은 시각 (ServerTimeUs, 링 지연 통계)
+    };
+
+    // 공유 메모리 맨 앞
+    struct Header
+    {
+        uint32 magic;
+        uint16 version;
+        uint16 outRings;
+        uint32 headerSize;
+        uint32 recordSize;
+        uint64 inCapacity;
+        uint64 outCapacity;
+        uint32 gamePid;
+
+        alignas(64) std::atomic<uint32> state;
+        std::atomic<uint32> gatewayPid;
+        std::atomic<uint64> gameBeatMs;
+        std::atomic<uint64> gatewayBeatMs;
+        std::atomic<uint32> gameLoad;       // 게임 프로세스 과부하 단계 (LoadLevel, 게이트웨이가 배정/accept에 씀)
+
+        alignas(64) std::atomic<uint32> gameWaiting;      // 게임 쪽 수신 스레드가 이벤트 대기 중
+        alignas(64) std::atomic<uint32> gatewayWaiting;   // 게이트웨이 쪽 수신 스레드가 이벤트 대기 중
+    };
+
+public:
+    GatewayLink() = default;
+
+    GatewayLink(const GatewayLink&) = delete;
+    GatewayLink& operator=(const GatewayLink&) = delete;
+
+    // 게임 프로세스: 만들고 Idle로 (같은 이름이 살아 있으면 waitMs 동안 재시도)
+    bool Create(const std::string& name, uint32 outRings, uint32 waitMs);
+
+    // 게이트웨이: 있는 링크를 열고 붙기 요청 -> 게임 쪽이 받아주면 true (outbound 잔여물은 버림)
+    // 없거나/다른 게이트웨이가 붙어 있거나/응답이 없으면 false (닫힌 상태)
+    bool Attach(const std::string& name);
+
+    // 자기 heartbeat를 0으로 -> 상대가 timeout을 기다리지 않고 바로 끊김으로 봄
+    void Close(Side self);
+
+    bool IsOpen() const { return _hdr != nullptr; }
+    const std::string& Name() const { return _name; }
+
+    ShmRing& In() { return _in; }
+    ShmRing& Out(uint32 i) { return _out[i]; }
+    uint32 OutRings() const { return _outRings; }
+
+    State GetState() const { return (State)_hdr->state.load(std::memory_order_acquire); }
+    void SetState(State s) { _hdr->state.store((uint32)s, std::memory_order_release); }
+
+    // 수신 스레드 루프마다 (상대는 이 값으로 생존 판단)
+    void Beat(Side self, uint64 nowMs);
+    bool PeerAlive(Side self, uint64 nowMs) const;
+
+    // 게임 프로세스 과부하 단계 (게임 쪽이 쓰고 게이트웨이가 읽음)
+    void SetGameLoad(uint32 level) { _hdr->gameLoad.store(level, std::memory_order_relaxed); }
+    uint32 GameLoad() const { return _hdr->gameLoad.load(std::memory_order_relaxed); }
+
+    // 생산자: Commit 뒤 호출. 상대 수신 스레드가 자고 있을 때만 이벤트
+    void Notify(Side peer);
+
+    // 소비자: 자기 쪽 링이 모두 비었으면 timeoutMs까지 잠 (Notify 경합은 waiting 플래그 + 재확인으로 막음)
+    void Wait(Side self, uint32 timeoutMs);
+
+    // 레코드 머리 쓰기/읽기 (Reserve 받은 자리에)
+    static constexpr size_t RECORD_SIZE = sizeof(Record);
+    static void StoreRecord(Byte* out, const Record& rec) { std::memcpy(out, &rec, sizeof(Record)); }
+    static bool LoadRecord(const Byte* in, size_t len, Record& rec)
+    {
+        if (len < sizeof(Record))
+            return false;
+        std::memcpy(&rec, in, sizeof(Record));
+        return true;
+    }
+
+private:
+    bool BindRings();
+    bool HasInput(Side self);
+    std::atomic<uint32>& Waiting(Side s) { return s == Side::Game ? _hdr->gameWaiting : _hdr->gatewayWaiting; }
+
+    static std::string MappingName(const std::string& name) { return "Local\\GameServer-link-" + name; }
+
+private:
+    std::string _name;
+    SharedMemory _shm;
+    Header* _hdr{ nullptr };
+
+    ShmRing _in;
+    std::array<ShmRing, LINK_MAX_OUT_RINGS> _out;
+    uint32 _outRings{ 0 };
+
+    // [Side] 쪽 수신 스레드를 깨우는 이벤트
+    std::array<NamedEvent, 2> _wake;
+};
\ No newline at end of file
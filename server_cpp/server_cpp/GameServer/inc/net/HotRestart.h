@@ -0,0 +1,36 @@
+#pragma once
+
+#include "common/Types.h"
+
+class Acceptor;
+class SessionManager;
+class RoomManager;
+
+// 무중단 재시작: listen 소켓 + 접속 중인 클라 소켓 + 세션/방 상태를 새 프로세스로 넘김
+// - 소켓은 WSADuplicateSocketW(WSAPROTOCOL_INFOW)로 복제해서 named pipe(\\.\pipe\GameServer-handoff-<port>)로 전달
+//   (Windows라 UNIX 소켓 SCM_RIGHTS 대신. 복제본은 같은 커널 소켓이라 연결/수신 버퍼가 그대로 이어짐)
+// - 순서: hello(버전 확인) -> accept/tick/세션 send 멈춤 -> 소켓 복제 + 새 프로세스 확인
+//   -> (여기부터 되돌릴 수 없음) recv 멈추고 핸들 닫기 -> 세션(수신 잔여/send 큐)+방 상태 전송
+// - 소켓 확인 전에 실패하면 이전 프로세스가 그대로 재개 (클라는 멈췄던 만큼 지연만 봄)
+// - 세션 id는 그대로 (SessionManager::Adopt) -> 방/스냅샷/클라가 보는 playerId 모두 변화 없음
+// - 게임 공백(gapMs) = 이전 프로세스 tick 정지 ~ 새 프로세스 tick 시작 (steady_clock은 QPC라 프로세스 간 비교 가능)
+// - 새 프로세스의 --record 로그에는 넘겨받은 방의 RoomOpen이 없음 (replay는 그 방 기록을 bad로 셈)
+class HotRestart
+{
+public:
+    static constexpr uint32 HANDOFF_MAGIC = 0x46444E48;            // "HNDF"
+    static constexpr uint16 HANDOFF_VERSION = 2;                   // 세션/방 SaveState 레이아웃이 바뀌면 올림
+    static constexpr uint32 HANDOFF_WAIT_MS = 30000;               // 상대 프로세스가 붙기를 기다리는 기본값
+    static constexpr uint32 HANDOFF_IO_TIMEOUT_MS = 10000;         // pipe 메시지 1개 송수신 한도
+    static constexpr uint32 HANDOFF_FREEZE_TIMEOUT_MS = 500;       // 걸린 WSASend가 끝나 프레임 경계에 설 때까지
+    static constexpr uint32 HANDOFF_MAX_MESSAGE = 256u << 20;
+
+public:
+    // 이전 프로세스 (콘솔 "handoff"): 새 프로세스(--takeover)가 waitMs 안에 붙으면 넘김
+    // true면 소켓/방이 넘어간 상태 -> 호출부는 종료만 하면 됨. false면 그대로 계속 서비스
+    static bool Handoff(uint16 port, uint32 waitMs, Acceptor& acceptor, SessionManager& sessions, RoomManager& rooms);
+
+    // 새 프로세스 (--takeover): RoomManager::Start / Acceptor::Start 대신 호출
+    // 실패하면 false (아무것도 시작 안 됨 -> 이전 프로세스가 살아 있으면 거기서 계속)
+    static bool Takeover(uint16 port, uint32 waitMs, Acceptor& acceptor, SessionManager& sessions, RoomManager& rooms);
+};
\ No newline at end of file
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "common/Types.h"
+
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Go 서비스로 POST만 하는 최소 HTTP/1.1 클라이언트 (전용 스레드 1개)
+// - non-blocking 소켓 + WSAPoll로 여러 요청을 한 스레드에서 진행 (요청마다 Connection: close)
+// - key(방 id)당 대기 작업은 1개: 아직 안 보낸 이전 body는 새 body로 덮어씀 (coalescing)
+// - 네트워크 오류/5xx는 지수 backoff로 재시도, 그 사이 새 body가 오면 그것으로 대체
+// - Post는 아무 스레드에서나 호출 가능 (큐에 넣기만 함)
+class HttpUploader
+{
+public:
+    static constexpr uint32 HTTP_MAX_CONNECTIONS = 4;           // 동시 진행 요청 수
+    static constexpr uint32 HTTP_REQUEST_TIMEOUT_MS = 5000;     // connect~응답 헤더까지
+    static constexpr uint32 HTTP_RETRY_BASE_MS = 500;
+    static constexpr uint32 HTTP_RETRY_MAX_MS = 30000;
+    static constexpr uint32 HTTP_MAX_ATTEMPTS = 8;              // 넘으면 버림 (다음 체크포인트가 대신함)
+    static constexpr size_t HTTP_MAX_RESPONSE_BYTES = 8 * 1024;
+    static constexpr int HTTP_POLL_TIMEOUT_MS = 20;             // 진행 중 요청이 있을 때 Post 반영 지연 상한
+
+    struct Stats
+    {
+        uint64 posted = 0;
+        uint64 succeeded = 0;
+        uint64 coalesced = 0;   // 보내기 전에 새 body로 대체된 수
+        uint64 retries = 0;
+        uint64 dropped = 0;     // 재시도 한도 초과 / 4xx
+        uint64 bytesSent = 0;
+    };
+
+public:
+    HttpUploader();
+    ~HttpUploader();
+
+    HttpUploader(const HttpUploader&) = delete;
+    HttpUploader& operator=(const HttpUploader&) = delete;
+
+    // host: IPv4 주소 또는 호스트명 (시작 시 1회 resolve)
+    bool Start(const std::string& host, uint16 port);
+
+    // 남은 작업을 drainMs 동안 마저 보내고 종료 (멱등)
+    void Stop(uint32 drainMs = 3000);
+
+    void Post(uint64 key, const std::string& path, ByteBuffer&& body);
+
+    Stats TakeStats();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Job
+    {
+        uint64 key = 0;
+        std::string path;
+        ByteBuffer body;
+        uint32 attempts = 0;
+        Clock::time_point notBefore{};
+    };
+
+    enum class ConnState : uint8
+    {
+        Connecting,
+        Sending,
+        Receiving
+    };
+
+    struct Conn
+    {
+        SOCKET sock = INVALID_SOCKET;
+        ConnState state = ConnState::Connecting;
+        Job job;
+        ByteBuffer request;     // 헤더 + body
+        size_t sentBytes = 0;
+        std::string response;
+        Clock::time_point deadline{};
+        bool done = false;
+    };
+
+    void WorkerLoop();
+
+    // 준비된 작업을 꺼내 연결 시작 (in-flight인 key는 건너뜀)
+    void StartReadyJobs(Clock::time_point now);
+    bool BeginConn(Conn& c);
+
+    // 이벤트 처리 (true = 요청 끝남, status: 0이면 응답 못 받음)
+    bool OnWritable(Conn& c);
+    bool OnReadable(Conn& c, int& status);
+
+    // 성공/재시도/포기 판정 후 소켓 닫음
+    void Finish(Conn& c, int status, const char* reason);
+
+    static int ParseStatus(const std::string& response);
+
+private:
+    std::atomic<bool> _running{ false };
+    std::thread _worker;
+
+    sockaddr_in _addr{};
+    std::string _hostHeader;
+
+    // 아래는 _mutex 보호
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    std::unordered_map<uint64, Job> _queued;    // key당 최신 1개
+    Clock::time_point _drainUntil{};
+    Stats _stats;
+
+    // 워커 전용
+    std::vector<Conn> _conns;
+
+    std::string _tag;
+};
\ No newline at end of file
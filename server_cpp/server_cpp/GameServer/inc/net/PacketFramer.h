@@ -1,53 +1,78 @@
 #pragma once
 #include "../common/Types.h"
-#include <string>
 
+class RecvBlockPool;
+
+// 꺼낸 프레임 (payload는 수신 블록 안을 가리킴 -> 다음 WritePtr/Release 전까지만 유효)
 struct Frame
 {
     MsgId msgId = 0;
-    ByteBuffer payload;
+    const Byte* payload = nullptr;
+    size_t payloadLen = 0;
 };
 
 enum class FrameError
 {
     None,
-    LengthTooSmall,     // length < 2 (msg_id  )
+    LengthTooSmall,     // length < 2 (msg_id 포함 못함)
     FrameTooLarge,      // total(2+length) > MAX_FRAME_TOTAL
-    RecvBufferTooLarge  // _buf > MAX_RECV_BUFFER
+    RecvBufferTooLarge, // Append가 블록 남은 자리(RECV_BLOCK_BYTES)보다 큼
+    OutOfMemory         // 블록을 못 빌림
 };
 
+// 수신 바이트 -> [len][msgId][payload] 프레임
+// - 버퍼는 RecvBlockPool 블록 1개 (RECV_BLOCK_BYTES). 읽을 때 붙이고, 덜 된 프레임이 안 남으면 ReleaseIfEmpty로 반납
+//   -> 조용한 세션은 버퍼 없음, 남는 건 최대 MAX_FRAME_TOTAL-1바이트라 블록 하나로 충분
+// - recv는 WritePtr 자리에 바로 받고 Commit (복사 없음)
 class PacketFramer
 {
 public:
-    PacketFramer() = default;
+    // pool = nullptr이면 블록을 직접 할당/해제
+    explicit PacketFramer(RecvBlockPool* pool = nullptr) : _pool(pool) {}
+    ~PacketFramer();
+
+    PacketFramer(const PacketFramer&) = delete;
+    PacketFramer& operator=(const PacketFramer&) = delete;
+
+    // recv할 자리 (블록이 없으면 빌리고, 남은 바이트는 앞으로 당김). 실패면 nullptr + lastError
+    Byte* WritePtr(size_t& space);
+    void Commit(size_t n) { _end += (uint32)n; }
 
-    //  ͸  ۿ 
-    // : true, : false + lastError 
+    // 다른 곳에서 받은 바이트를 넣음 (hot restart 인계분)
+    // 성공: true, 실패: false + lastError 설정
     bool Append(const Byte* data, size_t len);
 
-    // ϼ  1 
-    // Ok: outFrame ä
-    // NeedMore:   ϼ ȵ
-    // Error: lastError  ( disconnect )
+    // 완성된 프레임 1개를 꺼낸다
+    // Ok: outFrame 채워짐
+    // NeedMore: 아직 프레임 완성 안됨
+    // Error: lastError 설정됨 (세션 disconnect 권장)
     PopResult TryPopFrame(Frame& outFrame);
 
+    // 남은 바이트가 없으면 블록 반납 (recv 한 바퀴 끝날 때마다)
+    void ReleaseIfEmpty();
+
     void Clear();
-    size_t BufferedSize() const { return _buf.size(); }
+    size_t BufferedSize() const { return (size_t)(_end - _begin); }
+    bool HoldsBlock() const { return _block != nullptr; }
+
+    // 아직 프레임이 안 된 수신 바이트 (hot restart 인계용)
+    const Byte* BufferedData() const { return _block ? _block + _begin : nullptr; }
 
     FrameError LastError() const { return _lastError; }
-    const std::string& LastErrorMessage() const { return _lastErrorMsg; }
+    const char* LastErrorMessage() const { return _lastErrorMsg; }
 
 private:
-    // Ʋ u16 б (buf[off], buf[off+1])
-    static uint16 PeekU16LE(const ByteBuffer& buf, size_t off);
-
-    //  տ n Ʈ 
-    void Consume(size_t n);
+    // 리틀엔디안으로 u16 읽기 (p[0], p[1])
+    static uint16 PeekU16LE(const Byte* p);
 
+    void ReleaseBlock();
     void SetError(FrameError err, const char* msg);
 
 private:
-    ByteBuffer _buf;
+    RecvBlockPool* _pool{ nullptr };    // 소유 X
+    Byte* _block{ nullptr };
+    uint32 _begin{ 0 };
+    uint32 _end{ 0 };
     FrameError _lastError = FrameError::None;
-    std::string _lastErrorMsg;
+    const char* _lastErrorMsg = "";
 };
\ No newline at end of file
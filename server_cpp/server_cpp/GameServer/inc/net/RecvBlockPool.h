@@ -0,0 +1,51 @@
+#pragma once
+
+#include "common/Types.h"
+
+#include <atomic>
+#include <mutex>
+
+// 세션 수신 버퍼 풀 (RECV_BLOCK_BYTES 고정 크기)
+// - 세션은 읽을 데이터가 있을 때만 블록을 빌리고, 덜 된 프레임이 안 남으면 바로 돌려줌
+//   -> 조용한 세션은 수신 버퍼 0바이트 (PacketFramer)
+// - 빈 블록은 RECV_POOL_MAX_FREE개까지만 들고 나머지는 해제 (접속 폭주 뒤 메모리를 계속 쥐지 않게)
+// - I/O 완료 스레드 여럿이 같이 씀 -> 락 1개 (블록당 빌림/반납 1번씩이라 짧음)
+class RecvBlockPool
+{
+public:
+    static constexpr size_t RECV_POOL_MAX_FREE = 1024;
+
+    struct Stats
+    {
+        size_t inUse = 0;       // 세션에 붙어 있는 블록
+        size_t free = 0;        // 풀에 남은 블록
+        uint64 allocs = 0;      // 풀이 비어서 새로 할당한 수 (누적)
+    };
+
+public:
+    RecvBlockPool() = default;
+    ~RecvBlockPool();
+
+    RecvBlockPool(const RecvBlockPool&) = delete;
+    RecvBlockPool& operator=(const RecvBlockPool&) = delete;
+
+    // RECV_BLOCK_BYTES짜리 블록 (할당 실패면 nullptr)
+    Byte* Acquire();
+    void Release(Byte* block);
+
+    Stats GetStats() const;
+
+private:
+    // 빈 블록 앞부분을 다음 포인터로 씀
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    mutable std::mutex _mutex;
+    FreeBlock* _free{ nullptr };
+    size_t _freeCount{ 0 };
+
+    std::atomic<size_t> _inUse{ 0 };
+    std::atomic<uint64> _allocs{ 0 };
+};
\ No newline at end of file
@@ -2,68 +2,288 @@
 
 #include "common/Types.h"
 #include "net/PacketFramer.h"
+#include "proto/Codec.h"
 
 #include <winsock2.h>
 #include <ws2tcpip.h>
+#include <mstcpip.h>
 
+#include <array>
 #include <atomic>
-#include <condition_variable>
-#include <deque>
+#include <chrono>
 #include <functional>
+#include <memory>
 #include <mutex>
-#include <thread>
 #include <string>
 
-class Session
+// 큐 정책 구분
+// - Reliable: 절대 버리지 않음 (이벤트/응답)
+// - Snapshot: 전체 상태라 최신 것만 의미 있음 -> 새 스냅샷이 오면 큐에 남은 이전 것은 버림
+enum class SendKind : uint8
+{
+    Reliable,
+    Snapshot
+};
+
+struct SendQueueStats
+{
+    size_t queuedBytes = 0;
+    size_t queuedFrames = 0;
+    uint64 droppedSnapshots = 0;   // 새 스냅샷에 밀려 버려진 수
+    uint64 overflowEnqueues = 0;   // 예산 초과 상태에서 들어온 프레임 수
+};
+
+// 게임 입력을 게임 레이어로 넘기는 콜백 (SessionIo 완료 스레드에서 호출됨)
+// SessionManager가 소유, 세션은 포인터만 들고 있음
+class SessionIo;
+class UdpTransport;
+
+struct SessionInputHooks
+{
+    std::function<void(SessionId, const C_MoveInput&)> onMoveInput;
+    std::function<void(SessionId, const C_CastSkill&)> onCastSkill;
+    std::function<void(SessionId, const C_ChoiceVote&)> onChoiceVote;
+
+    // RTT 추정값 변화 (C_Pong이면 수신 완료에서 RTT_REPORT_MIN_DELTA_MS 이상 바뀔 때만,
+    // C_Pong 없는 클라는 SessionIo 타이머의 TCP RTT 표본, rttVarMs = 0)
+    std::function<void(SessionId, uint32 rttMs, uint32 rttVarMs)> onRttSample;
+
+    // 관전 요청 (관전 포트 SessionManager의 훅에만 있음 -> 게임 세션이 보내면 무시)
+    std::function<void(SessionId, const C_SpectateReq&)> onSpectate;
+};
+
+
+// 연결 1개 (스레드 없음: 수신/송신 완료는 SessionIo 스레드들이, ping/RTT 조회는 SessionIo 타이머가)
+// 조용한 세션이 들고 있는 것: 이 객체 + 소켓 (수신 블록/송신 노드는 보낼 것/읽을 것이 있을 때만)
+class Session : public std::enable_shared_from_this<Session>
 {
 public:
-    using SessionId = uint64_t;
     using OnCloseFn = std::function<void(SessionId)>;
 
 public:
-    explicit Session(SOCKET sock, SessionId id, OnCloseFn onClose);
-	~Session() = default;
+    // io/onClose/inputHooks/udp는 SessionManager 소유 (세션보다 오래 삶)
+    Session(SOCKET sock, SessionId id, SessionIo* io, const OnCloseFn* onClose, const SessionInputHooks* inputHooks = nullptr, UdpTransport* udp = nullptr);
+    ~Session();
 
     Session(const Session&) = delete;
     Session& operator=(const Session&) = delete;
 
+    // make_shared로 생성된 세션만 호출 가능 (걸어 둔 I/O가 자기 참조를 들고 있음)
     void Start();
-	void Stop();                // ܺ  (join )
-	void RequestStop();         // /ܺ 𼭵 ȣ (join )
+	void Stop();                // 외부 전용 (걸린 I/O가 끝날 때까지 기다림)
+	void RequestStop();         // 내부/외부 어디서든 호출 (안 기다림)
+
+    // S_Disconnect(reason)을 보내고 끊음 (남은 스냅샷은 버리고 그 뒤로는 큐에 안 넣음, Start 전이어도 됨)
+    // DISCONNECT_LINGER_MS 안에 못 보내면 그냥 끊음
+    void Disconnect(DisconnectReason reason);
 
     SessionId Id() const { return _id; }
 
     bool IsRunning() const { return _running.load(); }
     
-	// SendFrame: ť ִ ۾
-    bool SendFrame(MsgId msgId, const Byte* payload, size_t payloadLen);
+	// SendFrame: 큐에 넣고, 보내는 중이 아니면 WSASend까지 (완료는 SessionIo 스레드)
+    // 예산 초과가 SEND_OVERFLOW_DISCONNECT_MS 이상 지속되면 큐를 비우고 S_Disconnect(SlowConsumer) 후 false
+    bool SendFrame(MsgId msgId, const Byte* payload, size_t payloadLen, SendKind kind = SendKind::Reliable);
+
+    // 고정 길이 메시지 전송 (payload는 스택에서 인코딩)
+    template <typename Msg>
+    bool Send(const Msg& msg, SendKind kind = SendKind::Reliable)
+    {
+        std::array<Byte, FixedCodec<Msg>::SIZE> payload;
+        FixedCodec<Msg>::Encode(msg, payload.data());
+        return SendFrame(Msg::ID, payload.data(), payload.size(), kind);
+    }
+
+    // 이미 완성된 프레임([len][msgId][payload])을 그대로 큐에 (스냅샷 인코더 등)
+    bool SendRawFrame(ByteBuffer&& frame, SendKind kind = SendKind::Reliable);
+
+    // 관전 릴레이: 여러 세션이 공유하는 프레임을 복사 없이 큐에 (SendKind::Snapshot 정책, TCP 큐만)
+    // skipped: 아직 못 보내고 있던 이전 스냅샷을 이걸로 대체한 수 (느린 관전자)
+    bool SendSharedFrame(std::shared_ptr<const ByteBuffer> frame, uint32& skipped);
+
+    SendQueueStats GetSendStats() const;
+
+    // 스냅샷 전송 경로 선택: UDP로 묶여 있으면 데이터그램 1개 (큐 없음), 아니면 TCP 큐 (SendKind::Snapshot)
+    // UDP 쪽 클라가 UDP_PEER_TIMEOUT_MS 동안 조용하면 풀고 TCP로 (다음 데이터그램이 오면 다시 묶음)
+    bool SendSnapshotFrame(const ByteBuffer& frame);
+    bool UdpBound() const { return _udpPeer.load(std::memory_order_relaxed) != 0; }
+
+    // UdpTransport 수신 스레드: token/주소 확인 -> peer 갱신 -> 입력 프레임 count개 dispatch (실패하면 false, 끊지는 않음)
+    bool OnUdpDatagram(uint64 token, uint64 peer, uint8 count, const Byte* frames, size_t len);
+
+    // RTT 추정값 (C_Pong 평활값, 없으면 마지막 TCP RTT 표본 / 0 = 아직 없음)
+    uint32 RttMs() const { return _rttMs.load(std::memory_order_relaxed); }
+    uint32 SrttUs() const { return _srttUs.load(std::memory_order_relaxed); }
+    uint32 RttVarUs() const { return _rttVarUs.load(std::memory_order_relaxed); }
+    int64 ClockOffsetUs() const { return _clockOffsetUs.load(std::memory_order_relaxed); }
+
+    // 이 세션 방의 tick 0 서버 시각 (스냅샷 인코더가 보낼 때마다 갱신, 다음 S_Ping에 실림)
+    void SetTickOrigin(uint64 originUs, uint32 tickUs)
+    {
+        _tickOriginUs.store(originUs, std::memory_order_relaxed);
+        _tickUs.store(tickUs, std::memory_order_relaxed);
+    }
+
+    // SessionIo 타이머 (IO_TIMER_MS마다, 0번 I/O 스레드 1개에서만): ping 시각이면 S_Ping, TCP RTT 조회
+    void OnIoTimer(uint64 nowMs);
+
+    // hot restart 인계 (HotRestart 전용)
+    // - Freeze: 보내던 프레임까지만 보내고 송신을 세움 (큐는 그대로, 수신은 계속 -> 입력은 RoomManager 큐로)
+    // - Thaw: 인계 실패 시 송신 재개
+    // - Detach: 새 프로세스가 소켓을 복제한 뒤 수신을 멈추고 포트에서 떼고 핸들만 닫음 (shutdown/FIN 없음, onClose 없음)
+    bool Freeze(std::chrono::steady_clock::time_point deadline);
+    void Thaw();
+    void Detach();
+    SOCKET Socket() const { return _sock; }
+
+    // 인계 상태: 프레임이 덜 된 수신 바이트 + 못 보낸 send 큐 + RTT/시계 추정값 (Detach 후 / Start 전에만)
+    void ExportState(ByteWriter& w) const;
+    bool ImportState(ByteReader& r);
 
 private:
-    void RecvLoop();
-	void SendLoop(); // send queue flush 뵵
+    friend class SessionIo;
+
+    // SessionIo 완료 스레드: ov로 수신/송신 구분
+    void OnIoCompleted(OVERLAPPED* ov, uint32 bytes, bool ok);
+
+    // 0바이트 WSARecv를 걺 (읽을 게 생기면 완료) -> 실패하면 EndRecv
+    void PostRecv(std::shared_ptr<Session> self);
+    void OnRecvReady(std::shared_ptr<Session> self, bool ok);
+
+    // 소켓에 쌓인 만큼 수신 블록에 읽고 프레임 dispatch (계속 받을 수 있으면 true)
+    bool ReadAvailable();
+    void EndRecv();
 
-    void OnRecv(const Byte* data, size_t len);
     void Dispatch(const Frame& frame);
 
-    bool SendAll(const Byte* data, size_t len);
-    void CloseSocket();
+    // 메시지 핸들러 (Dispatcher가 decode 후 호출)
+    template <typename, typename...> friend class Dispatcher;
+    void On(const C_Ping& msg);
+    void On(const C_Pong& msg);
+    void On(const C_UdpOpenReq& msg);
+    void On(const C_SpectateReq& msg);
+    void On(const C_MoveInput& msg);
+    void On(const C_CastSkill& msg);
+    void On(const C_ChoiceVote& msg);
+
+    // 송신: _sendMutex 안에서 다음 것을 _sending으로 (ping이 밀려 있으면 먼저) -> true면 락 밖에서 IssueSend
+    bool TakeNextSend();
+    uint32 DropQueuedSnapshots();   // _sendMutex 안에서, 버린 수
+    void IssueSend();
+    void OnSendCompleted(uint32 bytes, bool ok);
+
+    // S_Ping을 _pingFrame에 (IssueSend가 락 밖에서 보내기 직전에 -> 큐에서 기다린 시간은 RTT에 안 들어감)
+    void EncodePing();
+
+    // 보내는 중인 프레임 (ping이면 세션에 박힌 _pingFrame)
+    const Byte* SendingData() const;
+    size_t SendingSize() const;
+
+    struct SendNode;
+
+    // 큐 정책(스냅샷 대체)/예산 검사 후 넣고 보낼 차례면 WSASend (false면 node는 해제됨, dropped = 대체된 스냅샷 수)
+    bool Enqueue(SendNode* node, uint32& dropped);
+
+    // _sendMutex 안에서: 큐 뒤에 S_Disconnect를 넣고 닫는 중으로 (dropAll이면 reliable까지 버리고 그것만, 버린 수는 dropped)
+    // true면 락 밖에서 IssueSend
+    bool QueueDisconnect(DisconnectReason reason, bool dropAll, uint32& dropped);
+
+    // SIO_TCP_INFO로 커널 RTT 추정값 조회 (Windows 10 1703+, 실패하면 더 안 물어봄)
+    void SampleRtt(uint64 nowMs);
+
+    // 걸린 수신/송신을 깨우기 위한 shutdown + 취소만 (핸들 close는 소멸자에서 1회)
+    void ShutdownSocket();
+
+    // 로그 태그는 쓸 때만 만듦 (세션마다 문자열을 들고 있지 않음)
+    std::string Tag() const { return "Session #" + std::to_string(_id); }
 
 private:
     SessionId _id{ 0 };
-    OnCloseFn _onClose;
+    SessionIo* _io{ nullptr };                          // 소유 X
+    const OnCloseFn* _onClose{ nullptr };               // 소유 X
+    const SessionInputHooks* _inputHooks{ nullptr };    // 소유 X
 
     SOCKET _sock{ INVALID_SOCKET };
     std::atomic<bool> _running{ false };
+    std::atomic<bool> _shutdown{ false };
+
+    // 수신: 0바이트 WSARecv 1개. 걸려 있는 동안 _recvRef가 자기 참조 (완료 스레드가 꺼내서 다시 걸 때 돌려놓음)
+    WSAOVERLAPPED _recvOv{};
+    std::shared_ptr<Session> _recvRef;
+    std::atomic<bool> _recvPending{ false };   // 걸림 ~ 더 안 걸기로 한 완료 처리 끝까지
+    PacketFramer _framer;                       // 읽을 때만 블록을 붙임
+    bool _recvDiscard{ false };                 // 수신 스레드 전용: 프로토콜 오류로 S_Disconnect 중 -> 받은 건 버림
+
+    // Send queue: 노드에 next가 들어 있는 단일 연결 리스트 (빈 큐는 포인터 2개)
+    struct SendNode
+    {
+        SendNode* next = nullptr;
+        SendKind kind = SendKind::Reliable;
+        ByteBuffer bytes;
+        std::shared_ptr<const ByteBuffer> shared;   // 관전 릴레이 프레임 (있으면 bytes는 비어 있음)
+
+        const Byte* Data() const { return shared ? shared->data() : bytes.data(); }
+        size_t Size() const { return shared ? shared->size() : bytes.size(); }
+    };
+
+    mutable std::mutex _sendMutex;
+    SendNode* _sendHead{ nullptr };
+    SendNode* _sendTail{ nullptr };
+
+    // 아래는 모두 _sendMutex 보호
+    size_t _sendQBytes{ 0 };
+    uint32 _sendQFrames{ 0 };
+    uint64 _droppedSnapshots{ 0 };
+    uint64 _overflowEnqueues{ 0 };
+    bool _overflowing{ false };
+    bool _closing{ false };         // Disconnect: S_Disconnect가 나가면 RequestStop
+    bool _sendBusy{ false };        // WSASend 걸림 (_sending)
+    bool _sendingLast{ false };     // _sending이 S_Disconnect
+    bool _frozen{ false };          // 인계: 다음 프레임을 안 꺼냄
+    std::chrono::steady_clock::time_point _overflowSince{};
+    std::atomic<uint64> _closeByMs{ 0 };    // 닫는 중: 이 시각(ServerTimeUs ms)이 지나면 타이머가 끊음 (0 = 아님)
+
+    // 타이머가 락 없이 세움 -> 다음에 꺼낼 때 큐 맨 앞 프레임보다 먼저 (쉬고 있으면 타이머가 직접 시작)
+    std::atomic<bool> _pingDue{ false };
+
+    // 송신 중인 프레임 (완료 전까지 커널이 버퍼를 씀). 걸려 있는 동안 _sendRef가 자기 참조
+    // ping은 노드 없이 _pingFrame (할당 없음). _sending/_sendingPing/_pingFrame은 TakeNextSend로 넘겨받은 스레드만
+    WSAOVERLAPPED _sendOv{};
+    SendNode* _sending{ nullptr };
+    bool _sendingPing{ false };
+    std::array<Byte, FixedCodec<S_Ping>::FRAME_SIZE> _pingFrame{};
+    size_t _sendOffset{ 0 };
+    std::shared_ptr<Session> _sendRef;
+
+    // RTT (TCP 표본은 타이머 전용)
+    std::atomic<uint32> _rttMs{ 0 };
+    uint64 _nextRttSampleMs{ 0 };
+    bool _rttUnsupported{ false };
+
+    // 서버 ping: 보낸 시각은 seq % PING_RING_SIZE 슬롯에 (송신 시 기록, 수신 완료가 echo와 비교 후 0으로)
+    std::array<std::atomic<uint64>, PING_RING_SIZE> _pingSentUs{};
+    uint32 _pingSeq{ 0 };           // EncodePing 전용 (송신은 한 번에 1개)
+    uint64 _nextPingMs{ 0 };        // 타이머 전용
 
-    std::thread _recvThread;
-    std::thread _sendThread;
+    // SRTT/RTTVAR (RFC 6298 가중치) + 시계 오프셋: 수신 완료(세션당 한 번에 1개)만 쓰고 누구나 읽음
+    std::atomic<uint32> _srttUs{ 0 };
+    std::atomic<uint32> _rttVarUs{ 0 };
+    std::atomic<int64> _clockOffsetUs{ 0 };
+    uint32 _reportedRttMs{ 0 };     // 수신 완료 전용 (마지막으로 게임 레이어에 알린 값)
+    uint32 _reportedRttVarMs{ 0 };
 
-    PacketFramer _framer;
+    std::atomic<uint64> _tickOriginUs{ 0 };
+    std::atomic<uint32> _tickUs{ 0 };
 
-	// Send queue 
-    std::mutex _sendMutex;
-    std::condition_variable _sendCv;
-    std::deque<ByteBuffer> _sendQ;
+    // UDP 스냅샷 채널 (UdpTransport::PackPeer 형식, 0 = 안 묶임)
+    // token/주소는 수신 완료(C_UdpOpenReq)가 쓰고 UDP 수신 스레드가 읽음, peer는 인코더 스레드도 읽음
+    UdpTransport* _udp{ nullptr };  // 소유 X
+    std::atomic<uint64> _udpToken{ 0 };
+    std::atomic<uint32> _udpAddr{ 0 };          // TCP 상대 IPv4 (다른 주소에서 온 데이터그램은 거절)
+    std::atomic<uint64> _udpPeer{ 0 };
+    std::atomic<uint64> _udpLastRecvMs{ 0 };
+    std::atomic<uint32> _udpSeq{ 0 };
 
-    std::string _tag;
+    // hot restart 인계
+    std::atomic<bool> _detached{ false };   // 소켓이 새 프로세스로 넘어감 -> 수신이 끝나도 shutdown/onClose 안 함
 };
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <winsock2.h>
+
+#include "common/Types.h"
+#include "net/RecvBlockPool.h"
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+class Session;
+
+// 세션 I/O 완료 스레드 (IOCP): 세션마다 스레드를 두지 않고 SESSION_IO_THREADS개가 모든 세션을 처리
+// - 세션 소켓은 Session 포인터를 key로 포트에 붙음 (Session::Start)
+// - 수신은 0바이트 WSARecv로 "읽을 게 생김"만 기다림 -> 조용한 세션은 커널에 잠긴 버퍼도, 수신 블록도 없음
+// - 송신은 세션당 WSASend 1개만 걸어 둠 (완료되면 다음 프레임)
+// - 0번 스레드가 IO_TIMER_MS마다 타이머 콜백 (ping/RTT 조회, SessionManager가 세션을 돎)
+// - 수신 블록 풀(RecvBlockPool)도 여기 (완료 스레드들이 같이 씀)
+class SessionIo
+{
+public:
+    static constexpr uint32 IO_BATCH = 64;          // GetQueuedCompletionStatusEx 1번에 꺼내는 완료 수
+    static constexpr uint32 IO_TIMER_MS = 100;
+
+    using TimerFn = std::function<void(uint64 nowMs)>;
+
+    struct Stats
+    {
+        uint64 completions = 0;
+        uint64 wakeups = 0;
+    };
+
+public:
+    SessionIo();
+    ~SessionIo();
+
+    SessionIo(const SessionIo&) = delete;
+    SessionIo& operator=(const SessionIo&) = delete;
+
+    // Start 전에 (이후 변경 금지)
+    void SetTimer(TimerFn fn) { _timer = std::move(fn); }
+
+    bool Start(uint32 threads);
+
+    // 걸려 있는 완료는 버려짐 -> 세션이 모두 멈춘 뒤에 (SessionManager::StopAll 다음)
+    void Stop();
+
+    bool IsRunning() const { return _running.load(std::memory_order_relaxed); }
+
+    // 소켓을 포트에 붙임 (완료 key = session)
+    bool Associate(SOCKET sock, Session* session);
+
+    // hot restart: 넘길 소켓을 이 프로세스 포트에서 뗌 (같은 소켓이라 안 떼면 새 프로세스가 못 붙임)
+    // FileReplaceCompletionInformation (Windows 8.1+), 안 되면 false
+    static bool Disassociate(SOCKET sock);
+
+    RecvBlockPool& RecvPool() { return _recvPool; }
+
+    Stats TakeStats();
+
+private:
+    void WorkerLoop(uint32 index);
+    void LogStats();
+
+private:
+    HANDLE _port{ nullptr };
+    std::vector<std::thread> _threads;
+    std::atomic<bool> _running{ false };
+
+    TimerFn _timer;
+    RecvBlockPool _recvPool;
+
+    std::atomic<uint64> _completions{ 0 };
+    std::atomic<uint64> _wakeups{ 0 };
+
+    std::string _tag;
+};
\ No newline at end of file
@@ -1,42 +1,138 @@
 #pragma once
 #include <winsock2.h>
 
+#include "common/EpochManager.h"
+#include "common/SlotMap.h"
+#include "net/Session.h"
+#include "net/SessionIo.h"
+
 #include <atomic>
+#include <functional>
 #include <memory>
 #include <mutex>
-#include <unordered_map>
 #include <vector>
 
-class Session;
-
 class SessionManager
 {
 public:
-    using SessionId = uint64_t;
+    // SessionId 레이아웃: [gen:32][shard:8][slot:24]
+    // - gen >= 1 이므로 0은 항상 무효 id
+    static constexpr uint32 SHARD_COUNT = 16;
+    static constexpr uint32 SLOT_BITS = 24;
+    static constexpr uint32 MAX_SLOTS_PER_SHARD = 1u << SLOT_BITS;
+
+    // 세션 등록/제거 통지 (게임 레이어 연결용)
+    // - opened: CreateAndAdd 호출 스레드(accept), closed: SessionIo 완료 스레드에서 호출됨
+    using SessionEventFn = std::function<void(SessionId)>;
 
 public:
-    SessionManager() = default;
+    // SessionIo 완료 스레드 시작 (세션 ping/RTT 타이머 포함)
+    SessionManager();
     ~SessionManager();
 
-    // accept    + 
+    // Acceptor 시작 전에 한 번만 설정 (이후 변경 금지, 락 없이 읽음)
+    void SetSessionHooks(SessionEventFn onOpened, SessionEventFn onClosed);
+    void SetInputHooks(SessionInputHooks hooks);
+    void SetUdpTransport(UdpTransport* udp);    // --udp일 때만 (없으면 C_UdpOpenReq에 ok=0)
+
+    // accept된 소켓으로 세션 생성 + 등록 (슬롯 고갈 시 nullptr)
     std::shared_ptr<Session> CreateAndAdd(SOCKET clientSock);
 
-    // Session onClose ȣ: ̳ʿ 
+    // hot restart 인계: 이전 프로세스 세션을 같은 id로 등록 (방에 이미 있으므로 opened 훅 없음)
+    // Start는 호출부가 인계 상태를 넣은 뒤에. 그 id 자리가 차 있으면 nullptr (소켓은 닫힘)
+    std::shared_ptr<Session> Adopt(SOCKET clientSock, SessionId id);
+
+    // Session에서 onClose로 호출: 컨테이너에서 제거 + epoch retire
     void Remove(SessionId id);
 
-    //    ü (ܺ 忡 ȣ)
+    // stale id(이미 제거된 세션)는 nullptr
+    std::shared_ptr<Session> Find(SessionId id) const;
+
+    // refcount/락 없는 조회 (슬롯 표 읽기 + id 세대 비교). 반드시 EpochGuard 구간 안에서 호출, 반환 포인터도 그 안에서만 유효
+    Session* Lookup(SessionId id) const;
+
+    // tick/I-O 스레드가 raw 포인터를 들고 있으려면 여기에 참가자 등록 후 EpochGuard 사용
+    EpochManager& Epoch() { return _epoch; }
+
+    // 브로드캐스트용 순회: 샤드별 dense 배열을 샤드 락 안에서 순회
+    // fn 안에서 Remove/CreateAndAdd 호출 금지 (같은 샤드 락 재진입)
+    template <typename Fn>
+    void ForEach(Fn&& fn) const
+    {
+        for (const Shard& shard : _shards)
+        {
+            std::lock_guard<std::mutex> lock(shard.mtx);
+            for (const auto& s : shard.sessions.Values())
+                fn(*s);
+        }
+    }
+
+    // 과부하 감시용: 세션 수와 send 큐가 backlogBytes를 넘게 쌓인 세션 수 (샤드 락 + 세션 send 락을 차례로 잡음)
+    void SampleSendQueues(size_t backlogBytes, uint32& sessions, uint32& backlogged) const;
+
+    // 서버 종료 시 전체 종료(외부 스레드에서 호출)
     void StopAll();
 
-    size_t Count() const;
+    // 수신 블록 풀 사용량 (--bench-idle)
+    RecvBlockPool::Stats RecvPoolStats() { return _io.RecvPool().GetStats(); }
+
+    size_t Count() const { return _count.load(std::memory_order_relaxed); }
+
+    // retire된 세션 중 reader가 더 이상 볼 수 없는 것 해제 (소켓도 세션 소멸자에서 닫힘)
+    // 회수 시점: SessionIo 타이머(IO_TIMER_MS마다) + CreateAndAdd/Remove 끝
+    // -> Remove 때 다른 reader가 EpochGuard 안이라 못 풀었어도 접속/종료가 더 없을 때 타이머가 마저 풂
+    void Collect() { _epoch.Collect(); }
 
-    void ReapClosed();
+private:
+    using Handle = SlotMap<std::shared_ptr<Session>>::Handle;
+
+    // Lookup 슬롯 표: 청크 단위로 처음 쓰일 때 만들고 소멸자까지 유지 (읽는 쪽이 락 없이 따라감)
+    static constexpr uint32 DIR_CHUNK_BITS = 12;
+    static constexpr uint32 DIR_CHUNK_SLOTS = 1u << DIR_CHUNK_BITS;
+    static constexpr uint32 DIR_CHUNKS = MAX_SLOTS_PER_SHARD >> DIR_CHUNK_BITS;
+    using DirChunk = std::atomic<Session*>;
+
+    static SessionId MakeId(uint32 shard, Handle h);
+    static uint32 ShardOf(SessionId id);
+    static Handle HandleOf(SessionId id);
+
+    // SessionIo 타이머: 샤드별로 세션 포인터를 락 안에서 복사, 락 밖에서 ping/RTT 차례 확인 + 끝에 Collect (retire된 세션 회수 시점)
+    void OnIoTimer(uint64 nowMs);
+
+    struct Shard;
+
+    // 샤드 락 안에서: 슬롯 표 갱신 (nullptr = 비움, 비우고 나서 retire)
+    static void Publish(Shard& shard, SessionId id, Session* session);
 
 private:
-    mutable std::mutex _mtx;
-    std::unordered_map<SessionId, std::shared_ptr<Session>> _sessions;
+    // 세션 I/O 완료 스레드 (세션들보다 늦게 멈춤 -> 소멸자에서 StopAll 다음)
+    SessionIo _io;
+    Session::OnCloseFn _removeFn;   // 세션들이 포인터로 참조
+
+    // 샤드마다 락/슬롯맵을 따로 둬서 로그인/대량 종료 시 경합 분산
+    struct alignas(64) Shard
+    {
+        mutable std::mutex mtx;
+        SlotMap<std::shared_ptr<Session>> sessions{ MAX_SLOTS_PER_SHARD };
+
+        // slot -> 세션 (슬롯맵 값과 같은 것, 쓰기는 락 안에서만)
+        std::atomic<DirChunk*> dir[DIR_CHUNKS]{};
+    };
+
+    Shard _shards[SHARD_COUNT];
+
+    std::atomic<uint32> _nextShard{ 0 };
+    std::atomic<size_t> _count{ 0 };
+
+    SessionEventFn _onOpened;
+    SessionEventFn _onClosed;
+    SessionInputHooks _inputHooks;  // 세션들이 포인터로 참조
+    UdpTransport* _udp{ nullptr };  // 소유 X
+
+    // 제거된 세션의 회수 시점 관리 (reaper 스레드 대체)
+    EpochManager _epoch;
 
-    std::atomic<SessionId> _idGen{ 0 };
-    
-    //  
-    std::vector<std::shared_ptr<Session>> _zombies;
+    // OnIoTimer 전용 (SessionIo 0번 스레드만): epoch 참가자 + 샤드 하나의 세션 포인터 버퍼 (재사용)
+    EpochManager::ParticipantId _timerPid{ EpochManager::INVALID_PARTICIPANT };
+    std::vector<Session*> _timerSessions;
 };
\ No newline at end of file
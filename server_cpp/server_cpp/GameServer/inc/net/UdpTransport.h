@@ -0,0 +1,93 @@
+#pragma once
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+#include "common/Types.h"
+
+#include <atomic>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+
+class SessionManager;
+
+// 스냅샷용 UDP 채널 (--udp, TCP와 같은 포트 번호)
+// - TCP 세션에서 C_UdpOpenReq -> token 발급, 클라가 token을 실은 데이터그램을 보내면 그 주소로 묶임
+// - S->C: [u32 seq][스냅샷 프레임] 1개씩, 재전송 없음 (최신 것만 의미 -> 유실돼도 다음 스냅샷이 덮음)
+//   TCP처럼 세그먼트 하나 유실로 뒤 스냅샷이 전부 막히는 일(HOL)이 없음
+// - C->S: [u64 sessionId][u64 token][u8 count][프레임 x count] (TCP와 같은 [len][msgId][payload])
+//   입력은 클라가 아직 확인 못 받은(스냅샷 lastInputSeq 이후) 것을 매번 다 실어 보냄 -> 중복은 jitter buffer가 버림
+// - 인증/이벤트/응답은 계속 TCP. 클라가 UDP_PEER_TIMEOUT_MS 동안 조용하면 스냅샷도 TCP로 돌아감
+class UdpTransport
+{
+public:
+    static constexpr uint32 UDP_PEER_TIMEOUT_MS = 3000;     // 클라는 1초마다 빈 데이터그램이라도 보내야 함
+    static constexpr int UDP_POLL_TIMEOUT_MS = 100;         // Stop 감지 주기
+    static constexpr size_t UDP_MAX_RECV = 1400;            // C->S 데이터그램 한도 (넘으면 버림)
+    static constexpr size_t UDP_SEND_HEADER = 4;
+    static constexpr size_t UDP_MAX_SEND = UDP_SEND_HEADER + MAX_FRAME_TOTAL;   // MTU를 넘으면 IP 단편화 (조각 하나 유실 = 스냅샷 유실)
+    static constexpr size_t UDP_RECV_HEADER = 17;
+    static constexpr int UDP_SOCKET_BUFFER = 4 * 1024 * 1024;
+
+    struct Stats
+    {
+        uint64 datagramsIn = 0;
+        uint64 rejected = 0;        // 크기/token/주소 불일치, 모르는 세션
+        uint64 snapshotsOut = 0;
+        uint64 sendFailed = 0;
+        uint64 bytesOut = 0;
+    };
+
+public:
+    explicit UdpTransport(SessionManager* mgr);
+    ~UdpTransport();
+
+    UdpTransport(const UdpTransport&) = delete;
+    UdpTransport& operator=(const UdpTransport&) = delete;
+
+    // bindWaitMs: 포트가 아직 잡혀 있으면 이만큼 재시도 (hot restart: 이전 프로세스가 놓을 때까지)
+    bool Start(uint16 port, uint32 bindWaitMs = 0);
+    void Stop();
+
+    bool IsRunning() const { return _running.load(std::memory_order_relaxed); }
+    uint16 Port() const { return _port; }
+
+    // 세션별 비밀값 (0은 안 나옴)
+    uint64 MakeToken();
+
+    // 스냅샷 1개 전송 (스택 버퍼, 할당 없음). 인코더 스레드 여럿이 동시에 불러도 됨
+    // peer = PackPeer 값
+    bool SendSnapshot(uint64 peer, uint32 seq, const ByteBuffer& frame);
+
+    // IPv4 주소 + 포트 -> 원자 변수 하나에 (0 = 없음)
+    static uint64 PackPeer(const sockaddr_in& addr) { return ((uint64)addr.sin_addr.s_addr << 16) | (uint64)addr.sin_port; }
+    static uint32 PeerAddr(uint64 peer) { return (uint32)(peer >> 16); }
+
+    Stats TakeStats();
+
+private:
+    void RecvLoop();
+    bool OpenSocket(uint16 port);
+    void HandleDatagram(const Byte* data, size_t len, const sockaddr_in& from, uint32 pid);
+    void LogStats();
+
+private:
+    SessionManager* _sessionMgr{ nullptr };    // 소유 X
+
+    std::atomic<bool> _running{ false };
+    SOCKET _sock{ INVALID_SOCKET };
+    uint16 _port{ 0 };
+    std::thread _recvThread;
+
+    std::mutex _tokenMutex;
+    std::mt19937_64 _tokenRng;
+
+    std::atomic<uint64> _datagramsIn{ 0 };
+    std::atomic<uint64> _rejected{ 0 };
+    std::atomic<uint64> _snapshotsOut{ 0 };
+    std::atomic<uint64> _sendFailed{ 0 };
+    std::atomic<uint64> _bytesOut{ 0 };
+
+    std::string _tag;
+};
\ No newline at end of file
@@ -0,0 +1,308 @@
+#pragma once
+
+#include "common/ByteIO.h"
+#include "proto/Protocol.h"
+
+#include <array>
+#include <tuple>
+#include <type_traits>
+
+// 스키마(Fields()) -> 고정 레이아웃 인코더/디코더
+// - wire 크기는 컴파일 타임 상수, 필드 오프셋도 상수로 접힘
+// - decode 시 길이 검사는 메시지당 1번 (필드마다 CanRead 안함)
+
+template <typename T> struct MemberTypeOf;
+template <typename C, typename T> struct MemberTypeOf<T C::*> { using type = T; };
+
+template <typename T>
+constexpr size_t WireSizeOf()
+{
+    static_assert(std::is_arithmetic<T>::value, "unsupported wire field type");
+    return sizeof(T);
+}
+
+template <typename... Ms>
+constexpr size_t FieldsWireSize(const std::tuple<Ms...>&)
+{
+    return (WireSizeOf<typename MemberTypeOf<Ms>::type>() + ... + 0);
+}
+
+template <typename Msg>
+struct FixedCodec
+{
+    static constexpr size_t SIZE = FieldsWireSize(Msg::Fields());
+    static_assert(4 + SIZE <= MAX_FRAME_TOTAL, "message exceeds MAX_FRAME_TOTAL");
+
+    // out은 SIZE 바이트 이상 보장
+    static void Encode(const Msg& m, Byte* out)
+    {
+        std::apply([&](auto... f) {
+            size_t off = 0;
+            ((StoreLE(out + off, m.*f), off += sizeof(m.*f)), ...);
+            }, Msg::Fields());
+    }
+
+    static void DecodeUnchecked(const Byte* in, Msg& m)
+    {
+        std::apply([&](auto... f) {
+            size_t off = 0;
+            ((m.*f = LoadLE<std::decay_t<decltype(m.*f)>>(in + off), off += sizeof(m.*f)), ...);
+            }, Msg::Fields());
+    }
+
+    // payload 길이가 정확히 SIZE여야 함 (남거나 모자라면 malformed)
+    static bool Decode(const Byte* in, size_t len, Msg& m)
+    {
+        if (len != SIZE) return false;
+        DecodeUnchecked(in, m);
+        return true;
+    }
+
+    static void Encode(const Msg& m, ByteWriter& w)
+    {
+        Encode(m, w.Grow(SIZE));
+    }
+
+    // 헤더 포함 완성 프레임을 호출부 버퍼에 (스택 버퍼로 보내면 할당 없음)
+    static constexpr size_t FRAME_SIZE = 4 + SIZE;
+
+    static void EncodeFrame(const Msg& m, Byte* out)
+    {
+        StoreLE<uint16>(out, (uint16)(2 + SIZE));
+        StoreLE<uint16>(out + 2, Msg::ID);
+        Encode(m, out + 4);
+    }
+
+    // 메모리 레이아웃 == wire 레이아웃 (패딩 없음 + LE 호스트)이면 배열을 통째로 복사 가능
+    static constexpr bool MEMCPY_LAYOUT = HOST_LITTLE_ENDIAN
+        && std::is_trivially_copyable<Msg>::value
+        && sizeof(Msg) == SIZE;
+
+    // 같은 타입 레코드 n개를 연속 기록 (out은 n * SIZE 바이트 이상)
+    static void EncodeArray(const Msg* recs, size_t n, Byte* out)
+    {
+        if constexpr (MEMCPY_LAYOUT)
+        {
+            if (n > 0)
+                std::memcpy(out, recs, n * SIZE);
+        }
+        else
+        {
+            for (size_t i = 0; i < n; ++i, out += SIZE)
+                Encode(recs[i], out);
+        }
+    }
+
+    static void DecodeArray(const Byte* in, size_t n, Msg* recs)
+    {
+        if constexpr (MEMCPY_LAYOUT)
+        {
+            if (n > 0)
+                std::memcpy(recs, in, n * SIZE);
+        }
+        else
+        {
+            for (size_t i = 0; i < n; ++i, in += SIZE)
+                DecodeUnchecked(in, recs[i]);
+        }
+    }
+};
+
+// 기본: 고정 길이 메시지
+template <typename Msg>
+struct Codec : FixedCodec<Msg> {};
+
+// ---- 가변 길이 메시지 ------------------------------------------------------
+
+// 수신 측 뷰: entry는 인덱스로 그때그때 decode (할당 없음)
+struct S_SnapshotView
+{
+    uint32 serverTick = 0;
+    uint8 playerCount = 0;
+    uint8 enemyCount = 0;
+    SegmentState segmentState = SegmentState::InSegment;
+    uint8 tickInterval = 1;
+    uint8 snapshotInterval = 0;
+
+    const Byte* playerBytes = nullptr;
+    const Byte* enemyBytes = nullptr;
+
+    SnapshotPlayer Player(size_t i) const
+    {
+        SnapshotPlayer p;
+        FixedCodec<SnapshotPlayer>::DecodeUnchecked(playerBytes + i * FixedCodec<SnapshotPlayer>::SIZE, p);
+        return p;
+    }
+
+    SnapshotEnemy Enemy(size_t i) const
+    {
+        SnapshotEnemy e;
+        FixedCodec<SnapshotEnemy>::DecodeUnchecked(enemyBytes + i * FixedCodec<SnapshotEnemy>::SIZE, e);
+        return e;
+    }
+};
+
+template <>
+struct Codec<S_Snapshot>
+{
+    static constexpr size_t PLAYER_SIZE = FixedCodec<SnapshotPlayer>::SIZE;
+    static constexpr size_t ENEMY_SIZE = FixedCodec<SnapshotEnemy>::SIZE;
+
+    // server_tick(4) + player_count(1) + enemy_count(1) + segment_state(1) + tick_interval(1) + snapshot_interval(1)
+    static constexpr size_t HEADER_SIZE = 4 + 1 + 1 + 1 + 1 + 1;
+
+    static size_t PayloadSize(uint8 playerCount, uint8 enemyCount)
+    {
+        return HEADER_SIZE + playerCount * PLAYER_SIZE + enemyCount * ENEMY_SIZE;
+    }
+
+    // 프레임 한도(MAX_FRAME_TOTAL)를 넘으면 false (엔티티 선별은 호출부 책임)
+    static bool Encode(const S_Snapshot& m, ByteWriter& w)
+    {
+        const size_t size = PayloadSize(m.playerCount, m.enemyCount);
+        if (4 + size > MAX_FRAME_TOTAL) return false;
+
+        EncodePayload(m, w.Grow(size));
+        return true;
+    }
+
+    // 헤더까지 포함한 완성 프레임을 할당 1번으로 (BuildFrame의 payload 복사 생략)
+    static bool EncodeFrame(const S_Snapshot& m, ByteBuffer& outFrame)
+    {
+        const size_t size = PayloadSize(m.playerCount, m.enemyCount);
+        if (4 + size > MAX_FRAME_TOTAL) return false;
+
+        outFrame.resize(4 + size);
+        StoreLE<uint16>(outFrame.data(), (uint16)(2 + size));
+        StoreLE<uint16>(outFrame.data() + 2, S_Snapshot::ID);
+        EncodePayload(m, outFrame.data() + 4);
+        return true;
+    }
+
+    static void EncodePayload(const S_Snapshot& m, Byte* out)
+    {
+        StoreLE<uint32>(out, m.serverTick);
+        out += 4;
+
+        *out++ = m.playerCount;
+        FixedCodec<SnapshotPlayer>::EncodeArray(m.players, m.playerCount, out);
+        out += m.playerCount * PLAYER_SIZE;
+
+        *out++ = m.enemyCount;
+        FixedCodec<SnapshotEnemy>::EncodeArray(m.enemies, m.enemyCount, out);
+        out += m.enemyCount * ENEMY_SIZE;
+
+        *out++ = (uint8)m.segmentState;
+        *out++ = m.tickInterval;
+        *out++ = m.snapshotInterval;
+    }
+
+    static bool Decode(const Byte* in, size_t len, S_SnapshotView& v)
+    {
+        // 가변 부분이 두 군데라 count를 읽을 때마다 한 번씩만 검사
+        if (len < HEADER_SIZE) return false;
+
+        v.serverTick = LoadLE<uint32>(in);
+        v.playerCount = in[4];
+
+        const size_t enemyCountAt = 5 + v.playerCount * PLAYER_SIZE;
+        if (len < enemyCountAt + 1 + 1) return false;
+
+        v.enemyCount = in[enemyCountAt];
+        if (len != PayloadSize(v.playerCount, v.enemyCount)) return false;
+
+        v.playerBytes = in + 5;
+        v.enemyBytes = in + enemyCountAt + 1;
+        v.segmentState = (SegmentState)in[len - 3];
+        v.tickInterval = in[len - 2];
+        v.snapshotInterval = in[len - 1];
+        return true;
+    }
+};
+
+// ---- 디스패치 --------------------------------------------------------------
+
+enum class DispatchResult
+{
+    Ok,
+    UnknownMsg,
+    Malformed
+};
+
+// msgId -> (decode + Handler::On(msg)) 점프 테이블
+// - 테이블 크기/인덱스(msgId % MOD)는 컴파일 타임에 충돌 없게 결정 -> 조회 O(1), if 체인 없음
+// - Handler는 등록한 메시지마다 void On(const Msg&) 제공
+template <typename Handler, typename... Msgs>
+class Dispatcher
+{
+public:
+    static DispatchResult Dispatch(Handler& h, MsgId id, const Byte* payload, size_t len)
+    {
+        const Entry& e = TABLE[id % MOD];
+        if (e.fn == nullptr || e.id != id)
+            return DispatchResult::UnknownMsg;
+
+        return e.fn(h, payload, len) ? DispatchResult::Ok : DispatchResult::Malformed;
+    }
+
+private:
+    using Fn = bool (*)(Handler&, const Byte*, size_t);
+
+    struct Entry
+    {
+        MsgId id;
+        Fn fn;
+    };
+
+    template <typename Msg>
+    static bool Invoke(Handler& h, const Byte* payload, size_t len)
+    {
+        Msg m{};
+        if (!Codec<Msg>::Decode(payload, len, m))
+            return false;
+
+        h.On(m);
+        return true;
+    }
+
+    static constexpr size_t COUNT = sizeof...(Msgs);
+    static constexpr MsgId IDS[] = { Msgs::ID... };
+
+    // 모든 id가 서로 다른 칸에 떨어지는 가장 작은 MOD
+    static constexpr size_t FindModulus()
+    {
+        for (size_t mod = COUNT; mod <= 4 * COUNT + 64; ++mod)
+        {
+            bool ok = true;
+            for (size_t i = 0; i < COUNT && ok; ++i)
+                for (size_t j = i + 1; j < COUNT && ok; ++j)
+                    ok = (IDS[i] % mod) != (IDS[j] % mod);
+
+            if (ok) return mod;
+        }
+        return 0;
+    }
+
+    static constexpr size_t MOD = FindModulus();
+    static_assert(MOD != 0, "duplicate msg id in Dispatcher");
+
+    static constexpr std::array<Entry, MOD> MakeTable()
+    {
+        std::array<Entry, MOD> t{};
+        const Entry entries[] = { Entry{ Msgs::ID, &Invoke<Msgs> }... };
+        for (const Entry& e : entries)
+            t[e.id % MOD] = e;
+        return t;
+    }
+
+    static constexpr std::array<Entry, MOD> TABLE = MakeTable();
+};
+
+// 고정 길이 메시지를 완성 프레임으로 (header + payload 한 번에)
+template <typename Msg>
+inline ByteBuffer BuildFrame(const Msg& m)
+{
+    std::array<Byte, FixedCodec<Msg>::SIZE> payload;
+    FixedCodec<Msg>::Encode(m, payload.data());
+    return BuildFrame(Msg::ID, payload.data(), payload.size());
+}
\ No newline at end of file
@@ -0,0 +1,278 @@
+#pragma once
+
+#include "common/Types.h"
+
+#include <cstddef>
+#include <tuple>
+
+// docs/protocol_v0.md 메시지 스키마
+// - 고정 길이 메시지는 Fields()에 wire 순서대로 멤버를 나열하면 Codec이 인코더/디코더를 만들어줌
+// - 가변 길이 메시지(bytes/repeated)는 proto/Codec.h에서 Codec 특수화
+
+namespace MsgIds
+{
+    constexpr MsgId C_TicketAuthReq = 1001;
+    constexpr MsgId S_TicketAuthRes = 1002;
+    constexpr MsgId C_Ping = 1101;
+    constexpr MsgId S_Pong = 1102;
+    constexpr MsgId S_Ping = 1103;
+    constexpr MsgId C_Pong = 1104;
+    constexpr MsgId C_UdpOpenReq = 1201;
+    constexpr MsgId S_UdpOpenRes = 1202;
+    constexpr MsgId S_UdpBound = 1203;
+    constexpr MsgId C_SpectateReq = 1301;
+    constexpr MsgId S_SpectateRes = 1302;
+    constexpr MsgId C_MoveInput = 2001;
+    constexpr MsgId C_CastSkill = 2002;
+    constexpr MsgId C_ChoiceVote = 2003;
+    constexpr MsgId S_Snapshot = 3001;
+    constexpr MsgId S_Disconnect = 9001;
+}
+
+enum class SegmentState : uint8
+{
+    InSegment = 0,
+    Clear = 1,
+    Choice = 2,
+    Transition = 3
+};
+
+enum class AuthFailReason : uint16
+{
+    None = 0,
+    Invalid = 1,
+    Expired = 2,
+    ServerError = 3
+};
+
+enum class DisconnectReason : uint16
+{
+    None = 0,
+    ProtocolError = 1,
+    SlowConsumer = 2,
+    ServerShutdown = 3,
+    Overloaded = 4,
+    RoomClosed = 5      // 관전하던 방이 없어짐 (관전 세션만)
+};
+
+// ---- 1001 / 1002 ---------------------------------------------------------
+
+// C_TicketAuthReq(1001)는 인증 서비스 연동 전까지 받지 않음 (id만 예약, 오면 모르는 msg로 끊김)
+// 연동할 때 ticket view 디코더(Codec 특수화)와 Session 핸들러를 같이 추가
+
+struct S_TicketAuthRes
+{
+    static constexpr MsgId ID = MsgIds::S_TicketAuthRes;
+
+    uint8 ok = 0;
+    uint16 reason = 0;
+    uint64 userId = 0;
+
+    static constexpr auto Fields() { return std::make_tuple(&S_TicketAuthRes::ok, &S_TicketAuthRes::reason, &S_TicketAuthRes::userId); }
+};
+
+// ---- 1101 / 1102 / 1103 / 1104 -------------------------------------------
+
+struct C_Ping
+{
+    static constexpr MsgId ID = MsgIds::C_Ping;
+
+    uint32 seq = 0;
+
+    static constexpr auto Fields() { return std::make_tuple(&C_Ping::seq); }
+};
+
+struct S_Pong
+{
+    static constexpr MsgId ID = MsgIds::S_Pong;
+
+    uint32 seq = 0;
+
+    static constexpr auto Fields() { return std::make_tuple(&S_Pong::seq); }
+};
+
+// 서버가 먼저 보내는 ping (세션마다 PING_INTERVAL_MS) -> 클라는 C_Pong으로 바로 응답
+// - 시각은 모두 서버 시계(us, 단조 증가, 프로세스 재시작/인계에도 같은 축)
+// - clockOffsetUs = 서버 시계 - 클라 시계 (srttUs == 0이면 아직 표본 없음)
+// - 방 tick T의 서버 시각 = tickOriginUs + T * tickUs (tickOriginUs == 0이면 아직 방 스냅샷 없음)
+struct S_Ping
+{
+    static constexpr MsgId ID = MsgIds::S_Ping;
+
+    uint32 seq = 0;
+    uint64 serverTimeUs = 0;
+    uint32 srttUs = 0;          // 서버가 추정한 평활 RTT
+    uint32 rttVarUs = 0;        // RTT 편차 (지터)
+    int64 clockOffsetUs = 0;
+    uint64 tickOriginUs = 0;
+    uint32 tickUs = 0;
+
+    static constexpr auto Fields() { return std::make_tuple(&S_Ping::seq, &S_Ping::serverTimeUs, &S_Ping::srttUs, &S_Ping::rttVarUs, &S_Ping::clockOffsetUs, &S_Ping::tickOriginUs, &S_Ping::tickUs); }
+};
+
+struct C_Pong
+{
+    static constexpr MsgId ID = MsgIds::C_Pong;
+
+    uint32 seq = 0;             // S_Ping.seq 그대로
+    uint64 serverTimeUs = 0;    // S_Ping.serverTimeUs 그대로 (서버는 ping별 상태를 따로 안 들고 이 값으로 RTT 계산)
+    uint64 clientTimeUs = 0;    // S_Ping을 받은 시점의 클라 시계
+
+    static constexpr auto Fields() { return std::make_tuple(&C_Pong::seq, &C_Pong::serverTimeUs, &C_Pong::clientTimeUs); }
+};
+
+// ---- 1201 / 1202 / 1203 --------------------------------------------------
+
+// UDP 스냅샷 채널 협상 (TCP로). 서버가 --udp로 떠 있을 때만 ok
+// 클라는 token을 실은 데이터그램을 보내서 주소를 묶음 -> S_UdpBound 이후 스냅샷은 UDP로
+struct C_UdpOpenReq
+{
+    static constexpr MsgId ID = MsgIds::C_UdpOpenReq;
+
+    uint8 version = 1;
+
+    static constexpr auto Fields() { return std::make_tuple(&C_UdpOpenReq::version); }
+};
+
+struct S_UdpOpenRes
+{
+    static constexpr MsgId ID = MsgIds::S_UdpOpenRes;
+
+    uint8 ok = 0;
+    uint16 port = 0;
+    uint64 token = 0;       // 세션별 비밀값 (데이터그램 인증)
+
+    static constexpr auto Fields() { return std::make_tuple(&S_UdpOpenRes::ok, &S_UdpOpenRes::port, &S_UdpOpenRes::token); }
+};
+
+struct S_UdpBound
+{
+    static constexpr MsgId ID = MsgIds::S_UdpBound;
+
+    uint16 maxDatagram = 0; // 서버가 보낼 수 있는 가장 큰 데이터그램 (스냅샷 프레임 + 헤더)
+
+    static constexpr auto Fields() { return std::make_tuple(&S_UdpBound::maxDatagram); }
+};
+
+// ---- 1301 / 1302 ---------------------------------------------------------
+
+// 관전 요청 (관전 포트로 붙은 세션만, 게임 포트 세션이 보내면 무시)
+// 이후 그 방 스냅샷이 SPECTATOR_DELAY_MS 늦게 옴 (입력 메시지는 무시)
+struct C_SpectateReq
+{
+    static constexpr MsgId ID = MsgIds::C_SpectateReq;
+
+    uint32 roomId = 0;      // 0 = 서버가 고른 방 (지금 인원이 가장 많은 방)
+
+    static constexpr auto Fields() { return std::make_tuple(&C_SpectateReq::roomId); }
+};
+
+struct S_SpectateRes
+{
+    static constexpr MsgId ID = MsgIds::S_SpectateRes;
+
+    uint8 ok = 0;           // 0 = 볼 방 없음
+    uint32 roomId = 0;
+    uint16 delayMs = 0;     // 스냅샷이 실제보다 늦은 시간
+
+    static constexpr auto Fields() { return std::make_tuple(&S_SpectateRes::ok, &S_SpectateRes::roomId, &S_SpectateRes::delayMs); }
+};
+
+// ---- 2001 / 2002 / 2003 --------------------------------------------------
+
+struct C_MoveInput
+{
+    static constexpr MsgId ID = MsgIds::C_MoveInput;
+
+    uint32 seq = 0;
+    int8 dirX = 0;
+    int8 dirY = 0;
+    uint16 dtMs = 0;
+
+    static constexpr auto Fields() { return std::make_tuple(&C_MoveInput::seq, &C_MoveInput::dirX, &C_MoveInput::dirY, &C_MoveInput::dtMs); }
+};
+
+struct C_CastSkill
+{
+    static constexpr MsgId ID = MsgIds::C_CastSkill;
+
+    uint32 seq = 0;
+    uint16 skillId = 0;
+    float targetX = 0.f;
+    float targetY = 0.f;
+    uint32 viewTick = 0;    // 시전 시점에 클라가 보고 있던 스냅샷 server_tick (lag compensation)
+
+    static constexpr auto Fields() { return std::make_tuple(&C_CastSkill::seq, &C_CastSkill::skillId, &C_CastSkill::targetX, &C_CastSkill::targetY, &C_CastSkill::viewTick); }
+};
+
+// CHOICE 구간에서 다음 구간 선택 투표 (다른 상태에서는 무시)
+struct C_ChoiceVote
+{
+    static constexpr MsgId ID = MsgIds::C_ChoiceVote;
+
+    uint32 seq = 0;
+    uint8 choice = 0;       // 0 ~ SEGMENT_CHOICE_OPTIONS-1
+
+    static constexpr auto Fields() { return std::make_tuple(&C_ChoiceVote::seq, &C_ChoiceVote::choice); }
+};
+
+// ---- 3001 ----------------------------------------------------------------
+
+// entry는 wire 레이아웃과 메모리 레이아웃을 일치시킴 (pack 1, Fields() 순서 = 선언 순서)
+// -> LE 호스트에서 배열 통째로 memcpy 인코딩/디코딩 가능 (Codec::EncodeArray)
+#pragma pack(push, 1)
+struct SnapshotPlayer
+{
+    uint64 id = 0;
+    float x = 0.f;
+    float y = 0.f;
+    uint16 hp = 0;
+    uint8 state = 0;
+    uint32 lastInputSeq = 0;    // 서버가 마지막으로 처리한 입력 seq (클라 reconcile용)
+
+    static constexpr auto Fields() { return std::make_tuple(&SnapshotPlayer::id, &SnapshotPlayer::x, &SnapshotPlayer::y, &SnapshotPlayer::hp, &SnapshotPlayer::state, &SnapshotPlayer::lastInputSeq); }
+};
+
+struct SnapshotEnemy
+{
+    uint32 id = 0;
+    float x = 0.f;
+    float y = 0.f;
+    uint16 hp = 0;
+    uint8 state = 0;
+
+    static constexpr auto Fields() { return std::make_tuple(&SnapshotEnemy::id, &SnapshotEnemy::x, &SnapshotEnemy::y, &SnapshotEnemy::hp, &SnapshotEnemy::state); }
+};
+#pragma pack(pop)
+
+static_assert(offsetof(SnapshotPlayer, x) == 8 && offsetof(SnapshotPlayer, y) == 12
+    && offsetof(SnapshotPlayer, hp) == 16 && offsetof(SnapshotPlayer, state) == 18
+    && offsetof(SnapshotPlayer, lastInputSeq) == 19, "SnapshotPlayer layout must match wire");
+static_assert(offsetof(SnapshotEnemy, x) == 4 && offsetof(SnapshotEnemy, y) == 8
+    && offsetof(SnapshotEnemy, hp) == 12 && offsetof(SnapshotEnemy, state) == 14, "SnapshotEnemy layout must match wire");
+
+// 가변 길이: 인코딩 입력은 배열 포인터 + 개수 (호출부 소유)
+struct S_Snapshot
+{
+    static constexpr MsgId ID = MsgIds::S_Snapshot;
+
+    uint32 serverTick = 0;
+    const SnapshotPlayer* players = nullptr;
+    uint8 playerCount = 0;
+    const SnapshotEnemy* enemies = nullptr;
+    uint8 enemyCount = 0;
+    SegmentState segmentState = SegmentState::InSegment;
+    uint8 tickInterval = 1;         // 방 시뮬레이션 간격 (tick, 1 = 매 tick / 정지 방은 스냅샷 주기와 같음)
+    uint8 snapshotInterval = 3;     // 다음 스냅샷까지 tick 수 (클라 보간 버퍼 기준)
+};
+
+// ---- 9001 ----------------------------------------------------------------
+
+struct S_Disconnect
+{
+    static constexpr MsgId ID = MsgIds::S_Disconnect;
+
+    uint16 reason = 0;
+
+    static constexpr auto Fields() { return std::make_tuple(&S_Disconnect::reason); }
+};
\ No newline at end of file
@@ -0,0 +1,123 @@
+#include "common/EpochManager.h"
+
+EpochManager::~EpochManager()
+{
+    DrainAll();
+}
+
+EpochManager::ParticipantId EpochManager::Register()
+{
+    for (uint32 i = 0; i < MAX_PARTICIPANTS; ++i)
+    {
+        bool expected = false;
+        if (_participants[i].used.compare_exchange_strong(expected, true))
+        {
+            _participants[i].state.store(0, std::memory_order_relaxed);
+            return i;
+        }
+    }
+    return INVALID_PARTICIPANT;
+}
+
+void EpochManager::Unregister(ParticipantId pid)
+{
+    if (pid >= MAX_PARTICIPANTS) return;
+
+    _participants[pid].state.store(0, std::memory_order_release);
+    _participants[pid].used.store(false, std::memory_order_release);
+}
+
+void EpochManager::Enter(ParticipantId pid)
+{
+    if (pid >= MAX_PARTICIPANTS) return;
+
+    // seq_cst store: 이후의 포인터 읽기보다 "활성 표시"가 먼저 보이도록
+    const uint64 e = _globalEpoch.load(std::memory_order_seq_cst);
+    _participants[pid].state.store((e << 1) | 1, std::memory_order_seq_cst);
+}
+
+void EpochManager::Leave(ParticipantId pid)
+{
+    if (pid >= MAX_PARTICIPANTS) return;
+
+    _participants[pid].state.store(0, std::memory_order_release);
+}
+
+void EpochManager::Retire(std::shared_ptr<void> obj)
+{
+    if (!obj) return;
+
+    {
+        std::lock_guard<std::mutex> lock(_limboMtx);
+        _limbo.push_back(Retired{ _globalEpoch.load(std::memory_order_seq_cst), std::move(obj) });
+    }
+    _pending.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool EpochManager::TryAdvance()
+{
+    uint64 e = _globalEpoch.load(std::memory_order_seq_cst);
+
+    // 활성 reader가 전부 현재 epoch에 있어야 전진 가능
+    for (const Participant& p : _participants)
+    {
+        if (!p.used.load(std::memory_order_acquire))
+            continue;
+
+        const uint64 s = p.state.load(std::memory_order_seq_cst);
+        if ((s & 1) && (s >> 1) != e)
+            return false;
+    }
+
+    return _globalEpoch.compare_exchange_strong(e, e + 1);
+}
+
+void EpochManager::Collect()
+{
+    if (_pending.load(std::memory_order_relaxed) == 0)
+        return;
+
+    // reader가 없으면 2번 연속 전진 -> 방금 retire된 것도 바로 해제됨
+    for (int i = 0; i < 2; ++i)
+    {
+        if (!TryAdvance())
+            break;
+    }
+
+    const uint64 now = _globalEpoch.load(std::memory_order_seq_cst);
+
+    std::vector<Retired> freeList;
+    {
+        std::lock_guard<std::mutex> lock(_limboMtx);
+
+        size_t keep = 0;
+        for (size_t i = 0; i < _limbo.size(); ++i)
+        {
+            if (_limbo[i].epoch + 2 <= now)
+                freeList.push_back(std::move(_limbo[i]));
+            else
+                _limbo[keep++] = std::move(_limbo[i]);
+        }
+        _limbo.resize(keep);
+    }
+
+    if (freeList.empty())
+        return;
+
+    _pending.fetch_sub(freeList.size(), std::memory_order_relaxed);
+
+    // 실제 해제(소멸자)는 락 밖에서
+    freeList.clear();
+}
+
+void EpochManager::DrainAll()
+{
+    std::vector<Retired> freeList;
+    {
+        std::lock_guard<std::mutex> lock(_limboMtx);
+        freeList.swap(_limbo);
+    }
+
+    _pending.fetch_sub(freeList.size(), std::memory_order_relaxed);
+    freeList.clear();
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#include "common/MappedFile.h"
+
+#include <windows.h>
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+bool MappedFile::Open(const std::string& path)
+{
+    Close();
+
+    HANDLE file = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+    _file = file;
+
+    LARGE_INTEGER size{};
+    if (!::GetFileSizeEx(_file, &size) || size.QuadPart <= 0)
+    {
+        Close();
+        return false;
+    }
+
+    _mapping = ::CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (_mapping == nullptr)
+    {
+        Close();
+        return false;
+    }
+
+    _data = (const Byte*)::MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0);
+    if (_data == nullptr)
+    {
+        Close();
+        return false;
+    }
+
+    _size = (size_t)size.QuadPart;
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (_data)
+    {
+        ::UnmapViewOfFile(_data);
+        _data = nullptr;
+    }
+    if (_mapping)
+    {
+        ::CloseHandle(_mapping);
+        _mapping = nullptr;
+    }
+    if (_file)
+    {
+        ::CloseHandle(_file);
+        _file = nullptr;
+    }
+    _size = 0;
+}
\ No newline at end of file
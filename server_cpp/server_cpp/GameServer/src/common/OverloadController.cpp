@@ -0,0 +1,248 @@
+#include "common/OverloadController.h"
+#include "common/ThreadPlacement.h"
+
+#include <windows.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+static void Log(const std::string& tag, const std::string& msg)
+{
+    std::cout << "[" << tag << "] " << msg << "\n";
+}
+
+static uint64 FileTimeNs(const FILETIME& ft)
+{
+    return ((((uint64)ft.dwHighDateTime) << 32) | (uint64)ft.dwLowDateTime) * 100;
+}
+
+const char* LoadLevelName(LoadLevel level)
+{
+    switch (level)
+    {
+    case LoadLevel::Normal: return "normal";
+    case LoadLevel::ReduceSnapshots: return "reduce-snapshots";
+    case LoadLevel::ShedOptional: return "shed-optional";
+    case LoadLevel::RejectRooms: return "reject-rooms";
+    case LoadLevel::RejectAccepts: return "reject-accepts";
+    }
+    return "?";
+}
+
+OverloadController::OverloadController(uint32 tickBudgetUs)
+    : _tickBudgetUs(tickBudgetUs), _bucketUs(std::max<uint32>(1, tickBudgetUs * 2 / OVERLOAD_TICK_BUCKETS))
+{
+    _tag = "Overload";
+}
+
+OverloadController::~OverloadController()
+{
+    Stop();
+}
+
+bool OverloadController::Start()
+{
+    if (_running.exchange(true))
+        return false;
+
+    _thread = std::thread(&OverloadController::MonitorLoop, this);
+    return true;
+}
+
+void OverloadController::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(_waitMutex);
+        if (!_running.exchange(false))
+            return;
+    }
+    _waitCv.notify_all();
+
+    if (_thread.joinable())
+        _thread.join();
+}
+
+void OverloadController::RecordTick(uint64 workUs)
+{
+    const uint32 bucket = (uint32)std::min<uint64>(workUs / _bucketUs, OVERLOAD_TICK_BUCKETS);
+    _tickBuckets[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+void OverloadController::MonitorLoop()
+{
+    ThreadPlacement::Pin(ThreadRole::Helper, 3);
+
+    // CPU 기준점 (첫 창부터 차이로 계산)
+    SampleCpuPermille();
+
+    auto nextStatLog = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+
+    std::unique_lock<std::mutex> lock(_waitMutex);
+    while (_running.load())
+    {
+        _waitCv.wait_for(lock, std::chrono::milliseconds(OVERLOAD_WINDOW_MS), [this] { return !_running.load(); });
+        if (!_running.load())
+            break;
+
+        // 샘플러가 세션 샤드 락을 잡으므로 대기 락은 풀고
+        lock.unlock();
+        Evaluate();
+
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= nextStatLog)
+        {
+            LogStats();
+            nextStatLog = now + std::chrono::seconds(10);
+        }
+        lock.lock();
+    }
+}
+
+void OverloadController::Evaluate()
+{
+    const Sample s = TakeSample();
+    _last = s;
+
+    const uint32 current = _level.load(std::memory_order_relaxed);
+    uint32 next = current;
+
+    if ((uint32)s.target > current)
+    {
+        // 창마다 한 단계씩 (앞 단계 조치가 먹히는지 먼저 봄)
+        next = current + 1;
+        _calmWindows = 0;
+    }
+    else if ((uint32)s.target < current)
+    {
+        if (++_calmWindows >= OVERLOAD_CALM_WINDOWS)
+        {
+            next = current - 1;
+            _calmWindows = 0;
+        }
+    }
+    else
+    {
+        _calmWindows = 0;
+    }
+
+    // 다른 프로세스가 알려 온 단계는 그대로 바닥으로 (그쪽에서 이미 단계적으로 올림)
+    next = std::max(next, (uint32)s.external);
+
+    if (next == current)
+        return;
+
+    _level.store((uint8)next, std::memory_order_relaxed);
+    _maxLevel = std::max(_maxLevel, next);
+    ++_changes;
+
+    Log(_tag, std::string(LoadLevelName((LoadLevel)current)) + " -> " + LoadLevelName((LoadLevel)next) +
+        " (tickUs p95=" + std::to_string(s.tickP95Us) + "/" + std::to_string(_tickBudgetUs) +
+        " cpu=" + std::to_string(s.cpuPermille / 10) + "%" +
+        " backlog=" + std::to_string(s.backlogged) + "/" + std::to_string(s.sessions) +
+        " external=" + LoadLevelName(s.external) + ")");
+}
+
+OverloadController::Sample OverloadController::TakeSample()
+{
+    Sample s;
+
+    std::array<uint32, OVERLOAD_TICK_BUCKETS + 1> counts;
+    for (uint32 i = 0; i <= OVERLOAD_TICK_BUCKETS; ++i)
+    {
+        counts[i] = _tickBuckets[i].exchange(0, std::memory_order_relaxed);
+        s.ticks += counts[i];
+    }
+    s.tickP50Us = TickPercentileUs(counts, s.ticks, 500);
+    s.tickP95Us = TickPercentileUs(counts, s.ticks, 950);
+    s.tickP99Us = TickPercentileUs(counts, s.ticks, 990);
+
+    s.cpuPermille = SampleCpuPermille();
+
+    if (_queueSampler)
+        _queueSampler(s.sessions, s.backlogged);
+
+    if (_externalSampler)
+        s.external = _externalSampler();
+
+    const uint32 tickPermille = (uint32)((uint64)s.tickP95Us * 1000 / _tickBudgetUs);
+    const uint32 backlogPermille = s.sessions > 0 ? (uint32)((uint64)s.backlogged * 1000 / s.sessions) : 0;
+
+    // tick이 없는 프로세스(게이트웨이)는 tick 기준을 안 봄
+    LoadLevel target = LevelFor(CPU_PERMILLE, s.cpuPermille);
+    if (s.ticks > 0)
+        target = std::max(target, LevelFor(TICK_P95_PERMILLE, tickPermille));
+    target = std::max(target, LevelFor(BACKLOG_PERMILLE, backlogPermille));
+    s.target = target;
+    return s;
+}
+
+uint32 OverloadController::TickPercentileUs(const std::array<uint32, OVERLOAD_TICK_BUCKETS + 1>& counts, uint32 total, uint32 permille) const
+{
+    if (total == 0)
+        return 0;
+
+    // 칸의 위쪽 끝 (보수적으로), 마지막 칸은 예산 2배 이상 전부
+    const uint64 rank = ((uint64)total * permille + 999) / 1000;
+    uint64 seen = 0;
+    for (uint32 i = 0; i <= OVERLOAD_TICK_BUCKETS; ++i)
+    {
+        seen += counts[i];
+        if (seen >= rank)
+            return (i + 1) * _bucketUs;
+    }
+    return (OVERLOAD_TICK_BUCKETS + 1) * _bucketUs;
+}
+
+uint32 OverloadController::SampleCpuPermille()
+{
+    FILETIME created, exited, kernel, user;
+    if (!::GetProcessTimes(::GetCurrentProcess(), &created, &exited, &kernel, &user))
+        return 0;
+
+    const uint64 cpuNs = FileTimeNs(kernel) + FileTimeNs(user);
+    const uint64 wallNs = (uint64)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+
+    uint32 permille = 0;
+    if (_lastWallNs != 0 && wallNs > _lastWallNs)
+    {
+        const uint64 cores = std::max<DWORD>(1, ::GetActiveProcessorCount(ALL_PROCESSOR_GROUPS));
+        permille = (uint32)std::min<uint64>(1000, (cpuNs - _lastCpuNs) * 1000 / ((wallNs - _lastWallNs) * cores));
+    }
+
+    _lastCpuNs = cpuNs;
+    _lastWallNs = wallNs;
+    return permille;
+}
+
+LoadLevel OverloadController::LevelFor(const std::array<uint32, 4>& thresholds, uint32 value)
+{
+    uint32 level = 0;
+    for (uint32 i = 0; i < (uint32)thresholds.size(); ++i)
+    {
+        if (value >= thresholds[i])
+            level = i + 1;
+    }
+    return (LoadLevel)level;
+}
+
+void OverloadController::LogStats()
+{
+    const LoadLevel level = Level();
+    if (level == LoadLevel::Normal && _changes == 0)
+        return;
+
+    // 마지막 창 값 + 지난 10초 최고 단계/변경 수
+    Log(_tag,
+        "level=" + std::string(LoadLevelName(level)) +
+        " maxLevel=" + LoadLevelName((LoadLevel)std::max(_maxLevel, (uint32)level)) +
+        " changes=" + std::to_string(_changes) +
+        " tickUs(p50/p95/p99)=" + std::to_string(_last.tickP50Us) + "/" + std::to_string(_last.tickP95Us) + "/" + std::to_string(_last.tickP99Us) +
+        " cpu=" + std::to_string(_last.cpuPermille / 10) + "%" +
+        " backlog=" + std::to_string(_last.backlogged) + "/" + std::to_string(_last.sessions) +
+        " external=" + LoadLevelName(_last.external));
+
+    _maxLevel = 0;
+    _changes = 0;
+}
\ No newline at end of file
@@ -0,0 +1,113 @@
+#include "common/SharedMemory.h"
+
+#include <windows.h>
+
+SharedMemory::~SharedMemory()
+{
+    Close();
+}
+
+bool SharedMemory::Create(const std::string& name, size_t size)
+{
+    Close();
+
+    const uint64 size64 = (uint64)size;
+    HANDLE mapping = ::CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+        (DWORD)(size64 >> 32), (DWORD)(size64 & 0xFFFFFFFF), name.c_str());
+    if (mapping == nullptr)
+        return false;
+
+    // 이미 있으면 핸들은 기존 것 -> 남의 메모리를 초기화하지 않게 실패
+    if (::GetLastError() == ERROR_ALREADY_EXISTS)
+    {
+        ::CloseHandle(mapping);
+        return false;
+    }
+    _mapping = mapping;
+
+    _data = (Byte*)::MapViewOfFile(_mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if (_data == nullptr)
+    {
+        Close();
+        return false;
+    }
+
+    _size = size;
+    return true;
+}
+
+bool SharedMemory::Open(const std::string& name)
+{
+    Close();
+
+    _mapping = ::OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, name.c_str());
+    if (_mapping == nullptr)
+        return false;
+
+    _data = (Byte*)::MapViewOfFile(_mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+    if (_data == nullptr)
+    {
+        Close();
+        return false;
+    }
+
+    MEMORY_BASIC_INFORMATION info{};
+    if (::VirtualQuery(_data, &info, sizeof(info)) == 0)
+    {
+        Close();
+        return false;
+    }
+
+    _size = (size_t)info.RegionSize;
+    return true;
+}
+
+void SharedMemory::Close()
+{
+    if (_data)
+    {
+        ::UnmapViewOfFile(_data);
+        _data = nullptr;
+    }
+    if (_mapping)
+    {
+        ::CloseHandle(_mapping);
+        _mapping = nullptr;
+    }
+    _size = 0;
+}
+
+NamedEvent::~NamedEvent()
+{
+    Close();
+}
+
+bool NamedEvent::Create(const std::string& name)
+{
+    Close();
+
+    _event = ::CreateEventA(nullptr, FALSE, FALSE, name.c_str());
+    return _event != nullptr;
+}
+
+void NamedEvent::Close()
+{
+    if (_event)
+    {
+        ::CloseHandle(_event);
+        _event = nullptr;
+    }
+}
+
+void NamedEvent::Signal()
+{
+    if (_event)
+        ::SetEvent(_event);
+}
+
+bool NamedEvent::Wait(uint32 timeoutMs)
+{
+    if (!_event)
+        return false;
+    return ::WaitForSingleObject(_event, timeoutMs) == WAIT_OBJECT_0;
+}
\ No newline at end of file
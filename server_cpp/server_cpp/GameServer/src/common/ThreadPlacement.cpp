@@ -0,0 +1,290 @@
+#include "common/ThreadPlacement.h"
+
+#include <windows.h>
+#pragma comment(lib, "Advapi32.lib")
+
+#include <array>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+static void Log(const std::string& tag, const std::string& msg)
+{
+    std::cout << "[" << tag << "] " << msg << "\n";
+}
+
+// 설정 키 (ThreadRole 순서)
+static const char* const s_roleKeys[(size_t)ThreadRole::Count] = { "tick", "workers", "encoders", "io", "accept", "helpers", "relays" };
+
+// Load 이후 읽기 전용
+static std::array<std::vector<uint32>, (size_t)ThreadRole::Count> s_cores;
+static bool s_largePages = false;
+
+static thread_local int32 t_node = -1;     // Pin으로 고정된 코어의 노드
+static thread_local ThreadRole t_role = ThreadRole::Count;
+
+static std::string Trim(const std::string& s)
+{
+    const size_t b = s.find_first_not_of(" \t\r");
+    if (b == std::string::npos)
+        return "";
+    const size_t e = s.find_last_not_of(" \t\r");
+    return s.substr(b, e - b + 1);
+}
+
+// "3,4,8-11" -> {3,4,8,9,10,11}
+static bool ParseCores(const std::string& value, std::vector<uint32>& out)
+{
+    out.clear();
+    size_t pos = 0;
+    while (pos <= value.size())
+    {
+        size_t comma = value.find(',', pos);
+        if (comma == std::string::npos)
+            comma = value.size();
+
+        const std::string item = Trim(value.substr(pos, comma - pos));
+        pos = comma + 1;
+        if (item.empty())
+            continue;
+
+        try
+        {
+            const size_t dash = item.find('-');
+            const uint32 first = (uint32)std::stoul(item.substr(0, dash));
+            const uint32 last = dash == std::string::npos ? first : (uint32)std::stoul(item.substr(dash + 1));
+            if (last < first || last - first > 1024)
+                return false;
+
+            for (uint32 c = first; c <= last; ++c)
+                out.push_back(c);
+        }
+        catch (...)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 논리 코어 번호 -> (group, group 안 번호)
+static bool CoreToProcessor(uint32 core, PROCESSOR_NUMBER& out)
+{
+    const WORD groups = ::GetActiveProcessorGroupCount();
+    for (WORD g = 0; g < groups; ++g)
+    {
+        const DWORD count = ::GetActiveProcessorCount(g);
+        if (core < count)
+        {
+            out = PROCESSOR_NUMBER{};
+            out.Group = g;
+            out.Number = (BYTE)core;
+            return true;
+        }
+        core -= count;
+    }
+    return false;
+}
+
+static int32 NodeOfProcessor(PROCESSOR_NUMBER& pn)
+{
+    USHORT node = 0;
+    if (!::GetNumaProcessorNodeEx(&pn, &node) || node == 0xFFFF)
+        return -1;
+    return (int32)node;
+}
+
+// large page는 프로세스 토큰에 SeLockMemoryPrivilege가 있어야 함 (로컬 보안 정책 "메모리에 페이지 잠금")
+static bool EnableLockMemoryPrivilege()
+{
+    HANDLE token = nullptr;
+    if (!::OpenProcessToken(::GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token))
+        return false;
+
+    TOKEN_PRIVILEGES tp{};
+    tp.PrivilegeCount = 1;
+    tp.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+
+    bool ok = ::LookupPrivilegeValueA(nullptr, "SeLockMemoryPrivilege", &tp.Privileges[0].Luid)
+        && ::AdjustTokenPrivileges(token, FALSE, &tp, 0, nullptr, nullptr)
+        && ::GetLastError() == ERROR_SUCCESS;   // 권한이 없으면 성공 + ERROR_NOT_ALL_ASSIGNED
+
+    ::CloseHandle(token);
+    return ok;
+}
+
+bool ThreadPlacement::Load(const std::string& path)
+{
+    std::ifstream in(path);
+    if (!in)
+    {
+        Log("ThreadPlacement", "Topology open failed: " + path);
+        return false;
+    }
+
+    std::string line;
+    uint32 lineNo = 0;
+    while (std::getline(in, line))
+    {
+        ++lineNo;
+        const size_t hash = line.find('#');
+        if (hash != std::string::npos)
+            line.resize(hash);
+
+        line = Trim(line);
+        if (line.empty())
+            continue;
+
+        const size_t eq = line.find('=');
+        const std::string key = eq == std::string::npos ? "" : Trim(line.substr(0, eq));
+        const std::string value = eq == std::string::npos ? "" : Trim(line.substr(eq + 1));
+
+        bool known = false;
+        bool ok = true;
+        for (size_t r = 0; r < (size_t)ThreadRole::Count; ++r)
+        {
+            if (key == s_roleKeys[r])
+            {
+                known = true;
+                ok = ParseCores(value, s_cores[r]);
+            }
+        }
+
+        if (key == "largePages")
+        {
+            known = true;
+            s_largePages = value == "1" || value == "true";
+        }
+
+        if (!known || !ok)
+        {
+            Log("ThreadPlacement", "Topology parse error at line " + std::to_string(lineNo) + ": " + line);
+            return false;
+        }
+    }
+
+    // 없는 코어를 지정하면 고정 실패 -> 시작 단계에서 거름
+    for (size_t r = 0; r < (size_t)ThreadRole::Count; ++r)
+    {
+        for (uint32 core : s_cores[r])
+        {
+            PROCESSOR_NUMBER pn;
+            if (!CoreToProcessor(core, pn))
+            {
+                Log("ThreadPlacement", std::string("No such core for ") + s_roleKeys[r] + ": " + std::to_string(core));
+                return false;
+            }
+        }
+    }
+
+    if (s_largePages && (::GetLargePageMinimum() == 0 || !EnableLockMemoryPrivilege()))
+    {
+        Log("ThreadPlacement", "Large pages unavailable (SeLockMemoryPrivilege?), using normal pages");
+        s_largePages = false;
+    }
+
+    Log("ThreadPlacement", "Topology " + Describe());
+    return true;
+}
+
+void ThreadPlacement::Pin(ThreadRole role, uint64 index)
+{
+    t_role = role;
+
+    const std::vector<uint32>& cores = s_cores[(size_t)role];
+    if (cores.empty())
+        return;
+
+    const uint32 core = cores[(size_t)(index % cores.size())];
+
+    PROCESSOR_NUMBER pn;
+    if (!CoreToProcessor(core, pn))
+        return;
+
+    GROUP_AFFINITY affinity{};
+    affinity.Group = pn.Group;
+    affinity.Mask = (KAFFINITY)1 << pn.Number;
+    if (!::SetThreadGroupAffinity(::GetCurrentThread(), &affinity, nullptr))
+    {
+        Log("ThreadPlacement", "SetThreadGroupAffinity failed core=" + std::to_string(core)
+            + " err=" + std::to_string(::GetLastError()));
+        return;
+    }
+
+    t_node = NodeOfProcessor(pn);
+}
+
+ThreadRole ThreadPlacement::CurrentRole()
+{
+    return t_role;
+}
+
+uint32 ThreadPlacement::CurrentNode()
+{
+    if (t_node >= 0)
+        return (uint32)t_node;
+
+    PROCESSOR_NUMBER pn{};
+    ::GetCurrentProcessorNumberEx(&pn);
+    const int32 node = NodeOfProcessor(pn);
+    return node >= 0 ? (uint32)node : 0;
+}
+
+void* ThreadPlacement::AllocPages(size_t& bytes, uint32 node, bool& large)
+{
+    large = false;
+
+    if (s_largePages)
+    {
+        const size_t page = ::GetLargePageMinimum();
+        const size_t rounded = (bytes + page - 1) / page * page;
+        void* p = ::VirtualAllocExNuma(::GetCurrentProcess(), nullptr, rounded,
+            MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE, node);
+        if (p)
+        {
+            bytes = rounded;
+            large = true;
+            return p;
+        }
+        // 물리 메모리 단편화로 연속 large page가 없을 수 있음 -> 일반 페이지로
+    }
+
+    SYSTEM_INFO si{};
+    ::GetSystemInfo(&si);
+    const size_t page = si.dwPageSize;
+    const size_t rounded = (bytes + page - 1) / page * page;
+
+    void* p = ::VirtualAllocExNuma(::GetCurrentProcess(), nullptr, rounded, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE, node);
+    if (p)
+        bytes = rounded;
+    return p;
+}
+
+void ThreadPlacement::FreePages(void* p)
+{
+    if (p)
+        ::VirtualFree(p, 0, MEM_RELEASE);
+}
+
+bool ThreadPlacement::LargePages()
+{
+    return s_largePages;
+}
+
+std::string ThreadPlacement::Describe()
+{
+    std::string out;
+    for (size_t r = 0; r < (size_t)ThreadRole::Count; ++r)
+    {
+        if (s_cores[r].empty())
+            continue;
+
+        out += std::string(out.empty() ? "" : " ") + s_roleKeys[r] + "=";
+        for (size_t i = 0; i < s_cores[r].size(); ++i)
+            out += (i ? "," : "") + std::to_string(s_cores[r][i]);
+    }
+    if (out.empty())
+        out = "(os default)";
+
+    return out + " largePages=" + (s_largePages ? "1" : "0");
+}
\ No newline at end of file
@@ -0,0 +1,135 @@
+#include "common/TickArena.h"
+#include "common/ThreadPlacement.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <string>
+
+static void Log(const std::string& tag, const std::string& msg)
+{
+    std::cout << "[" << tag << "] " << msg << "\n";
+}
+
+static thread_local TickArena* t_bound = nullptr;
+
+TickArena::TickArena(size_t chunkBytes)
+    : _chunkBytes(std::max<size_t>(chunkBytes, 64))
+{
+}
+
+TickArena::~TickArena()
+{
+    for (const Chunk& c : _chunks)
+        ThreadPlacement::FreePages(c.data);
+}
+
+void TickArena::AddChunk(size_t bytes)
+{
+    // 주인 스레드 노드에 (첫 할당/Reset 모두 주인 스레드에서 일어남), 설정되면 large page
+    bool large = false;
+    Chunk c{ static_cast<Byte*>(ThreadPlacement::AllocPages(bytes, ThreadPlacement::CurrentNode(), large)), bytes };
+    if (!c.data)
+        throw std::bad_alloc();
+
+    _chunks.push_back(c);
+    ++_stats.chunkAllocs;
+
+    _begin = c.data;
+    _cur = c.data;
+    _end = c.data + bytes;
+}
+
+void* TickArena::AllocateSlow(size_t bytes, size_t align)
+{
+    // 이번 tick은 새 chunk로 넘어감 (앞 chunk 남은 자리는 버림, Reset 때 합쳐짐)
+    _usedBefore += (size_t)(_cur - _begin);
+    AddChunk(std::max(_chunkBytes, bytes + align));
+    return Allocate(bytes, align);
+}
+
+void TickArena::Reset()
+{
+    const size_t used = Used();
+    _stats.highWater = std::max(_stats.highWater, used);
+    ++_stats.resets;
+    ++_generation;
+
+#if TICK_ARENA_CHECKS
+    if (_live != 0)
+    {
+        Log("TickArena", "escaped allocations at reset: live=" + std::to_string(_live)
+            + " gen=" + std::to_string(_generation - 1));
+        std::cout.flush();
+        std::abort();
+    }
+
+    // 남은 포인터로 읽으면 바로 티 나게
+    for (const Chunk& c : _chunks)
+        std::memset(c.data, 0xCD, c.size);
+#endif
+
+    if (_chunks.size() > 1)
+    {
+        // 넘쳤던 tick 크기만큼 한 chunk로 -> 다음 tick부터는 malloc 없음
+        size_t total = 0;
+        for (const Chunk& c : _chunks)
+        {
+            total += c.size;
+            ThreadPlacement::FreePages(c.data);
+        }
+        _chunks.clear();
+        _chunkBytes = std::max(_chunkBytes, total);
+    }
+
+    if (_chunks.empty())
+    {
+        AddChunk(_chunkBytes);
+    }
+    else
+    {
+        _begin = _chunks[0].data;
+        _cur = _begin;
+        _end = _begin + _chunks[0].size;
+    }
+    _usedBefore = 0;
+}
+
+TickArena::Stats TickArena::TakeStats()
+{
+    Stats s = _stats;
+    s.highWater = std::max(s.highWater, Used());
+    s.capacity = 0;
+    for (const Chunk& c : _chunks)
+        s.capacity += c.size;
+
+    _stats = Stats{};
+    return s;
+}
+
+TickArena& TickArena::ForThread()
+{
+    if (t_bound)
+        return *t_bound;
+
+    static thread_local TickArena local;
+    t_bound = &local;
+    return local;
+}
+
+void TickArena::Bind(TickArena* arena)
+{
+    t_bound = arena;
+}
+
+#if TICK_ARENA_CHECKS
+void TickArenaEscaped(uint32 madeAt, uint32 now)
+{
+    Log("TickArena", "container used after tick reset: madeAt=" + std::to_string(madeAt)
+        + " now=" + std::to_string(now));
+    std::cout.flush();
+    std::abort();
+}
+#endif
\ No newline at end of file
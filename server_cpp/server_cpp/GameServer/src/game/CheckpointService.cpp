@@ -0,0 +1,196 @@
+#include "game/CheckpointService.h"
+#include "common/ThreadPlacement.h"
+
+#include <chrono>
+#include <iostream>
+
+static void Log(const std::string& tag, const std::string& msg)
+{
+    std::cout << "[" << tag << "] " << msg << "\n";
+}
+
+CheckpointService::CheckpointService()
+{
+    _tag = "CheckpointService";
+}
+
+CheckpointService::~CheckpointService()
+{
+    Stop();
+}
+
+bool CheckpointService::Start(const std::string& host, uint16 port)
+{
+    if (_running.exchange(true))
+        return false;
+
+    if (!_uploader.Start(host, port))
+    {
+        _running.store(false);
+        return false;
+    }
+
+    _stopping = false;
+    _worker = std::thread(&CheckpointService::SerializeLoop, this);
+    return true;
+}
+
+void CheckpointService::Stop()
+{
+    // 멱등
+    if (!_running.exchange(false))
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _cv.notify_one();
+
+    if (_worker.joinable())
+        _worker.join();
+
+    // 마지막(방 종료) 체크포인트가 나가도록 잠깐 기다림
+    _uploader.Stop();
+
+    Log(_tag, "Stopped");
+}
+
+std::unique_ptr<CheckpointDelta> CheckpointService::Acquire()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_free.empty())
+        {
+            auto delta = std::move(_free.back());
+            _free.pop_back();
+            return delta;
+        }
+    }
+    return std::make_unique<CheckpointDelta>();
+}
+
+void CheckpointService::Submit(std::unique_ptr<CheckpointDelta> delta)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        ++_stats.submitted;
+        _stats.dirtyEnemies += delta->dirtyEnemies.size();
+        _queue.push_back(std::move(delta));
+    }
+    _cv.notify_one();
+}
+
+CheckpointService::Stats CheckpointService::TakeStats()
+{
+    Stats s;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        s = _stats;
+        _stats = Stats{};
+    }
+    s.upload = _uploader.TakeStats();
+    return s;
+}
+
+void CheckpointService::SerializeLoop()
+{
+    ThreadPlacement::Pin(ThreadRole::Helper, 0);
+
+    std::vector<std::unique_ptr<CheckpointDelta>> local;
+    ByteWriter blob;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _cv.wait(lock, [this] { return _stopping || !_queue.empty(); });
+
+            if (_queue.empty())
+                break; // _stopping && 남은 것 없음
+
+            local.swap(_queue);
+        }
+
+        for (auto& delta : local)
+        {
+            const auto t0 = std::chrono::steady_clock::now();
+
+            RoomShadow& shadow = _shadows[delta->roomId];
+            Merge(*delta, shadow);
+
+            blob = ByteWriter();
+            Serialize(*delta, shadow, blob);
+
+            const uint64 ns = (uint64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count();
+            const size_t bytes = blob.Size();
+
+            // body 소유권은 업로더로 (재시도/coalescing 동안 보관)
+            _uploader.Post(delta->roomId, "/internal/rooms/" + std::to_string(delta->roomId) + "/checkpoint", std::move(blob.buf));
+
+            if (delta->flags & CHECKPOINT_FLAG_FINAL)
+                _shadows.erase(delta->roomId);
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stats.serializeNs += ns;
+                _stats.blobBytes += bytes;
+            }
+        }
+
+        // 변경분 버퍼 반납
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (auto& delta : local)
+            {
+                delta->Clear();
+                _free.push_back(std::move(delta));
+            }
+        }
+        local.clear();
+    }
+}
+
+void CheckpointService::Merge(const CheckpointDelta& delta, RoomShadow& shadow)
+{
+    shadow.players = delta.players;
+
+    // 적 배열은 구간 시작 때만 통째로 바뀜 (새 적은 스폰 시 전부 dirty) -> 바뀐 index는 이번 변경분에 반드시 들어 있음
+    shadow.enemies.resize(delta.enemyCount);
+    for (const CheckpointEnemy& e : delta.dirtyEnemies)
+    {
+        if (e.index < shadow.enemies.size())
+            shadow.enemies[e.index] = e;
+    }
+}
+
+void CheckpointService::Serialize(const CheckpointDelta& delta, const RoomShadow& shadow, ByteWriter& out)
+{
+    out.Reserve(CHECKPOINT_HEADER_SIZE + shadow.players.size() * CHECKPOINT_PLAYER_SIZE + shadow.enemies.size() * CHECKPOINT_ENEMY_SIZE);
+
+    out.WriteU32LE(CHECKPOINT_MAGIC);
+    out.WriteU16LE(CHECKPOINT_VERSION);
+    out.WriteU32LE(delta.roomId);
+    out.WriteU32LE(delta.serverTick);
+    out.WriteU8((uint8)delta.segmentState);
+    out.WriteU8(delta.flags);
+    out.WriteU16LE((uint16)shadow.players.size());
+    out.WriteU32LE((uint32)shadow.enemies.size());
+
+    for (const CheckpointPlayer& p : shadow.players)
+    {
+        out.WriteU64LE(p.playerId);
+        out.WriteF32LE(p.x);
+        out.WriteF32LE(p.y);
+        out.WriteU16LE(p.hp);
+        out.WriteU8(p.state);
+    }
+
+    for (const CheckpointEnemy& e : shadow.enemies)
+    {
+        out.WriteU32LE(e.id);
+        out.WriteU16LE(e.defId);
+        out.WriteU16LE(e.hp);
+        out.WriteU8(e.state);
+    }
+}
\ No newline at end of file
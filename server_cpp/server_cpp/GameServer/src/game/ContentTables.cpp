@@ -0,0 +1,203 @@
+#include "game/ContentTables.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+static void Log(const std::string& tag, const std::string& msg)
+{
+    std::cout << "[" << tag << "] " << msg << "\n";
+}
+
+template <typename Def>
+static const Def* FindById(const Def* defs, uint32 count, bool dense, uint16 id)
+{
+    // id가 빈틈없이 이어지면 (정렬+중복 없음 전제) 바로 인덱싱
+    if (dense)
+    {
+        const uint32 idx = (uint32)(id - defs[0].id);
+        return (id >= defs[0].id && idx < count) ? &defs[idx] : nullptr;
+    }
+
+    const Def* end = defs + count;
+    const Def* it = std::lower_bound(defs, end, id, [](const Def& d, uint16 key) { return d.id < key; });
+    return (it != end && it->id == id) ? it : nullptr;
+}
+
+template <typename Def>
+static bool IsDense(const Def* defs, uint32 count)
+{
+    return count > 0 && (uint32)(defs[count - 1].id - defs[0].id) == count - 1;
+}
+
+template <typename Def>
+static bool IsSortedUnique(const Def* defs, uint32 count)
+{
+    for (uint32 i = 1; i < count; ++i)
+    {
+        if (defs[i - 1].id >= defs[i].id)
+            return false;
+    }
+    return true;
+}
+
+std::unique_ptr<ContentTables> ContentTables::Load(const std::string& path)
+{
+    const auto t0 = std::chrono::steady_clock::now();
+
+    std::unique_ptr<ContentTables> tables(new ContentTables());
+    if (!tables->_file.Open(path))
+    {
+        Log("Content", "Open failed: " + path);
+        return nullptr;
+    }
+
+    std::string error;
+    if (!tables->Bind(error))
+    {
+        Log("Content", "Invalid " + path + ": " + error);
+        return nullptr;
+    }
+
+    const auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t0).count();
+    Log("Content", "Loaded " + path + " (data v" + std::to_string(tables->_dataVersion)
+        + ", skills=" + std::to_string(tables->_skillCount) + ", enemies=" + std::to_string(tables->_enemyCount)
+        + ", " + std::to_string(us) + "us)");
+    return tables;
+}
+
+bool ContentTables::Bind(std::string& outError)
+{
+    const Byte* base = _file.Data();
+    const size_t size = _file.Size();
+
+    if (size < sizeof(ContentFileHeader))
+    {
+        outError = "too small";
+        return false;
+    }
+
+    const ContentFileHeader& header = *(const ContentFileHeader*)base;
+    if (header.magic != CONTENT_MAGIC)
+    {
+        outError = "bad magic";
+        return false;
+    }
+    if (header.formatVersion != CONTENT_FORMAT_VERSION)
+    {
+        outError = "format version " + std::to_string(header.formatVersion) + " (expected " + std::to_string(CONTENT_FORMAT_VERSION) + ")";
+        return false;
+    }
+    if (header.fileSize != size)
+    {
+        outError = "size mismatch (truncated?)";
+        return false;
+    }
+
+    const size_t descEnd = sizeof(ContentFileHeader) + (size_t)header.tableCount * sizeof(ContentTableDesc);
+    if (descEnd > size)
+    {
+        outError = "table directory out of range";
+        return false;
+    }
+
+    const ContentTableDesc* descs = (const ContentTableDesc*)(base + sizeof(ContentFileHeader));
+    for (uint32 i = 0; i < header.tableCount; ++i)
+    {
+        const ContentTableDesc& d = descs[i];
+
+        if (d.offset % CONTENT_TABLE_ALIGN != 0 || d.offset < descEnd
+            || (uint64)d.offset + (uint64)d.recordSize * d.count > size)
+        {
+            outError = "table " + std::to_string(d.tableId) + " out of range";
+            return false;
+        }
+
+        switch ((ContentTableId)d.tableId)
+        {
+        case ContentTableId::Skill:
+            if (d.recordSize != sizeof(SkillDef)) { outError = "skill record size"; return false; }
+            _skills = (const SkillDef*)(base + d.offset);
+            _skillCount = d.count;
+            break;
+
+        case ContentTableId::Enemy:
+            if (d.recordSize != sizeof(EnemyDef)) { outError = "enemy record size"; return false; }
+            _enemies = (const EnemyDef*)(base + d.offset);
+            _enemyCount = d.count;
+            break;
+
+        default:
+            // 신규 테이블은 구버전 서버에서 무시 (formatVersion을 안 올리고 추가 가능)
+            break;
+        }
+    }
+
+    // 이진 탐색 전제 확인 (레코드 수만큼 1회, 할당 없음)
+    if (!IsSortedUnique(_skills, _skillCount) || !IsSortedUnique(_enemies, _enemyCount))
+    {
+        outError = "ids not sorted/unique";
+        return false;
+    }
+
+    _skillsDense = IsDense(_skills, _skillCount);
+    _enemiesDense = IsDense(_enemies, _enemyCount);
+
+    _dataVersion = header.dataVersion;
+    return true;
+}
+
+const SkillDef* ContentTables::FindSkill(uint16 id) const
+{
+    return FindById(_skills, _skillCount, _skillsDense, id);
+}
+
+const EnemyDef* ContentTables::FindEnemy(uint16 id) const
+{
+    return FindById(_enemies, _enemyCount, _enemiesDense, id);
+}
+
+ContentManager::~ContentManager()
+{
+    delete _pending.exchange(nullptr);
+}
+
+bool ContentManager::LoadInitial(const std::string& path)
+{
+    {
+        std::lock_guard<std::mutex> lock(_pathMutex);
+        _path = path;
+    }
+
+    _current = ContentTables::Load(path);
+    return _current != nullptr;
+}
+
+bool ContentManager::RequestReload(const std::string& path)
+{
+    std::string target;
+    {
+        std::lock_guard<std::mutex> lock(_pathMutex);
+        if (!path.empty())
+            _path = path;
+        target = _path;
+    }
+
+    std::unique_ptr<ContentTables> fresh = ContentTables::Load(target);
+    if (!fresh)
+        return false;
+
+    // 아직 적용 안 된 이전 요청이 있으면 그건 tick이 본 적 없으므로 바로 해제
+    delete _pending.exchange(fresh.release(), std::memory_order_acq_rel);
+    return true;
+}
+
+bool ContentManager::ApplyPendingReload()
+{
+    ContentTables* next = _pending.exchange(nullptr, std::memory_order_acq_rel);
+    if (!next)
+        return false;
+
+    _current.reset(next);
+    return true;
+}
\ No newline at end of file
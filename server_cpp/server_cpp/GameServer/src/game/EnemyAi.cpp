@@ -0,0 +1,363 @@
+#include "game/EnemyAi.h"
+#include "common/ByteIO.h"
+
+#include <algorithm>
+#include <cmath>
+
+void EnemyAi::Clear()
+{
+    for (auto& bucket : _buckets)
+        bucket.clear();
+    _slotOf.clear();
+    _lastTargets.clear();
+
+    _idleCursor = 0;
+    _chaseCursor = 0;
+    _cleanScans = 0;
+    _maxSpeed = 0.f;
+}
+
+void EnemyAi::Add(uint32 enemy, float x, float y, float speed, uint16 damage, uint16 intervalTicks)
+{
+    std::vector<AiAgent>& idle = BucketOf(AiBehavior::Idle);
+
+    AiAgent a;
+    a.enemy = enemy;
+    a.x = x;
+    a.y = y;
+    a.speed = speed;
+    a.damage = damage;
+    a.intervalTicks = intervalTicks;
+
+    if (_slotOf.size() <= enemy)
+        _slotOf.resize(enemy + 1);
+    _slotOf[enemy] = ((uint32)AiBehavior::Idle << SLOT_POS_BITS) | (uint32)idle.size();
+    idle.push_back(a);
+    _maxSpeed = std::max(_maxSpeed, speed);
+
+    // 새 Idle은 아직 탐색 전
+    _cleanScans = 0;
+}
+
+void EnemyAi::Kill(uint32 enemy)
+{
+    if (BehaviorOf(enemy) == AiBehavior::Dead)
+        return;
+
+    Move(enemy, AiBehavior::Dead);
+}
+
+const AiAgent& EnemyAi::Agent(uint32 enemy) const
+{
+    const uint32 slot = _slotOf[enemy];
+    return _buckets[slot >> SLOT_POS_BITS][slot & SLOT_POS_MASK];
+}
+
+void EnemyAi::Move(uint32 enemy, AiBehavior to)
+{
+    const uint32 slot = _slotOf[enemy];
+    const AiBehavior from = (AiBehavior)(slot >> SLOT_POS_BITS);
+    if (from == to)
+        return;
+
+    std::vector<AiAgent>& src = BucketOf(from);
+    const uint32 pos = slot & SLOT_POS_MASK;
+
+    AiAgent a = src[pos];
+    if (to != AiBehavior::Chase && to != AiBehavior::Attack)
+        a.targetId = 0;
+
+    // swap-remove: 마지막 원소를 빈자리로
+    if (pos + 1 != (uint32)src.size())
+    {
+        src[pos] = src.back();
+        _slotOf[src[pos].enemy] = slot;
+    }
+    src.pop_back();
+
+    std::vector<AiAgent>& dst = BucketOf(to);
+    _slotOf[enemy] = ((uint32)to << SLOT_POS_BITS) | (uint32)dst.size();
+    dst.push_back(a);
+
+    // Idle 순서가 바뀌면 커서 한 바퀴가 전원을 본다는 보장이 깨짐 -> 다시 셈
+    if (from == AiBehavior::Idle || to == AiBehavior::Idle)
+        _cleanScans = 0;
+}
+
+uint32 EnemyAi::ScanBudget(size_t count)
+{
+    const uint32 n = (uint32)count;
+    const uint32 perPeriod = (n + AI_SCAN_PERIOD_TICKS - 1) / AI_SCAN_PERIOD_TICKS;
+    return std::min(n, std::max(perPeriod, AI_SCAN_MIN_PER_TICK));
+}
+
+const AiTarget* EnemyAi::FindNearest(float x, float y, float radius, const ArenaVector<AiTarget>& targets)
+{
+    const AiTarget* best = nullptr;
+    float bestD2 = radius * radius;
+    for (const AiTarget& t : targets)
+    {
+        const float dx = t.x - x;
+        const float dy = t.y - y;
+        const float d2 = dx * dx + dy * dy;
+        if (d2 <= bestD2)
+        {
+            best = &t;
+            bestD2 = d2;
+        }
+    }
+    return best;
+}
+
+const AiTarget* EnemyAi::FindTarget(uint64 playerId, const ArenaVector<AiTarget>& targets)
+{
+    // 방 인원이 작아서 선형 탐색
+    for (const AiTarget& t : targets)
+    {
+        if (t.playerId == playerId)
+            return &t;
+    }
+    return nullptr;
+}
+
+void EnemyAi::Update(uint32 tick, float dt, const ArenaVector<AiTarget>& targets, ArenaVector<AiHit>& outHits)
+{
+    // _lastTargets는 tick을 넘어 유지 -> arena 밖(std::vector)에 복사
+    if (targets.size() != _lastTargets.size() || !std::equal(targets.begin(), targets.end(), _lastTargets.begin()))
+    {
+        _lastTargets.assign(targets.begin(), targets.end());
+        _cleanScans = 0;
+    }
+
+    // 이번 tick 전이 목록은 tick 안에서 끝남 -> tick arena (가끔 커지던 멤버 vector 대신)
+    ArenaVector<Transition> transitions;
+
+    ScanIdle(targets, transitions);
+    RetargetChase(targets);
+    UpdateChase(tick, dt, targets, transitions);
+    UpdateAttack(tick, targets, outHits, transitions);
+
+    for (const Transition& t : transitions)
+        Move(t.enemy, t.to);
+}
+
+void EnemyAi::ScanIdle(const ArenaVector<AiTarget>& targets, ArenaVector<Transition>& transitions)
+{
+    std::vector<AiAgent>& idle = BucketOf(AiBehavior::Idle);
+    const uint32 n = (uint32)idle.size();
+    if (n == 0)
+        return;
+
+    const uint32 budget = ScanBudget(n);
+    _idleCursor %= n;
+    _scans += budget;
+
+    for (uint32 k = 0; k < budget; ++k)
+    {
+        AiAgent& a = idle[_idleCursor];
+        _idleCursor = _idleCursor + 1 == n ? 0 : _idleCursor + 1;
+
+        const AiTarget* t = FindNearest(a.x, a.y, ENEMY_AGGRO_RADIUS, targets);
+        if (!t)
+        {
+            ++_cleanScans;
+            continue;
+        }
+
+        a.targetId = t->playerId;
+        transitions.push_back(Transition{ a.enemy, AiBehavior::Chase });
+    }
+}
+
+void EnemyAi::RetargetChase(const ArenaVector<AiTarget>& targets)
+{
+    std::vector<AiAgent>& chase = BucketOf(AiBehavior::Chase);
+    const uint32 n = (uint32)chase.size();
+    if (n == 0)
+        return;
+
+    const uint32 budget = ScanBudget(n);
+    _chaseCursor %= n;
+    _scans += budget;
+
+    for (uint32 k = 0; k < budget; ++k)
+    {
+        AiAgent& a = chase[_chaseCursor];
+        _chaseCursor = _chaseCursor + 1 == n ? 0 : _chaseCursor + 1;
+
+        // 더 가까운 대상이 어그로 반경 안에 있으면 갈아탐 (없으면 기존 대상을 리쉬 거리까지 쫓음)
+        const AiTarget* t = FindNearest(a.x, a.y, ENEMY_AGGRO_RADIUS, targets);
+        if (t)
+            a.targetId = t->playerId;
+    }
+}
+
+void EnemyAi::UpdateChase(uint32 tick, float dt, const ArenaVector<AiTarget>& targets, ArenaVector<Transition>& transitions)
+{
+    constexpr float range2 = ENEMY_ATTACK_RANGE * ENEMY_ATTACK_RANGE;
+    constexpr float leash2 = ENEMY_LEASH_RADIUS * ENEMY_LEASH_RADIUS;
+
+    for (AiAgent& a : BucketOf(AiBehavior::Chase))
+    {
+        const AiTarget* t = FindTarget(a.targetId, targets);
+        if (!t)
+        {
+            // 대상이 죽었거나 나감
+            transitions.push_back(Transition{ a.enemy, AiBehavior::Idle });
+            continue;
+        }
+
+        const float dx = t->x - a.x;
+        const float dy = t->y - a.y;
+        const float d2 = dx * dx + dy * dy;
+
+        if (d2 > leash2)
+        {
+            // 놓침 -> 그 자리에서 대기
+            transitions.push_back(Transition{ a.enemy, AiBehavior::Idle });
+            continue;
+        }
+
+        if (d2 <= range2)
+        {
+            a.readyTick = tick + ENEMY_ATTACK_WINDUP_TICKS;
+            transitions.push_back(Transition{ a.enemy, AiBehavior::Attack });
+            continue;
+        }
+
+        // 대상과 겹치지 않게 사거리 절반 앞에서 멈춤
+        const float d = std::sqrt(d2);
+        const float step = std::min(a.speed * dt, d - ENEMY_ATTACK_RANGE * 0.5f);
+        a.x += dx / d * step;
+        a.y += dy / d * step;
+    }
+}
+
+void EnemyAi::UpdateAttack(uint32 tick, const ArenaVector<AiTarget>& targets, ArenaVector<AiHit>& outHits, ArenaVector<Transition>& transitions)
+{
+    // 사거리를 조금 벗어나도 계속 공격 (경계에서 Chase/Attack 왕복 방지)
+    constexpr float keep = ENEMY_ATTACK_RANGE * 1.25f;
+    constexpr float keep2 = keep * keep;
+
+    for (AiAgent& a : BucketOf(AiBehavior::Attack))
+    {
+        const AiTarget* t = FindTarget(a.targetId, targets);
+        if (!t)
+        {
+            transitions.push_back(Transition{ a.enemy, AiBehavior::Idle });
+            continue;
+        }
+
+        const float dx = t->x - a.x;
+        const float dy = t->y - a.y;
+        if (dx * dx + dy * dy > keep2)
+        {
+            transitions.push_back(Transition{ a.enemy, AiBehavior::Chase });
+            continue;
+        }
+
+        if (tick >= a.readyTick)
+        {
+            outHits.push_back(AiHit{ t->playerId, a.damage });
+            a.readyTick = tick + a.intervalTicks;
+        }
+    }
+}
+
+bool EnemyAi::Settled() const
+{
+    return Count(AiBehavior::Chase) == 0 && Count(AiBehavior::Attack) == 0 && _cleanScans >= Count(AiBehavior::Idle);
+}
+
+void EnemyAi::Skip(uint32 ticks)
+{
+    // Settled면 Update는 Idle 커서만 돌리고 전부 허탕 (Chase 버킷은 비어 있음)
+    const uint32 n = (uint32)Count(AiBehavior::Idle);
+    if (n == 0)
+        return;
+
+    const uint64 steps = (uint64)ScanBudget(n) * ticks;
+    _idleCursor = (uint32)(((uint64)(_idleCursor % n) + steps) % n);
+    _cleanScans += steps;
+}
+
+void EnemyAi::SaveState(ByteWriter& w) const
+{
+    for (const auto& bucket : _buckets)
+    {
+        w.WriteU32LE((uint32)bucket.size());
+        for (const AiAgent& a : bucket)
+        {
+            w.WriteU32LE(a.enemy);
+            w.WriteF32LE(a.x);
+            w.WriteF32LE(a.y);
+            w.WriteF32LE(a.speed);
+            w.WriteU64LE(a.targetId);
+            w.WriteU32LE(a.readyTick);
+            w.WriteU16LE(a.damage);
+            w.WriteU16LE(a.intervalTicks);
+        }
+    }
+
+    w.WriteU32LE(_idleCursor);
+    w.WriteU32LE(_chaseCursor);
+    w.WriteU64LE(_cleanScans);
+    w.WriteF32LE(_maxSpeed);
+
+    w.WriteU32LE((uint32)_lastTargets.size());
+    for (const AiTarget& t : _lastTargets)
+    {
+        w.WriteU64LE(t.playerId);
+        w.WriteF32LE(t.x);
+        w.WriteF32LE(t.y);
+    }
+}
+
+bool EnemyAi::LoadState(ByteReader& r)
+{
+    Clear();
+
+    size_t total = 0;
+    for (size_t b = 0; b < _buckets.size(); ++b)
+    {
+        uint32 count = 0;
+        if (!r.ReadU32LE(count) || count > SLOT_POS_MASK || count > r.Remaining())
+            return false;
+
+        std::vector<AiAgent>& bucket = _buckets[b];
+        bucket.resize(count);
+        for (AiAgent& a : bucket)
+        {
+            if (!r.ReadU32LE(a.enemy) || !r.ReadF32LE(a.x) || !r.ReadF32LE(a.y) || !r.ReadF32LE(a.speed)
+                || !r.ReadU64LE(a.targetId) || !r.ReadU32LE(a.readyTick) || !r.ReadU16LE(a.damage) || !r.ReadU16LE(a.intervalTicks))
+                return false;
+        }
+        total += count;
+    }
+
+    // 적 index는 0 ~ total-1을 한 번씩
+    _slotOf.assign(total, UINT32_MAX);
+    for (size_t b = 0; b < _buckets.size(); ++b)
+    {
+        for (uint32 pos = 0; pos < (uint32)_buckets[b].size(); ++pos)
+        {
+            const uint32 enemy = _buckets[b][pos].enemy;
+            if (enemy >= total || _slotOf[enemy] != UINT32_MAX)
+                return false;
+            _slotOf[enemy] = ((uint32)b << SLOT_POS_BITS) | pos;
+        }
+    }
+
+    uint32 targets = 0;
+    if (!r.ReadU32LE(_idleCursor) || !r.ReadU32LE(_chaseCursor) || !r.ReadU64LE(_cleanScans) || !r.ReadF32LE(_maxSpeed)
+        || !r.ReadU32LE(targets) || targets > r.Remaining())
+        return false;
+
+    _lastTargets.resize(targets);
+    for (AiTarget& t : _lastTargets)
+    {
+        if (!r.ReadU64LE(t.playerId) || !r.ReadF32LE(t.x) || !r.ReadF32LE(t.y))
+            return false;
+    }
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,153 @@
+#include "game/HitResolver.h"
+
+#include <algorithm>
+#include <numeric>
+
+void HitResolver::BeginBodies(uint32 count)
+{
+    if (_bodies.size() == count)
+        return;
+
+    // 구간이 바뀌어 적 배열이 새로 채워짐 -> 이전 순서는 의미 없음
+    _bodies.assign(count, Body{});
+    _order.resize(count);
+    std::iota(_order.begin(), _order.end(), 0u);
+}
+
+void HitResolver::SetBody(uint32 index, float x, float y, float radius, bool active)
+{
+    Body& b = _bodies[index];
+    b.x = x;
+    b.y = y;
+    b.radius = radius;
+    b.active = active;
+}
+
+void HitResolver::SortBodies(ArenaVector<SweepBody>& sweep)
+{
+    // 직전 순서대로 옮겨 담고 (키가 연속 배치) 삽입 정렬 -> 거의 정렬된 입력에서 선형
+    const size_t n = _order.size();
+    sweep.resize(n);
+    for (size_t k = 0; k < n; ++k)
+    {
+        const uint32 index = _order[k];
+        const Body& b = _bodies[index];
+        sweep[k] = SweepBody{ b.x - b.radius, b.x + b.radius, b.x, b.y, b.radius, index, b.active };
+    }
+
+    // 동률은 index 순 (같은 입력이면 항상 같은 순서)
+    auto less = [](const SweepBody& a, const SweepBody& b) {
+        return a.minX < b.minX || (a.minX == b.minX && a.index < b.index);
+        };
+
+    for (size_t i = 1; i < n; ++i)
+    {
+        // 대부분 이미 제자리 -> 복사 없이 넘어감
+        if (!less(sweep[i], sweep[i - 1]))
+            continue;
+
+        const SweepBody v = sweep[i];
+        size_t j = i;
+        do
+        {
+            sweep[j] = sweep[j - 1];
+            --j;
+        } while (j > 0 && less(v, sweep[j - 1]));
+        sweep[j] = v;
+    }
+
+    _maxRadius = 0.f;
+    for (size_t k = 0; k < n; ++k)
+    {
+        _order[k] = sweep[k].index;
+        if (sweep[k].active)
+            _maxRadius = std::max(_maxRadius, sweep[k].radius);
+    }
+}
+
+bool HitResolver::Overlaps(const HitQuery& q, float x, float y, float radius)
+{
+    if (q.shape == HitShape::Box)
+    {
+        // 원 중심에서 가장 가까운 사각형 위 점
+        const float cx = std::clamp(x, q.x - q.extent, q.x + q.extent);
+        const float cy = std::clamp(y, q.y - q.extent, q.y + q.extent);
+        const float dx = x - cx;
+        const float dy = y - cy;
+        return dx * dx + dy * dy <= radius * radius;
+    }
+
+    const float dx = x - q.x;
+    const float dy = y - q.y;
+    const float reach = q.extent + radius;
+    return dx * dx + dy * dy <= reach * reach;
+}
+
+void HitResolver::Sweep(const ArenaVector<HitQuery>& queries, ArenaVector<HitPair>& out)
+{
+    out.clear();
+    if (queries.empty())
+        return;
+
+    ArenaVector<SweepBody> sweep;
+    SortBodies(sweep);
+    if (sweep.empty())
+        return;
+
+    ArenaVector<uint32> queryOrder(queries.size());
+    std::iota(queryOrder.begin(), queryOrder.end(), 0u);
+    std::sort(queryOrder.begin(), queryOrder.end(), [&](uint32 a, uint32 b) {
+        const float ka = queries[a].x - queries[a].extent - queries[a].margin;
+        const float kb = queries[b].x - queries[b].extent - queries[b].margin;
+        return ka < kb || (ka == kb && a < b);
+        });
+
+    // 몸체 폭은 최대 2 * _maxRadius -> 시작점이 query 시작보다 그만큼 앞선 몸체는 다시 볼 필요 없음
+    // query 시작점이 오름차순이라 begin은 앞으로만 감
+    const float maxWidth = 2.f * _maxRadius;
+    size_t begin = 0;
+
+    for (uint32 qi : queryOrder)
+    {
+        const HitQuery& q = queries[qi];
+        const float half = q.extent + q.margin;
+        const float qMin = q.x - half;
+        const float qMax = q.x + half;
+
+        while (begin < sweep.size() && sweep[begin].minX < qMin - maxWidth)
+            ++begin;
+
+        for (size_t j = begin; j < sweep.size() && sweep[j].minX <= qMax; ++j)
+        {
+            const SweepBody& b = sweep[j];
+            if (!b.active || b.maxX < qMin)
+                continue;
+
+            if (b.y + b.radius < q.y - half || b.y - b.radius > q.y + half)
+                continue;
+
+            out.push_back(HitPair{ qi, b.index });
+        }
+    }
+    _candidates += out.size();
+
+    // sweep 순서가 아니라 입력 순서로 적용해야 함 (먼저 들어온 시전이 먼저 잡음)
+    std::sort(out.begin(), out.end(), [](const HitPair& a, const HitPair& b) {
+        return a.query < b.query || (a.query == b.query && a.body < b.body);
+        });
+}
+
+void HitResolver::Query(const ArenaVector<HitQuery>& queries, ArenaVector<HitPair>& out)
+{
+    Sweep(queries, out);
+
+    // 정렬된 순서 유지한 채 narrowphase 통과만 남김
+    size_t kept = 0;
+    for (const HitPair& hit : out)
+    {
+        const Body& b = _bodies[hit.body];
+        if (Overlaps(queries[hit.query], b.x, b.y, b.radius))
+            out[kept++] = hit;
+    }
+    out.resize(kept);
+}
\ No newline at end of file
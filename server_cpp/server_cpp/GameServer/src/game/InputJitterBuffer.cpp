@@ -0,0 +1,144 @@
+#include "game/InputJitterBuffer.h"
+#include "common/ByteIO.h"
+#include "proto/Codec.h"
+
+InputJitterBuffer::PushResult InputJitterBuffer::Push(const PlayerInput& in)
+{
+    if (!_started)
+    {
+        _started = true;
+        _lastProcessed = in.seq - 1;
+    }
+
+    // seq는 uint32 wrap 허용: 차이로만 비교
+    const uint32 ahead = in.seq - _lastProcessed;
+    if (ahead == 0 || ahead > 0x80000000u)
+    {
+        ++_stats.duplicates;
+        return PushResult::Duplicate;
+    }
+
+    if (ahead > CAPACITY)
+    {
+        ++_stats.tooFar;
+        return PushResult::TooFar;
+    }
+
+    // 창 안의 seq는 슬롯이 1:1 -> 채워져 있으면 같은 seq 재전송
+    Slot& slot = SlotOf(in.seq);
+    if (slot.filled)
+    {
+        ++_stats.duplicates;
+        return PushResult::Duplicate;
+    }
+
+    slot.filled = true;
+    slot.input = in;
+    ++_buffered;
+    ++_stats.accepted;
+    return PushResult::Ok;
+}
+
+uint32 InputJitterBuffer::PopReady(std::array<PlayerInput, MAX_POP_PER_TICK>& out)
+{
+    uint32 n = 0;
+
+    while (n < MAX_POP_PER_TICK && _buffered > 0)
+    {
+        const uint32 next = _lastProcessed + 1;
+        Slot& slot = SlotOf(next);
+
+        if (slot.filled)
+        {
+            out[n++] = slot.input;
+            slot.filled = false;
+            --_buffered;
+            _lastProcessed = next;
+            _gapWaitTicks = 0;
+            continue;
+        }
+
+        // 빈 seq: 늦게 올 수 있으니 몇 tick은 기다림 (tick당 1회만 카운트)
+        if (++_gapWaitTicks < INPUT_GAP_WAIT_TICKS)
+            break;
+
+        // 유실로 보고 버퍼에 있는 다음 seq로 건너뜀
+        const uint32 lowest = LowestBufferedSeq();
+        _stats.skipped += lowest - next;
+        _lastProcessed = lowest - 1;
+        _gapWaitTicks = 0;
+    }
+
+    return n;
+}
+
+uint32 InputJitterBuffer::LowestBufferedSeq() const
+{
+    for (uint32 d = 1; d <= CAPACITY; ++d)
+    {
+        const uint32 seq = _lastProcessed + d;
+        if (_slots[seq & (CAPACITY - 1)].filled)
+            return seq;
+    }
+    return _lastProcessed + 1;
+}
+
+void InputJitterBuffer::SaveState(ByteWriter& w) const
+{
+    w.WriteU8(_started ? 1 : 0);
+    w.WriteU32LE(_lastProcessed);
+    w.WriteU32LE(_gapWaitTicks);
+
+    // 채워진 슬롯만 (seq로 위치가 정해짐)
+    w.WriteU32LE(_buffered);
+    for (const Slot& slot : _slots)
+    {
+        if (!slot.filled)
+            continue;
+
+        w.WriteU8((uint8)slot.input.kind);
+        w.WriteU32LE(slot.input.seq);
+        FixedCodec<C_MoveInput>::Encode(slot.input.move, w);
+        FixedCodec<C_CastSkill>::Encode(slot.input.cast, w);
+        FixedCodec<C_ChoiceVote>::Encode(slot.input.vote, w);
+    }
+}
+
+bool InputJitterBuffer::LoadState(ByteReader& r)
+{
+    constexpr size_t INPUT_BYTES = FixedCodec<C_MoveInput>::SIZE + FixedCodec<C_CastSkill>::SIZE + FixedCodec<C_ChoiceVote>::SIZE;
+
+    uint8 started = 0;
+    uint32 buffered = 0;
+    if (!r.ReadU8(started) || !r.ReadU32LE(_lastProcessed) || !r.ReadU32LE(_gapWaitTicks) || !r.ReadU32LE(buffered)
+        || buffered > CAPACITY)
+        return false;
+
+    _started = started != 0;
+    _slots = {};
+    _buffered = 0;
+
+    for (uint32 i = 0; i < buffered; ++i)
+    {
+        uint8 kind = 0;
+        PlayerInput in;
+        const Byte* bytes = nullptr;
+        if (!r.ReadU8(kind) || !r.ReadU32LE(in.seq) || !r.ReadBytes(INPUT_BYTES, bytes))
+            return false;
+
+        in.kind = (InputKind)kind;
+        FixedCodec<C_MoveInput>::DecodeUnchecked(bytes, in.move);
+        bytes += FixedCodec<C_MoveInput>::SIZE;
+        FixedCodec<C_CastSkill>::DecodeUnchecked(bytes, in.cast);
+        bytes += FixedCodec<C_CastSkill>::SIZE;
+        FixedCodec<C_ChoiceVote>::DecodeUnchecked(bytes, in.vote);
+
+        Slot& slot = SlotOf(in.seq);
+        if (slot.filled)
+            return false;
+        slot.filled = true;
+        slot.input = in;
+        ++_buffered;
+    }
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,184 @@
+#include "game/InputRecorder.h"
+#include "common/ThreadPlacement.h"
+#include "game/InputJitterBuffer.h"
+#include "proto/Codec.h"
+
+#include <iostream>
+
+static void Log(const std::string& tag, const std::string& msg)
+{
+    std::cout << "[" << tag << "] " << msg << "\n";
+}
+
+InputRecorder::InputRecorder()
+{
+    _tag = "InputRecorder";
+}
+
+InputRecorder::~InputRecorder()
+{
+    Stop();
+}
+
+bool InputRecorder::Start(const std::string& path, uint16 tickHz)
+{
+    if (_running.exchange(true))
+        return false;
+
+    _file.open(path, std::ios::binary | std::ios::trunc);
+    if (!_file.is_open())
+    {
+        Log(_tag, "Open failed: " + path);
+        _running.store(false);
+        return false;
+    }
+
+    ByteWriter header(INPUT_LOG_HEADER_SIZE);
+    header.WriteU32LE(INPUT_LOG_MAGIC);
+    header.WriteU16LE(INPUT_LOG_VERSION);
+    header.WriteU16LE(tickHz);
+    _file.write((const char*)header.buf.data(), (std::streamsize)header.Size());
+    _written.store(header.Size(), std::memory_order_relaxed);
+
+    _stopping = false;
+    _writer = std::thread(&InputRecorder::WriterLoop, this);
+
+    Log(_tag, "Recording to " + path);
+    return true;
+}
+
+void InputRecorder::Stop()
+{
+    // 멱등
+    if (!_running.exchange(false))
+        return;
+
+    Flush();
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _cv.notify_one();
+
+    if (_writer.joinable())
+        _writer.join();
+
+    _file.close();
+    Log(_tag, "Stopped (" + std::to_string(_written.load()) + " bytes)");
+}
+
+void InputRecorder::WriteRecordHeader(InputLogRecord type, uint32 roomId, uint32 tick, SessionId sid, uint16 bodyLen)
+{
+    _active.WriteU8((uint8)type);
+    _active.WriteU32LE(roomId);
+    _active.WriteU32LE(tick);
+    _active.WriteU64LE(sid);
+    _active.WriteU16LE(bodyLen);
+}
+
+void InputRecorder::RecordRoomOpen(uint32 roomId, uint32 tick)
+{
+    WriteRecordHeader(InputLogRecord::RoomOpen, roomId, tick, 0, 0);
+}
+
+void InputRecorder::RecordRoomClose(uint32 roomId, uint32 tick)
+{
+    WriteRecordHeader(InputLogRecord::RoomClose, roomId, tick, 0, 0);
+}
+
+void InputRecorder::RecordPlayerJoin(uint32 roomId, uint32 tick, SessionId sid)
+{
+    WriteRecordHeader(InputLogRecord::PlayerJoin, roomId, tick, sid, 0);
+}
+
+void InputRecorder::RecordPlayerLeave(uint32 roomId, uint32 tick, SessionId sid)
+{
+    WriteRecordHeader(InputLogRecord::PlayerLeave, roomId, tick, sid, 0);
+}
+
+void InputRecorder::RecordInput(uint32 roomId, uint32 tick, SessionId sid, const PlayerInput& in)
+{
+    // 원래 wire 바이트 그대로 (replay는 같은 Codec으로 decode)
+    switch (in.kind)
+    {
+    case InputKind::Move:
+        WriteRecordHeader(InputLogRecord::Input, roomId, tick, sid, (uint16)(2 + FixedCodec<C_MoveInput>::SIZE));
+        _active.WriteU16LE(C_MoveInput::ID);
+        FixedCodec<C_MoveInput>::Encode(in.move, _active);
+        return;
+
+    case InputKind::CastSkill:
+        WriteRecordHeader(InputLogRecord::Input, roomId, tick, sid, (uint16)(2 + FixedCodec<C_CastSkill>::SIZE));
+        _active.WriteU16LE(C_CastSkill::ID);
+        FixedCodec<C_CastSkill>::Encode(in.cast, _active);
+        return;
+
+    case InputKind::ChoiceVote:
+        WriteRecordHeader(InputLogRecord::Input, roomId, tick, sid, (uint16)(2 + FixedCodec<C_ChoiceVote>::SIZE));
+        _active.WriteU16LE(C_ChoiceVote::ID);
+        FixedCodec<C_ChoiceVote>::Encode(in.vote, _active);
+        return;
+    }
+}
+
+void InputRecorder::RecordChecksum(uint32 roomId, uint32 tick, uint64 hash)
+{
+    WriteRecordHeader(InputLogRecord::Checksum, roomId, tick, 0, 8);
+    _active.WriteU64LE(hash);
+}
+
+void InputRecorder::RecordRoomState(uint32 roomId, uint32 tick, const ByteBuffer& state)
+{
+    WriteRecordHeader(InputLogRecord::RoomState, roomId, tick, 0, (uint16)state.size());
+    _active.WriteBytes(state.data(), state.size());
+}
+
+void InputRecorder::Flush()
+{
+    if (_active.Size() == 0)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (_pending.empty())
+        {
+            // writer가 쓰고 비워둔 버퍼와 교체 (capacity 재사용)
+            _pending.swap(_active.buf);
+        }
+        else
+        {
+            // writer가 아직 이전 것을 못 가져감 -> 뒤에 붙임
+            _pending.insert(_pending.end(), _active.buf.begin(), _active.buf.end());
+        }
+    }
+    _active.Clear();
+    _cv.notify_one();
+}
+
+void InputRecorder::WriterLoop()
+{
+    ThreadPlacement::Pin(ThreadRole::Helper, 2);
+
+    ByteBuffer local;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _cv.wait(lock, [this] { return _stopping || !_pending.empty(); });
+
+            if (_pending.empty())
+                break; // _stopping && 남은 것 없음
+
+            local.swap(_pending);
+        }
+
+        _file.write((const char*)local.data(), (std::streamsize)local.size());
+        _written.fetch_add(local.size(), std::memory_order_relaxed);
+        local.clear();
+    }
+
+    _file.flush();
+}
\ No newline at end of file
@@ -0,0 +1,216 @@
+#include "game/ReplayRunner.h"
+#include "game/InputLog.h"
+#include "game/Room.h"
+#include "common/ByteIO.h"
+#include "common/TickArena.h"
+#include "proto/Codec.h"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <unordered_map>
+
+static void Log(const std::string& tag, const std::string& msg)
+{
+    std::cout << "[" << tag << "] " << msg << "\n";
+}
+
+ReplayRunner::ReplayRunner()
+{
+    _tag = "Replay";
+}
+
+bool ReplayRunner::Load(const std::string& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open())
+    {
+        Log(_tag, "Open failed: " + path);
+        return false;
+    }
+
+    _data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+
+    ByteReader r(_data.data(), _data.size());
+    uint32 magic = 0;
+    uint16 version = 0;
+    if (!r.ReadU32LE(magic) || !r.ReadU16LE(version) || !r.ReadU16LE(_tickHz)
+        || magic != INPUT_LOG_MAGIC || version != INPUT_LOG_VERSION || _tickHz == 0)
+    {
+        Log(_tag, "Bad header: " + path);
+        return false;
+    }
+
+    Log(_tag, "Loaded " + path + " (" + std::to_string(_data.size()) + " bytes, " + std::to_string(_tickHz) + "Hz)");
+    return true;
+}
+
+bool ReplayRunner::LoadContent(const std::string& path)
+{
+    _content = ContentTables::Load(path);
+    return _content != nullptr;
+}
+
+bool ReplayRunner::Run(Result& out)
+{
+    out = Result{};
+    if (_data.size() < INPUT_LOG_HEADER_SIZE)
+        return false;
+
+    // 라이브 tick 루프와 같은 dt 식 (float 결과까지 같아야 해시가 맞음)
+    const float dt = 1.f / (float)_tickHz;
+
+    std::unordered_map<uint32, std::unique_ptr<Room>> rooms;
+
+    // 기록된 tick까지 빈 tick을 돌려서 맞춤
+    auto advanceTo = [&](Room& room, uint32 tick) -> bool {
+        if (room.ServerTick() > tick)
+            return false;
+
+        while (room.ServerTick() < tick)
+        {
+            room.Update(dt, _content.get());
+            TickArena::ForThread().Reset();     // 라이브와 같이 tick마다 비움
+            ++out.roomTicks;
+        }
+        return true;
+    };
+
+    const auto t0 = std::chrono::steady_clock::now();
+
+    ByteReader r(_data.data() + INPUT_LOG_HEADER_SIZE, _data.size() - INPUT_LOG_HEADER_SIZE);
+    while (r.Remaining() > 0)
+    {
+        uint8 type = 0;
+        uint32 roomId = 0;
+        uint32 tick = 0;
+        SessionId sid = 0;
+        uint16 bodyLen = 0;
+        const Byte* body = nullptr;
+
+        if (!r.ReadU8(type) || !r.ReadU32LE(roomId) || !r.ReadU32LE(tick) || !r.ReadU64LE(sid)
+            || !r.ReadU16LE(bodyLen) || !r.ReadBytes(bodyLen, body))
+        {
+            out.truncated = true;
+            break;
+        }
+        ++out.records;
+
+        if ((InputLogRecord)type == InputLogRecord::RoomOpen)
+        {
+            rooms[roomId] = std::make_unique<Room>(roomId, _content.get());
+            ++out.rooms;
+            continue;
+        }
+
+        if ((InputLogRecord)type == InputLogRecord::RoomState)
+        {
+            // hot restart로 넘겨받은 방: 방금 RoomOpen으로 만든 방을 넘겨받은 시점 상태로 덮어씀
+            auto it = rooms.find(roomId);
+            ByteReader br(body, bodyLen);
+            if (it == rooms.end() || it->second->ServerTick() != 0 || !it->second->LoadState(br) || it->second->ServerTick() != tick)
+            {
+                if (it != rooms.end())
+                    rooms.erase(it);
+                ++out.badRecords;
+                continue;
+            }
+            ++out.importedRooms;
+            continue;
+        }
+
+        auto it = rooms.find(roomId);
+        if (it == rooms.end() || !advanceTo(*it->second, tick))
+        {
+            ++out.badRecords;
+            continue;
+        }
+        Room& room = *it->second;
+
+        switch ((InputLogRecord)type)
+        {
+        case InputLogRecord::RoomClose:
+            rooms.erase(it);
+            break;
+
+        case InputLogRecord::PlayerJoin:
+            room.AddPlayer(sid);
+            break;
+
+        case InputLogRecord::PlayerLeave:
+            room.RemovePlayer(sid);
+            break;
+
+        case InputLogRecord::Input:
+        {
+            ByteReader br(body, bodyLen);
+            MsgId msgId = 0;
+            const Byte* payload = nullptr;
+            PlayerInput in;
+            bool ok = br.ReadU16LE(msgId) && br.ReadBytes(br.Remaining(), payload);
+
+            if (ok && msgId == C_MoveInput::ID)
+            {
+                in.kind = InputKind::Move;
+                ok = Codec<C_MoveInput>::Decode(payload, bodyLen - 2, in.move);
+                in.seq = in.move.seq;
+            }
+            else if (ok && msgId == C_CastSkill::ID)
+            {
+                in.kind = InputKind::CastSkill;
+                ok = Codec<C_CastSkill>::Decode(payload, bodyLen - 2, in.cast);
+                in.seq = in.cast.seq;
+            }
+            else if (ok && msgId == C_ChoiceVote::ID)
+            {
+                in.kind = InputKind::ChoiceVote;
+                ok = Codec<C_ChoiceVote>::Decode(payload, bodyLen - 2, in.vote);
+                in.seq = in.vote.seq;
+            }
+            else
+            {
+                ok = false;
+            }
+
+            InputJitterBuffer::PushResult result;
+            if (!ok || !room.PushInput(sid, in, result))
+            {
+                ++out.badRecords;
+                break;
+            }
+            ++out.inputs;
+            break;
+        }
+
+        case InputLogRecord::Checksum:
+        {
+            ByteReader br(body, bodyLen);
+            uint64 expected = 0;
+            if (!br.ReadU64LE(expected))
+            {
+                ++out.badRecords;
+                break;
+            }
+
+            ++out.checksums;
+            if (room.StateHash() != expected)
+            {
+                // 처음 몇 개만 출력 (첫 지점이 원인, 이후는 연쇄)
+                if (out.mismatches < 8)
+                    Log(_tag, "Desync room=" + std::to_string(roomId) + " tick=" + std::to_string(tick));
+                ++out.mismatches;
+            }
+            break;
+        }
+
+        default:
+            ++out.badRecords;
+            break;
+        }
+    }
+
+    out.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,899 @@
+#include "game/Room.h"
+#include "common/ByteIO.h"
+#include "game/Checkpoint.h"
+#include "game/ContentTables.h"
+#include "game/WorldState.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+Room::Room(uint32 id, const ContentTables* content) : _id(id)
+{
+    BeginSegment(content);
+}
+
+bool Room::AddPlayer(SessionId sid)
+{
+    if (IsFull())
+        return false;
+
+    Player p;
+    p.sessionId = sid;
+    p.playerId = sid;   // 티켓 인증 연동 전: user_id 대신 세션 id 사용
+    p.x = 2.f * (float)_players.size();
+    p.y = 0.f;
+    p.hp = PLAYER_MAX_HP;
+
+    _players.push_back(p);
+    return true;
+}
+
+bool Room::PushInput(SessionId sid, const PlayerInput& in, InputJitterBuffer::PushResult& outResult)
+{
+    Player* p = FindPlayer(sid);
+    if (!p)
+        return false;
+
+    outResult = p->inputs.Push(in);
+    return true;
+}
+
+void Room::SetRtt(SessionId sid, uint32 rttMs, uint32 rttVarMs)
+{
+    Player* p = FindPlayer(sid);
+    if (p)
+    {
+        p->rttMs = rttMs;
+        p->rttVarMs = rttVarMs;
+    }
+}
+
+bool Room::ClampViewTick(SessionId sid, C_CastSkill& cast)
+{
+    const Player* p = FindPlayer(sid);
+    if (!p || p->rttMs == 0 || cast.viewTick >= _tick)
+        return false;
+
+    // 클라가 보는 스냅샷은 (편도 + 보간 지연)만큼 과거, 그걸 보고 쏜 입력은 다시 편도 뒤 도착
+    // -> 정상 클라의 되감기 = 왕복 + 보간 지연. 지터만큼은 여유로 줌
+    const uint32 slackMs = p->rttMs + LAG_COMP_RTTVAR_MARGIN * p->rttVarMs;
+    const uint32 allowed = (slackMs * TICK_HZ + 999) / 1000 + 2 * _schedule.snapshotEvery + 1;
+    if (_tick - cast.viewTick <= allowed)
+        return false;
+
+    cast.viewTick = _tick > allowed ? _tick - allowed : 0;
+    return true;
+}
+
+Player* Room::FindPlayer(SessionId sid)
+{
+    // 방 인원이 작아서 선형 탐색
+    for (Player& p : _players)
+    {
+        if (p.sessionId == sid)
+            return &p;
+    }
+    return nullptr;
+}
+
+void Room::RemovePlayer(SessionId sid)
+{
+    auto it = std::find_if(_players.begin(), _players.end(), [&](const Player& p) { return p.sessionId == sid; });
+    if (it == _players.end())
+        return;
+
+    if (it != _players.end() - 1)
+        *it = std::move(_players.back());
+    _players.pop_back();
+
+    // 안 한 사람이 나가서 투표가 끝날 수도 있음 (Transition 진입은 content 불필요)
+    if (_segment == SegmentState::Choice && !_players.empty() && AllVoted())
+        FireSegmentEvent(SegmentEvent::VoteComplete, nullptr);
+}
+
+bool Room::IsFull() const
+{
+    return _players.size() >= MAX_PLAYERS_PER_ROOM;
+}
+
+void Room::Update(float dt, const ContentTables* content)
+{
+    std::array<PlayerInput, InputJitterBuffer::MAX_POP_PER_TICK> ready;
+    CastBatch batch;
+
+    // 시전 판정이 되감을 수 있으므로 입력보다 먼저 (Skip 후 처음 Update할 때만)
+    if (_historyTick != _tick)
+        RestoreHistory();
+
+    for (Player& p : _players)
+    {
+        const uint32 n = p.inputs.PopReady(ready);
+        for (uint32 i = 0; i < n; ++i)
+            ApplyInput(p, ready[i], content, batch);
+    }
+
+    ResolveSkills(dt, content, batch);
+
+    // 입력/시전으로 구간이 바뀌었을 수 있으므로 소비 후에 판단
+    const bool simulate = !IsDormantSegment(_segment);
+
+    if (simulate)
+    {
+        for (Player& p : _players)
+        {
+            if (p.state == ENTITY_STATE_DEAD)
+                continue;
+
+            p.x += p.moveDirX * PLAYER_MOVE_SPEED * dt;
+            p.y += p.moveDirY * PLAYER_MOVE_SPEED * dt;
+        }
+
+        UpdateEnemies(dt);
+        ResolveCollisions();
+    }
+
+    ++_tick;
+
+    // 스냅샷은 tick 끝 상태 -> 같은 tick 번호로 기록해야 클라 viewTick과 맞음
+    // 죽은 적은 Dead 버킷에 그대로 (되감기로 죽기 전 위치를 봐야 할 수 있음)
+    if (simulate)
+    {
+        for (uint32 b = 0; b < (uint32)AiBehavior::Count; ++b)
+        {
+            for (const AiAgent& a : _ai.Bucket((AiBehavior)b))
+                _enemies[a.enemy].history.Record(_tick, a.x, a.y);
+        }
+    }
+    _historyTick = _tick;
+
+    if (_segmentTimerTick != 0 && _tick >= _segmentTimerTick)
+    {
+        _segmentTimerTick = 0;
+        FireSegmentEvent(SegmentEvent::TimerFired, content);
+    }
+}
+
+void Room::UpdateEnemies(float dt)
+{
+    ArenaVector<AiTarget> targets;
+    targets.reserve(_players.size());
+    for (const Player& p : _players)
+    {
+        if (p.state != ENTITY_STATE_DEAD)
+            targets.push_back(AiTarget{ p.playerId, p.x, p.y });
+    }
+
+    ArenaVector<AiHit> hits;
+    hits.reserve(_ai.Count(AiBehavior::Attack));
+    _ai.Update(_tick, dt, targets, hits);
+
+    for (const AiHit& hit : hits)
+    {
+        // 같은 tick에 앞선 타격으로 이미 죽었을 수 있음
+        for (Player& p : _players)
+        {
+            if (p.playerId != hit.playerId || p.state == ENTITY_STATE_DEAD)
+                continue;
+
+            p.hp = p.hp > hit.damage ? (uint16)(p.hp - hit.damage) : 0;
+            if (p.hp == 0)
+            {
+                p.state = ENTITY_STATE_DEAD;
+                p.moveDirX = 0.f;
+                p.moveDirY = 0.f;
+            }
+            ++_enemyHits;
+            break;
+        }
+    }
+}
+
+bool Room::CanSleep() const
+{
+    for (const Player& p : _players)
+    {
+        if (p.inputs.Buffered() > 0)
+            return false;
+    }
+
+    if (IsDormantSegment(_segment))
+        return true;
+
+    // 이동 중인 플레이어가 있으면 tick마다 위치가 바뀜 (죽은 플레이어는 안 움직임)
+    for (const Player& p : _players)
+    {
+        if (p.state != ENTITY_STATE_DEAD && (p.moveDirX != 0.f || p.moveDirY != 0.f))
+            return false;
+    }
+
+    // 밀어낸 직후는 다른 적과 겹쳤을 수 있음 -> 한 tick 더 돌려서 확인
+    if (_contacts != 0)
+        return false;
+
+    // 쫓거나 때리는 적이 있거나, 아직 대상 탐색이 한 바퀴 안 돈 상태
+    return _ai.Settled();
+}
+
+uint32 Room::TicksUntilTimer() const
+{
+    if (_segmentTimerTick == 0 || _segmentTimerTick <= _tick)
+        return 0;
+    return _segmentTimerTick - _tick;
+}
+
+void Room::Skip(uint32 ticks)
+{
+    const uint32 untilTimer = TicksUntilTimer();
+    if (untilTimer != 0 && ticks >= untilTimer)
+        ticks = untilTimer - 1;
+
+    if (ticks == 0)
+        return;
+
+    if (IsDormantSegment(_segment))
+    {
+        // 이동/이력 없음 -> tick만
+        _tick += ticks;
+        _historyTick = _tick;
+        return;
+    }
+
+    // 정지 방: 아무것도 안 움직이고 AI는 Idle 탐색 커서만 돎
+    // 이력은 다음 Update에서 복원 (계속 자는 동안엔 기록 안 함)
+    _ai.Skip(ticks);
+    _tick += ticks;
+}
+
+void Room::RestoreHistory()
+{
+    // 링에 남는 마지막 LAG_COMP_HISTORY_TICKS개만 기록 (그보다 오래된 건 덮여 없어질 값)
+    const uint32 from = _historyTick + 1;
+    const uint32 keepFrom = _tick >= LAG_COMP_HISTORY_TICKS ? _tick - LAG_COMP_HISTORY_TICKS + 1 : 0;
+    const uint32 recordFrom = std::max(from, keepFrom);
+
+    // Skip은 Settled 상태에서만 -> 밀린 구간 동안 적 위치는 그대로
+    for (uint32 b = 0; b < (uint32)AiBehavior::Count; ++b)
+    {
+        for (const AiAgent& a : _ai.Bucket((AiBehavior)b))
+        {
+            Enemy& e = _enemies[a.enemy];
+            for (uint32 t = recordFrom; t <= _tick; ++t)
+                e.history.Record(t, a.x, a.y);
+        }
+    }
+
+    _historyTick = _tick;
+}
+
+uint32 Room::SnapshotEveryTicks() const
+{
+    if (IsDormantSegment(_segment))
+        return SEGMENT_DORMANT_TICK_STRIDE;
+
+    // 전원 정지: 방도 이 주기로만 시뮬레이션 (RoomManager가 재움)
+    if (CanSleep())
+        return SNAPSHOT_QUIET_EVERY_TICKS;
+
+    // 지터가 크면 클라 보간 버퍼도 그만큼 길어야 해서 RTT가 큰 것과 같음
+    uint32 maxRtt = 0;
+    for (const Player& p : _players)
+        maxRtt = std::max(maxRtt, p.rttMs + 2 * p.rttVarMs);
+
+    // 전투 중이고 전원 RTT가 낮을 때만 올림 (RTT가 크면 체감 지연이 RTT에 묶여서 효과가 작음)
+    // 적이 때리고 있어도 전투 (맞는 쪽도 hp가 빨리 보여야 함)
+    const bool casting = _lastCastTick != 0 && _tick - _lastCastTick < SNAPSHOT_COMBAT_WINDOW_TICKS;
+    const bool combat = casting || _ai.Count(AiBehavior::Attack) > 0;
+    if (combat && maxRtt != 0 && maxRtt <= SNAPSHOT_FAST_RTT_MS)
+        return SNAPSHOT_MIN_EVERY_TICKS;
+
+    // RTT가 크면 클라 보간 버퍼가 어차피 길어서 한 단계 늦춰도 차이가 작고, 혼잡한 링크로 나가는 양이 줄어듦
+    if (maxRtt >= SNAPSHOT_SLOW_RTT_MS)
+        return SNAPSHOT_EVERY_TICKS + 1;
+
+    return SNAPSHOT_EVERY_TICKS;
+}
+
+void Room::ApplyInput(Player& p, const PlayerInput& in, const ContentTables* content, CastBatch& batch)
+{
+    if (p.state == ENTITY_STATE_DEAD)
+        return;
+
+    switch (in.kind)
+    {
+    case InputKind::Move:
+    {
+        // 방향만 신뢰 (-1/0/1 밖은 잘라냄), 대각선은 정규화
+        float dx = (float)std::clamp<int>(in.move.dirX, -1, 1);
+        float dy = (float)std::clamp<int>(in.move.dirY, -1, 1);
+        if (dx != 0.f && dy != 0.f)
+        {
+            dx *= 0.70710678f;
+            dy *= 0.70710678f;
+        }
+        p.moveDirX = dx;
+        p.moveDirY = dy;
+        return;
+    }
+
+    case InputKind::CastSkill:
+        QueueSkill(p, in.cast, content, batch);
+        return;
+
+    case InputKind::ChoiceVote:
+        ApplyVote(p, in.vote, content);
+        return;
+    }
+}
+
+void Room::ApplyVote(Player& p, const C_ChoiceVote& vote, const ContentTables* content)
+{
+    if (_segment != SegmentState::Choice || vote.choice >= SEGMENT_CHOICE_OPTIONS)
+        return;
+
+    p.vote = (int8)vote.choice;
+
+    // 마지막 한 표가 들어온 순간이 이벤트 (tick마다 투표 수를 세지 않음)
+    if (AllVoted())
+        FireSegmentEvent(SegmentEvent::VoteComplete, content);
+}
+
+bool Room::AllVoted() const
+{
+    for (const Player& p : _players)
+    {
+        if (p.vote < 0)
+            return false;
+    }
+    return true;
+}
+
+uint8 Room::TallyVotes() const
+{
+    // 최다 득표, 동률이면 낮은 번호, 표가 없으면 0
+    std::array<uint32, SEGMENT_CHOICE_OPTIONS> counts{};
+    for (const Player& p : _players)
+    {
+        if (p.vote >= 0)
+            ++counts[(size_t)p.vote];
+    }
+
+    uint8 best = 0;
+    for (uint8 i = 1; i < SEGMENT_CHOICE_OPTIONS; ++i)
+    {
+        if (counts[i] > counts[best])
+            best = i;
+    }
+    return best;
+}
+
+void Room::FireSegmentEvent(SegmentEvent ev, const ContentTables* content)
+{
+    SegmentState next;
+    if (!NextSegmentState(_segment, ev, next))
+        return;
+
+    EnterSegmentState(next, content);
+}
+
+void Room::EnterSegmentState(SegmentState next, const ContentTables* content)
+{
+    const SegmentState prev = _segment;
+    _segment = next;
+    ++_segmentTransitions;
+
+    const uint32 timerTicks = SegmentInfo(next).timerTicks;
+    _segmentTimerTick = timerTicks > 0 ? _tick + timerTicks : 0;
+
+    switch (next)
+    {
+    case SegmentState::Choice:
+        for (Player& p : _players)
+            p.vote = -1;
+        break;
+
+    case SegmentState::Transition:
+        if (prev == SegmentState::Choice)
+            _lastChoice = TallyVotes();
+        break;
+
+    case SegmentState::InSegment:
+        BeginSegment(content);
+        break;
+
+    case SegmentState::Clear:
+        break;
+    }
+}
+
+void Room::QueueSkill(Player& caster, const C_CastSkill& cast, const ContentTables* content, CastBatch& batch)
+{
+    HitQuery query;
+    query.x = cast.targetX;
+    query.y = cast.targetY;
+    query.extent = SKILL_HIT_RADIUS;
+    uint16 damage = SKILL_DAMAGE;
+    float range = 0.f;          // 0 = 사거리 제한 없음
+    uint32 cooldownTicks = 0;
+
+    if (content)
+    {
+        const SkillDef* def = content->FindSkill(cast.skillId);
+        if (!def)
+        {
+            ++_rejectedCasts;
+            return;
+        }
+
+        query.shape = def->shape == (uint8)HitShape::Box ? HitShape::Box : HitShape::Circle;
+        query.extent = def->radius;
+        damage = def->damage;
+        range = def->range;
+        cooldownTicks = (def->cooldownMs * TICK_HZ + 999) / 1000;
+    }
+
+    // 전투 없는 구간 (dormant 방에 들어온 시전 입력)
+    if (IsDormantSegment(_segment))
+    {
+        ++_rejectedCasts;
+        return;
+    }
+
+    if (_tick < caster.skillReadyTick)
+    {
+        ++_rejectedCasts;
+        return;
+    }
+
+    if (range > 0.f)
+    {
+        const float cx = cast.targetX - caster.x;
+        const float cy = cast.targetY - caster.y;
+        if (cx * cx + cy * cy > range * range)
+        {
+            ++_rejectedCasts;
+            return;
+        }
+    }
+
+    ++_skillCasts;
+    caster.skillReadyTick = _tick + cooldownTicks;
+    _lastCastTick = _tick;
+
+    // 클라가 보던 tick으로 되감기 (미래 tick은 현재로, 너무 과거는 이력 길이까지만)
+    uint32 rewind = 0;
+    if (cast.viewTick < _tick)
+        rewind = std::min<uint32>(_tick - cast.viewTick, LAG_COMP_MAX_REWIND_TICKS);
+
+    _rewindTicks += rewind;
+
+    batch.casts.push_back(PendingCast{ _tick - rewind, damage });
+    batch.queries.push_back(query);
+}
+
+void Room::ResolveSkills(float dt, const ContentTables* content, CastBatch& batch)
+{
+    if (batch.casts.empty())
+        return;
+
+    const uint32 enemyCount = (uint32)_enemies.size();
+    _hits.BeginBodies(enemyCount);
+    for (uint32 i = 0; i < enemyCount; ++i)
+    {
+        const AiAgent& a = _ai.Agent(i);
+        _hits.SetBody(i, a.x, a.y, _enemies[i].hitRadius, _enemies[i].state != ENTITY_STATE_DEAD);
+    }
+
+    // 되감은 tick 위치는 현재 위치에서 (최고 속도 * 되감은 시간) 안쪽 (+ float 오차 여유)
+    const float perTick = _ai.MaxSpeed() * dt;
+    for (uint32 i = 0; i < (uint32)batch.casts.size(); ++i)
+        batch.queries[i].margin = perTick * (float)(_tick - batch.casts[i].atTick) + 0.01f;
+
+    ArenaVector<HitPair> pairs;
+    _hits.Sweep(batch.queries, pairs);
+
+    // 후보는 시전 순 -> 적 index 순
+    for (const HitPair& hit : pairs)
+    {
+        Enemy& e = _enemies[hit.body];
+        if (e.state == ENTITY_STATE_DEAD)
+            continue;
+
+        const PendingCast& cast = batch.casts[hit.query];
+        const AiAgent& a = _ai.Agent(hit.body);
+        float ex = a.x;
+        float ey = a.y;
+        e.history.At(cast.atTick, ex, ey);  // 이력이 없으면(막 스폰) 현재 위치
+
+        if (!HitResolver::Overlaps(batch.queries[hit.query], ex, ey, e.hitRadius))
+            continue;
+
+        e.hp = e.hp > cast.damage ? (uint16)(e.hp - cast.damage) : 0;
+        if (e.hp == 0)
+        {
+            e.state = ENTITY_STATE_DEAD;
+            --_aliveEnemies;
+            _ai.Kill(hit.body);
+        }
+
+        MarkCheckpointDirty(hit.body);
+    }
+
+    // 마지막 적이 죽은 순간이 구간 클리어 이벤트
+    if (_aliveEnemies == 0 && _segment == SegmentState::InSegment)
+        FireSegmentEvent(SegmentEvent::AllEnemiesDead, content);
+}
+
+void Room::ResolveCollisions()
+{
+    _contacts = 0;
+    if (_aliveEnemies == 0)
+        return;
+
+    ArenaVector<HitQuery> bodies;        // 충돌용 플레이어 몸체
+    ArenaVector<uint32> bodyPlayers;     // bodies index -> 플레이어 index
+    bodies.reserve(_players.size());
+    bodyPlayers.reserve(_players.size());
+    for (uint32 i = 0; i < (uint32)_players.size(); ++i)
+    {
+        const Player& p = _players[i];
+        if (p.state == ENTITY_STATE_DEAD)
+            continue;
+
+        HitQuery q;
+        q.x = p.x;
+        q.y = p.y;
+        q.extent = PLAYER_RADIUS;
+        bodies.push_back(q);
+        bodyPlayers.push_back(i);
+    }
+
+    if (bodies.empty())
+        return;
+
+    const uint32 enemyCount = (uint32)_enemies.size();
+    _hits.BeginBodies(enemyCount);
+    for (uint32 i = 0; i < enemyCount; ++i)
+    {
+        const AiAgent& a = _ai.Agent(i);
+        _hits.SetBody(i, a.x, a.y, _enemies[i].hitRadius, _enemies[i].state != ENTITY_STATE_DEAD);
+    }
+
+    ArenaVector<HitPair> pairs;
+    _hits.Query(bodies, pairs);
+
+    // 플레이어 순 -> 적 index 순. 앞에서 밀린 위치로 다시 확인 (밀려서 안 겹치게 됐을 수 있음)
+    for (const HitPair& hit : pairs)
+    {
+        Player& p = _players[bodyPlayers[hit.query]];
+        const AiAgent& a = _ai.Agent(hit.body);
+
+        const float reach = PLAYER_RADIUS + _enemies[hit.body].hitRadius;
+        const float dx = p.x - a.x;
+        const float dy = p.y - a.y;
+        const float d2 = dx * dx + dy * dy;
+        if (d2 >= reach * reach)
+            continue;
+
+        // 정확히 겹치면 방향이 없음 -> +x로
+        const float d = std::sqrt(d2);
+        const float nx = d > 0.f ? dx / d : 1.f;
+        const float ny = d > 0.f ? dy / d : 0.f;
+        p.x = a.x + nx * (reach + COLLISION_SLOP);
+        p.y = a.y + ny * (reach + COLLISION_SLOP);
+        ++_contacts;
+    }
+}
+
+void Room::MarkCheckpointDirty(uint32 enemyIndex)
+{
+    Enemy& e = _enemies[enemyIndex];
+    if (e.checkpointDirty)
+        return;
+
+    e.checkpointDirty = true;
+    _checkpointDirty.push_back(enemyIndex);
+}
+
+static void HashBytes(uint64& h, const void* data, size_t len)
+{
+    const Byte* p = (const Byte*)data;
+    for (size_t i = 0; i < len; ++i)
+    {
+        h ^= p[i];
+        h *= 1099511628211ull;
+    }
+}
+
+template <typename T>
+static void HashValue(uint64& h, const T& v)
+{
+    HashBytes(h, &v, sizeof(T));
+}
+
+uint64 Room::StateHash() const
+{
+    uint64 h = 14695981039346656037ull;
+
+    HashValue(h, _tick);
+    HashValue(h, _segment);
+    HashValue(h, _segmentIndex);
+    HashValue(h, _segmentTimerTick);
+    for (const Player& p : _players)
+    {
+        HashValue(h, p.sessionId);
+        HashValue(h, p.x);
+        HashValue(h, p.y);
+        HashValue(h, p.hp);
+        HashValue(h, p.state);
+        HashValue(h, p.inputs.LastProcessedSeq());
+        HashValue(h, p.vote);
+    }
+    for (uint32 i = 0; i < (uint32)_enemies.size(); ++i)
+    {
+        const Enemy& e = _enemies[i];
+        const AiAgent& a = _ai.Agent(i);
+        HashValue(h, e.id);
+        HashValue(h, a.x);
+        HashValue(h, a.y);
+        HashValue(h, e.hp);
+        HashValue(h, e.state);
+        HashValue(h, _ai.BehaviorOf(i));
+        HashValue(h, a.targetId);
+    }
+    return h;
+}
+
+uint32 Room::Capture(WorldState& out, uint32 snapshotEvery)
+{
+    out.Clear();
+
+    out.roomId = _id;
+    out.serverTick = _tick;
+    out.segmentState = _segment;
+
+    for (const Player& p : _players)
+    {
+        SnapshotPlayer sp;
+        sp.id = p.playerId;
+        sp.x = p.x;
+        sp.y = p.y;
+        sp.hp = p.hp;
+        sp.state = p.state;
+        sp.lastInputSeq = p.inputs.LastProcessedSeq();
+        out.players.push_back(sp);
+
+        out.recipients.push_back(p.sessionId);
+    }
+
+    for (uint32 i = 0; i < (uint32)_enemies.size(); ++i)
+    {
+        const Enemy& e = _enemies[i];
+        const AiAgent& a = _ai.Agent(i);
+
+        SnapshotEnemy se;
+        se.id = e.id;
+        se.x = a.x;
+        se.y = a.y;
+        se.hp = e.hp;
+        se.state = e.state;
+        out.enemies.push_back(se);
+    }
+
+    // 플레이어는 항상 전부 (인원 상한이 작고 reconcile용 lastInputSeq가 실림), 적만 예산 안에서 고름
+    const uint32 enemyCount = (uint32)out.enemies.size();
+    const uint32 maxEnemies = SnapshotPriority::EnemyBudget((uint32)_players.size(), snapshotEvery);
+    if (enemyCount <= maxEnemies)
+    {
+        for (Player& p : _players)
+            p.snapshotPriority.MarkAllSent(_tick, out.enemies.data(), enemyCount);
+        return 0;
+    }
+
+    out.partial = true;
+    uint32 omitted = 0;
+    for (Player& p : _players)
+    {
+        const uint32 n = p.snapshotPriority.Select(_tick, p.x, p.y, out.enemies.data(), enemyCount, maxEnemies, out.enemySel);
+        out.selEnd.push_back((uint32)out.enemySel.size());
+        omitted += enemyCount - n;
+    }
+    return omitted;
+}
+
+void Room::SaveState(ByteWriter& w) const
+{
+    w.WriteU32LE(_tick);
+    w.WriteU8((uint8)_segment);
+    w.WriteU32LE(_segmentIndex);
+    w.WriteU32LE(_segmentTimerTick);
+    w.WriteU32LE(_aliveEnemies);
+    w.WriteU8(_lastChoice);
+    w.WriteU32LE(_historyTick);
+    w.WriteU32LE(_lastCastTick);
+    w.WriteU32LE(_contacts);
+    w.WriteU32LE(_nextEnemyId);
+
+    w.WriteU32LE((uint32)_players.size());
+    for (const Player& p : _players)
+    {
+        w.WriteU64LE(p.sessionId);
+        w.WriteU64LE(p.playerId);
+        w.WriteF32LE(p.x);
+        w.WriteF32LE(p.y);
+        w.WriteU16LE(p.hp);
+        w.WriteU8(p.state);
+        w.WriteF32LE(p.moveDirX);
+        w.WriteF32LE(p.moveDirY);
+        w.WriteU32LE(p.skillReadyTick);
+        w.WriteI8(p.vote);
+        w.WriteU32LE(p.rttMs);
+        w.WriteU32LE(p.rttVarMs);
+        p.inputs.SaveState(w);
+    }
+
+    w.WriteU32LE((uint32)_enemies.size());
+    for (const Enemy& e : _enemies)
+    {
+        w.WriteU32LE(e.id);
+        w.WriteU16LE(e.hp);
+        w.WriteU8(e.state);
+        w.WriteU16LE(e.defId);
+        w.WriteF32LE(e.hitRadius);
+        e.history.SaveState(w);
+    }
+
+    _ai.SaveState(w);
+}
+
+bool Room::LoadState(ByteReader& r)
+{
+    uint8 segment = 0;
+    if (!r.ReadU32LE(_tick) || !r.ReadU8(segment) || !r.ReadU32LE(_segmentIndex) || !r.ReadU32LE(_segmentTimerTick)
+        || !r.ReadU32LE(_aliveEnemies) || !r.ReadU8(_lastChoice) || !r.ReadU32LE(_historyTick) || !r.ReadU32LE(_lastCastTick)
+        || !r.ReadU32LE(_contacts) || !r.ReadU32LE(_nextEnemyId))
+        return false;
+    _segment = (SegmentState)segment;
+
+    uint32 players = 0;
+    if (!r.ReadU32LE(players) || players > MAX_PLAYERS_PER_ROOM)
+        return false;
+
+    _players.assign(players, Player{});
+    for (Player& p : _players)
+    {
+        if (!r.ReadU64LE(p.sessionId) || !r.ReadU64LE(p.playerId) || !r.ReadF32LE(p.x) || !r.ReadF32LE(p.y)
+            || !r.ReadU16LE(p.hp) || !r.ReadU8(p.state) || !r.ReadF32LE(p.moveDirX) || !r.ReadF32LE(p.moveDirY)
+            || !r.ReadU32LE(p.skillReadyTick) || !r.ReadI8(p.vote) || !r.ReadU32LE(p.rttMs) || !r.ReadU32LE(p.rttVarMs)
+            || !p.inputs.LoadState(r))
+            return false;
+    }
+
+    uint32 enemies = 0;
+    if (!r.ReadU32LE(enemies) || enemies > r.Remaining())
+        return false;
+
+    _enemies.assign(enemies, Enemy{});
+    _checkpointDirty.clear();
+    for (Enemy& e : _enemies)
+    {
+        if (!r.ReadU32LE(e.id) || !r.ReadU16LE(e.hp) || !r.ReadU8(e.state) || !r.ReadU16LE(e.defId)
+            || !r.ReadF32LE(e.hitRadius) || !e.history.LoadState(r))
+            return false;
+    }
+
+    if (!_ai.LoadState(r))
+        return false;
+
+    // AI 쪽 적 수가 다르면 index가 어긋남
+    size_t agents = 0;
+    for (uint32 b = 0; b < (uint32)AiBehavior::Count; ++b)
+        agents += _ai.Count((AiBehavior)b);
+    if (agents != _enemies.size())
+        return false;
+
+    for (uint32 i = 0; i < (uint32)_enemies.size(); ++i)
+        MarkCheckpointDirty(i);
+    return true;
+}
+
+void Room::CaptureCheckpoint(CheckpointDelta& out)
+{
+    out.Clear();
+
+    out.roomId = _id;
+    out.serverTick = _tick;
+    out.segmentState = _segment;
+    out.enemyCount = (uint32)_enemies.size();
+
+    for (const Player& p : _players)
+    {
+        CheckpointPlayer cp;
+        cp.playerId = p.playerId;
+        cp.x = p.x;
+        cp.y = p.y;
+        cp.hp = p.hp;
+        cp.state = p.state;
+        out.players.push_back(cp);
+    }
+
+    out.dirtyEnemies.reserve(_checkpointDirty.size());
+    for (uint32 index : _checkpointDirty)
+    {
+        Enemy& e = _enemies[index];
+        e.checkpointDirty = false;
+
+        CheckpointEnemy ce;
+        ce.index = index;
+        ce.id = e.id;
+        ce.defId = e.defId;
+        ce.hp = e.hp;
+        ce.state = e.state;
+        out.dirtyEnemies.push_back(ce);
+    }
+    _checkpointDirty.clear();
+}
+
+void Room::BeginSegment(const ContentTables* content)
+{
+    ++_segmentIndex;
+
+    // 이전 구간 적은 모두 죽은 상태 -> 배열을 새로 채움 (체크포인트는 새 적이 전부 dirty라 통째로 바뀜)
+    _enemies.clear();
+    _checkpointDirty.clear();
+    _ai.Clear();
+
+    // 죽은 플레이어는 다음 구간 시작에 부활 (부활 규칙 생기기 전 임시)
+    for (Player& p : _players)
+    {
+        if (p.state == ENTITY_STATE_DEAD)
+        {
+            p.state = ENTITY_STATE_ALIVE;
+            p.hp = PLAYER_MAX_HP;
+        }
+    }
+
+    SpawnSegmentEnemies(content);
+    _aliveEnemies = (uint32)_enemies.size();
+}
+
+void Room::SpawnSegmentEnemies(const ContentTables* content)
+{
+    // 구간 시작: 원형으로 배치
+    const float radius = 10.f;
+    for (uint32 i = 0; i < ENEMIES_PER_SEGMENT; ++i)
+    {
+        const float a = 6.2831853f * (float)i / (float)ENEMIES_PER_SEGMENT;
+
+        const float x = radius * std::cos(a);
+        const float y = radius * std::sin(a);
+
+        Enemy e;
+        e.id = _nextEnemyId++;
+        e.hp = ENEMY_MAX_HP;
+
+        float speed = ENEMY_MOVE_SPEED;
+        uint16 damage = ENEMY_ATTACK_DAMAGE;
+        uint32 intervalTicks = ENEMY_ATTACK_INTERVAL_TICKS;
+
+        // 테이블 순서대로 돌려가며 배치 (구간별 구성 데이터 생기기 전 임시)
+        if (content && content->EnemyCount() > 0)
+        {
+            const EnemyDef& def = content->Enemies()[i % content->EnemyCount()];
+            e.defId = def.id;
+            e.hp = def.maxHp;
+            e.hitRadius = def.radius;
+
+            speed = def.moveSpeed;
+            damage = def.attackDamage;
+            intervalTicks = std::max<uint32>((def.attackIntervalMs * TICK_HZ + 999) / 1000, 1);
+        }
+
+        e.history.Record(_tick, x, y);
+        _ai.Add((uint32)_enemies.size(), x, y, speed, damage, (uint16)intervalTicks);
+        _enemies.push_back(e);
+
+        // 새 적은 다음 체크포인트에 전부 들어가야 함
+        MarkCheckpointDirty((uint32)_enemies.size() - 1);
+    }
+}
\ No newline at end of file
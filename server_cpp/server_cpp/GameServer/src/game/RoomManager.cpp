@@ -0,0 +1,882 @@
+#include "game/RoomManager.h"
+#include "net/GameLink.h"
+#include "net/SessionManager.h"
+#include "common/ServerClock.h"
+#include "common/ThreadPlacement.h"
+#include "game/SpectatorRelay.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+static void Log(const std::string& tag, const std::string& msg)
+{
+    std::cout << "[" << tag << "] " << msg << "\n";
+}
+
+RoomManager::RoomManager(SessionManager* mgr) : _sessionMgr(mgr), _pipeline(mgr)
+{
+    _tag = "RoomManager";
+}
+
+RoomManager::~RoomManager()
+{
+    Stop();
+}
+
+bool RoomManager::EnableRecording(const std::string& path)
+{
+    if (_running.load())
+        return false;
+
+    auto recorder = std::make_unique<InputRecorder>();
+    if (!recorder->Start(path, (uint16)TICK_HZ))
+        return false;
+
+    _recorder = std::move(recorder);
+    return true;
+}
+
+bool RoomManager::EnableCheckpoints(const std::string& host, uint16 port)
+{
+    if (_running.load())
+        return false;
+
+    auto checkpoints = std::make_unique<CheckpointService>();
+    if (!checkpoints->Start(host, port))
+        return false;
+
+    _checkpoints = std::move(checkpoints);
+    return true;
+}
+
+bool RoomManager::Start()
+{
+    if (_running.exchange(true))
+        return false;
+
+    if (!_pipeline.Start())
+    {
+        _running.store(false);
+        return false;
+    }
+
+    _workers.Start();
+    _laneSkipped.assign(_workers.Lanes(), 0);
+
+    _tickThread = std::thread(&RoomManager::TickLoop, this);
+
+    Log(_tag, "Start tick loop (" + std::to_string(TICK_HZ) + "Hz, snapshot every " + std::to_string(SNAPSHOT_MIN_EVERY_TICKS) + "~" + std::to_string(SNAPSHOT_MAX_EVERY_TICKS) + " ticks)");
+    return true;
+}
+
+void RoomManager::Stop()
+{
+    // 멱등
+    if (!_running.exchange(false))
+        return;
+
+    if (_tickThread.joinable())
+        _tickThread.join();
+
+    _workers.Stop();
+
+    // 마지막 tick까지 끝난 상태로 맞춤 (잠든 방도 닫는 tick이 맞아야 함)
+    for (auto& room : _rooms)
+        CatchUp(*room, _tickCount);
+
+    if (_recorder)
+    {
+        // 남은 방을 닫힌 것으로 기록해야 replay가 마지막 tick까지 돌림
+        for (auto& room : _rooms)
+            _recorder->RecordRoomClose(room->Id(), room->ServerTick());
+        _recorder->Stop();
+    }
+
+    if (_checkpoints)
+    {
+        // 살아 있는 방도 마지막 상태를 남김
+        for (auto& room : _rooms)
+            SubmitCheckpoint(*room, CHECKPOINT_FLAG_FINAL);
+        _checkpoints->Stop();
+    }
+
+    // tick이 멈춘 뒤라 더 이상 publish 없음 -> 남은 인코딩만 마저 처리
+    _pipeline.Stop();
+
+    Log(_tag, "Stopped");
+}
+
+bool RoomManager::Freeze()
+{
+    if (!_running.load() || _frozen.exchange(true))
+        return false;
+
+    // 진행 중인 tick은 끝까지 (workers/파이프라인은 그대로 둠)
+    if (_tickThread.joinable())
+        _tickThread.join();
+
+    Log(_tag, "Frozen at tick " + std::to_string(_tickCount));
+    return true;
+}
+
+void RoomManager::Resume()
+{
+    if (!_frozen.exchange(false))
+        return;
+
+    // 멈춘 동안은 tick이 없었던 것 (방 시간이 그만큼 늦게 감)
+    _tickThread = std::thread(&RoomManager::TickLoop, this);
+    Log(_tag, "Resumed at tick " + std::to_string(_tickCount));
+}
+
+void RoomManager::ExportState(ByteWriter& w)
+{
+    // 인계 직전까지 들어온 입장/입력/퇴장 (세션 수신은 이미 다 멈춤, tick 스레드도 없음)
+    ApplyPendingCommands();
+
+    w.WriteU64LE(_tickCount);
+    w.WriteU32LE(_nextRoomId);
+    w.WriteU32LE((uint32)_rooms.size());
+
+    // 잠든 방도 따라잡지 않고 그대로 (스케줄이 전역 tick 기준이라 새 프로세스에서 이어서 깨움)
+    for (const auto& room : _rooms)
+    {
+        const RoomSchedule& sched = room->Schedule();
+        w.WriteU32LE(room->Id());
+        w.WriteU8(sched.sleeping ? 1 : 0);
+        w.WriteU64LE(sched.lastUpdateTick);
+        w.WriteU64LE(sched.wakeTick);
+        w.WriteU64LE(sched.nextSnapshotTick);
+        w.WriteU32LE(sched.snapshotEvery);
+        room->SaveState(w);
+    }
+}
+
+bool RoomManager::ImportState(ByteReader& r)
+{
+    if (_running.load())
+        return false;
+
+    uint64 tickCount = 0;
+    uint32 nextRoomId = 0;
+    uint32 roomCount = 0;
+    if (!r.ReadU64LE(tickCount) || !r.ReadU32LE(nextRoomId) || !r.ReadU32LE(roomCount) || roomCount > r.Remaining())
+        return false;
+
+    std::vector<std::unique_ptr<Room>> rooms;
+    rooms.reserve(roomCount);
+    for (uint32 i = 0; i < roomCount; ++i)
+    {
+        uint32 id = 0;
+        uint8 sleeping = 0;
+        RoomSchedule sched;
+        if (!r.ReadU32LE(id) || !r.ReadU8(sleeping) || !r.ReadU64LE(sched.lastUpdateTick) || !r.ReadU64LE(sched.wakeTick)
+            || !r.ReadU64LE(sched.nextSnapshotTick) || !r.ReadU32LE(sched.snapshotEvery))
+            return false;
+        sched.sleeping = sleeping != 0;
+
+        auto room = std::make_unique<Room>(id, _content.Current());
+        if (!room->LoadState(r))
+        {
+            Log(_tag, "Import failed at room " + std::to_string(id));
+            return false;
+        }
+        room->Schedule() = sched;
+        rooms.push_back(std::move(room));
+    }
+
+    _tickCount = tickCount;
+    _nextRoomId = nextRoomId;
+    _rooms = std::move(rooms);
+
+    _roomOfSession.clear();
+    for (auto& room : _rooms)
+    {
+        for (size_t i = 0; i < room->PlayerCount(); ++i)
+            _roomOfSession[room->SessionAt(i)] = room.get();
+    }
+
+    if (_recorder)
+    {
+        // 넘겨받은 방은 이 기록에 RoomOpen이 없음 -> 여는 것 + 넘겨받은 상태로 남겨야 replay가 이어서 돌림
+        ByteWriter state;
+        for (auto& room : _rooms)
+        {
+            state.buf.clear();
+            room->SaveState(state);
+            if (state.Size() > INPUT_LOG_MAX_BODY)
+            {
+                Log(_tag, "Room " + std::to_string(room->Id()) + " state too large to record (" + std::to_string(state.Size())
+                    + " bytes), replay will not see it");
+                continue;
+            }
+            _recorder->RecordRoomOpen(room->Id(), room->ServerTick());
+            _recorder->RecordRoomState(room->Id(), room->ServerTick(), state.buf);
+        }
+    }
+
+    Log(_tag, "Imported " + std::to_string(_rooms.size()) + " rooms, " + std::to_string(_roomOfSession.size())
+        + " players at tick " + std::to_string(_tickCount));
+    return true;
+}
+
+void RoomManager::DiscardRooms()
+{
+    _rooms.clear();
+    _roomOfSession.clear();
+}
+
+void RoomManager::PushCommand(const Command& cmd)
+{
+    std::lock_guard<std::mutex> lock(_cmdMutex);
+    _pending.push_back(cmd);
+}
+
+void RoomManager::OnSessionOpened(SessionId sid)
+{
+    Command cmd;
+    cmd.kind = CommandKind::Open;
+    cmd.sid = sid;
+    PushCommand(cmd);
+}
+
+void RoomManager::OnSessionClosed(SessionId sid)
+{
+    Command cmd;
+    cmd.kind = CommandKind::Close;
+    cmd.sid = sid;
+    PushCommand(cmd);
+}
+
+void RoomManager::OnMoveInput(SessionId sid, const C_MoveInput& msg)
+{
+    Command cmd;
+    cmd.kind = CommandKind::Input;
+    cmd.sid = sid;
+    cmd.input.kind = InputKind::Move;
+    cmd.input.seq = msg.seq;
+    cmd.input.move = msg;
+    PushCommand(cmd);
+}
+
+void RoomManager::OnCastSkill(SessionId sid, const C_CastSkill& msg)
+{
+    Command cmd;
+    cmd.kind = CommandKind::Input;
+    cmd.sid = sid;
+    cmd.input.kind = InputKind::CastSkill;
+    cmd.input.seq = msg.seq;
+    cmd.input.cast = msg;
+    PushCommand(cmd);
+}
+
+void RoomManager::OnChoiceVote(SessionId sid, const C_ChoiceVote& msg)
+{
+    Command cmd;
+    cmd.kind = CommandKind::Input;
+    cmd.sid = sid;
+    cmd.input.kind = InputKind::ChoiceVote;
+    cmd.input.seq = msg.seq;
+    cmd.input.vote = msg;
+    PushCommand(cmd);
+}
+
+void RoomManager::OnRttSample(SessionId sid, uint32 rttMs, uint32 rttVarMs)
+{
+    Command cmd;
+    cmd.kind = CommandKind::Rtt;
+    cmd.sid = sid;
+    cmd.rttMs = rttMs;
+    cmd.rttVarMs = rttVarMs;
+    PushCommand(cmd);
+}
+
+void RoomManager::TickLoop()
+{
+    using Clock = std::chrono::steady_clock;
+
+    ThreadPlacement::Pin(ThreadRole::Tick, 0);
+
+    const auto tickInterval = std::chrono::microseconds(TICK_INTERVAL_US);
+
+    auto nextTick = Clock::now();
+    auto nextStatLog = nextTick + std::chrono::seconds(10);
+
+    while (_running.load() && !_frozen.load())
+    {
+        const auto tickBegin = Clock::now();
+
+        // 테이블 교체는 tick 경계에서만 (tick 도중엔 모든 방이 같은 테이블을 봄)
+        if (_content.ApplyPendingReload())
+            Log(_tag, "Content reloaded (data v" + std::to_string(_content.Current()->DataVersion()) + ")");
+
+        // 이번 tick 번호 (방 스케줄 기준) + 예정 시각 (실제로 깬 시각은 지터가 있어서 안 씀)
+        ++_tickCount;
+        _tickStartUs = ServerTimeUs(nextTick);
+
+        ApplyPendingCommands();
+
+        const auto updateBegin = Clock::now();
+        const ContentTables* content = _content.Current();
+        _workers.Run((uint32)_rooms.size(), ROOM_UPDATE_CHUNK, [&](uint32 begin, uint32 end, uint32 lane) {
+            for (uint32 i = begin; i < end; ++i)
+                _laneSkipped[lane] += UpdateRoom(*_rooms[i], content);
+            });
+        for (uint64& skipped : _laneSkipped)
+        {
+            _skippedRoomTicks += skipped;
+            skipped = 0;
+        }
+        const uint64 updateNs = (uint64)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - updateBegin).count();
+        _updateNs += updateNs;
+        _costUpdateNsSum.fetch_add(updateNs, std::memory_order_relaxed);
+
+        // 방마다 스냅샷 tick이 다름 (주기/시작 tick이 방별) -> 매 tick 확인
+        PublishSnapshots();
+
+        // 과부하: 주기 체크포인트와 replay checksum은 미룸 (dirty는 쌓였다가 다음 체크포인트에 같이, replay는 기록된 것만 비교)
+        const bool shed = _overload && _overload->AtLeast(LoadLevel::ShedOptional);
+        if (shed)
+            ++_shedTicks;
+
+        if (_checkpoints && !shed)
+            SubmitCheckpoints();
+
+        if (_recorder)
+        {
+            for (auto& room : _rooms)
+            {
+                // 잠든 방은 이번 tick에 상태가 안 바뀜 (replay는 기록된 checksum만 비교)
+                if (!shed && !room->Schedule().sleeping && room->ServerTick() % INPUT_LOG_CHECKSUM_EVERY_TICKS == 0)
+                    _recorder->RecordChecksum(room->Id(), room->ServerTick(), room->StateHash());
+            }
+            _recorder->Flush();
+        }
+
+        const auto now = Clock::now();
+        const uint64 workUs = (uint64)std::chrono::duration_cast<std::chrono::microseconds>(now - tickBegin).count();
+        if (_overload)
+            _overload->RecordTick(workUs);
+
+        _costTicks.fetch_add(1, std::memory_order_relaxed);
+        _costWorkUsSum.fetch_add(workUs, std::memory_order_relaxed);
+        if (workUs > _costWorkUsMax.load(std::memory_order_relaxed))
+            _costWorkUsMax.store(workUs, std::memory_order_relaxed);   // 쓰는 쪽은 tick 스레드 1개 (리셋과 겹치면 1 tick 값이 남을 뿐)
+
+        if (now >= nextStatLog)
+        {
+            LogStats();
+            nextStatLog = now + std::chrono::seconds(10);
+        }
+
+        nextTick += tickInterval;
+
+        // 많이 밀렸으면 따라잡기 대신 기준점 재설정 (몰아서 tick 방지)
+        if (now - nextTick > tickInterval * 5)
+            nextTick = now;
+
+        // tick 스레드 arena (방 Update를 혼자 돌린 몫 포함)
+        TickArena::ForThread().Reset();
+
+        std::this_thread::sleep_until(nextTick);
+
+        const uint64 lateNs = (uint64)std::max<int64>(0,
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - nextTick).count());
+        _tickLateNsSum += lateNs;
+        _tickLateNsMax = std::max(_tickLateNsMax, lateNs);
+        ++_tickLateCount;
+    }
+}
+
+void RoomManager::ApplyPendingCommands()
+{
+    {
+        std::lock_guard<std::mutex> lock(_cmdMutex);
+        _applying.swap(_pending);
+    }
+
+    for (Command& cmd : _applying)
+    {
+        switch (cmd.kind)
+        {
+        case CommandKind::Open:
+        {
+            if (_roomOfSession.count(cmd.sid) != 0)
+                break;
+
+            Room* room = AssignRoom();
+            if (!room)
+            {
+                // 새 방을 못 만드는 단계: 끊게 함 (게이트웨이 세션은 링크로, 게이트웨이가 공개된 단계를 보기 전의 경합분)
+                // 거절도 못 보내면(게이트웨이 없음/링 가득) 방 없이 둠 -> 입력은 버려지고 퇴장 때 정리
+                ++_roomsRejected;
+                RejectSession(cmd.sid);
+                break;
+            }
+            WakeRoom(*room);
+            if (!room->AddPlayer(cmd.sid))
+                break;
+
+            _roomOfSession[cmd.sid] = room;
+            if (_recorder)
+                _recorder->RecordPlayerJoin(room->Id(), room->ServerTick(), cmd.sid);
+            break;
+        }
+
+        case CommandKind::Close:
+        {
+            auto it = _roomOfSession.find(cmd.sid);
+            if (it == _roomOfSession.end())
+                break;
+
+            WakeRoom(*it->second);
+            it->second->RemovePlayer(cmd.sid);
+            if (_recorder)
+                _recorder->RecordPlayerLeave(it->second->Id(), it->second->ServerTick(), cmd.sid);
+
+            _roomOfSession.erase(it);
+            break;
+        }
+
+        case CommandKind::Input:
+        {
+            auto it = _roomOfSession.find(cmd.sid);
+            if (it == _roomOfSession.end())
+            {
+                ++_inputsRejected;
+                break;
+            }
+
+            // 입력이 잠든 방을 깨우는 이벤트 (투표 등)
+            WakeRoom(*it->second);
+
+            // 기록/jitter buffer 전에 검사 -> 기록되는 viewTick이 실제로 판정에 쓴 값
+            if (cmd.input.kind == InputKind::CastSkill && it->second->ClampViewTick(cmd.sid, cmd.input.cast))
+                ++_viewTicksClamped;
+
+            InputJitterBuffer::PushResult result = InputJitterBuffer::PushResult::TooFar;
+            if (!it->second->PushInput(cmd.sid, cmd.input, result))
+            {
+                ++_inputsRejected;
+                break;
+            }
+
+            if (result == InputJitterBuffer::PushResult::Ok)
+            {
+                ++_inputsAccepted;
+
+                // 버퍼 상태를 바꾸는 건 Ok뿐 -> 이것만 기록하면 replay가 같은 순서로 소비
+                if (_recorder)
+                    _recorder->RecordInput(it->second->Id(), it->second->ServerTick(), cmd.sid, cmd.input);
+            }
+            else if (result == InputJitterBuffer::PushResult::Duplicate)
+                ++_inputsDuplicate;
+            else
+                ++_inputsRejected;
+            break;
+        }
+
+        case CommandKind::Rtt:
+        {
+            // 스냅샷 주기에만 쓰임 (시뮬레이션 상태 아님) -> 깨우지도 기록하지도 않음
+            auto it = _roomOfSession.find(cmd.sid);
+            if (it != _roomOfSession.end())
+                it->second->SetRtt(cmd.sid, cmd.rttMs, cmd.rttVarMs);
+            break;
+        }
+        }
+    }
+    _applying.clear();
+
+    // 빈 방 정리 (남는 방 중 인원이 가장 많은 방 = 관전 기본 방, 어차피 매 tick 전체를 도는 김에)
+    uint32 featuredId = 0;
+    size_t featuredPlayers = 0;
+    _rooms.erase(
+        std::remove_if(_rooms.begin(), _rooms.end(), [&](const std::unique_ptr<Room>& r) {
+            if (!r->IsEmpty())
+            {
+                if (r->PlayerCount() > featuredPlayers)
+                {
+                    featuredId = r->Id();
+                    featuredPlayers = r->PlayerCount();
+                }
+                return false;
+            }
+            WakeRoom(*r);
+            if (_recorder)
+                _recorder->RecordRoomClose(r->Id(), r->ServerTick());
+            if (_checkpoints)
+                SubmitCheckpoint(*r, CHECKPOINT_FLAG_FINAL);
+            return true;
+        }),
+        _rooms.end());
+    _featuredRoom.store(featuredId, std::memory_order_relaxed);
+}
+
+RoomManager::TickCost RoomManager::TakeTickCost()
+{
+    TickCost c;
+    c.ticks = _costTicks.exchange(0, std::memory_order_relaxed);
+    c.workUsSum = _costWorkUsSum.exchange(0, std::memory_order_relaxed);
+    c.workUsMax = _costWorkUsMax.exchange(0, std::memory_order_relaxed);
+    c.updateNsSum = _costUpdateNsSum.exchange(0, std::memory_order_relaxed);
+    c.captureNsSum = _costCaptureNsSum.exchange(0, std::memory_order_relaxed);
+    c.snapshots = _costSnapshots.exchange(0, std::memory_order_relaxed);
+    return c;
+}
+
+Room* RoomManager::AssignRoom()
+{
+    // Go 매칭(CreateRoom) 연동 전 임시: 자리 있는 방에 채우고 없으면 새로 만듦
+    for (auto& room : _rooms)
+    {
+        if (!room->IsFull())
+            return room.get();
+    }
+
+    // 과부하: 있는 방은 계속 돌리고 새 방만 안 만듦 (매칭 쪽은 OverloadController::AcceptingRooms로 봄)
+    if (_overload && !_overload->AcceptingRooms())
+        return nullptr;
+
+    return NewRoom();
+}
+
+Room* RoomManager::NewRoom()
+{
+    _rooms.push_back(std::make_unique<Room>(_nextRoomId++, _content.Current()));
+
+    Room* room = _rooms.back().get();
+    room->Schedule().lastUpdateTick = _tickCount - 1;  // 이번 tick부터 Update
+    if (_recorder)
+        _recorder->RecordRoomOpen(room->Id(), room->ServerTick());
+    return room;
+}
+
+bool RoomManager::RejectSession(SessionId sid)
+{
+    if (_link)
+        return _link->RejectSession(sid, DisconnectReason::Overloaded);
+
+    std::shared_ptr<Session> s = _sessionMgr->Find(sid);
+    if (!s)
+        return false;
+
+    s->Disconnect(DisconnectReason::Overloaded);
+    return true;
+}
+
+void RoomManager::PublishSnapshots()
+{
+    const auto t0 = std::chrono::steady_clock::now();
+
+    // 과부하: 스냅샷 주기를 늘림 (capture/인코딩/전송이 같이 줄어듦, 클라는 S_Snapshot의 주기로 보간)
+    const bool reduce = _overload && _overload->AtLeast(LoadLevel::ReduceSnapshots);
+
+    for (auto& room : _rooms)
+    {
+        RoomSchedule& sched = room->Schedule();
+        if (sched.sleeping || _tickCount < sched.nextSnapshotTick)
+            continue;   // 잠든 방은 스냅샷 tick에 맞춰 깨어남
+
+        // 주기는 capture 시점 상태로 정하고 클라에도 그대로 알림 (다음 스냅샷이 이만큼 뒤에 옴)
+        uint32 every = _adaptiveSnapshots ? room->SnapshotEveryTicks() : SNAPSHOT_EVERY_TICKS;
+        if (reduce && every < SNAPSHOT_OVERLOAD_MAX_EVERY_TICKS)
+        {
+            every = std::min(every * SNAPSHOT_OVERLOAD_FACTOR, SNAPSHOT_OVERLOAD_MAX_EVERY_TICKS);
+            ++_stretchedSnapshots;
+        }
+        sched.snapshotEvery = every;
+        sched.nextSnapshotTick = _tickCount + every;
+
+        WorldState* ws = _pipeline.Acquire();
+        if (ws)
+        {
+            const uint32 omitted = room->Capture(*ws, every);
+            if (ws->partial)
+            {
+                ++_budgetedSnapshots;
+                _omittedEnemies += omitted;
+            }
+            ws->snapshotInterval = (uint8)every;
+            ws->tickInterval = _roomSleep && room->CanSleep() ? (uint8)every : 1;  // 재우는 방은 스냅샷 주기로만 시뮬레이션
+            ws->capturedAt = std::chrono::steady_clock::now();
+            ws->tickOriginUs = _tickStartUs - (uint64)ws->serverTick * TICK_INTERVAL_US;
+            _pipeline.Publish(ws);
+
+            _snapshotEverySum += every;
+            ++_snapshotsCaptured;
+            _costSnapshots.fetch_add(1, std::memory_order_relaxed);
+        }
+        // else: 인코더 밀림 -> 이번 스냅샷 생략 (다음 스냅샷이 어차피 덮어씀)
+
+        SleepIfIdle(*room);
+    }
+
+    const uint64 captureNs = (uint64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count();
+    _captureNs += captureNs;
+    _costCaptureNsSum.fetch_add(captureNs, std::memory_order_relaxed);
+}
+
+void RoomManager::SleepIfIdle(Room& room)
+{
+    if (!_roomSleep || !room.CanSleep())
+        return;
+
+    // 다음 스냅샷 tick에 깨움 / 구간 타이머가 먼저면 그 tick에
+    RoomSchedule& sched = room.Schedule();
+    uint64 wake = sched.nextSnapshotTick;
+    const uint32 untilTimer = room.TicksUntilTimer();
+    if (untilTimer != 0)
+        wake = std::min<uint64>(wake, _tickCount + untilTimer);
+
+    // 바로 다음 tick에 깰 거면 재워 봐야 Skip 비용만 더함
+    if (wake <= _tickCount + 1)
+        return;
+
+    sched.sleeping = true;
+    sched.wakeTick = wake;
+}
+
+uint64 RoomManager::UpdateRoom(Room& room, const ContentTables* content)
+{
+    uint64 skipped = 0;
+
+    RoomSchedule& sched = room.Schedule();
+    if (sched.sleeping)
+    {
+        // 잠든 방은 깨울 tick 비교만 (방 상태는 안 건드림)
+        if (_tickCount < sched.wakeTick)
+            return 0;
+
+        // 계속 잘 수 있으면 이번 tick까지 Skip으로 따라잡고 끝 (정지 방은 Update하면 이력 복원 비용)
+        // 단 구간 타이머가 이번 tick이면 실제 Update에서 발화해야 함
+        const uint32 untilTimer = room.TicksUntilTimer();
+        if (room.CanSleep() && (untilTimer == 0 || untilTimer > _tickCount - sched.lastUpdateTick))
+            return CatchUpRoom(room, _tickCount);
+
+        skipped = CatchUpRoom(room, _tickCount - 1);
+    }
+
+    room.Update(TICK_DT, content);
+    sched.lastUpdateTick = _tickCount;
+    return skipped;
+}
+
+uint64 RoomManager::CatchUpRoom(Room& room, uint64 throughTick)
+{
+    RoomSchedule& sched = room.Schedule();
+    if (!sched.sleeping)
+        return 0;
+
+    uint64 skipped = 0;
+    if (throughTick > sched.lastUpdateTick)
+    {
+        skipped = throughTick - sched.lastUpdateTick;
+        room.Skip((uint32)skipped);
+        sched.lastUpdateTick = throughTick;
+    }
+    sched.sleeping = false;
+    return skipped;
+}
+
+void RoomManager::SubmitCheckpoints()
+{
+    for (auto& room : _rooms)
+    {
+        if (room->Schedule().sleeping)
+            continue;
+
+        // 방마다 주기 시작점을 엇갈림 -> 한 tick에 모든 방 capture가 몰리지 않음
+        if ((room->ServerTick() + room->Id()) % CHECKPOINT_EVERY_TICKS == 0)
+            SubmitCheckpoint(*room, 0);
+    }
+}
+
+void RoomManager::SubmitCheckpoint(Room& room, uint8 flags)
+{
+    const auto t0 = std::chrono::steady_clock::now();
+
+    auto delta = _checkpoints->Acquire();
+    room.CaptureCheckpoint(*delta);
+    delta->flags = flags;
+    _checkpoints->Submit(std::move(delta));
+
+    const uint64 ns = (uint64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count();
+    _checkpointNs += ns;
+    _checkpointMaxNs = std::max(_checkpointMaxNs, ns);
+}
+
+void RoomManager::LogStats()
+{
+    const SnapshotPipeline::Stats s = _pipeline.TakeStats();
+
+    const uint64 avgLatencyUs = s.published > 0 ? s.latencyNsSum / s.published / 1000 : 0;
+
+    uint64 rewindTicks = 0;
+    uint64 skillCasts = 0;
+    uint64 segmentTransitions = 0;
+    uint64 aiScans = 0;
+    uint64 hitCandidates = 0;
+    uint64 enemyHits = 0;
+    size_t activeEnemies = 0;
+    size_t sleeping = 0;
+    uint64 rttSumMs = 0;
+    uint32 rttMaxMs = 0;
+    uint64 rttVarSumMs = 0;
+    uint64 rttKnown = 0;
+    const TickArena::Stats arena = _workers.TakeArenaStats();
+    for (auto& room : _rooms)
+    {
+        rewindTicks += room->TakeRewindTicks();
+        skillCasts += room->TakeSkillCasts();
+        _castsRejected += room->TakeRejectedCasts();
+        segmentTransitions += room->TakeSegmentTransitions();
+        aiScans += room->TakeAiScans();
+        hitCandidates += room->TakeHitCandidates();
+        enemyHits += room->TakeEnemyHits();
+        activeEnemies += room->Ai().Count(AiBehavior::Chase) + room->Ai().Count(AiBehavior::Attack);
+        if (room->Schedule().sleeping)
+            ++sleeping;
+
+        for (size_t i = 0; i < room->PlayerCount(); ++i)
+        {
+            const Player& p = room->PlayerAt(i);
+            if (p.rttMs == 0)
+                continue;
+            rttSumMs += p.rttMs;
+            rttMaxMs = std::max(rttMaxMs, p.rttMs);
+            rttVarSumMs += p.rttVarMs;
+            ++rttKnown;
+        }
+    }
+
+    // lag compensation 이력 상주 메모리 (방 수에 비례, 할당은 방 생성 시 1회)
+    const uint64 historyBytes = (uint64)_rooms.size() * ENEMIES_PER_SEGMENT * sizeof(PositionHistory<LAG_COMP_HISTORY_TICKS>);
+
+    // capture = tick 스레드에 남은 비용, encode = 인코더 스레드로 빠진 비용
+    Log(_tag,
+        "rooms=" + std::to_string(_rooms.size()) +
+        " players=" + std::to_string(_roomOfSession.size()) +
+        " snapshots=" + std::to_string(s.published) +
+        " dropped=" + std::to_string(s.dropped) +
+        " encodeFailed=" + std::to_string(s.encodeFailed) +
+        " frames=" + std::to_string(s.framesSent) +
+        " egressKB=" + std::to_string(s.bytesSent / 1024) +
+        " captureUs=" + std::to_string(_captureNs / 1000) +
+        " offloadedEncodeUs=" + std::to_string(s.encodeNs / 1000) +
+        " latencyUs(avg/max)=" + std::to_string(avgLatencyUs) + "/" + std::to_string(s.latencyNsMax / 1000));
+
+    Log(_tag,
+        "inputs=" + std::to_string(_inputsAccepted) +
+        " dup=" + std::to_string(_inputsDuplicate) +
+        " rejected=" + std::to_string(_inputsRejected) +
+        " casts=" + std::to_string(skillCasts) +
+        " castsRejected=" + std::to_string(_castsRejected) +
+        " avgRewindTicks=" + std::to_string(skillCasts > 0 ? rewindTicks / skillCasts : 0) +
+        " viewTicksClamped=" + std::to_string(_viewTicksClamped) +
+        " updateUs=" + std::to_string(_updateNs / 1000) +
+        " tickLateUs(avg/max)=" + std::to_string(_tickLateCount > 0 ? _tickLateNsSum / _tickLateCount / 1000 : 0) +
+        "/" + std::to_string(_tickLateNsMax / 1000) +
+        " historyKB=" + std::to_string(historyBytes / 1024));
+
+    // 평균 스냅샷 주기 (tick, 소수 1자리) = capture마다 실어 보낸 주기의 평균
+    const uint64 avgEvery10 = _snapshotsCaptured > 0 ? _snapshotEverySum * 10 / _snapshotsCaptured : 0;
+
+    // sleeping = 지금 잠든 방 수, skippedRoomTicks = 잠들어서 안 돌린 Update 수
+    Log(_tag,
+        "segmentTransitions=" + std::to_string(segmentTransitions) +
+        " sleeping=" + std::to_string(sleeping) + "/" + std::to_string(_rooms.size()) +
+        " skippedRoomTicks=" + std::to_string(_skippedRoomTicks) +
+        " avgSnapshotEvery=" + std::to_string(avgEvery10 / 10) + "." + std::to_string(avgEvery10 % 10) +
+        " rttMs(avg/max)=" + std::to_string(rttKnown > 0 ? rttSumMs / rttKnown : 0) + "/" + std::to_string(rttMaxMs) +
+        " jitterMs(avg)=" + std::to_string(rttKnown > 0 ? rttVarSumMs / rttKnown : 0));
+
+    // 과부하 조치: roomsRejected = 새 방이 필요했던 입장 거절, shedTicks = 부가 작업을 건너뛴 tick, stretched = 주기를 늘린 스냅샷
+    if (_overload && (_overload->Level() != LoadLevel::Normal || _roomsRejected + _shedTicks + _stretchedSnapshots > 0))
+    {
+        Log(_tag,
+            "load=" + std::string(LoadLevelName(_overload->Level())) +
+            " roomsRejected=" + std::to_string(_roomsRejected) +
+            " shedTicks=" + std::to_string(_shedTicks) +
+            " stretchedSnapshots=" + std::to_string(_stretchedSnapshots));
+    }
+
+    // 클라 예산(SNAPSHOT_CLIENT_BYTES_PER_SEC)을 넘어 적을 골라 담은 스냅샷 / 그때 수신자별로 빠진 적 수 합 (선택 비용은 captureUs에 포함)
+    if (_budgetedSnapshots > 0)
+    {
+        Log(_tag,
+            "budgetedSnapshots=" + std::to_string(_budgetedSnapshots) +
+            " omittedEnemies=" + std::to_string(_omittedEnemies) +
+            " perClientFrames=" + std::to_string(s.perClientFrames));
+    }
+
+    // 관전: spectators = 지금 구독 수, sends = 관전 큐에 넣은 프레임 참조, skipped = 느린 관전자라 대체된 프레임, relayUs = lane fan-out 시간
+    if (_relay)
+    {
+        const SpectatorRelay::Stats rs = _relay->TakeStats();
+        if (_relay->Spectators() > 0 || rs.framesIn > 0 || rs.gone > 0)
+        {
+            Log(_tag,
+                "spectators=" + std::to_string(_relay->Spectators()) +
+                " relayFrames=" + std::to_string(rs.framesIn) +
+                " relayDropped=" + std::to_string(rs.framesDropped) +
+                " sends=" + std::to_string(rs.sends) +
+                " skipped=" + std::to_string(rs.skipped) +
+                " gone=" + std::to_string(rs.gone) +
+                " relayUs=" + std::to_string(rs.relayNs / 1000));
+        }
+    }
+
+    // aiScans = 시간 분할 대상 탐색 수, activeEnemies = 지금 Chase/Attack 버킷 합
+    // hitCandidates = broadphase를 통과해서 모양까지 본 시전/충돌 판정 수, lanes = 방 Update 스레드 수
+    // arenaPeakKB = lane 중 tick 1번 최대 임시 메모리, arenaMallocs = arena가 chunk를 새로 잡은 횟수 (안정 상태 0)
+    Log(_tag,
+        "aiScans=" + std::to_string(aiScans) +
+        " activeEnemies=" + std::to_string(activeEnemies) +
+        " enemyHits=" + std::to_string(enemyHits) +
+        " hitCandidates=" + std::to_string(hitCandidates) +
+        " lanes=" + std::to_string(_workers.Lanes()) +
+        " arenaPeakKB=" + std::to_string(arena.highWater / 1024) +
+        " arenaKB=" + std::to_string(arena.capacity / 1024) +
+        " arenaMallocs=" + std::to_string(arena.chunkAllocs));
+
+    if (_checkpoints)
+    {
+        const CheckpointService::Stats c = _checkpoints->TakeStats();
+
+        // stall = tick 스레드 capture 시간, serialize = 직렬화 스레드로 빠진 시간
+        Log(_tag,
+            "checkpoints=" + std::to_string(c.submitted) +
+            " dirtyEnemies=" + std::to_string(c.dirtyEnemies) +
+            " stallUs(avg/max)=" + std::to_string(c.submitted > 0 ? _checkpointNs / c.submitted / 1000 : 0) + "/" + std::to_string(_checkpointMaxNs / 1000) +
+            " serializeUs=" + std::to_string(c.serializeNs / 1000) +
+            " blobKB=" + std::to_string(c.blobBytes / 1024) +
+            " uploaded=" + std::to_string(c.upload.succeeded) +
+            " coalesced=" + std::to_string(c.upload.coalesced) +
+            " retries=" + std::to_string(c.upload.retries) +
+            " uploadDropped=" + std::to_string(c.upload.dropped));
+
+        _checkpointNs = 0;
+        _checkpointMaxNs = 0;
+    }
+
+    _captureNs = 0;
+    _updateNs = 0;
+    _tickLateNsSum = 0;
+    _tickLateNsMax = 0;
+    _tickLateCount = 0;
+    _skippedRoomTicks = 0;
+    _snapshotEverySum = 0;
+    _snapshotsCaptured = 0;
+    _inputsAccepted = 0;
+    _inputsDuplicate = 0;
+    _inputsRejected = 0;
+    _castsRejected = 0;
+    _viewTicksClamped = 0;
+    _roomsRejected = 0;
+    _shedTicks = 0;
+    _stretchedSnapshots = 0;
+    _budgetedSnapshots = 0;
+    _omittedEnemies = 0;
+}
\ No newline at end of file
@@ -0,0 +1,163 @@
+#include "game/RoomWorkers.h"
+#include "common/ThreadPlacement.h"
+
+#include <algorithm>
+#include <iostream>
+
+static void Log(const std::string& tag, const std::string& msg)
+{
+    std::cout << "[" << tag << "] " << msg << "\n";
+}
+
+RoomWorkers::RoomWorkers()
+{
+    _tag = "RoomWorkers";
+}
+
+RoomWorkers::~RoomWorkers()
+{
+    Stop();
+}
+
+bool RoomWorkers::Start(uint32 threads)
+{
+    if (!_threads.empty())
+        return false;
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = false;
+    }
+
+    for (uint32 i = 0; i < threads; ++i)
+        _arenas.push_back(std::make_unique<TickArena>());
+    _cursors.reset(new LaneCursor[threads + 1]);
+
+    for (uint32 i = 0; i < threads; ++i)
+        _threads.emplace_back(&RoomWorkers::WorkLoop, this, i + 1);
+
+    Log(_tag, "Start (lanes=" + std::to_string(Lanes()) + ")");
+    return true;
+}
+
+void RoomWorkers::Stop()
+{
+    if (_threads.empty())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _startCv.notify_all();
+
+    for (auto& t : _threads)
+    {
+        if (t.joinable())
+            t.join();
+    }
+    _threads.clear();
+    _arenas.clear();
+}
+
+void RoomWorkers::Run(uint32 count, uint32 chunk, const Job& job)
+{
+    if (count == 0)
+        return;
+
+    // 작업 스레드가 없거나 한 chunk로 끝나면 깨우는 비용이 더 큼
+    if (_threads.empty() || count <= chunk)
+    {
+        job(0, count, 0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _job = &job;
+        _count = count;
+        _chunk = chunk;
+        _chunks = (count + chunk - 1) / chunk;
+        for (uint32 l = 0; l < Lanes(); ++l)
+            _cursors[l].next.store(0, std::memory_order_relaxed);
+        _busy = (uint32)_threads.size();
+        ++_generation;
+    }
+    _startCv.notify_all();
+
+    Drain(0);
+
+    // 작업 스레드가 마지막 chunk를 끝낼 때까지 (job/_count는 그때까지 살아 있어야 함)
+    std::unique_lock<std::mutex> lock(_mutex);
+    _doneCv.wait(lock, [this] { return _busy == 0; });
+    _job = nullptr;
+}
+
+TickArena::Stats RoomWorkers::TakeArenaStats()
+{
+    TickArena::Stats total = TickArena::ForThread().TakeStats();
+
+    // 작업 스레드는 Run이 끝나면 다음 Run까지 arena를 안 건드림
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto& arena : _arenas)
+    {
+        const TickArena::Stats s = arena->TakeStats();
+        total.resets += s.resets;
+        total.chunkAllocs += s.chunkAllocs;
+        total.highWater = std::max(total.highWater, s.highWater);
+        total.capacity += s.capacity;
+    }
+    return total;
+}
+
+void RoomWorkers::Drain(uint32 lane)
+{
+    const uint32 lanes = Lanes();
+    for (uint32 k = 0; k < lanes; ++k)
+    {
+        const uint32 owner = (lane + k) % lanes;
+        for (;;)
+        {
+            const uint32 n = _cursors[owner].next.fetch_add(1, std::memory_order_relaxed);
+            const uint32 c = owner + n * lanes;
+            if (c >= _chunks)
+                break;
+
+            const uint32 begin = c * _chunk;
+            (*_job)(begin, std::min(begin + _chunk, _count), lane);
+        }
+    }
+}
+
+void RoomWorkers::WorkLoop(uint32 lane)
+{
+    ThreadPlacement::Pin(ThreadRole::RoomWorker, lane - 1);
+
+    uint64 seen = 0;
+    TickArena& arena = *_arenas[lane - 1];
+    TickArena::Bind(&arena);
+
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _startCv.wait(lock, [&] { return _stopping || _generation != seen; });
+
+            if (_stopping)
+                return;
+
+            seen = _generation;
+        }
+
+        Drain(lane);
+
+        // 이번 Run에 만든 방 Update 임시값은 전부 끝남
+        arena.Reset();
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            --_busy;
+        }
+        _doneCv.notify_one();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,277 @@
+#include "game/SnapshotPipeline.h"
+#include "common/ThreadPlacement.h"
+#include "game/SpectatorRelay.h"
+#include "net/GameLink.h"
+#include "net/SessionManager.h"
+#include "net/Session.h"
+#include "proto/Codec.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+static void Log(const std::string& tag, const std::string& msg)
+{
+    std::cout << "[" << tag << "] " << msg << "\n";
+}
+
+static uint64 ElapsedNs(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to)
+{
+    return (uint64)std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count();
+}
+
+SnapshotPipeline::SnapshotPipeline(SessionManager* mgr) : _sessionMgr(mgr)
+{
+    _tag = "SnapshotPipeline";
+
+    _jobs.assign(SNAPSHOT_MAX_IN_FLIGHT, nullptr);
+    _owned.reserve(SNAPSHOT_MAX_IN_FLIGHT);
+    _free.reserve(SNAPSHOT_MAX_IN_FLIGHT);
+}
+
+SnapshotPipeline::~SnapshotPipeline()
+{
+    Stop();
+}
+
+bool SnapshotPipeline::Start(uint32 encoderThreads)
+{
+    if (_running.exchange(true))
+        return false;
+
+    if (encoderThreads == 0)
+        encoderThreads = 1;
+
+    {
+        std::lock_guard<std::mutex> lock(_jobMutex);
+        _stopping = false;
+    }
+
+    for (uint32 i = 0; i < encoderThreads; ++i)
+        _encoders.emplace_back(&SnapshotPipeline::EncodeLoop, this, i);
+
+    Log(_tag, "Start (encoder threads=" + std::to_string(encoderThreads) + ")");
+    return true;
+}
+
+void SnapshotPipeline::Stop()
+{
+    // 멱등
+    if (!_running.exchange(false))
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(_jobMutex);
+        _stopping = true;
+    }
+    _jobCv.notify_all();
+
+    for (auto& t : _encoders)
+    {
+        if (t.joinable())
+            t.join();
+    }
+    _encoders.clear();
+
+    Log(_tag, "Stopped");
+}
+
+WorldState* SnapshotPipeline::Acquire()
+{
+    std::lock_guard<std::mutex> lock(_poolMutex);
+
+    if (!_free.empty())
+    {
+        WorldState* ws = _free.back();
+        _free.pop_back();
+        return ws;
+    }
+
+    // 인코더가 밀려서 버퍼가 다 나가 있으면 버림 (tick 스레드를 막지 않음)
+    if (_owned.size() >= SNAPSHOT_MAX_IN_FLIGHT)
+    {
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    _owned.push_back(std::make_unique<WorldState>());
+    return _owned.back().get();
+}
+
+void SnapshotPipeline::Publish(WorldState* ws)
+{
+    if (!ws)
+        return;
+
+    _published.fetch_add(1, std::memory_order_relaxed);
+
+    {
+        std::lock_guard<std::mutex> lock(_jobMutex);
+        _jobs[(_jobHead + _jobCount) % _jobs.size()] = ws;
+        ++_jobCount;
+    }
+    _jobCv.notify_one();
+}
+
+void SnapshotPipeline::Release(WorldState* ws)
+{
+    std::lock_guard<std::mutex> lock(_poolMutex);
+    _free.push_back(ws);
+}
+
+SnapshotPipeline::Stats SnapshotPipeline::TakeStats()
+{
+    Stats s;
+    s.published = _published.exchange(0, std::memory_order_relaxed);
+    s.dropped = _dropped.exchange(0, std::memory_order_relaxed);
+    s.encodeFailed = _encodeFailed.exchange(0, std::memory_order_relaxed);
+    s.framesSent = _framesSent.exchange(0, std::memory_order_relaxed);
+    s.bytesSent = _bytesSent.exchange(0, std::memory_order_relaxed);
+    s.perClientFrames = _perClientFrames.exchange(0, std::memory_order_relaxed);
+    s.encodeNs = _encodeNs.exchange(0, std::memory_order_relaxed);
+    s.latencyNsSum = _latencyNsSum.exchange(0, std::memory_order_relaxed);
+    s.latencyNsMax = _latencyNsMax.exchange(0, std::memory_order_relaxed);
+    return s;
+}
+
+void SnapshotPipeline::EncodeLoop(uint32 index)
+{
+    ThreadPlacement::Pin(ThreadRole::Encoder, index);
+
+    // 세션 raw 포인터를 쓰므로 epoch 참가자로 등록
+    EpochManager& epoch = _sessionMgr->Epoch();
+    const EpochManager::ParticipantId pid = epoch.Register();
+    if (pid == EpochManager::INVALID_PARTICIPANT)
+    {
+        Log(_tag, "Encoder " + std::to_string(index) + " epoch register failed");
+        return;
+    }
+
+    // 스레드마다 프레임 버퍼 1개 + 수신자별 적 버퍼 1개 재사용
+    ByteBuffer frame;
+    frame.reserve(MAX_FRAME_TOTAL);
+    std::vector<SnapshotEnemy> picked;
+    picked.reserve(255);
+
+    while (true)
+    {
+        WorldState* ws = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(_jobMutex);
+            _jobCv.wait(lock, [this] { return _stopping || _jobCount != 0; });
+
+            if (_jobCount == 0)
+                break; // _stopping && 남은 작업 없음
+
+            ws = _jobs[_jobHead];
+            _jobHead = (_jobHead + 1) % _jobs.size();
+            --_jobCount;
+        }
+
+        EncodeAndSend(*ws, frame, picked, index, pid);
+        Release(ws);
+    }
+
+    epoch.Unregister(pid);
+}
+
+void SnapshotPipeline::EncodeAndSend(const WorldState& ws, ByteBuffer& frame, std::vector<SnapshotEnemy>& picked, uint32 index, uint32 pid)
+{
+    const auto t0 = std::chrono::steady_clock::now();
+
+    S_Snapshot msg;
+    msg.serverTick = ws.serverTick;
+    msg.players = ws.players.data();
+    msg.playerCount = (uint8)std::min<size_t>(ws.players.size(), 255);
+    msg.enemies = ws.enemies.data();
+    msg.enemyCount = (uint8)std::min<size_t>(ws.enemies.size(), 255);
+    msg.segmentState = ws.segmentState;
+    msg.tickInterval = ws.tickInterval;
+    msg.snapshotInterval = ws.snapshotInterval;
+
+    uint64 sent = 0;
+    uint64 bytes = 0;
+    if (!ws.partial)
+    {
+        if (!Codec<S_Snapshot>::EncodeFrame(msg, frame))
+        {
+            _encodeFailed.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        sent = Deliver(ws, frame, ws.recipients.data(), ws.recipients.size(), index, pid);
+        bytes = sent * frame.size();
+
+        if (_relay)
+            _relay->Offer(ws.roomId, frame, ws.tickOriginUs);
+    }
+    else
+    {
+        // 헤더/플레이어는 같고 적만 수신자별 (Room::Capture에서 SnapshotPriority로 고른 index)
+        uint32 begin = 0;
+        for (size_t i = 0; i < ws.recipients.size(); ++i)
+        {
+            const uint32 end = ws.selEnd[i];
+            picked.clear();
+            for (uint32 k = begin; k < end; ++k)
+                picked.push_back(ws.enemies[ws.enemySel[k]]);
+            begin = end;
+
+            msg.enemies = picked.data();
+            msg.enemyCount = (uint8)picked.size();
+            if (!Codec<S_Snapshot>::EncodeFrame(msg, frame))
+            {
+                _encodeFailed.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+
+            const uint64 n = Deliver(ws, frame, &ws.recipients[i], 1, index, pid);
+            sent += n;
+            bytes += n * frame.size();
+
+            // 관전자는 첫 수신자 시점으로
+            if (_relay && i == 0)
+                _relay->Offer(ws.roomId, frame, ws.tickOriginUs);
+        }
+        _perClientFrames.fetch_add(ws.recipients.size(), std::memory_order_relaxed);
+    }
+
+    const auto t1 = std::chrono::steady_clock::now();
+
+    _framesSent.fetch_add(sent, std::memory_order_relaxed);
+    _bytesSent.fetch_add(bytes, std::memory_order_relaxed);
+    _encodeNs.fetch_add(ElapsedNs(t0, t1), std::memory_order_relaxed);
+
+    const uint64 latency = ElapsedNs(ws.capturedAt, t1);
+    _latencyNsSum.fetch_add(latency, std::memory_order_relaxed);
+
+    uint64 prevMax = _latencyNsMax.load(std::memory_order_relaxed);
+    while (latency > prevMax && !_latencyNsMax.compare_exchange_weak(prevMax, latency, std::memory_order_relaxed))
+    {
+    }
+}
+
+uint64 SnapshotPipeline::Deliver(const WorldState& ws, const ByteBuffer& frame, const SessionId* recipients, size_t count, uint32 index, uint32 pid)
+{
+    if (_link)
+    {
+        // 레코드 1개: 세션별 복사/UDP 선택은 게이트웨이가
+        return _link->SendSnapshot(index % _link->OutRings(), recipients, count, frame, ws.tickOriginUs, TICK_INTERVAL_US) ? count : 0;
+    }
+
+    EpochGuard guard(_sessionMgr->Epoch(), pid);
+
+    uint64 sent = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        Session* s = _sessionMgr->Lookup(recipients[i]);
+        if (!s)
+            continue; // 이미 나간 세션
+
+        // TCP면 세션 큐가 프레임을 소유하므로 세션별 사본, UDP면 바로 데이터그램
+        s->SendSnapshotFrame(frame);
+        s->SetTickOrigin(ws.tickOriginUs, TICK_INTERVAL_US);
+        ++sent;
+    }
+    return sent;
+}
\ No newline at end of file
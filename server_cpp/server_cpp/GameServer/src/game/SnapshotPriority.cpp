@@ -0,0 +1,106 @@
+#include "game/SnapshotPriority.h"
+#include "game/GameConfig.h"
+#include "proto/Codec.h"
+
+#include <algorithm>
+#include <cmath>
+
+uint32 SnapshotPriority::EnemyBudget(uint32 playerCount, uint32 snapshotEvery)
+{
+    // 주기가 길면 한 번에 더 담음 (초당 바이트 기준). 프레임 한도(length/msgId 4바이트 제외)는 못 넘음
+    const size_t budget = std::min<size_t>((size_t)SNAPSHOT_CLIENT_BYTES_PER_SEC * snapshotEvery / TICK_HZ, MAX_FRAME_TOTAL - 4);
+    const size_t fixed = Codec<S_Snapshot>::PayloadSize((uint8)std::min<uint32>(playerCount, 255), 0);
+    if (budget <= fixed)
+        return 0;
+
+    return (uint32)std::min<size_t>((budget - fixed) / Codec<S_Snapshot>::ENEMY_SIZE, 255);
+}
+
+uint32 SnapshotPriority::Select(uint32 tick, float viewX, float viewY, const SnapshotEnemy* enemies, uint32 count, uint32 maxCount, std::vector<uint16>& out)
+{
+    Resize(count);
+
+    // 잠든 방은 Skip으로 tick이 한 번에 넘어옴 -> 그만큼 누적
+    const float elapsed = (float)(tick - _lastTick);
+    _lastTick = tick;
+
+    _order.clear();
+    for (uint32 i = 0; i < count; ++i)
+    {
+        const SnapshotEnemy& se = enemies[i];
+        Entry& e = _entries[i];
+
+        if (e.id != se.id)
+        {
+            e.priority = NEW_ENTITY;
+            _order.push_back((uint16)i);
+            continue;
+        }
+
+        // 죽음까지 보냈으면 끝 (hp/위치도 더 안 바뀜)
+        if (e.sentState == ENTITY_STATE_DEAD && se.state == ENTITY_STATE_DEAD)
+            continue;
+
+        const float dx = se.x - viewX;
+        const float dy = se.y - viewY;
+        const float near = std::max(0.f, 1.f - std::sqrt(dx * dx + dy * dy) / FAR_RADIUS);
+
+        const float mx = se.x - e.sentX;
+        const float my = se.y - e.sentY;
+        const float hpDelta = (float)(se.hp > e.sentHp ? se.hp - e.sentHp : e.sentHp - se.hp);
+        float change = std::sqrt(mx * mx + my * my) + hpDelta * 10.f / (float)ENEMY_MAX_HP;
+        if (se.state != e.sentState)
+            change += 4.f;
+
+        e.priority += elapsed * (BASE + NEAR * near + CHANGE * std::min(change, CHANGE_CAP));
+        _order.push_back((uint16)i);
+    }
+
+    // 높은 순 maxCount개 (같으면 index 순 -> 결과가 실행마다 같음)
+    uint32 n = (uint32)_order.size();
+    if (n > maxCount)
+    {
+        auto higher = [this](uint16 a, uint16 b) {
+            const float pa = _entries[a].priority;
+            const float pb = _entries[b].priority;
+            return pa != pb ? pa > pb : a < b;
+        };
+        std::nth_element(_order.begin(), _order.begin() + maxCount, _order.end(), higher);
+        n = maxCount;
+    }
+    std::sort(_order.begin(), _order.begin() + n);
+
+    for (uint32 k = 0; k < n; ++k)
+    {
+        const uint16 i = _order[k];
+        MarkSent(_entries[i], enemies[i]);
+        out.push_back(i);
+    }
+    return n;
+}
+
+void SnapshotPriority::MarkAllSent(uint32 tick, const SnapshotEnemy* enemies, uint32 count)
+{
+    Resize(count);
+    _lastTick = tick;
+
+    for (uint32 i = 0; i < count; ++i)
+        MarkSent(_entries[i], enemies[i]);
+}
+
+void SnapshotPriority::Resize(uint32 count)
+{
+    // 적 배열은 구간마다 새로 채워짐 (index 재사용 -> id로 구분)
+    if (_entries.size() != count)
+        _entries.resize(count);
+}
+
+void SnapshotPriority::MarkSent(Entry& e, const SnapshotEnemy& se)
+{
+    e.id = se.id;
+    e.priority = 0.f;
+    e.sentX = se.x;
+    e.sentY = se.y;
+    e.sentHp = se.hp;
+    e.sentState = se.state;
+}
\ No newline at end of file
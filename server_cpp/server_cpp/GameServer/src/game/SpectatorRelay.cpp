@@ -0,0 +1,349 @@
+#include "game/SpectatorRelay.h"
+#include "common/ServerClock.h"
+#include "common/ThreadPlacement.h"
+#include "net/SessionManager.h"
+#include "net/Session.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+static void Log(const std::string& tag, const std::string& msg)
+{
+    std::cout << "[" << tag << "] " << msg << "\n";
+}
+
+SpectatorRelay::SpectatorRelay(SessionManager* spectators) : _sessions(spectators)
+{
+    _tag = "SpectatorRelay";
+}
+
+SpectatorRelay::~SpectatorRelay()
+{
+    Stop();
+}
+
+bool SpectatorRelay::Start(uint32 laneThreads)
+{
+    if (_running.exchange(true))
+        return false;
+
+    if (laneThreads == 0)
+        laneThreads = 1;
+
+    // lane 수는 Start에서 정해지고 Stop까지 안 바뀜 (Subscribe/Offer가 락 없이 순회)
+    _lanes.clear();
+    for (uint32 i = 0; i < laneThreads; ++i)
+        _lanes.push_back(std::make_unique<Lane>());
+    for (uint32 i = 0; i < laneThreads; ++i)
+        _lanes[i]->thread = std::thread(&SpectatorRelay::LaneLoop, this, i);
+
+    Log(_tag, "Start (lanes=" + std::to_string(laneThreads) + ", delay=" + std::to_string(SPECTATOR_DELAY_MS) + "ms)");
+    return true;
+}
+
+void SpectatorRelay::Stop()
+{
+    // 멱등
+    if (!_running.exchange(false))
+        return;
+
+    for (auto& lane : _lanes)
+    {
+        {
+            std::lock_guard<std::mutex> lock(lane->mtx);
+            lane->stopping = true;
+        }
+        lane->cv.notify_all();
+    }
+
+    for (auto& lane : _lanes)
+    {
+        if (lane->thread.joinable())
+            lane->thread.join();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_watchMutex);
+        _watchCount.clear();
+    }
+    _spectators.store(0, std::memory_order_relaxed);
+
+    Log(_tag, "Stopped");
+}
+
+void SpectatorRelay::Subscribe(SessionId sid, uint32 roomId)
+{
+    std::shared_ptr<Session> s = _sessions->Find(sid);
+    if (!s)
+        return;
+
+    if (roomId == 0 || !_running.load(std::memory_order_relaxed))
+    {
+        s->Send(S_SpectateRes{ 0, 0, 0 });
+        return;
+    }
+
+    // 세션 id -> lane 고정 (같은 세션의 재요청이 같은 lane에서 순서대로 반영)
+    Lane& lane = *_lanes[(uint32)(sid ^ (sid >> 32)) % _lanes.size()];
+    {
+        std::lock_guard<std::mutex> lock(lane.mtx);
+        lane.subscribes.emplace_back(sid, roomId);
+    }
+    lane.cv.notify_one();
+
+    s->Send(S_SpectateRes{ 1, roomId, (uint16)SPECTATOR_DELAY_MS });
+}
+
+void SpectatorRelay::Offer(uint32 roomId, const ByteBuffer& frame, uint64 tickOriginUs)
+{
+    if (_spectators.load(std::memory_order_relaxed) == 0)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(_watchMutex);
+        if (_watchCount.find(roomId) == _watchCount.end())
+            return;
+    }
+
+    // 관전자 수와 무관하게 사본 1개 (인코더 프레임 버퍼는 스레드가 재사용)
+    Frame f;
+    f.roomId = roomId;
+    f.dueUs = ServerTimeUs() + (uint64)SPECTATOR_DELAY_MS * 1000;
+    f.tickOriginUs = tickOriginUs;
+    f.bytes = std::make_shared<const ByteBuffer>(frame);
+
+    _framesIn.fetch_add(1, std::memory_order_relaxed);
+
+    for (auto& lane : _lanes)
+    {
+        bool wake = false;
+        {
+            std::lock_guard<std::mutex> lock(lane->mtx);
+            if (lane->frames.size() >= LANE_MAX_FRAMES)
+            {
+                _framesDropped.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+
+            // 비어 있던 lane은 IDLE_CHECK_MS까지 자고 있을 수 있음 -> 새 마감 시각으로 다시 재우게 깨움
+            wake = lane->frames.empty();
+            lane->frames.push_back(f);
+        }
+        if (wake)
+            lane->cv.notify_one();
+    }
+}
+
+SpectatorRelay::Stats SpectatorRelay::TakeStats()
+{
+    Stats s;
+    s.framesIn = _framesIn.exchange(0, std::memory_order_relaxed);
+    s.framesDropped = _framesDropped.exchange(0, std::memory_order_relaxed);
+    s.sends = _sends.exchange(0, std::memory_order_relaxed);
+    s.skipped = _skipped.exchange(0, std::memory_order_relaxed);
+    s.gone = _gone.exchange(0, std::memory_order_relaxed);
+    s.relayNs = _relayNs.exchange(0, std::memory_order_relaxed);
+    return s;
+}
+
+void SpectatorRelay::LaneLoop(uint32 index)
+{
+    ThreadPlacement::Pin(ThreadRole::Relay, index);
+
+    EpochManager& epoch = _sessions->Epoch();
+    const EpochManager::ParticipantId pid = epoch.Register();
+    if (pid == EpochManager::INVALID_PARTICIPANT)
+    {
+        Log(_tag, "Lane " + std::to_string(index) + " epoch register failed");
+        return;
+    }
+
+    Lane& lane = *_lanes[index];
+
+    // 락 밖에서 처리할 몫 (capacity 재사용)
+    std::vector<std::pair<SessionId, uint32>> subscribes;
+    std::vector<Frame> due;
+    uint64 nextIdleCheckUs = ServerTimeUs() + (uint64)IDLE_CHECK_MS * 1000;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(lane.mtx);
+
+            // 가장 이른 프레임 마감까지 (없으면 닫힌 방 확인 주기까지)
+            const uint64 nowUs = ServerTimeUs();
+            uint64 waitUs = nextIdleCheckUs > nowUs ? nextIdleCheckUs - nowUs : 0;
+            if (!lane.frames.empty())
+                waitUs = std::min(waitUs, lane.frames.front().dueUs > nowUs ? lane.frames.front().dueUs - nowUs : 0);
+            if (waitUs > 0 && lane.subscribes.empty() && !lane.stopping)
+                lane.cv.wait_for(lock, std::chrono::microseconds(waitUs));
+
+            if (lane.stopping)
+                break;
+
+            subscribes.swap(lane.subscribes);
+
+            const uint64 dueNowUs = ServerTimeUs();
+            while (!lane.frames.empty() && lane.frames.front().dueUs <= dueNowUs)
+            {
+                due.push_back(std::move(lane.frames.front()));
+                lane.frames.pop_front();
+            }
+        }
+
+        const auto t0 = std::chrono::steady_clock::now();
+        const uint64 nowUs = ServerTimeUs();
+        {
+            EpochGuard guard(epoch, pid);
+
+            for (const auto& sub : subscribes)
+                ApplySubscribe(lane, sub.first, sub.second, nowUs);
+
+            for (const Frame& f : due)
+                FanOut(lane, f, nowUs);
+
+            if (nowUs >= nextIdleCheckUs)
+            {
+                CloseIdleRooms(lane, nowUs);
+                nextIdleCheckUs = nowUs + (uint64)IDLE_CHECK_MS * 1000;
+            }
+        }
+
+        if (!due.empty())
+        {
+            _relayNs.fetch_add((uint64)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - t0).count(), std::memory_order_relaxed);
+        }
+
+        subscribes.clear();
+        due.clear();    // 마지막 참조면 여기서 프레임 해제
+    }
+
+    // 남은 프레임은 버림 (관전 세션은 곧 정리됨)
+    {
+        std::lock_guard<std::mutex> lock(lane.mtx);
+        lane.frames.clear();
+        lane.subscribes.clear();
+    }
+    lane.rooms.clear();
+    lane.roomOf.clear();
+
+    epoch.Unregister(pid);
+}
+
+void SpectatorRelay::ApplySubscribe(Lane& lane, SessionId sid, uint32 roomId, uint64 nowUs)
+{
+    auto it = lane.roomOf.find(sid);
+    if (it != lane.roomOf.end())
+    {
+        if (it->second == roomId)
+            return;
+
+        // 방 바꾸기: 이전 방 목록에서 뺌
+        auto room = lane.rooms.find(it->second);
+        if (room != lane.rooms.end())
+        {
+            std::vector<SessionId>& sids = room->second.sids;
+            sids.erase(std::remove(sids.begin(), sids.end(), sid), sids.end());
+            if (sids.empty())
+                lane.rooms.erase(room);
+        }
+        Watch(it->second, -1);
+        lane.roomOf.erase(it);
+    }
+
+    Watchers& w = lane.rooms[roomId];
+    if (w.sids.empty())
+        w.lastFrameUs = nowUs;  // 첫 프레임은 지연만큼 뒤에 옴 -> 닫힌 방 판단은 지금부터
+    w.sids.push_back(sid);
+    lane.roomOf[sid] = roomId;
+    Watch(roomId, 1);
+}
+
+void SpectatorRelay::FanOut(Lane& lane, const Frame& frame, uint64 nowUs)
+{
+    auto it = lane.rooms.find(frame.roomId);
+    if (it == lane.rooms.end())
+        return;
+
+    Watchers& w = it->second;
+    w.lastFrameUs = nowUs;
+
+    // 관전 클라 시계로는 tick이 지연만큼 늦게 도착 -> S_Ping의 tick 원점도 그만큼 뒤로
+    const uint64 originUs = frame.tickOriginUs + (uint64)SPECTATOR_DELAY_MS * 1000;
+
+    uint64 sends = 0;
+    uint64 skipped = 0;
+    uint32 gone = 0;
+    for (size_t i = 0; i < w.sids.size();)
+    {
+        Session* s = _sessions->Lookup(w.sids[i]);
+        if (!s)
+        {
+            // 끊긴 관전자 (순서 무관 -> swap-pop)
+            lane.roomOf.erase(w.sids[i]);
+            w.sids[i] = w.sids.back();
+            w.sids.pop_back();
+            ++gone;
+            continue;
+        }
+
+        uint32 replaced = 0;
+        if (s->SendSharedFrame(frame.bytes, replaced))
+        {
+            s->SetTickOrigin(originUs, TICK_INTERVAL_US);
+            ++sends;
+        }
+        skipped += replaced;
+        ++i;
+    }
+
+    _sends.fetch_add(sends, std::memory_order_relaxed);
+    _skipped.fetch_add(skipped, std::memory_order_relaxed);
+    if (gone > 0)
+    {
+        _gone.fetch_add(gone, std::memory_order_relaxed);
+        Watch(frame.roomId, -(int32)gone);
+        if (w.sids.empty())
+            lane.rooms.erase(it);
+    }
+}
+
+void SpectatorRelay::CloseIdleRooms(Lane& lane, uint64 nowUs)
+{
+    for (auto it = lane.rooms.begin(); it != lane.rooms.end();)
+    {
+        Watchers& w = it->second;
+        if (nowUs - w.lastFrameUs < (uint64)SPECTATOR_ROOM_IDLE_MS * 1000)
+        {
+            ++it;
+            continue;
+        }
+
+        // 방이 닫힘 (또는 처음부터 없는 방 id)
+        for (SessionId sid : w.sids)
+        {
+            Session* s = _sessions->Lookup(sid);
+            if (s)
+                s->Disconnect(DisconnectReason::RoomClosed);
+            lane.roomOf.erase(sid);
+        }
+
+        _gone.fetch_add(w.sids.size(), std::memory_order_relaxed);
+        Watch(it->first, -(int32)w.sids.size());
+        it = lane.rooms.erase(it);
+    }
+}
+
+void SpectatorRelay::Watch(uint32 roomId, int32 delta)
+{
+    std::lock_guard<std::mutex> lock(_watchMutex);
+
+    uint32& count = _watchCount[roomId];
+    count = (uint32)((int32)count + delta);
+    if (count == 0)
+        _watchCount.erase(roomId);
+
+    _spectators.fetch_add((uint32)delta, std::memory_order_relaxed);
+}
\ No newline at end of file
@@ -1,19 +1,3677 @@
-﻿#include <iostream>
+﻿#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <random>
 #include <vector>
 #include <string>
+#include <thread>
+#include <unordered_map>
 
 #define NOMINMAX
 #include <winsock2.h>
 #include <ws2tcpip.h>
+#include <windows.h>
+#include <psapi.h>
 #pragma comment(lib, "Ws2_32.lib")
+#pragma comment(lib, "Psapi.lib")
 
 #include "common/Types.h"
 #include "common/ByteIO.h"
+#include "common/OverloadController.h"
+#include "common/ServerClock.h"
+#include "common/ThreadPlacement.h"
 #include "net/Session.h"
 #include "net/Acceptor.h"
+#include "net/GameLink.h"
+#include "net/Gateway.h"
+#include "net/HotRestart.h"
 #include "net/SessionManager.h"
+#include "net/UdpTransport.h"
+#include "game/RoomManager.h"
+#include "game/ReplayRunner.h"
+#include "game/SnapshotPipeline.h"
+#include "game/SnapshotPriority.h"
+#include "game/SpectatorRelay.h"
 
-int main()
+// --replay <file>: 소켓 없이 기록된 입력으로 방 재시뮬레이션 (desync 확인 + 시뮬레이션 벤치)
+static int RunReplay(const std::string& path, const std::string& contentPath)
+{
+    ReplayRunner replay;
+    if (!replay.Load(path))
+        return 1;
+
+    // 테이블 파일이 없으면 라이브 서버처럼 임시값으로 진행
+    replay.LoadContent(contentPath);
+
+    ReplayRunner::Result r;
+    if (!replay.Run(r))
+        return 1;
+
+    const double ticksPerSec = r.seconds > 0.0 ? (double)r.roomTicks / r.seconds : 0.0;
+
+    std::cout << "rooms=" << r.rooms << " (imported " << r.importedRooms << ") roomTicks=" << r.roomTicks << " inputs=" << r.inputs
+        << " checksums=" << r.checksums << " mismatches=" << r.mismatches << " bad=" << r.badRecords
+        << (r.truncated ? " (truncated)" : "") << "\n";
+    std::cout << "replay " << r.seconds << "s, " << (uint64)ticksPerSec << " room-ticks/s\n";
+
+    return r.mismatches == 0 ? 0 : 2;
+}
+
+// 프로세스 상주 메모리 (working set / private)
+static void SampleMemory(uint64& workingSet, uint64& privateBytes)
+{
+    PROCESS_MEMORY_COUNTERS_EX pmc{};
+    pmc.cb = sizeof(pmc);
+    ::GetProcessMemoryInfo(::GetCurrentProcess(), (PROCESS_MEMORY_COUNTERS*)&pmc, sizeof(pmc));
+    workingSet = pmc.WorkingSetSize;
+    privateBytes = pmc.PrivateUsage;
+}
+
+// loopback listen 소켓 (포트는 OS가 고름, 실패하면 INVALID_SOCKET)
+static SOCKET OpenLoopbackListener(sockaddr_in& addr)
+{
+    SOCKET s = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    addr = sockaddr_in{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    int addrLen = sizeof(addr);
+    if (s == INVALID_SOCKET || ::bind(s, (sockaddr*)&addr, sizeof(addr)) == SOCKET_ERROR
+        || ::listen(s, SOMAXCONN) == SOCKET_ERROR || ::getsockname(s, (sockaddr*)&addr, &addrLen) == SOCKET_ERROR)
+    {
+        if (s != INVALID_SOCKET)
+            ::closesocket(s);
+        return INVALID_SOCKET;
+    }
+    return s;
+}
+
+// --bench-idle [N]: loopback으로 조용한 세션 N개(기본 10000)를 붙이고 세션당 상주 메모리 측정
+// - Acceptor(속도 제한/과부하) 없이 직접 accept -> CreateAndAdd -> Start
+// - 클라 소켓도 같은 프로세스라 값에 포함됨 (실제 서버보다 큰 쪽)
+static int RunIdleBench(uint32 count)
+{
+    WSADATA wsa{};
+    if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0)
+    {
+        std::cout << "WSAStartup failed\n";
+        return 1;
+    }
+
+    sockaddr_in addr{};
+    SOCKET listenSock = OpenLoopbackListener(addr);
+    if (listenSock == INVALID_SOCKET)
+    {
+        std::cout << "bench listen failed err=" << ::WSAGetLastError() << "\n";
+        WSACleanup();
+        return 1;
+    }
+
+    std::vector<SOCKET> clients;
+    clients.reserve(count);
+
+    SessionManager sessionMgr;
+
+    // I/O 스레드/풀이 자리 잡은 뒤부터 (세션과 무관한 고정분 제외)
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    uint64 wsBefore = 0;
+    uint64 privBefore = 0;
+    SampleMemory(wsBefore, privBefore);
+
+    uint32 opened = 0;
+    for (uint32 i = 0; i < count; ++i)
+    {
+        SOCKET c = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        if (c == INVALID_SOCKET || ::connect(c, (sockaddr*)&addr, sizeof(addr)) == SOCKET_ERROR)
+        {
+            std::cout << "bench connect failed at " << i << " err=" << ::WSAGetLastError() << "\n";
+            if (c != INVALID_SOCKET)
+                ::closesocket(c);
+            break;
+        }
+        clients.push_back(c);
+
+        SOCKET s = ::accept(listenSock, nullptr, nullptr);
+        if (s == INVALID_SOCKET)
+            break;
+
+        auto session = sessionMgr.CreateAndAdd(s);
+        if (!session)
+        {
+            ::closesocket(s);
+            break;
+        }
+        session->Start();
+        ++opened;
+    }
+
+    // 첫 ping/RTT 조회가 한 바퀴 돌고 송신 노드가 반납될 때까지
+    std::this_thread::sleep_for(std::chrono::milliseconds(2 * SessionIo::IO_TIMER_MS + 500));
+
+    uint64 wsAfter = 0;
+    uint64 privAfter = 0;
+    SampleMemory(wsAfter, privAfter);
+
+    const RecvBlockPool::Stats pool = sessionMgr.RecvPoolStats();
+    const uint64 n = opened > 0 ? opened : 1;
+    const uint64 privPer = privAfter > privBefore ? (privAfter - privBefore) / n : 0;
+    const uint64 wsPer = wsAfter > wsBefore ? (wsAfter - wsBefore) / n : 0;
+
+    std::cout << "idle sessions=" << sessionMgr.Count() << " sizeof(Session)=" << sizeof(Session) << "\n";
+    std::cout << "private " << privPer << " B/session (" << privPer * 10000 / (1024 * 1024) << " MB per 10k), "
+        << "working set " << wsPer << " B/session (" << wsPer * 10000 / (1024 * 1024) << " MB per 10k)\n";
+    std::cout << "recvBlocks inUse=" << pool.inUse << " free=" << pool.free << " allocs=" << pool.allocs << "\n";
+    std::cout << (privPer <= SESSION_IDLE_BUDGET_BYTES ? "within" : "OVER") << " budget " << SESSION_IDLE_BUDGET_BYTES << " B\n";
+
+    for (SOCKET c : clients)
+        ::closesocket(c);
+    sessionMgr.StopAll();
+
+    ::closesocket(listenSock);
+    WSACleanup();
+    return opened == count && privPer <= SESSION_IDLE_BUDGET_BYTES ? 0 : 2;
+}
+
+// 정렬해서 q 분위 값 (비어 있으면 0)
+static uint64 Percentile(std::vector<uint64>& values, double q)
+{
+    if (values.empty())
+        return 0;
+    std::sort(values.begin(), values.end());
+    return values[std::min(values.size() - 1, (size_t)(q * (double)values.size()))];
+}
+
+// --bench-churn 비교 대상: 샤딩 전 레지스트리 (unordered_map 1개 + 락 1개, 조회도 락 안에서)
+struct BaselineRegistry
+{
+    std::mutex mtx;
+    std::unordered_map<SessionId, std::shared_ptr<Session>> sessions;
+    std::atomic<SessionId> idGen{ 0 };
+
+    SessionId Add()
+    {
+        const SessionId id = ++idGen;
+        auto session = std::make_shared<Session>(INVALID_SOCKET, id, nullptr, nullptr);
+
+        std::lock_guard<std::mutex> lock(mtx);
+        sessions.emplace(id, std::move(session));
+        return id;
+    }
+
+    void Remove(SessionId id)
+    {
+        std::shared_ptr<Session> session;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            auto it = sessions.find(id);
+            if (it == sessions.end())
+                return;
+            session = std::move(it->second);
+            sessions.erase(it);
+        }
+    }
+
+    Session* Lookup(SessionId id)
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        auto it = sessions.find(id);
+        return it != sessions.end() ? it->second.get() : nullptr;
+    }
+};
+
+struct ChurnResult
+{
+    uint64 ops = 0;         // 등록 + 해제 쌍
+    double seconds = 0.0;
+    uint64 lookupP50Ns = 0;
+    uint64 lookupP99Ns = 0;
+    uint32 hitPct = 0;      // 조회가 살아 있는 세션을 찾은 비율
+};
+
+// 스레드마다 등록 -> 최근 id 공유 -> 조회 -> 오래된 것 해제를 반복
+// 조회 시간은 CHURN_LOOKUP_BATCH번 묶음 평균 (steady_clock 해상도가 조회 1번보다 거침)
+static constexpr uint32 CHURN_WINDOW = 64;          // 스레드당 살아 있는 세션 수
+static constexpr uint32 CHURN_RECENT = 4096;        // 다른 스레드가 등록한 최근 id 링
+static constexpr uint32 CHURN_LOOKUP_BATCH = 8;     // 등록 1번당 조회 수
+static constexpr uint32 CHURN_SECONDS = 3;
+
+template <typename AddFn, typename RemoveFn, typename LookupFn>
+static ChurnResult RunChurn(uint32 threads, AddFn add, RemoveFn remove, LookupFn lookup)
+{
+    std::vector<std::atomic<SessionId>> recent(CHURN_RECENT);
+    std::atomic<uint32> recentCursor{ 0 };
+    std::atomic<bool> running{ true };
+    std::atomic<uint64> ops{ 0 };
+    std::atomic<uint64> hits{ 0 };
+    std::vector<std::vector<uint64>> samples(threads);
+
+    std::vector<std::thread> workers;
+    const auto t0 = std::chrono::steady_clock::now();
+    for (uint32 t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&, t]() {
+            std::mt19937 rng(1000 + t);
+            std::deque<SessionId> own;
+            std::vector<uint64>& mine = samples[t];
+            uint64 done = 0;
+            uint64 hit = 0;
+            while (running.load(std::memory_order_relaxed))
+            {
+                const SessionId id = add();
+                if (id != 0)
+                {
+                    recent[recentCursor.fetch_add(1, std::memory_order_relaxed) % CHURN_RECENT].store(id, std::memory_order_relaxed);
+                    own.push_back(id);
+                }
+                if (own.size() > CHURN_WINDOW || (id == 0 && !own.empty()))
+                {
+                    remove(own.front());
+                    own.pop_front();
+                }
+                ++done;
+
+                SessionId ids[CHURN_LOOKUP_BATCH];
+                for (uint32 k = 0; k < CHURN_LOOKUP_BATCH; ++k)
+                {
+                    // 절반은 자기 살아 있는 세션, 절반은 아무 스레드의 최근 id (대부분 해제된 stale id)
+                    ids[k] = (k & 1) == 0 && !own.empty() ? own[rng() % own.size()]
+                        : recent[rng() % CHURN_RECENT].load(std::memory_order_relaxed);
+                }
+
+                uint32 found = 0;
+                const auto l0 = std::chrono::steady_clock::now();
+                for (uint32 k = 0; k < CHURN_LOOKUP_BATCH; ++k)
+                    found += lookup(t, ids[k]) ? 1 : 0;
+                const auto l1 = std::chrono::steady_clock::now();
+                mine.push_back((uint64)std::chrono::duration_cast<std::chrono::nanoseconds>(l1 - l0).count() / CHURN_LOOKUP_BATCH);
+                hit += found;
+            }
+
+            for (SessionId id : own)
+                remove(id);
+            ops.fetch_add(done, std::memory_order_relaxed);
+            hits.fetch_add(hit, std::memory_order_relaxed);
+            });
+    }
+
+    std::this_thread::sleep_for(std::chrono::seconds(CHURN_SECONDS));
+    running.store(false);
+    for (auto& w : workers)
+        w.join();
+
+    ChurnResult r;
+    r.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    r.ops = ops.load();
+    r.hitPct = r.ops > 0 ? (uint32)(hits.load() * 100 / (r.ops * CHURN_LOOKUP_BATCH)) : 0;
+
+    std::vector<uint64> all;
+    for (auto& s : samples)
+        all.insert(all.end(), s.begin(), s.end());
+    r.lookupP50Ns = Percentile(all, 0.5);
+    r.lookupP99Ns = Percentile(all, 0.99);
+    return r;
+}
+
+// --bench-churn [threads]: 스레드 N개(기본 16)가 세션 등록/해제 + 조회를 반복 -> 초당 등록/해제 쌍, 조회 p50/p99
+// - 소켓 없는 세션으로 레지스트리 비용만 (accept/IOCP는 --bench-idle 쪽)
+// - 비교 대상은 샤딩 전 구조 (BaselineRegistry)
+static int RunChurnBench(uint32 threads)
+{
+    threads = std::min<uint32>(std::max<uint32>(threads, 1), EpochManager::MAX_PARTICIPANTS / 2);
+
+    auto report = [](const char* label, const ChurnResult& r) {
+        std::cout << label << ": ops/s=" << (uint64)((double)r.ops / r.seconds)
+            << " lookupNs(p50/p99)=" << r.lookupP50Ns << "/" << r.lookupP99Ns << " hit=" << r.hitPct << "%\n";
+    };
+
+    std::cout << "churn threads=" << threads << " window=" << CHURN_WINDOW << " lookups/op=" << CHURN_LOOKUP_BATCH
+        << " " << CHURN_SECONDS << "s each\n";
+
+    {
+        BaselineRegistry baseline;
+        const ChurnResult r = RunChurn(threads,
+            [&baseline]() { return baseline.Add(); },
+            [&baseline](SessionId id) { baseline.Remove(id); },
+            [&baseline](uint32, SessionId id) { return baseline.Lookup(id) != nullptr; });
+        report("baseline map", r);
+    }
+
+    {
+        SessionManager sessionMgr;
+        std::vector<EpochManager::ParticipantId> pids(threads);
+        for (auto& pid : pids)
+            pid = sessionMgr.Epoch().Register();
+
+        const ChurnResult r = RunChurn(threads,
+            [&sessionMgr]() {
+                auto s = sessionMgr.CreateAndAdd(INVALID_SOCKET);
+                return s ? s->Id() : (SessionId)0;
+            },
+            [&sessionMgr](SessionId id) { sessionMgr.Remove(id); },
+            [&sessionMgr, &pids](uint32 t, SessionId id) {
+                EpochGuard guard(sessionMgr.Epoch(), pids[t]);
+                return sessionMgr.Lookup(id) != nullptr;
+            });
+        report("sharded slots", r);
+
+        for (auto pid : pids)
+            sessionMgr.Epoch().Unregister(pid);
+        std::cout << "left sessions=" << sessionMgr.Count() << " pendingRetire=" << sessionMgr.Epoch().PendingCount() << "\n";
+    }
+    return 0;
+}
+
+// 스냅샷 시점에 클라가 가진 적 상태 나이(tick) 분포 + 위치 오차 (--bench-priority 전략 1개분)
+struct StalenessTrack
+{
+    std::vector<uint32> sentTick;   // 적별 마지막으로 보낸 tick
+    std::vector<float> sentX;
+    std::vector<float> sentY;
+    std::vector<uint32> nearAges;
+    std::vector<uint32> farAges;
+    double nearError = 0.0;
+    double farError = 0.0;
+
+    explicit StalenessTrack(uint32 count) : sentTick(count, 0), sentX(count, 0.f), sentY(count, 0.f) {}
+
+    void Sent(uint32 i, uint32 tick, const SnapshotEnemy& e)
+    {
+        sentTick[i] = tick;
+        sentX[i] = e.x;
+        sentY[i] = e.y;
+    }
+
+    void Sample(uint32 tick, const std::vector<SnapshotEnemy>& enemies)
+    {
+        for (uint32 i = 0; i < (uint32)enemies.size(); ++i)
+        {
+            const SnapshotEnemy& e = enemies[i];
+            const float err = std::sqrt((e.x - sentX[i]) * (e.x - sentX[i]) + (e.y - sentY[i]) * (e.y - sentY[i]));
+            if (std::sqrt(e.x * e.x + e.y * e.y) < SnapshotPriority::FAR_RADIUS * 0.5f)
+            {
+                nearAges.push_back(tick - sentTick[i]);
+                nearError += err;
+            }
+            else
+            {
+                farAges.push_back(tick - sentTick[i]);
+                farError += err;
+            }
+        }
+    }
+
+    static std::string Describe(std::vector<uint32>& ages, double errorSum)
+    {
+        if (ages.empty())
+            return "-";
+        std::sort(ages.begin(), ages.end());
+        auto at = [&ages](double q) { return ages[std::min(ages.size() - 1, (size_t)(q * (double)ages.size()))]; };
+        return "p50=" + std::to_string(at(0.5)) + " p90=" + std::to_string(at(0.9)) + " p99=" + std::to_string(at(0.99))
+            + " max=" + std::to_string(ages.back()) + " err=" + std::to_string(errorSum / (double)ages.size());
+    }
+};
+
+// --bench-priority [N]: 적 N개(기본 200)인 합성 방 1개를 시점 1명(원점) 기준으로 60초 돌려 적 선택 비용/신선도 측정
+// - 예산은 라이브와 같은 EnemyBudget(MAX_PLAYERS_PER_ROOM, SNAPSHOT_EVERY_TICKS), 비교 대상은 index 순환(round-robin)
+// - 적 1/3만 움직이고 매 tick 일부가 hp를 잃음 (시드 고정 -> 실행마다 같은 결과)
+static int RunPriorityBench(uint32 count)
+{
+    count = std::min<uint32>(std::max<uint32>(count, 1), 0xFFFF); // 선택 결과가 uint16 index
+    const uint32 budget = SnapshotPriority::EnemyBudget(MAX_PLAYERS_PER_ROOM, SNAPSHOT_EVERY_TICKS);
+    const uint32 ticks = TICK_HZ * 60;
+
+    std::mt19937 rng(20240601);
+    std::uniform_real_distribution<float> pos(-48.f, 48.f);
+    std::uniform_real_distribution<float> dir(-1.f, 1.f);
+    std::uniform_int_distribution<uint32> pick(0, count - 1);
+
+    std::vector<SnapshotEnemy> enemies(count);
+    std::vector<float> velX(count, 0.f);
+    std::vector<float> velY(count, 0.f);
+    for (uint32 i = 0; i < count; ++i)
+    {
+        enemies[i].id = i + 1;
+        enemies[i].x = pos(rng);
+        enemies[i].y = pos(rng);
+        enemies[i].hp = ENEMY_MAX_HP;
+        enemies[i].state = ENTITY_STATE_ALIVE;
+        if (i % 3 == 0)
+        {
+            velX[i] = dir(rng) * ENEMY_MOVE_SPEED * TICK_DT;
+            velY[i] = dir(rng) * ENEMY_MOVE_SPEED * TICK_DT;
+        }
+    }
+
+    SnapshotPriority priority;
+    StalenessTrack prio(count);
+    StalenessTrack robin(count);
+    std::vector<uint16> selected;
+    uint32 robinCursor = 0;
+    uint64 selectNs = 0;
+    uint64 selects = 0;
+
+    // 첫 스냅샷은 전부 (접속 직후와 같음)
+    priority.MarkAllSent(0, enemies.data(), count);
+
+    for (uint32 tick = 1; tick <= ticks; ++tick)
+    {
+        for (uint32 i = 0; i < count; ++i)
+        {
+            enemies[i].x += velX[i];
+            enemies[i].y += velY[i];
+        }
+        SnapshotEnemy& hit = enemies[pick(rng)];
+        if (hit.hp > 0)
+            hit.hp = (uint16)(hit.hp - 1);
+
+        if (tick % SNAPSHOT_EVERY_TICKS != 0)
+            continue;
+
+        prio.Sample(tick, enemies);
+        robin.Sample(tick, enemies);
+
+        selected.clear();
+        const auto t0 = std::chrono::steady_clock::now();
+        priority.Select(tick, 0.f, 0.f, enemies.data(), count, budget, selected);
+        const auto t1 = std::chrono::steady_clock::now();
+        selectNs += (uint64)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+        ++selects;
+
+        for (uint16 i : selected)
+            prio.Sent(i, tick, enemies[i]);
+
+        for (uint32 k = 0; k < std::min(budget, count); ++k)
+        {
+            robin.Sent(robinCursor, tick, enemies[robinCursor]);
+            robinCursor = (robinCursor + 1) % count;
+        }
+    }
+
+    std::cout << "enemies=" << count << " budget=" << budget << "/snapshot (" << SNAPSHOT_CLIENT_BYTES_PER_SEC << " B/s, every "
+        << SNAPSHOT_EVERY_TICKS << " ticks) snapshots=" << selects << "\n";
+    std::cout << "select " << (selects > 0 ? selectNs / selects : 0) << " ns/session/snapshot\n";
+    std::cout << "priority near: " << StalenessTrack::Describe(prio.nearAges, prio.nearError) << "\n";
+    std::cout << "priority far:  " << StalenessTrack::Describe(prio.farAges, prio.farError) << "\n";
+    std::cout << "robin near:    " << StalenessTrack::Describe(robin.nearAges, robin.nearError) << "\n";
+    std::cout << "robin far:     " << StalenessTrack::Describe(robin.farAges, robin.farError) << "\n";
+    return 0;
+}
+
+// loopback connect -> accept -> 세션 시작, 클라 소켓은 non-blocking으로 돌려줌 (실패하면 INVALID_SOCKET)
+// sid: 있으면 서버 쪽 세션 id
+static SOCKET ConnectLoopbackSession(SOCKET listenSock, const sockaddr_in& addr, SessionManager& mgr, SessionId* sid = nullptr)
+{
+    SOCKET c = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (c == INVALID_SOCKET || ::connect(c, (const sockaddr*)&addr, sizeof(addr)) == SOCKET_ERROR)
+    {
+        if (c != INVALID_SOCKET)
+            ::closesocket(c);
+        return INVALID_SOCKET;
+    }
+
+    SOCKET s = ::accept(listenSock, nullptr, nullptr);
+    auto session = s != INVALID_SOCKET ? mgr.CreateAndAdd(s) : nullptr;
+    if (!session)
+    {
+        if (s != INVALID_SOCKET)
+            ::closesocket(s);
+        ::closesocket(c);
+        return INVALID_SOCKET;
+    }
+    session->Start();
+    if (sid)
+        *sid = session->Id();
+
+    u_long nonBlocking = 1;
+    ::ioctlsocket(c, FIONBIO, &nonBlocking);
+    return c;
+}
+
+// --bench-spectators [N]: loopback 방 1개(플레이어 MAX_PLAYERS_PER_ROOM명, 계속 이동)의 tick 스레드 비용을 관전자 0명 / N명(기본 500)으로 비교
+// - 서버와 같은 구성 (관전 SessionManager + SpectatorRelay, 인코더 -> 릴레이), Acceptor 없이 직접 accept
+// - 클라 소켓 수신도 같은 프로세스라 코어 경합까지 들어간 값
+static int RunSpectatorBench(uint32 count)
+{
+    WSADATA wsa{};
+    if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0)
+    {
+        std::cout << "WSAStartup failed\n";
+        return 1;
+    }
+
+    sockaddr_in playerAddr{};
+    sockaddr_in spectatorAddr{};
+    SOCKET playerListen = OpenLoopbackListener(playerAddr);
+    SOCKET spectatorListen = OpenLoopbackListener(spectatorAddr);
+    if (playerListen == INVALID_SOCKET || spectatorListen == INVALID_SOCKET)
+    {
+        std::cout << "bench listen failed err=" << ::WSAGetLastError() << "\n";
+        WSACleanup();
+        return 1;
+    }
+
+    SessionManager sessionMgr;
+    SessionManager spectatorMgr;
+    SpectatorRelay relay(&spectatorMgr);
+    RoomManager roomMgr(&sessionMgr);
+    roomMgr.SetSpectatorRelay(&relay);
+
+    sessionMgr.SetSessionHooks(
+        [&roomMgr](SessionId sid) { roomMgr.OnSessionOpened(sid); },
+        [&roomMgr](SessionId sid) { roomMgr.OnSessionClosed(sid); });
+    SessionInputHooks inputHooks;
+    inputHooks.onMoveInput = [&roomMgr](SessionId sid, const C_MoveInput& msg) { roomMgr.OnMoveInput(sid, msg); };
+    sessionMgr.SetInputHooks(std::move(inputHooks));
+
+    SessionInputHooks spectatorHooks;
+    spectatorHooks.onSpectate = [&roomMgr, &relay](SessionId sid, const C_SpectateReq& msg) {
+        relay.Subscribe(sid, msg.roomId != 0 ? msg.roomId : roomMgr.FeaturedRoom());
+        };
+    spectatorMgr.SetInputHooks(std::move(spectatorHooks));
+
+    if (!roomMgr.Start() || !relay.Start())
+    {
+        ::closesocket(playerListen);
+        ::closesocket(spectatorListen);
+        WSACleanup();
+        return 1;
+    }
+
+    std::vector<SOCKET> players;
+    for (uint32 i = 0; i < MAX_PLAYERS_PER_ROOM; ++i)
+    {
+        SOCKET c = ConnectLoopbackSession(playerListen, playerAddr, sessionMgr);
+        if (c != INVALID_SOCKET)
+            players.push_back(c);
+    }
+
+    // 클라 쪽: 받은 건 버리고(관전자는 바이트만 셈) 플레이어는 100ms마다 방향을 바꿔 이동 입력
+    std::mutex spectatorsMutex;
+    std::vector<SOCKET> spectators;
+    std::atomic<uint64> spectatorBytes{ 0 };
+    std::atomic<bool> clientsRunning{ true };
+    std::thread clients([&]() {
+        std::vector<Byte> buf(64 * 1024);
+        std::vector<SOCKET> watching;
+        uint32 seq = 0;
+        auto nextInput = std::chrono::steady_clock::now();
+        while (clientsRunning.load())
+        {
+            const auto now = std::chrono::steady_clock::now();
+            if (now >= nextInput)
+            {
+                ++seq;
+                const ByteBuffer frame = BuildFrame(C_MoveInput{ seq, (int8)((seq / 10) % 3) - 1, (int8)((seq / 30) % 3) - 1, 100 });
+                for (SOCKET c : players)
+                    ::send(c, (const char*)frame.data(), (int)frame.size(), 0);
+                nextInput = now + std::chrono::milliseconds(100);
+            }
+
+            for (SOCKET c : players)
+            {
+                while (::recv(c, (char*)buf.data(), (int)buf.size(), 0) > 0)
+                {
+                }
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(spectatorsMutex);
+                watching = spectators;
+            }
+            for (SOCKET c : watching)
+            {
+                int n = 0;
+                while ((n = ::recv(c, (char*)buf.data(), (int)buf.size(), 0)) > 0)
+                    spectatorBytes.fetch_add((uint64)n, std::memory_order_relaxed);
+            }
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        });
+
+    // 구간마다 tick 작업 시간 (평균/최대)
+    auto measure = [&roomMgr](const std::string& label) {
+        roomMgr.TakeTickCost();
+        std::this_thread::sleep_for(std::chrono::seconds(5));
+        const RoomManager::TickCost c = roomMgr.TakeTickCost();
+        const uint64 avgNs = c.ticks > 0 ? c.workUsSum * 1000 / c.ticks : 0;
+        std::cout << label << ": ticks=" << c.ticks << " tickWorkUs(avg/max)=" << avgNs / 1000 << "." << (avgNs % 1000) / 100
+            << "/" << c.workUsMax << "\n";
+    };
+
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    std::cout << "players=" << players.size() << " room=" << roomMgr.FeaturedRoom() << "\n";
+    measure("0 spectators");
+
+    // 관전자 접속 + C_SpectateReq(기본 방), 지연이 지나 fan-out이 돌기 시작할 때부터 잼
+    const ByteBuffer spectateReq = BuildFrame(C_SpectateReq{ 0 });
+    uint32 opened = 0;
+    for (uint32 i = 0; i < count; ++i)
+    {
+        SOCKET c = ConnectLoopbackSession(spectatorListen, spectatorAddr, spectatorMgr);
+        if (c == INVALID_SOCKET)
+        {
+            std::cout << "spectator connect failed at " << i << " err=" << ::WSAGetLastError() << "\n";
+            break;
+        }
+        ::send(c, (const char*)spectateReq.data(), (int)spectateReq.size(), 0);
+
+        std::lock_guard<std::mutex> lock(spectatorsMutex);
+        spectators.push_back(c);
+        ++opened;
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(SPECTATOR_DELAY_MS + 1000));
+    relay.TakeStats();
+    spectatorBytes.store(0);
+    measure(std::to_string(opened) + " spectators");
+
+    const SpectatorRelay::Stats rs = relay.TakeStats();
+    std::cout << "subscribed=" << relay.Spectators() << " relayFrames=" << rs.framesIn << " sends=" << rs.sends
+        << " skipped=" << rs.skipped << " relayUs/frame=" << (rs.framesIn > 0 ? rs.relayNs / rs.framesIn / 1000 : 0)
+        << " spectatorKB/s=" << spectatorBytes.load() / 1024 / 5 << "\n";
+
+    clientsRunning.store(false);
+    clients.join();
+    for (SOCKET c : players)
+        ::closesocket(c);
+    for (SOCKET c : spectators)
+        ::closesocket(c);
+
+    roomMgr.Stop();
+    relay.Stop();
+    sessionMgr.StopAll();
+    spectatorMgr.StopAll();
+
+    ::closesocket(playerListen);
+    ::closesocket(spectatorListen);
+    WSACleanup();
+    return opened == count && rs.sends > 0 ? 0 : 2;
+}
+
+struct StormResult
+{
+    uint32 answered = 0;        // 일반 주소: 첫 응답 바이트까지 받음
+    uint32 failed = 0;          // 일반 주소: connect 실패/응답 없이 끊김
+    uint32 hotAnswered = 0;     // 한 주소에서 몰아 붙인 쪽
+    double seconds = 0;
+    uint64 ttfbP50Us = 0;
+    uint64 ttfbP99Us = 0;
+};
+
+static constexpr uint32 STORM_THREADS = 16;
+static constexpr uint32 STORM_PER_ADDRESS = 16;     // 일반 주소당 접속 수 (IP당 burst 안쪽)
+static constexpr uint32 STORM_TIMEOUT_MS = 5000;
+
+// 배포 직후 재접속 폭주 흉내: STORM_THREADS개가 count + hot개를 나눠 한꺼번에 connect -> C_Ping -> 첫 응답 바이트
+// - 일반 접속 i는 127.0.0.(2 + i / STORM_PER_ADDRESS)에서, hot개는 전부 127.0.0.1에서 (IP당 제한에 걸리는 쪽)
+// - 소켓은 다 끝날 때까지 열어 둠 (세션 수가 계속 늘어나는 상태)
+static StormResult RunStorm(const sockaddr_in& server, uint32 count, uint32 hot)
+{
+    const ByteBuffer ping = BuildFrame(C_Ping{ 1 });
+    std::mutex resultMutex;
+    std::vector<uint64> ttfbUs;
+    std::vector<SOCKET> sockets;
+    StormResult r;
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (uint32 t = 0; t < STORM_THREADS; ++t)
+    {
+        threads.emplace_back([&, t]() {
+            for (uint32 i = t; i < count + hot; i += STORM_THREADS)
+            {
+                const bool isHot = i >= count;
+                sockaddr_in local{};
+                local.sin_family = AF_INET;
+                local.sin_addr.s_addr = htonl(INADDR_LOOPBACK + (isHot ? 0 : 1 + i / STORM_PER_ADDRESS));
+
+                const auto t0 = std::chrono::steady_clock::now();
+                SOCKET c = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+                DWORD timeout = STORM_TIMEOUT_MS;
+                ::setsockopt(c, SOL_SOCKET, SO_RCVTIMEO, (const char*)&timeout, sizeof(timeout));
+
+                Byte first = 0;
+                const bool answered = c != INVALID_SOCKET
+                    && ::bind(c, (sockaddr*)&local, sizeof(local)) != SOCKET_ERROR
+                    && ::connect(c, (const sockaddr*)&server, sizeof(server)) != SOCKET_ERROR
+                    && ::send(c, (const char*)ping.data(), (int)ping.size(), 0) == (int)ping.size()
+                    && ::recv(c, (char*)&first, 1, 0) == 1;
+                const uint64 us = (uint64)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t0).count();
+
+                std::lock_guard<std::mutex> lock(resultMutex);
+                if (c != INVALID_SOCKET)
+                    sockets.push_back(c);
+                if (isHot)
+                {
+                    r.hotAnswered += answered ? 1 : 0;
+                }
+                else if (answered)
+                {
+                    ++r.answered;
+                    ttfbUs.push_back(us);
+                }
+                else
+                {
+                    ++r.failed;
+                }
+            }
+            });
+    }
+    for (auto& t : threads)
+        t.join();
+
+    r.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    r.ttfbP50Us = Percentile(ttfbUs, 0.50);
+    r.ttfbP99Us = Percentile(ttfbUs, 0.99);
+
+    for (SOCKET c : sockets)
+        ::closesocket(c);
+    return r;
+}
+
+static void PrintStorm(const char* label, const StormResult& r, uint32 hot)
+{
+    std::cout << label << ": answered=" << r.answered << " failed=" << r.failed << " accepts/s=" << (uint64)(r.answered / r.seconds)
+        << " ttfbUs(p50/p99)=" << r.ttfbP50Us << "/" << r.ttfbP99Us << " hotAnswered=" << r.hotAnswered << "/" << hot << "\n";
+}
+
+// --bench-connect-storm [N]: 접속 N개(기본 2000, + 한 주소에서 N/8개)를 한꺼번에 붙였을 때 accepts/s, 첫 응답까지 시간
+// - 이전: 블로킹 accept 스레드 1개 + 접속마다 주소 문자열/로그 (Acceptor의 예전 루프 그대로)
+// - 지금: Acceptor (non-blocking listen + WSAPoll 배치 accept 스레드 + IP당 속도 제한)
+static int RunConnectStormBench(uint32 count)
+{
+    WSADATA wsa{};
+    if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0)
+    {
+        std::cout << "WSAStartup failed\n";
+        return 1;
+    }
+
+    // 일반 주소는 127.0.0.2 ~ 127.0.0.254
+    count = std::min<uint32>(count, 253 * STORM_PER_ADDRESS);
+    const uint32 hot = count / 8;
+    std::cout << "connect storm: " << count << " connections from " << (count + STORM_PER_ADDRESS - 1) / STORM_PER_ADDRESS
+        << " addresses + " << hot << " from one address, " << STORM_THREADS << " client threads\n";
+
+    // ---- 이전: 블로킹 accept 1개
+    StormResult before;
+    {
+        sockaddr_in addr{};
+        SOCKET listenSock = OpenLoopbackListener(addr);
+        if (listenSock == INVALID_SOCKET)
+        {
+            std::cout << "bench listen failed err=" << ::WSAGetLastError() << "\n";
+            WSACleanup();
+            return 1;
+        }
+
+        SessionManager sessionMgr;
+        std::thread acceptThread([&]() {
+            while (true)
+            {
+                sockaddr_in caddr{};
+                int clen = sizeof(caddr);
+                SOCKET clientSock = ::accept(listenSock, (sockaddr*)&caddr, &clen);
+                if (clientSock == INVALID_SOCKET)
+                    break;
+
+                auto session = sessionMgr.CreateAndAdd(clientSock);
+                if (!session)
+                {
+                    ::closesocket(clientSock);
+                    continue;
+                }
+                session->Start();
+
+                char ipbuf[64]{};
+                inet_ntop(AF_INET, &caddr.sin_addr, ipbuf, (socklen_t)sizeof(ipbuf));
+                std::cout << "[Acceptor] Accepted client: " << ipbuf << ":" << ntohs(caddr.sin_port) << "\n";
+            }
+            });
+
+        before = RunStorm(addr, count, hot);
+
+        // 블로킹 accept를 깨움
+        ::shutdown(listenSock, SD_BOTH);
+        ::closesocket(listenSock);
+        acceptThread.join();
+        sessionMgr.StopAll();
+    }
+
+    // ---- 지금: Acceptor (같은 포트 번호를 쓰려고 OS가 고른 빈 포트를 받아 둠)
+    StormResult after;
+    uint64 rejected = 0;
+    {
+        sockaddr_in addr{};
+        SOCKET probe = OpenLoopbackListener(addr);
+        if (probe == INVALID_SOCKET)
+        {
+            WSACleanup();
+            return 1;
+        }
+        ::closesocket(probe);
+
+        SessionManager sessionMgr;
+        Acceptor acceptor(&sessionMgr);
+        if (!acceptor.Start(ntohs(addr.sin_port)))
+        {
+            WSACleanup();
+            return 1;
+        }
+
+        after = RunStorm(addr, count, hot);
+        rejected = acceptor.RejectedCount();
+
+        acceptor.Stop();
+        sessionMgr.StopAll();
+    }
+
+    PrintStorm("blocking accept", before, hot);
+    PrintStorm("batched + limiter", after, hot);
+    std::cout << "rate limited (closed before session)=" << rejected << "\n";
+
+    WSACleanup();
+    return after.failed == 0 ? 0 : 2;
+}
+
+// 받은 바이트에서 프레임을 꺼내 fn(msgId, payload, len), fn이 false를 주면 true로 끝
+// (EOF/에러/timeoutMs 경과면 false, ping은 계속 오므로 시간은 전체 기준)
+template <typename FrameFn>
+static bool DrainFrames(SOCKET c, uint32 timeoutMs, FrameFn fn)
+{
+    DWORD timeout = timeoutMs;
+    ::setsockopt(c, SOL_SOCKET, SO_RCVTIMEO, (const char*)&timeout, sizeof(timeout));
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+
+    std::vector<Byte> buf;
+    Byte chunk[16 * 1024];
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        const int n = ::recv(c, (char*)chunk, sizeof(chunk), 0);
+        if (n <= 0)
+            return false;
+        buf.insert(buf.end(), chunk, chunk + n);
+
+        size_t pos = 0;
+        bool more = true;
+        while (more && buf.size() - pos >= 4)
+        {
+            const size_t total = 2 + (size_t)LoadLE<uint16>(buf.data() + pos);
+            if (buf.size() - pos < total)
+                break;
+            more = fn(LoadLE<uint16>(buf.data() + pos + 2), buf.data() + pos + 4, total - 4);
+            pos += total;
+        }
+        buf.erase(buf.begin(), buf.begin() + pos);
+        if (!more)
+            return true;
+    }
+    return false;
+}
+
+// --bench-slow-consumer [N]: 받지 않는 클라 하나에 보내면서 send 큐 정책 확인 (N = 1단계 reliable 수, 기본 200)
+// 1) reliable N개 + 스냅샷 N개를 번갈아: 스냅샷은 대체(최신만 도착), reliable은 전부 순서대로
+// 2) 예산 초과(프레임 수)를 유지: SEND_OVERFLOW_DISCONNECT_MS 전에는 안 끊기고, 끊길 때 마지막 프레임은 S_Disconnect(SlowConsumer)
+// 3) 끝까지 안 받는 클라 (hard limit): S_Disconnect도 못 나가면 DISCONNECT_LINGER_MS 뒤 세션이 닫힘
+static int RunSlowConsumerBench(uint32 count)
+{
+    WSADATA wsa{};
+    if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0)
+    {
+        std::cout << "WSAStartup failed\n";
+        return 1;
+    }
+
+    sockaddr_in addr{};
+    SOCKET listenSock = OpenLoopbackListener(addr);
+    if (listenSock == INVALID_SOCKET)
+    {
+        std::cout << "bench listen failed err=" << ::WSAGetLastError() << "\n";
+        WSACleanup();
+        return 1;
+    }
+
+    SessionManager sessionMgr;
+
+    // 소켓 버퍼를 작게 (안 읽으면 바로 서버 큐에 쌓이게)
+    auto connectOne = [&](SOCKET& outClient) -> std::shared_ptr<Session> {
+        const int bufBytes = 8 * 1024;
+        outClient = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        ::setsockopt(outClient, SOL_SOCKET, SO_RCVBUF, (const char*)&bufBytes, sizeof(bufBytes));
+        if (::connect(outClient, (sockaddr*)&addr, sizeof(addr)) == SOCKET_ERROR)
+            return nullptr;
+
+        SOCKET s = ::accept(listenSock, nullptr, nullptr);
+        if (s == INVALID_SOCKET)
+            return nullptr;
+        ::setsockopt(s, SOL_SOCKET, SO_SNDBUF, (const char*)&bufBytes, sizeof(bufBytes));
+
+        auto session = sessionMgr.CreateAndAdd(s);
+        if (!session)
+        {
+            ::closesocket(s);
+            return nullptr;
+        }
+        session->Start();
+        return session;
+    };
+
+    // 스냅샷 대신 크기만 비슷한 가짜 (앞 4바이트 = tick)
+    std::vector<Byte> snapshotPayload(1000, 0);
+    std::vector<Byte> bulkPayload(MAX_FRAME_TOTAL - 4, 0);
+    bool ok = true;
+
+    // ---- 1) 대체 / reliable 보존
+    SOCKET c1 = INVALID_SOCKET;
+    auto s1 = connectOne(c1);
+    if (!s1)
+    {
+        std::cout << "bench connect failed err=" << ::WSAGetLastError() << "\n";
+        ok = false;
+    }
+    else
+    {
+        for (uint32 i = 0; i < count; ++i)
+        {
+            s1->Send(S_Pong{ i });
+            StoreLE<uint32>(snapshotPayload.data(), i);
+            s1->SendFrame(S_Snapshot::ID, snapshotPayload.data(), snapshotPayload.size(), SendKind::Snapshot);
+        }
+        const SendQueueStats queued = s1->GetSendStats();
+
+        uint32 nextReliable = 0;
+        uint32 snapshots = 0;
+        uint32 lastTick = 0;
+        bool ordered = true;
+        DrainFrames(c1, 2000, [&](MsgId id, const Byte* payload, size_t) {
+            if (id == S_Pong::ID)
+                ordered = ordered && LoadLE<uint32>(payload) == nextReliable++;
+            else if (id == S_Snapshot::ID)
+            {
+                const uint32 tick = LoadLE<uint32>(payload);
+                ordered = ordered && (snapshots == 0 || tick > lastTick);
+                lastTick = tick;
+                ++snapshots;
+            }
+            return nextReliable < count || snapshots == 0 || lastTick + 1 < count;
+            });
+
+        const bool pass = ordered && nextReliable == count && snapshots > 0 && lastTick + 1 == count && snapshots < count && queued.droppedSnapshots > 0;
+        std::cout << "supersede: reliable " << nextReliable << "/" << count << " in order=" << (ordered ? "yes" : "NO")
+            << ", snapshots delivered " << snapshots << "/" << count << " (dropped " << queued.droppedSnapshots
+            << ", last tick " << lastTick << ") -> " << (pass ? "ok" : "FAIL") << "\n";
+        ok = ok && pass;
+
+        // ---- 2) 초과 유지 -> SEND_OVERFLOW_DISCONNECT_MS 뒤에 S_Disconnect(SlowConsumer)
+        // 10ms마다 큐가 프레임 예산(MAX_SEND_QUEUE_FRAMES)을 넘을 때까지 채움 (바이트는 hard limit 한참 아래)
+        // 그 사이 커널 버퍼가 다 받아 가서 예산 아래로 내려가면 서버도 초과 시작을 다시 잡으므로 여기서도 다시
+        uint32 seq = count;
+        const auto start = std::chrono::steady_clock::now();
+        auto overSince = std::chrono::steady_clock::time_point{};
+        auto lastAccepted = std::chrono::steady_clock::time_point{};
+        bool rejected = false;
+        while (!rejected && std::chrono::steady_clock::now() - start < std::chrono::seconds(10))
+        {
+            if (s1->GetSendStats().queuedFrames <= MAX_SEND_QUEUE_FRAMES)
+                overSince = std::chrono::steady_clock::time_point{};
+
+            while (true)
+            {
+                const auto before = std::chrono::steady_clock::now();
+                rejected = !s1->Send(S_Pong{ seq++ });
+                if (rejected)
+                {
+                    lastAccepted = before;
+                    break;
+                }
+                if (s1->GetSendStats().queuedFrames > MAX_SEND_QUEUE_FRAMES)
+                {
+                    if (overSince == std::chrono::steady_clock::time_point{})
+                        overSince = std::chrono::steady_clock::now();
+                    break;
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        // overSince는 실제 초과 시작보다 늦고 lastAccepted는 끊은 판단보다 이르므로 둘의 차이는 하한
+        const int64 overMs = std::chrono::duration_cast<std::chrono::milliseconds>(lastAccepted - overSince).count();
+
+        uint32 lastReliable = 0;
+        uint16 lastMsg = 0;
+        uint16 reason = 0;
+        bool monotonic = true;
+        DrainFrames(c1, 2000, [&](MsgId id, const Byte* payload, size_t) {
+            if (id == S_Pong::ID)
+            {
+                const uint32 s = LoadLE<uint32>(payload);
+                monotonic = monotonic && s > lastReliable;
+                lastReliable = s;
+            }
+            if (id == S_Disconnect::ID)
+                reason = LoadLE<uint16>(payload);
+            lastMsg = id;
+            return true;
+            });
+
+        const bool pass2 = rejected && overMs >= (int64)SEND_OVERFLOW_DISCONNECT_MS - 1
+            && overMs <= (int64)SEND_OVERFLOW_DISCONNECT_MS + 500
+            && monotonic && lastMsg == S_Disconnect::ID && reason == (uint16)DisconnectReason::SlowConsumer;
+        std::cout << "overflow: disconnected after " << overMs << "ms over budget (limit " << SEND_OVERFLOW_DISCONNECT_MS
+            << "), last frame " << lastMsg << " reason=" << reason << " reliable in order=" << (monotonic ? "yes" : "NO")
+            << " -> " << (pass2 ? "ok" : "FAIL") << "\n";
+        ok = ok && pass2;
+    }
+
+    // ---- 3) 끝까지 안 받음 (hard limit): DISCONNECT_LINGER_MS 뒤 타이머가 닫음
+    SOCKET c2 = INVALID_SOCKET;
+    auto s2 = connectOne(c2);
+    if (!s2)
+    {
+        ok = false;
+    }
+    else
+    {
+        // 천천히 채워 커널 버퍼부터 다 차게 한 뒤 (그 전에 몰아 넣으면 S_Disconnect가 그냥 나감) hard limit까지
+        bool accepted = true;
+        while (accepted && s2->GetSendStats().queuedBytes < MAX_SEND_QUEUE_BYTES / 4)
+        {
+            accepted = s2->SendFrame(S_Pong::ID, bulkPayload.data(), bulkPayload.size());
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        while (accepted)
+            accepted = s2->SendFrame(S_Pong::ID, bulkPayload.data(), bulkPayload.size());
+        const auto rejectedAt = std::chrono::steady_clock::now();
+        std::weak_ptr<Session> watch = s2;
+        s2.reset();
+
+        // 매니저에서 빠지고 I/O 참조까지 다 놓으면 만료
+        while (!watch.expired()
+            && std::chrono::steady_clock::now() - rejectedAt < std::chrono::milliseconds(DISCONNECT_LINGER_MS + 2000))
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        const int64 closeMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - rejectedAt).count();
+        const bool pass3 = watch.expired() && closeMs >= (int64)DISCONNECT_LINGER_MS - 10
+            && closeMs <= (int64)(DISCONNECT_LINGER_MS + 2 * SessionIo::IO_TIMER_MS);
+        std::cout << "never reads: closed " << closeMs << "ms after hard limit (linger " << DISCONNECT_LINGER_MS << ") -> "
+            << (pass3 ? "ok" : "FAIL") << "\n";
+        ok = ok && pass3;
+    }
+
+    s1.reset();
+    if (c1 != INVALID_SOCKET)
+        ::closesocket(c1);
+    if (c2 != INVALID_SOCKET)
+        ::closesocket(c2);
+    sessionMgr.StopAll();
+
+    ::closesocket(listenSock);
+    WSACleanup();
+    return ok ? 0 : 2;
+}
+
+// 필드마다 다른 값 (0 아님, 바이트가 서로 다름) -> 오프셋/순서/엔디언이 틀리면 round-trip에서 드러남
+template <typename T>
+static T CodecPattern(uint32 k)
+{
+    const uint64 bits = (0x9E3779B97F4A7C15ull * (k + 1)) ^ 0x0123456789ABCDEFull;
+    if constexpr (std::is_floating_point<T>::value)
+        return (T)((int64)(bits >> 40) - (1 << 23)) / (T)64;
+    else if constexpr (sizeof(T) == 8)
+        return (T)bits;
+    else
+        return (T)(bits >> (64 - 8 * sizeof(T)));
+}
+
+template <typename Msg>
+static Msg CodecSample(uint32 seed)
+{
+    Msg m{};
+    uint32 k = seed;
+    std::apply([&](auto... f) { ((m.*f = CodecPattern<std::decay_t<decltype(m.*f)>>(k++)), ...); }, Msg::Fields());
+    return m;
+}
+
+template <typename Msg>
+static bool CodecSameFields(const Msg& a, const Msg& b)
+{
+    bool same = true;
+    std::apply([&](auto... f) {
+        ((same = same && std::memcmp(&(a.*f), &(b.*f), sizeof(a.*f)) == 0), ...);
+        }, Msg::Fields());
+    return same;
+}
+
+static constexpr uint32 CODEC_SAMPLES = 16;     // 타이밍 루프가 돌리는 서로 다른 값 수
+
+struct CodecTiming
+{
+    double encodeNs = 0;
+    double decodeNs = 0;
+};
+
+// 표본 CODEC_SAMPLES개를 돌아가며 encodeFn/decodeFn을 iterations번 (결과 바이트를 sink에 섞어 최적화로 안 빠지게)
+template <typename EncodeFn, typename DecodeFn>
+static CodecTiming TimeCodec(uint32 iterations, EncodeFn encodeFn, DecodeFn decodeFn)
+{
+    volatile uint64 sink = 0;
+    uint64 acc = 0;
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32 i = 0; i < iterations; ++i)
+        acc += encodeFn(i % CODEC_SAMPLES);
+    auto t1 = std::chrono::steady_clock::now();
+    for (uint32 i = 0; i < iterations; ++i)
+        acc += decodeFn(i % CODEC_SAMPLES);
+    auto t2 = std::chrono::steady_clock::now();
+    sink = acc;
+
+    CodecTiming t;
+    t.encodeNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / iterations;
+    t.decodeNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / iterations;
+    return t;
+}
+
+static void PrintCodecLine(const char* name, const std::string& kind, size_t size, const CodecTiming& t, bool ok)
+{
+    std::cout << "  " << name << " " << kind << " size=" << size << " encodeNs=" << (uint64)(t.encodeNs * 10) / 10.0
+        << " decodeNs=" << (uint64)(t.decodeNs * 10) / 10.0 << (ok ? " ok" : " ROUND-TRIP FAIL") << "\n";
+}
+
+// Fields() 메시지 1개: 프레임 헤더, BuildFrame/ByteWriter 경로가 같은 바이트인지, 디코드 == 원본, 길이 ±1은 malformed
+template <typename Msg>
+static bool CheckCodecMessage(const char* name, uint32 iterations)
+{
+    using C = FixedCodec<Msg>;
+
+    bool ok = true;
+    std::array<std::array<Byte, C::FRAME_SIZE + 1>, CODEC_SAMPLES> frames{};
+    std::array<Msg, CODEC_SAMPLES> samples{};
+    for (uint32 s = 0; s < CODEC_SAMPLES; ++s)
+    {
+        samples[s] = CodecSample<Msg>(s * 16);
+        Byte* frame = frames[s].data();
+        C::EncodeFrame(samples[s], frame);
+
+        const ByteBuffer built = BuildFrame(samples[s]);
+        ByteWriter w;
+        C::Encode(samples[s], w);
+
+        Msg out{};
+        ok = ok && LoadLE<uint16>(frame) == 2 + C::SIZE && LoadLE<uint16>(frame + 2) == Msg::ID
+            && built.size() == C::FRAME_SIZE && std::memcmp(built.data(), frame, C::FRAME_SIZE) == 0
+            && w.Size() == C::SIZE && std::memcmp(w.buf.data(), frame + 4, C::SIZE) == 0
+            && Codec<Msg>::Decode(frame + 4, C::SIZE, out) && CodecSameFields(samples[s], out)
+            && !Codec<Msg>::Decode(frame + 4, C::SIZE - 1, out) && !Codec<Msg>::Decode(frame + 4, C::SIZE + 1, out);
+    }
+
+    std::array<Byte, C::FRAME_SIZE> scratch{};
+    const CodecTiming t = TimeCodec(iterations,
+        [&](uint32 s) { C::EncodeFrame(samples[s], scratch.data()); return (uint64)scratch[C::FRAME_SIZE - 1]; },
+        [&](uint32 s) { Msg m{}; Codec<Msg>::Decode(frames[s].data() + 4, C::SIZE, m); return (uint64)(m.*std::get<0>(Msg::Fields())); });
+
+    PrintCodecLine(name, "id=" + std::to_string(Msg::ID), C::SIZE, t, ok);
+    return ok;
+}
+
+// 스냅샷 레코드: 필드별 인코딩 == 배열 인코딩(MEMCPY_LAYOUT이면 memcpy), 디코드 == 원본
+template <typename Rec>
+static bool CheckCodecRecord(const char* name, uint32 iterations)
+{
+    using C = FixedCodec<Rec>;
+
+    std::array<Rec, CODEC_SAMPLES> samples{};
+    std::array<Byte, CODEC_SAMPLES * C::SIZE> perField{};
+    std::array<Byte, CODEC_SAMPLES * C::SIZE> asArray{};
+    for (uint32 s = 0; s < CODEC_SAMPLES; ++s)
+    {
+        samples[s] = CodecSample<Rec>(s * 16);
+        C::Encode(samples[s], perField.data() + s * C::SIZE);
+    }
+    C::EncodeArray(samples.data(), CODEC_SAMPLES, asArray.data());
+
+    std::array<Rec, CODEC_SAMPLES> decoded{};
+    C::DecodeArray(asArray.data(), CODEC_SAMPLES, decoded.data());
+
+    bool ok = perField == asArray;
+    for (uint32 s = 0; s < CODEC_SAMPLES; ++s)
+    {
+        Rec one{};
+        C::DecodeUnchecked(perField.data() + s * C::SIZE, one);
+        ok = ok && CodecSameFields(samples[s], one) && CodecSameFields(samples[s], decoded[s]);
+    }
+
+    std::array<Byte, C::SIZE> scratch{};
+    const CodecTiming t = TimeCodec(iterations,
+        [&](uint32 s) { C::Encode(samples[s], scratch.data()); return (uint64)scratch[C::SIZE - 1]; },
+        [&](uint32 s) { Rec r{}; C::DecodeUnchecked(perField.data() + s * C::SIZE, r); return (uint64)r.state; });
+
+    PrintCodecLine(name, C::MEMCPY_LAYOUT ? "record(memcpy)" : "record(per-field)", C::SIZE, t, ok);
+    return ok;
+}
+
+// Session과 같은 Dispatcher 구성으로 디스패치 비용 (decode + On)
+struct CodecBenchHandler
+{
+    uint64 sum = 0;
+
+    template <typename Msg>
+    void On(const Msg& m) { sum += (uint64)(m.*std::get<0>(Msg::Fields())); }
+};
+
+// --bench-codec [N]: Fields() 메시지마다 round-trip 검사 + encode/decode N번(기본 1000000) 평균 ns, 디스패치 비용
+static int RunCodecBench(uint32 iterations)
+{
+    bool ok = true;
+
+    std::cout << "codec round-trip + timing (" << iterations << " iterations each)\n";
+    ok = CheckCodecMessage<S_TicketAuthRes>("S_TicketAuthRes", iterations) && ok;
+    ok = CheckCodecMessage<C_Ping>("C_Ping", iterations) && ok;
+    ok = CheckCodecMessage<S_Pong>("S_Pong", iterations) && ok;
+    ok = CheckCodecMessage<S_Ping>("S_Ping", iterations) && ok;
+    ok = CheckCodecMessage<C_Pong>("C_Pong", iterations) && ok;
+    ok = CheckCodecMessage<C_UdpOpenReq>("C_UdpOpenReq", iterations) && ok;
+    ok = CheckCodecMessage<S_UdpOpenRes>("S_UdpOpenRes", iterations) && ok;
+    ok = CheckCodecMessage<S_UdpBound>("S_UdpBound", iterations) && ok;
+    ok = CheckCodecMessage<C_SpectateReq>("C_SpectateReq", iterations) && ok;
+    ok = CheckCodecMessage<S_SpectateRes>("S_SpectateRes", iterations) && ok;
+    ok = CheckCodecMessage<C_MoveInput>("C_MoveInput", iterations) && ok;
+    ok = CheckCodecMessage<C_CastSkill>("C_CastSkill", iterations) && ok;
+    ok = CheckCodecMessage<C_ChoiceVote>("C_ChoiceVote", iterations) && ok;
+    ok = CheckCodecMessage<S_Disconnect>("S_Disconnect", iterations) && ok;
+    ok = CheckCodecRecord<SnapshotPlayer>("SnapshotPlayer", iterations) && ok;
+    ok = CheckCodecRecord<SnapshotEnemy>("SnapshotEnemy", iterations) && ok;
+
+    // 클라 -> 서버 메시지 전부를 번갈아 디스패치 + 모르는 id / 길이 틀림 판정
+    using BenchDispatcher = Dispatcher<CodecBenchHandler, C_Ping, C_Pong, C_UdpOpenReq, C_SpectateReq, C_MoveInput, C_CastSkill, C_ChoiceVote>;
+    const std::vector<ByteBuffer> inbound = {
+        BuildFrame(CodecSample<C_Ping>(1)), BuildFrame(CodecSample<C_Pong>(2)), BuildFrame(CodecSample<C_UdpOpenReq>(3)),
+        BuildFrame(CodecSample<C_SpectateReq>(4)), BuildFrame(CodecSample<C_MoveInput>(5)), BuildFrame(CodecSample<C_CastSkill>(6)),
+        BuildFrame(CodecSample<C_ChoiceVote>(7)) };
+
+    CodecBenchHandler handler;
+    bool dispatchOk = true;
+    for (const ByteBuffer& f : inbound)
+        dispatchOk = dispatchOk && BenchDispatcher::Dispatch(handler, LoadLE<uint16>(f.data() + 2), f.data() + 4, f.size() - 4) == DispatchResult::Ok;
+    const ByteBuffer outbound = BuildFrame(CodecSample<S_Pong>(8));
+    dispatchOk = dispatchOk
+        && BenchDispatcher::Dispatch(handler, S_Pong::ID, outbound.data() + 4, outbound.size() - 4) == DispatchResult::UnknownMsg
+        && BenchDispatcher::Dispatch(handler, C_Ping::ID, inbound[0].data() + 4, inbound[0].size() - 5) == DispatchResult::Malformed;
+
+    const auto t0 = std::chrono::steady_clock::now();
+    for (uint32 i = 0; i < iterations; ++i)
+    {
+        const ByteBuffer& f = inbound[i % inbound.size()];
+        BenchDispatcher::Dispatch(handler, LoadLE<uint16>(f.data() + 2), f.data() + 4, f.size() - 4);
+    }
+    const double dispatchNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / iterations;
+    volatile uint64 sink = handler.sum;
+    (void)sink;
+
+    std::cout << "  dispatch (" << inbound.size() << " inbound types, decode + On) ns=" << (uint64)(dispatchNs * 10) / 10.0
+        << (dispatchOk ? " ok" : " FAIL (unknown/malformed not detected)") << "\n";
+
+    ok = ok && dispatchOk;
+    std::cout << (ok ? "all round-trips ok" : "ROUND-TRIP FAILURES") << "\n";
+    return ok ? 0 : 2;
+}
+
+// memcpy 경로 전 인코딩 방식 (payload 버퍼를 한 번 잡고 필드마다 바이트 단위 shift 저장, 다 만든 뒤 BuildFrame이 한 번 더 복사)
+// wire는 지금 포맷
+template <typename T>
+static void StoreLEPerByte(Byte*& out, T v)
+{
+    using U = typename UIntOfSize<sizeof(T)>::type;
+    U u;
+    std::memcpy(&u, &v, sizeof(T));
+    for (size_t i = 0; i < sizeof(T); ++i)
+        *out++ = (Byte)(u >> (8 * i));
+}
+
+template <typename Rec>
+static void StoreRecordPerByte(Byte*& out, const Rec& r)
+{
+    std::apply([&](auto... f) { (StoreLEPerByte(out, r.*f), ...); }, Rec::Fields());
+}
+
+static ByteBuffer EncodeSnapshotPerByte(const S_Snapshot& m)
+{
+    ByteBuffer payload(Codec<S_Snapshot>::PayloadSize(m.playerCount, m.enemyCount));
+    Byte* out = payload.data();
+    StoreLEPerByte(out, m.serverTick);
+    *out++ = m.playerCount;
+    for (uint8 i = 0; i < m.playerCount; ++i)
+        StoreRecordPerByte(out, m.players[i]);
+    *out++ = m.enemyCount;
+    for (uint8 i = 0; i < m.enemyCount; ++i)
+        StoreRecordPerByte(out, m.enemies[i]);
+    *out++ = (uint8)m.segmentState;
+    *out++ = m.tickInterval;
+    *out++ = m.snapshotInterval;
+    return BuildFrame(S_Snapshot::ID, payload.data(), payload.size());
+}
+
+static constexpr uint32 SNAPSHOT_BENCH_FRAMES = 100000;
+
+// --bench-snapshot-encode [N]: 엔티티 N개(기본 256, 플레이어 MAX_PLAYERS_PER_ROOM + 나머지 적) S_Snapshot 한 프레임의 크기와 인코딩 ns
+// - 예전 방식(필드마다 바이트 단위 + BuildFrame 복사) / EncodeFrame 새 버퍼 / EncodeFrame 버퍼 재사용(SnapshotPipeline)을 같은 바이트인지 확인한 뒤 비교
+static int RunSnapshotEncodeBench(uint32 entities)
+{
+    const uint32 players = std::min<uint32>(entities, MAX_PLAYERS_PER_ROOM);
+    const uint32 enemies = std::min<uint32>(entities - players, 255);
+
+    std::vector<SnapshotPlayer> ps(players);
+    std::vector<SnapshotEnemy> es(enemies);
+    for (uint32 i = 0; i < players; ++i)
+        ps[i] = CodecSample<SnapshotPlayer>(i * 8);
+    for (uint32 i = 0; i < enemies; ++i)
+        es[i] = CodecSample<SnapshotEnemy>(1000 + i * 8);
+
+    S_Snapshot msg;
+    msg.serverTick = 1;
+    msg.players = ps.data();
+    msg.playerCount = (uint8)players;
+    msg.enemies = es.data();
+    msg.enemyCount = (uint8)enemies;
+    msg.segmentState = SegmentState::InSegment;
+
+    ByteBuffer reference;
+    if (!Codec<S_Snapshot>::EncodeFrame(msg, reference))
+    {
+        std::cout << players + enemies << " entities do not fit in MAX_FRAME_TOTAL=" << MAX_FRAME_TOTAL << "\n";
+        return 1;
+    }
+
+    // 세 방식이 같은 바이트이고 디코드하면 원래 값
+    S_SnapshotView view;
+    bool ok = Codec<S_Snapshot>::Decode(reference.data() + 4, reference.size() - 4, view)
+        && view.playerCount == players && view.enemyCount == enemies && EncodeSnapshotPerByte(msg) == reference;
+    for (uint32 i = 0; ok && i < players; ++i)
+        ok = CodecSameFields(view.Player(i), ps[i]);
+    for (uint32 i = 0; ok && i < enemies; ++i)
+        ok = CodecSameFields(view.Enemy(i), es[i]);
+
+    auto timeFrames = [&](auto encodeOne) {
+        volatile uint64 sink = 0;
+        uint64 acc = 0;
+        const auto t0 = std::chrono::steady_clock::now();
+        for (uint32 i = 0; i < SNAPSHOT_BENCH_FRAMES; ++i)
+        {
+            msg.serverTick = i;
+            acc += encodeOne();
+        }
+        const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / SNAPSHOT_BENCH_FRAMES;
+        sink = acc;
+        return ns;
+    };
+
+    const double perByteNs = timeFrames([&]() { const ByteBuffer f = EncodeSnapshotPerByte(msg); return (uint64)f[4]; });
+    const double freshNs = timeFrames([&]() { ByteBuffer f; Codec<S_Snapshot>::EncodeFrame(msg, f); return (uint64)f[4]; });
+    ByteBuffer reused;
+    const double reusedNs = timeFrames([&]() { Codec<S_Snapshot>::EncodeFrame(msg, reused); return (uint64)reused[4]; });
+
+    const uint32 n = players + enemies;
+    auto print = [n](const char* label, double ns) {
+        std::cout << "  " << label << ": " << (uint64)ns << " ns/frame (" << (uint64)(ns * 10 / n) / 10.0 << " ns/entity)\n";
+    };
+
+    std::cout << "S_Snapshot players=" << players << " enemies=" << enemies << ": " << reference.size() << " B/frame ("
+        << (uint64)(reference.size() * 10 / n) / 10.0 << " B/entity), " << SNAPSHOT_BENCH_FRAMES << " frames each\n";
+    print("per-byte field stores + BuildFrame copy (before)", perByteNs);
+    print("EncodeFrame, new buffer", freshNs);
+    print("EncodeFrame, reused buffer (SnapshotPipeline)", reusedNs);
+    std::cout << (ok ? "same bytes, decode ok" : "ENCODINGS DIFFER") << "\n";
+    return ok ? 0 : 2;
+}
+
+// Room::SaveState 형식으로 적 count개(간격 1 격자) + 플레이어 MAX_PLAYERS_PER_ROOM명(격자 밖 어그로 범위 너머)인 방 상태를 만들어 LoadState
+// - 구간 스폰은 ENEMIES_PER_SEGMENT개뿐이라 큰 방은 이렇게만 만들 수 있음. 불러온 방은 적 전부 체크포인트 dirty
+static bool LoadCrowdRoom(Room& room, uint32 count)
+{
+    const uint32 tick = LAG_COMP_HISTORY_TICKS;
+    const uint32 side = std::max<uint32>((uint32)std::ceil(std::sqrt((double)count)), 1);
+    const float half = (float)side * 0.5f;
+
+    ByteWriter w;
+    w.WriteU32LE(tick);
+    w.WriteU8((uint8)SegmentState::InSegment);
+    w.WriteU32LE(1);            // segmentIndex
+    w.WriteU32LE(0);            // segmentTimerTick
+    w.WriteU32LE(count);        // aliveEnemies
+    w.WriteU8(0);               // lastChoice
+    w.WriteU32LE(tick);         // historyTick
+    w.WriteU32LE(0);            // lastCastTick
+    w.WriteU32LE(0);            // contacts
+    w.WriteU32LE(count + 1);    // nextEnemyId
+
+    w.WriteU32LE(MAX_PLAYERS_PER_ROOM);
+    for (uint32 i = 0; i < MAX_PLAYERS_PER_ROOM; ++i)
+    {
+        w.WriteU64LE(i + 1);
+        w.WriteU64LE(i + 1);
+        w.WriteF32LE((float)i - 1.5f);
+        w.WriteF32LE(-half - ENEMY_LEASH_RADIUS);
+        w.WriteU16LE(PLAYER_MAX_HP);
+        w.WriteU8(ENTITY_STATE_ALIVE);
+        w.WriteF32LE(0.f);
+        w.WriteF32LE(0.f);
+        w.WriteU32LE(0);        // skillReadyTick
+        w.WriteI8(-1);          // vote
+        w.WriteU32LE(0);        // rttMs
+        w.WriteU32LE(0);        // rttVarMs
+        InputJitterBuffer().SaveState(w);
+    }
+
+    EnemyAi ai;
+    w.WriteU32LE(count);
+    for (uint32 i = 0; i < count; ++i)
+    {
+        const float x = (float)(i % side) - half;
+        const float y = (float)(i / side) - half;
+
+        w.WriteU32LE(i + 1);
+        w.WriteU16LE(ENEMY_MAX_HP);
+        w.WriteU8(ENTITY_STATE_ALIVE);
+        w.WriteU16LE(0);        // defId
+        w.WriteF32LE(0.4f);     // hitRadius
+
+        PositionHistory<LAG_COMP_HISTORY_TICKS> history;
+        history.Record(tick, x, y);
+        history.SaveState(w);
+
+        ai.Add(i, x, y, ENEMY_MOVE_SPEED, ENEMY_ATTACK_DAMAGE, (uint16)ENEMY_ATTACK_INTERVAL_TICKS);
+    }
+    ai.SaveState(w);
+
+    ByteReader r(w.buf.data(), w.Size());
+    return room.LoadState(r);
+}
+
+// CheckpointService::Serialize와 같은 blob (Checkpoint.h 형식): 변경분 헤더 + 전체 적 목록
+static void WriteCheckpointBlob(const CheckpointDelta& delta, const std::vector<CheckpointEnemy>& enemies, ByteWriter& out)
+{
+    out.Reserve(CHECKPOINT_HEADER_SIZE + delta.players.size() * CHECKPOINT_PLAYER_SIZE + enemies.size() * CHECKPOINT_ENEMY_SIZE);
+
+    out.WriteU32LE(CHECKPOINT_MAGIC);
+    out.WriteU16LE(CHECKPOINT_VERSION);
+    out.WriteU32LE(delta.roomId);
+    out.WriteU32LE(delta.serverTick);
+    out.WriteU8((uint8)delta.segmentState);
+    out.WriteU8(delta.flags);
+    out.WriteU16LE((uint16)delta.players.size());
+    out.WriteU32LE((uint32)enemies.size());
+
+    for (const CheckpointPlayer& p : delta.players)
+    {
+        out.WriteU64LE(p.playerId);
+        out.WriteF32LE(p.x);
+        out.WriteF32LE(p.y);
+        out.WriteU16LE(p.hp);
+        out.WriteU8(p.state);
+    }
+
+    for (const CheckpointEnemy& e : enemies)
+    {
+        out.WriteU32LE(e.id);
+        out.WriteU16LE(e.defId);
+        out.WriteU16LE(e.hp);
+        out.WriteU8(e.state);
+    }
+}
+
+static constexpr uint32 CHECKPOINT_BENCH_ROUNDS = 20;
+static constexpr uint32 CHECKPOINT_BENCH_CAST_TICKS = 12;  // 체크포인트 사이 시전 tick 수 (일부 dirty)
+
+// --bench-checkpoint [N]: 적 N개(기본 10000)인 방 1개에서 체크포인트 1번에 tick 스레드가 멈추는 시간 (적 전부 dirty / 일부 / 없음)
+// - 지금: Room::CaptureCheckpoint (플레이어 + dirty 적만 복사, 버퍼는 CheckpointService처럼 재사용)
+// - 이전: tick 스레드에서 적 전부 복사 + blob 직렬화 (지금은 CheckpointService 직렬화 스레드가 방별 사본으로 하는 일)
+// - 일부 dirty: 플레이어 MAX_PLAYERS_PER_ROOM명이 CHECKPOINT_BENCH_CAST_TICKS tick 동안 tick마다 기본 스킬 1번 (시드 고정)
+// - 변경분을 합친 사본 blob == 그 시점 방 전체를 새로 불러와 뽑은 blob 인지 확인
+static int RunCheckpointBench(uint32 count)
+{
+    struct Timing
+    {
+        uint64 sumNs = 0;
+        uint64 maxNs = 0;
+        uint64 enemies = 0;     // 복사/직렬화한 적 수 합
+        uint32 n = 0;
+
+        void Add(uint64 ns, size_t copied)
+        {
+            sumNs += ns;
+            maxNs = std::max(maxNs, ns);
+            enemies += copied;
+            ++n;
+        }
+    };
+
+    auto elapsedNs = [](std::chrono::steady_clock::time_point t0) {
+        return (uint64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count();
+    };
+
+    CheckpointDelta delta;                  // CheckpointService::Acquire가 돌려주는 재사용 버퍼
+    std::vector<CheckpointEnemy> shadow;    // 직렬화 스레드의 방별 사본
+    auto merge = [&]() {
+        shadow.resize(delta.enemyCount);
+        for (const CheckpointEnemy& e : delta.dirtyEnemies)
+            shadow[e.index] = e;
+    };
+
+    Timing allDirty;
+    Timing someDirty;
+    Timing noneDirty;
+    Timing before;
+    Timing serialize;
+    ByteWriter blob;
+    CheckpointDelta full;
+
+    std::unique_ptr<Room> room;
+    for (uint32 round = 0; round < CHECKPOINT_BENCH_ROUNDS; ++round)
+    {
+        room = std::make_unique<Room>(1);
+        if (!LoadCrowdRoom(*room, count))
+        {
+            std::cout << "crowd room load failed (enemies=" << count << ")\n";
+            return 1;
+        }
+
+        const auto t0 = std::chrono::steady_clock::now();
+        room->CaptureCheckpoint(delta);
+        allDirty.Add(elapsedNs(t0), delta.dirtyEnemies.size());
+        merge();
+    }
+
+    std::mt19937 rng(20240601);
+    const float half = std::ceil(std::sqrt((float)count)) * 0.5f;
+    std::uniform_real_distribution<float> target(-half, half);
+    uint32 seq = 0;
+
+    for (uint32 round = 0; round < CHECKPOINT_BENCH_ROUNDS; ++round)
+    {
+        for (uint32 t = 0; t < CHECKPOINT_BENCH_CAST_TICKS; ++t)
+        {
+            ++seq;
+            for (uint32 p = 0; p < room->PlayerCount(); ++p)
+            {
+                PlayerInput in;
+                in.kind = InputKind::CastSkill;
+                in.seq = seq;
+                in.cast.seq = seq;
+                in.cast.skillId = 1;
+                in.cast.targetX = target(rng);
+                in.cast.targetY = target(rng);
+                in.cast.viewTick = room->ServerTick();
+
+                InputJitterBuffer::PushResult pushed;
+                room->PushInput(room->SessionAt(p), in, pushed);
+            }
+            room->Update(TICK_DT);
+            TickArena::ForThread().Reset();
+        }
+
+        auto t0 = std::chrono::steady_clock::now();
+        room->CaptureCheckpoint(delta);
+        someDirty.Add(elapsedNs(t0), delta.dirtyEnemies.size());
+        merge();
+
+        t0 = std::chrono::steady_clock::now();
+        blob = ByteWriter();
+        WriteCheckpointBlob(delta, shadow, blob);
+        serialize.Add(elapsedNs(t0), shadow.size());
+
+        // 이전: 적 전부를 변경분처럼 복사하고 tick 스레드에서 바로 직렬화
+        t0 = std::chrono::steady_clock::now();
+        full.Clear();
+        full.roomId = delta.roomId;
+        full.serverTick = delta.serverTick;
+        full.segmentState = delta.segmentState;
+        full.enemyCount = delta.enemyCount;
+        full.players = delta.players;
+        full.dirtyEnemies.assign(shadow.begin(), shadow.end());
+        blob = ByteWriter();
+        WriteCheckpointBlob(full, full.dirtyEnemies, blob);
+        before.Add(elapsedNs(t0), full.dirtyEnemies.size());
+
+        t0 = std::chrono::steady_clock::now();
+        room->CaptureCheckpoint(delta);
+        noneDirty.Add(elapsedNs(t0), delta.dirtyEnemies.size());
+        merge();
+    }
+
+    // 합친 사본 == 지금 방 전체
+    blob = ByteWriter();
+    WriteCheckpointBlob(delta, shadow, blob);
+    ByteWriter state;
+    room->SaveState(state);
+    ByteReader reader(state.buf.data(), state.Size());
+    Room reloaded(1);
+    CheckpointDelta whole;
+    bool ok = reloaded.LoadState(reader);
+    reloaded.CaptureCheckpoint(whole);
+    ByteWriter wholeBlob;
+    WriteCheckpointBlob(whole, whole.dirtyEnemies, wholeBlob);
+    ok = ok && wholeBlob.buf == blob.buf;
+
+    auto print = [](const char* label, const Timing& t) {
+        std::cout << "  " << label << ": enemies=" << (t.n > 0 ? t.enemies / t.n : 0) << " us(avg/max)="
+            << (t.n > 0 ? t.sumNs / t.n / 100 : 0) / 10.0 << "/" << t.maxNs / 100 / 10.0 << "\n";
+    };
+
+    std::cout << "enemies=" << count << " players=" << room->PlayerCount() << " blob=" << wholeBlob.Size() << " B rounds="
+        << CHECKPOINT_BENCH_ROUNDS << " (casts: " << CHECKPOINT_BENCH_CAST_TICKS << " ticks between checkpoints)\n";
+    std::cout << "tick thread per checkpoint:\n";
+    print("capture, all dirty (first checkpoint)", allDirty);
+    print("capture, dirty since last checkpoint", someDirty);
+    print("capture, nothing dirty", noneDirty);
+    print("full copy + serialize (before)", before);
+    std::cout << "serializer thread per checkpoint:\n";
+    print("serialize merged copy", serialize);
+    std::cout << (ok ? "merged blob == full blob" : "MERGED BLOB DIFFERS") << "\n";
+    return ok ? 0 : 2;
+}
+
+static constexpr uint32 HIT_BENCH_TICKS = 900;
+static constexpr uint32 HIT_BENCH_CASTS = 100;     // tick당 시전 수
+static constexpr uint32 HIT_BENCH_MAX_REWIND = 9;
+
+// --bench-hits [N]: 적 N개(기본 1000, 전부 이동)에 tick마다 시전 HIT_BENCH_CASTS개(되감기 0..HIT_BENCH_MAX_REWIND tick)를 판정하는 tick당 시간
+// - 이전: 시전마다 적 전부를 되감은 위치로 검사 (입력을 소비하며 1건씩 판정하던 루프)
+// - 지금: Room::ResolveSkills 순서 (현재 위치로 HitResolver sweep 1번, 되감은 만큼 넓힘 -> 후보만 되감은 위치로 narrowphase)
+// - tick당 p50/p99/max로 튀는 정도까지, 두 방식 타격 목록(시전 순 -> 적 index 순)이 tick마다 같은지 확인 (시드 고정)
+static int RunHitBench(uint32 count)
+{
+    struct Body
+    {
+        float x = 0.f;
+        float y = 0.f;
+        float vx = 0.f;
+        float vy = 0.f;
+        PositionHistory<LAG_COMP_HISTORY_TICKS> history;
+    };
+
+    const float radius = 0.5f;
+    const float half = std::sqrt((float)count) * 1.5f;  // 적 밀도 ~0.1/unit^2
+    const float perTick = ENEMY_MOVE_SPEED * TICK_DT;
+
+    std::mt19937 rng(20240601);
+    std::uniform_real_distribution<float> pos(-half, half);
+    std::uniform_real_distribution<float> angle(0.f, 6.2831853f);
+    std::uniform_real_distribution<float> offset(-2.f, 2.f);
+    std::uniform_int_distribution<uint32> pick(0, count - 1);
+
+    std::vector<Body> bodies(count);
+    for (Body& b : bodies)
+    {
+        const float a = angle(rng);
+        b.x = pos(rng);
+        b.y = pos(rng);
+        b.vx = std::cos(a) * perTick;
+        b.vy = std::sin(a) * perTick;
+    }
+
+    HitResolver resolver;
+    std::vector<HitPair> beforeHits;
+    std::vector<HitPair> afterHits;
+    std::vector<uint32> atTicks(HIT_BENCH_CASTS);
+    std::vector<uint64> beforeNs;
+    std::vector<uint64> afterNs;
+    uint64 hits = 0;
+    uint64 candidates = 0;
+    uint32 mismatchTicks = 0;
+
+    auto elapsedNs = [](std::chrono::steady_clock::time_point t0) {
+        return (uint64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count();
+    };
+
+    for (uint32 tick = 1; tick <= HIT_BENCH_TICKS + LAG_COMP_HISTORY_TICKS; ++tick)
+    {
+        // 지난 tick의 arena 목록(queries/pairs)은 이미 끝남 (tick 루프 끝 Reset과 같음)
+        TickArena::ForThread().Reset();
+
+        // 벽에서 튕기며 이동 -> tick 끝 위치 기록 (Room과 같은 순서)
+        for (Body& b : bodies)
+        {
+            if (std::abs(b.x + b.vx) > half)
+                b.vx = -b.vx;
+            if (std::abs(b.y + b.vy) > half)
+                b.vy = -b.vy;
+            b.x += b.vx;
+            b.y += b.vy;
+            b.history.Record(tick, b.x, b.y);
+        }
+
+        // 이력이 찰 때까지는 이동만
+        if (tick <= LAG_COMP_HISTORY_TICKS)
+            continue;
+
+        // 시전은 아무 적 근처로 (원 3/4, 사각형 1/4), 되감기는 0..HIT_BENCH_MAX_REWIND 순환
+        ArenaVector<HitQuery> queries;
+        queries.resize(HIT_BENCH_CASTS);
+        for (uint32 c = 0; c < HIT_BENCH_CASTS; ++c)
+        {
+            const Body& near = bodies[pick(rng)];
+            const uint32 rewind = c % (HIT_BENCH_MAX_REWIND + 1);
+            HitQuery& q = queries[c];
+            q.shape = c % 4 == 3 ? HitShape::Box : HitShape::Circle;
+            q.x = near.x + offset(rng);
+            q.y = near.y + offset(rng);
+            q.extent = SKILL_HIT_RADIUS;
+            q.margin = perTick * (float)rewind + 0.01f;
+            atTicks[c] = tick - rewind;
+        }
+
+        // 이전: 시전 1건마다 적 전부
+        auto t0 = std::chrono::steady_clock::now();
+        beforeHits.clear();
+        for (uint32 c = 0; c < HIT_BENCH_CASTS; ++c)
+        {
+            for (uint32 i = 0; i < count; ++i)
+            {
+                float x = bodies[i].x;
+                float y = bodies[i].y;
+                bodies[i].history.At(atTicks[c], x, y);
+                if (HitResolver::Overlaps(queries[c], x, y, radius))
+                    beforeHits.push_back(HitPair{ c, i });
+            }
+        }
+        beforeNs.push_back(elapsedNs(t0));
+
+        // 지금: 묶음 sweep + 후보만 되감은 위치로
+        t0 = std::chrono::steady_clock::now();
+        afterHits.clear();
+        resolver.BeginBodies(count);
+        for (uint32 i = 0; i < count; ++i)
+            resolver.SetBody(i, bodies[i].x, bodies[i].y, radius, true);
+
+        ArenaVector<HitPair> pairs;
+        resolver.Sweep(queries, pairs);
+        for (const HitPair& hit : pairs)
+        {
+            float x = bodies[hit.body].x;
+            float y = bodies[hit.body].y;
+            bodies[hit.body].history.At(atTicks[hit.query], x, y);
+            if (HitResolver::Overlaps(queries[hit.query], x, y, radius))
+                afterHits.push_back(hit);
+        }
+        afterNs.push_back(elapsedNs(t0));
+
+        hits += afterHits.size();
+        candidates += pairs.size();
+        const bool same = beforeHits.size() == afterHits.size()
+            && std::equal(beforeHits.begin(), beforeHits.end(), afterHits.begin(),
+                [](const HitPair& a, const HitPair& b) { return a.query == b.query && a.body == b.body; });
+        mismatchTicks += same ? 0 : 1;
+    }
+
+    auto print = [](const char* label, std::vector<uint64>& ns) {
+        uint64 sum = 0;
+        for (uint64 v : ns)
+            sum += v;
+        const uint64 avg = ns.empty() ? 0 : sum / ns.size();
+        const uint64 p50 = Percentile(ns, 0.50);
+        const uint64 p99 = Percentile(ns, 0.99);
+        std::cout << "  " << label << ": us/tick avg=" << avg / 1000 << " p50=" << p50 / 1000 << " p99=" << p99 / 1000
+            << " max=" << ns.back() / 1000 << "\n";
+    };
+
+    std::cout << "enemies=" << count << " casts/tick=" << HIT_BENCH_CASTS << " rewind=0.." << HIT_BENCH_MAX_REWIND << " ticks="
+        << HIT_BENCH_TICKS << " hits/tick=" << hits / HIT_BENCH_TICKS << " candidates/tick=" << candidates / HIT_BENCH_TICKS << "\n";
+    print("per-cast loop over all enemies (before)", beforeNs);
+    print("batched sweep + rewound narrowphase", afterNs);
+    std::cout << (mismatchTicks == 0 ? "same hits on every tick" : "HIT SETS DIFFER on " + std::to_string(mismatchTicks) + " ticks") << "\n";
+    return mismatchTicks == 0 ? 0 : 2;
+}
+
+// --bench-arena: 스레드 역할(ThreadPlacement::Pin)별 operator new 횟수
+// - GAMESERVER_BENCH_ALLOC_COUNT 빌드에서만 operator new를 교체 (서버 빌드에는 안 들어감, 없으면 --bench-arena는 알리고 끝)
+// - 교체는 프로세스 전체지만 세는 구간 밖에서는 플래그 1번 읽고 malloc/free 그대로
+// - 정렬 new(alignas 초과 타입)는 교체 안 함 -> 기본 구현 그대로, 안 셈
+static std::array<std::atomic<uint64>, (size_t)ThreadRole::Count + 1> s_newCounts{};
+static std::atomic<bool> s_countNews{ false };
+
+#ifdef GAMESERVER_BENCH_ALLOC_COUNT
+static constexpr bool ALLOC_COUNTING = true;
+
+void* operator new(size_t bytes)
+{
+    if (s_countNews.load(std::memory_order_relaxed))
+        s_newCounts[(size_t)ThreadPlacement::CurrentRole()].fetch_add(1, std::memory_order_relaxed);
+
+    void* p = std::malloc(bytes > 0 ? bytes : 1);
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+    std::free(p);
+}
+#else
+static constexpr bool ALLOC_COUNTING = false;
+#endif
+
+static constexpr uint32 ARENA_BENCH_WARMUP_SEC = 11;   // 첫 LogStats(10초, 문자열 할당) 뒤부터
+static constexpr uint32 ARENA_BENCH_MEASURE_SEC = 8;   // 다음 LogStats(20초) 전까지
+
+// --bench-arena [N]: loopback 세션 N개(기본 48 -> 방 N / MAX_PLAYERS_PER_ROOM개)가 이동/시전을 계속 보내는 동안
+// tick 스레드와 RoomWorkers lane이 tick 안에서 operator new를 부르는지 (역할별 횟수, 안정 상태 기대값 0)
+// - 서버와 같은 구성 (RoomManager + RoomWorkers lane, 인코더, 세션 I/O), Acceptor 없이 직접 accept
+// - 인코더(수신자별 프레임)/세션 I/O(입력 명령)는 tick 밖으로 나가는 버퍼라 arena 대상이 아님 -> 참고로만 출력
+// - TICK_ARENA_CHECKS 빌드(_DEBUG 기본)면 tick 밖으로 샌 arena 컨테이너를 Reset에서 잡아 중단 -> 끝까지 돌면 escape 없음
+static int RunArenaBench(uint32 count)
+{
+    if (!ALLOC_COUNTING)
+    {
+        std::cout << "--bench-arena needs a build with GAMESERVER_BENCH_ALLOC_COUNT defined (operator new is not replaced)\n";
+        return 1;
+    }
+
+    WSADATA wsa{};
+    if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0)
+    {
+        std::cout << "WSAStartup failed\n";
+        return 1;
+    }
+
+    sockaddr_in addr{};
+    SOCKET listenSock = OpenLoopbackListener(addr);
+    if (listenSock == INVALID_SOCKET)
+    {
+        std::cout << "bench listen failed err=" << ::WSAGetLastError() << "\n";
+        WSACleanup();
+        return 1;
+    }
+
+    SessionManager sessionMgr;
+    RoomManager roomMgr(&sessionMgr);
+    sessionMgr.SetSessionHooks(
+        [&roomMgr](SessionId sid) { roomMgr.OnSessionOpened(sid); },
+        [&roomMgr](SessionId sid) { roomMgr.OnSessionClosed(sid); });
+    SessionInputHooks inputHooks;
+    inputHooks.onMoveInput = [&roomMgr](SessionId sid, const C_MoveInput& msg) { roomMgr.OnMoveInput(sid, msg); };
+    inputHooks.onCastSkill = [&roomMgr](SessionId sid, const C_CastSkill& msg) { roomMgr.OnCastSkill(sid, msg); };
+    inputHooks.onRttSample = [&roomMgr](SessionId sid, uint32 rttMs, uint32 rttVarMs) { roomMgr.OnRttSample(sid, rttMs, rttVarMs); };
+    sessionMgr.SetInputHooks(std::move(inputHooks));
+
+    if (!roomMgr.Start())
+    {
+        ::closesocket(listenSock);
+        WSACleanup();
+        return 1;
+    }
+    const auto started = std::chrono::steady_clock::now();
+
+    std::vector<SOCKET> players;
+    for (uint32 i = 0; i < count; ++i)
+    {
+        SOCKET c = ConnectLoopbackSession(listenSock, addr, sessionMgr);
+        if (c == INVALID_SOCKET)
+        {
+            std::cout << "connect failed at " << i << " err=" << ::WSAGetLastError() << "\n";
+            break;
+        }
+        players.push_back(c);
+    }
+
+    // 클라: 받은 건 버리고 100ms마다 방향을 바꿔 이동 + 근처에 시전 (seq는 이동/시전 공용)
+    std::atomic<bool> clientsRunning{ true };
+    std::thread clients([&]() {
+        std::vector<Byte> buf(64 * 1024);
+        uint32 seq = 0;
+        uint32 round = 0;
+        auto nextInput = std::chrono::steady_clock::now();
+        while (clientsRunning.load())
+        {
+            const auto now = std::chrono::steady_clock::now();
+            if (now >= nextInput)
+            {
+                ++round;
+                const uint32 moveSeq = ++seq;
+                const uint32 castSeq = ++seq;
+                const ByteBuffer move = BuildFrame(C_MoveInput{ moveSeq, (int8)((round / 10) % 3) - 1, (int8)((round / 30) % 3) - 1, 100 });
+                const ByteBuffer cast = BuildFrame(C_CastSkill{ castSeq, 1, (float)(round % 20) - 10.f, 5.f, 0 });
+                for (SOCKET c : players)
+                {
+                    ::send(c, (const char*)move.data(), (int)move.size(), 0);
+                    ::send(c, (const char*)cast.data(), (int)cast.size(), 0);
+                }
+                nextInput = now + std::chrono::milliseconds(100);
+            }
+
+            for (SOCKET c : players)
+            {
+                while (::recv(c, (char*)buf.data(), (int)buf.size(), 0) > 0)
+                {
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        });
+
+    std::this_thread::sleep_until(started + std::chrono::seconds(ARENA_BENCH_WARMUP_SEC));
+    roomMgr.TakeTickCost();
+    for (auto& n : s_newCounts)
+        n.store(0);
+    s_countNews.store(true);
+
+    std::this_thread::sleep_for(std::chrono::seconds(ARENA_BENCH_MEASURE_SEC));
+
+    s_countNews.store(false);
+    const RoomManager::TickCost cost = roomMgr.TakeTickCost();
+    auto newsOf = [](ThreadRole role) { return s_newCounts[(size_t)role].load(); };
+
+    clientsRunning.store(false);
+    clients.join();
+    for (SOCKET c : players)
+        ::closesocket(c);
+
+    roomMgr.Stop();
+    sessionMgr.StopAll();
+    ::closesocket(listenSock);
+    WSACleanup();
+
+    const uint64 tickNews = newsOf(ThreadRole::Tick) + newsOf(ThreadRole::RoomWorker);
+    std::cout << "sessions=" << players.size() << " rooms=" << (players.size() + MAX_PLAYERS_PER_ROOM - 1) / MAX_PLAYERS_PER_ROOM
+        << " lanes=" << ROOM_UPDATE_THREADS + 1 << " ticks=" << cost.ticks << " (" << ARENA_BENCH_WARMUP_SEC << "s warm-up, "
+        << ARENA_BENCH_MEASURE_SEC << "s measured) arenaChecks=" << (TICK_ARENA_CHECKS ? "on" : "off") << "\n";
+    std::cout << "operator new: tick=" << newsOf(ThreadRole::Tick) << " workers=" << newsOf(ThreadRole::RoomWorker)
+        << " (per tick " << (cost.ticks > 0 ? (double)tickNews / (double)cost.ticks : 0.0) << ")"
+        << " | encoders=" << newsOf(ThreadRole::Encoder) << " io=" << newsOf(ThreadRole::SessionIo)
+        << " other(bench clients, unpinned)=" << newsOf(ThreadRole::Count) + newsOf(ThreadRole::Accept) + newsOf(ThreadRole::Helper) + newsOf(ThreadRole::Relay) << "\n";
+    return players.size() == count && tickNews == 0 ? 0 : 2;
+}
+
+static constexpr uint32 UDP_BENCH_DELAY_MS = 30;        // shim 편도 지연 (서버 -> 클라)
+static constexpr uint32 UDP_BENCH_RTO_MS = 200;         // TCP 유실 복구 시간 (최소 RTO)
+static constexpr uint32 UDP_BENCH_WARMUP_MS = 2000;
+static constexpr uint32 UDP_BENCH_MEASURE_MS = 20000;
+
+// --bench-udp [N]: 같은 방 loopback 세션 4개(TCP만 / UDP 채널 x 유실 0% / N%, 기본 2)가 서버 -> 클라 유실/지연 shim을 거쳐 받는 스냅샷 나이
+// - 4명이 같은 스냅샷 흐름을 같은 시간에 받음 -> 방 스냅샷 주기 변화(전투/정지/구간)가 비교에 안 섞임
+// - held age = 지금 - 클라가 가진 가장 새 스냅샷이 shim에 들어온 시각 (1ms마다 표본, 스냅샷 주기만큼은 기본으로 늙음)
+//   arrival = 스냅샷 1개가 shim에 들어와서 클라에 닿기까지 (전달된 것만)
+// - shim (userspace netem 흉내, 클라와 같은 스레드): 스냅샷마다 유실 확률, 나머지는 UDP_BENCH_DELAY_MS 뒤 전달
+//   TCP: 프레임 1개 = 세그먼트 1개. 유실된 것은 UDP_BENCH_RTO_MS 뒤에 오고 뒤 프레임도 그때까지 못 나옴 (HOL)
+//        스냅샷처럼 띄엄띄엄 보내면 fast retransmit용 중복 ACK가 안 모여서 RTO로 복구된다고 봄
+//   UDP: 유실된 데이터그램은 그냥 없음 (다음 스냅샷이 덮음)
+// - 클라 -> 서버(이동 입력, UDP 열기/keepalive)는 shim 없이 바로
+static int RunUdpBench(uint32 lossPercent)
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct Pending
+    {
+        Clock::time_point in;
+        Clock::time_point due;
+        uint32 tick = 0;
+    };
+
+    struct BenchClient
+    {
+        const char* label = "";
+        uint32 loss = 0;
+        bool wantUdp = false;
+
+        SOCKET tcp = INVALID_SOCKET;
+        SOCKET dgram = INVALID_SOCKET;
+        SessionId sid = 0;
+        uint64 token = 0;
+        bool bound = false;
+        sockaddr_in udpAddr{};
+        std::vector<Byte> carry;
+
+        // shim 큐 (due 순: TCP는 순서 보장, UDP는 고정 지연)
+        std::deque<Pending> queue;
+        Clock::time_point lastDue{};    // TCP HOL: 뒤 프레임은 앞 프레임보다 먼저 못 나옴
+        bool have = false;
+        uint32 newestTick = 0;
+        Clock::time_point newestIn{};
+
+        uint64 delivered = 0;
+        uint64 lost = 0;
+        std::vector<uint64> heldUs;
+        std::vector<uint64> arrivalUs;
+    };
+
+    WSADATA wsa{};
+    if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0)
+    {
+        std::cout << "WSAStartup failed\n";
+        return 1;
+    }
+
+    sockaddr_in addr{};
+    SOCKET listenSock = OpenLoopbackListener(addr);
+    if (listenSock == INVALID_SOCKET)
+    {
+        std::cout << "bench listen failed err=" << ::WSAGetLastError() << "\n";
+        WSACleanup();
+        return 1;
+    }
+
+    SessionManager sessionMgr;
+    RoomManager roomMgr(&sessionMgr);
+    UdpTransport udp(&sessionMgr);
+    sessionMgr.SetUdpTransport(&udp);
+    sessionMgr.SetSessionHooks(
+        [&roomMgr](SessionId sid) { roomMgr.OnSessionOpened(sid); },
+        [&roomMgr](SessionId sid) { roomMgr.OnSessionClosed(sid); });
+    SessionInputHooks inputHooks;
+    inputHooks.onMoveInput = [&roomMgr](SessionId sid, const C_MoveInput& msg) { roomMgr.OnMoveInput(sid, msg); };
+    inputHooks.onRttSample = [&roomMgr](SessionId sid, uint32 rttMs, uint32 rttVarMs) { roomMgr.OnRttSample(sid, rttMs, rttVarMs); };
+    sessionMgr.SetInputHooks(std::move(inputHooks));
+
+    // UDP도 TCP listener와 같은 포트 번호 (서버와 같은 구성)
+    if (!udp.Start(ntohs(addr.sin_port)) || !roomMgr.Start())
+    {
+        roomMgr.Stop();
+        udp.Stop();
+        ::closesocket(listenSock);
+        WSACleanup();
+        return 1;
+    }
+
+    std::array<BenchClient, MAX_PLAYERS_PER_ROOM> clients;
+    static_assert(MAX_PLAYERS_PER_ROOM >= 4, "bench needs 4 sessions in one room");
+    clients[0].label = "tcp";
+    clients[1].label = "udp";
+    clients[1].wantUdp = true;
+    clients[2].label = "tcp";
+    clients[2].loss = lossPercent;
+    clients[3].label = "udp";
+    clients[3].loss = lossPercent;
+    clients[3].wantUdp = true;
+
+    bool connected = true;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        BenchClient& c = clients[i];
+        c.tcp = ConnectLoopbackSession(listenSock, addr, sessionMgr, &c.sid);
+        connected = connected && c.tcp != INVALID_SOCKET;
+        if (!connected || !c.wantUdp)
+            continue;
+
+        u_long nonBlocking = 1;
+        c.dgram = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        connected = c.dgram != INVALID_SOCKET && ::ioctlsocket(c.dgram, FIONBIO, &nonBlocking) != SOCKET_ERROR;
+
+        const ByteBuffer openReq = BuildFrame(C_UdpOpenReq{});
+        ::send(c.tcp, (const char*)openReq.data(), (int)openReq.size(), 0);
+    }
+
+    std::mt19937 rng(20240601);
+    std::uniform_int_distribution<uint32> roll(0, 99);
+
+    auto shimIn = [&](BenchClient& c, uint32 tick, bool inOrder, Clock::time_point now) {
+        const bool lost = roll(rng) < c.loss;
+        if (lost && !inOrder)
+        {
+            ++c.lost;
+            return;
+        }
+
+        Pending p;
+        p.in = now;
+        p.tick = tick;
+        p.due = now + std::chrono::milliseconds(UDP_BENCH_DELAY_MS + (lost ? UDP_BENCH_RTO_MS : 0));
+        if (inOrder)
+        {
+            p.due = std::max(p.due, c.lastDue);
+            c.lastDue = p.due;
+        }
+        c.queue.push_back(p);
+    };
+
+    auto sendDatagram = [](BenchClient& c) {
+        Byte dgram[UdpTransport::UDP_RECV_HEADER];
+        StoreLE<uint64>(dgram, c.sid);
+        StoreLE<uint64>(dgram + 8, c.token);
+        dgram[16] = 0;  // 입력 없음 (keepalive)
+        ::sendto(c.dgram, (const char*)dgram, (int)sizeof(dgram), 0, (const sockaddr*)&c.udpAddr, sizeof(c.udpAddr));
+    };
+
+    // TCP: 받은 만큼 프레임으로 잘라서 스냅샷은 shim으로 (UDP 세션도 묶이기 전/타임아웃 뒤엔 TCP로 옴)
+    auto pumpTcp = [&](BenchClient& c, Clock::time_point now) {
+        Byte chunk[16 * 1024];
+        int n = 0;
+        while ((n = ::recv(c.tcp, (char*)chunk, sizeof(chunk), 0)) > 0)
+            c.carry.insert(c.carry.end(), chunk, chunk + n);
+
+        size_t pos = 0;
+        while (c.carry.size() - pos >= 4)
+        {
+            const size_t total = 2 + (size_t)LoadLE<uint16>(c.carry.data() + pos);
+            if (c.carry.size() - pos < total)
+                break;
+
+            const MsgId id = LoadLE<uint16>(c.carry.data() + pos + 2);
+            const Byte* payload = c.carry.data() + pos + 4;
+            S_UdpOpenRes res;
+            if (id == S_Snapshot::ID && total - 4 >= 4)
+            {
+                shimIn(c, LoadLE<uint32>(payload), true, now);
+            }
+            else if (id == S_UdpOpenRes::ID && Codec<S_UdpOpenRes>::Decode(payload, total - 4, res) && res.ok)
+            {
+                c.token = res.token;
+                c.udpAddr = addr;
+                c.udpAddr.sin_port = htons(res.port);
+                sendDatagram(c);
+            }
+            else if (id == S_UdpBound::ID)
+            {
+                c.bound = true;
+            }
+            pos += total;
+        }
+        c.carry.erase(c.carry.begin(), c.carry.begin() + pos);
+    };
+
+    const auto start = Clock::now();
+    const auto measureFrom = start + std::chrono::milliseconds(UDP_BENCH_WARMUP_MS);
+    const auto end = measureFrom + std::chrono::milliseconds(UDP_BENCH_MEASURE_MS);
+    auto nextInput = start;
+    auto nextKeepalive = start;
+    auto nextSample = measureFrom;
+    uint32 seq = 0;
+    bool measuring = false;
+
+    std::array<Byte, UdpTransport::UDP_MAX_SEND> dgram;
+    for (auto now = start; connected && now < end; now = Clock::now())
+    {
+        if (!measuring && now >= measureFrom)
+        {
+            measuring = true;
+            for (BenchClient& c : clients)
+            {
+                c.delivered = 0;
+                c.lost = 0;
+            }
+        }
+
+        // 방이 잠들지 않게(스냅샷 주기가 덜 바뀌게) 멈추지 않고 이동 (입력은 전부 TCP로)
+        if (now >= nextInput)
+        {
+            ++seq;
+            const ByteBuffer move = BuildFrame(C_MoveInput{ seq, (int8)((seq / 10) % 2 ? 1 : -1), (int8)((seq / 30) % 2 ? 1 : -1), 100 });
+            for (size_t i = 0; i < 4; ++i)
+                ::send(clients[i].tcp, (const char*)move.data(), (int)move.size(), 0);
+            nextInput = now + std::chrono::milliseconds(100);
+        }
+        const bool keepalive = now >= nextKeepalive;
+        if (keepalive)
+            nextKeepalive = now + std::chrono::milliseconds(500);
+
+        for (size_t i = 0; i < 4; ++i)
+        {
+            BenchClient& c = clients[i];
+            pumpTcp(c, now);
+
+            if (c.token != 0 && keepalive)
+                sendDatagram(c);
+
+            // UDP: [u32 seq][스냅샷 프레임]
+            int n = 0;
+            while (c.dgram != INVALID_SOCKET && (n = ::recvfrom(c.dgram, (char*)dgram.data(), (int)dgram.size(), 0, nullptr, nullptr)) > 0)
+            {
+                const Byte* frame = dgram.data() + UdpTransport::UDP_SEND_HEADER;
+                if ((size_t)n >= UdpTransport::UDP_SEND_HEADER + 4 + 4 && LoadLE<uint16>(frame + 2) == S_Snapshot::ID)
+                    shimIn(c, LoadLE<uint32>(frame + 4), false, now);
+            }
+
+            // 때가 된 것 전달 (UDP는 늦게 온 옛 스냅샷이면 안 바꿈)
+            while (!c.queue.empty() && c.queue.front().due <= now)
+            {
+                const Pending& p = c.queue.front();
+                if (!c.have || p.tick > c.newestTick)
+                {
+                    c.have = true;
+                    c.newestTick = p.tick;
+                    c.newestIn = p.in;
+                }
+                ++c.delivered;
+                if (measuring)
+                    c.arrivalUs.push_back((uint64)std::chrono::duration_cast<std::chrono::microseconds>(now - p.in).count());
+                c.queue.pop_front();
+            }
+
+            if (measuring && now >= nextSample && c.have)
+                c.heldUs.push_back((uint64)std::chrono::duration_cast<std::chrono::microseconds>(now - c.newestIn).count());
+        }
+        if (measuring && now >= nextSample)
+            nextSample = now + std::chrono::milliseconds(1);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    for (size_t i = 0; i < 4; ++i)
+    {
+        ::closesocket(clients[i].tcp);
+        if (clients[i].dgram != INVALID_SOCKET)
+            ::closesocket(clients[i].dgram);
+    }
+
+    roomMgr.Stop();
+    udp.Stop();
+    sessionMgr.StopAll();
+    ::closesocket(listenSock);
+    WSACleanup();
+
+    if (!connected)
+    {
+        std::cout << "bench connect failed\n";
+        return 1;
+    }
+
+    std::cout << "shim: " << UDP_BENCH_DELAY_MS << "ms one-way, tcp loss recovery " << UDP_BENCH_RTO_MS << "ms, "
+        << UDP_BENCH_MEASURE_MS / 1000 << "s measured, same room (snapshot every " << SNAPSHOT_MIN_EVERY_TICKS << "~"
+        << SNAPSHOT_MAX_EVERY_TICKS << " ticks at " << TICK_HZ << "Hz)\n";
+
+    bool ok = true;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        BenchClient& c = clients[i];
+        const uint64 heldP50 = Percentile(c.heldUs, 0.50);
+        const uint64 heldP99 = Percentile(c.heldUs, 0.99);
+        const uint64 heldMax = c.heldUs.empty() ? 0 : c.heldUs.back();
+        const uint64 arrivalP99 = Percentile(c.arrivalUs, 0.99);
+        std::cout << "  loss=" << c.loss << "% " << c.label << ": snapshots=" << c.delivered << " lost=" << c.lost
+            << " | held age ms p50=" << heldP50 / 1000 << " p99=" << heldP99 / 1000 << " max=" << heldMax / 1000
+            << " | arrival ms p99=" << arrivalP99 / 1000 << "\n";
+        ok = ok && c.delivered > 0 && (!c.wantUdp || c.bound);
+    }
+    if (!ok)
+        std::cout << "some session got no snapshots or UDP never bound\n";
+    return ok ? 0 : 2;
+}
+
+static constexpr uint32 PIPELINE_BENCH_TICKS = 150;     // 단계마다 (30Hz로 5초)
+
+// --bench-pipeline [N]: loopback 방 N개(기본 100, 방마다 세션 MAX_PLAYERS_PER_ROOM개 + 구간 적)를 30Hz로 돌리며 SNAPSHOT_EVERY_TICKS마다 스냅샷
+// 1) inline: tick 스레드가 capture -> 인코딩 -> 세션 enqueue까지 (파이프라인 이전 방식)
+// 2) pipeline: tick 스레드는 Acquire -> Capture -> Publish만, 나머지는 인코더 SNAPSHOT_ENCODER_THREADS개
+// - 스냅샷 tick마다 tick 스레드가 스냅샷에 쓴 시간(avg/p99)과 pipeline의 capture -> 마지막 enqueue 지연(Stats latencyNs)
+// - 클라 수신도 같은 프로세스라 코어 경합까지 들어간 값
+static int RunPipelineBench(uint32 roomCount)
+{
+    WSADATA wsa{};
+    if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0)
+    {
+        std::cout << "WSAStartup failed\n";
+        return 1;
+    }
+
+    sockaddr_in addr{};
+    SOCKET listenSock = OpenLoopbackListener(addr);
+    if (listenSock == INVALID_SOCKET)
+    {
+        std::cout << "bench listen failed err=" << ::WSAGetLastError() << "\n";
+        WSACleanup();
+        return 1;
+    }
+
+    SessionManager sessionMgr;
+    std::vector<std::unique_ptr<Room>> rooms;
+    std::vector<SOCKET> clients;
+    for (uint32 r = 0; r < roomCount; ++r)
+    {
+        rooms.push_back(std::make_unique<Room>(r + 1));
+        for (uint32 i = 0; i < MAX_PLAYERS_PER_ROOM; ++i)
+        {
+            SessionId sid = 0;
+            SOCKET c = ConnectLoopbackSession(listenSock, addr, sessionMgr, &sid);
+            if (c == INVALID_SOCKET)
+                continue;
+            clients.push_back(c);
+            rooms.back()->AddPlayer(sid);
+        }
+    }
+
+    // 클라 쪽: 받은 바이트만 셈
+    std::atomic<uint64> clientBytes{ 0 };
+    std::atomic<bool> clientsRunning{ true };
+    std::thread drain([&]() {
+        std::vector<Byte> buf(64 * 1024);
+        while (clientsRunning.load())
+        {
+            for (SOCKET c : clients)
+            {
+                int n = 0;
+                while ((n = ::recv(c, (char*)buf.data(), (int)buf.size(), 0)) > 0)
+                    clientBytes.fetch_add((uint64)n, std::memory_order_relaxed);
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        });
+
+    EpochManager& epoch = sessionMgr.Epoch();
+    const EpochManager::ParticipantId pid = epoch.Register();
+
+    // PIPELINE_BENCH_TICKS tick을 30Hz로: 방 Update(시간 밖) -> 스냅샷 tick이면 snapshot(tickStartUs) 시간 기록
+    auto run = [&](const char* label, auto snapshot) {
+        std::vector<uint64> snapshotNs;
+        clientBytes.store(0);
+        auto next = std::chrono::steady_clock::now();
+        for (uint32 t = 0; t < PIPELINE_BENCH_TICKS; ++t)
+        {
+            const uint64 tickStartUs = ServerTimeUs();
+            for (auto& room : rooms)
+                room->Update(TICK_DT);
+
+            if (t % SNAPSHOT_EVERY_TICKS == 0)
+            {
+                const auto t0 = std::chrono::steady_clock::now();
+                snapshot(tickStartUs);
+                snapshotNs.push_back((uint64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count());
+            }
+
+            next += std::chrono::microseconds(TICK_INTERVAL_US);
+            std::this_thread::sleep_until(next);
+        }
+
+        uint64 sum = 0;
+        for (uint64 ns : snapshotNs)
+            sum += ns;
+        const uint64 avgUs = snapshotNs.empty() ? 0 : sum / snapshotNs.size() / 1000;
+        std::cout << label << ": snapshot ticks=" << snapshotNs.size() << " tick-thread snapshot us(avg/p99)=" << avgUs
+            << "/" << Percentile(snapshotNs, 0.99) / 1000 << " clientKB/s=" << clientBytes.load() * TICK_HZ / PIPELINE_BENCH_TICKS / 1024 << "\n";
+        return avgUs;
+    };
+
+    std::cout << "rooms=" << rooms.size() << " sessions=" << clients.size() << " (" << PIPELINE_BENCH_TICKS << " ticks each)\n";
+
+    // 1) inline: RoomManager::PublishSnapshots가 인코딩/전송까지 하던 경우
+    WorldState inlineWs;
+    ByteBuffer frame;
+    uint64 inlineFrames = 0;
+    const uint64 inlineUs = run("inline (capture+encode+enqueue)", [&](uint64 tickStartUs) {
+        for (auto& room : rooms)
+        {
+            room->Capture(inlineWs, SNAPSHOT_EVERY_TICKS);
+
+            S_Snapshot msg;
+            msg.serverTick = inlineWs.serverTick;
+            msg.players = inlineWs.players.data();
+            msg.playerCount = (uint8)std::min<size_t>(inlineWs.players.size(), 255);
+            msg.enemies = inlineWs.enemies.data();
+            msg.enemyCount = (uint8)std::min<size_t>(inlineWs.enemies.size(), 255);
+            msg.segmentState = inlineWs.segmentState;
+            msg.snapshotInterval = SNAPSHOT_EVERY_TICKS;
+            if (!Codec<S_Snapshot>::EncodeFrame(msg, frame))
+                continue;
+
+            const uint64 tickOriginUs = tickStartUs - (uint64)inlineWs.serverTick * TICK_INTERVAL_US;
+            EpochGuard guard(epoch, pid);
+            for (SessionId sid : inlineWs.recipients)
+            {
+                Session* s = sessionMgr.Lookup(sid);
+                if (!s)
+                    continue;
+                s->SendSnapshotFrame(frame);
+                s->SetTickOrigin(tickOriginUs, TICK_INTERVAL_US);
+                ++inlineFrames;
+            }
+        }
+        });
+
+    // 2) pipeline: 지금 서버 방식
+    SnapshotPipeline pipeline(&sessionMgr);
+    pipeline.Start();
+    pipeline.TakeStats();
+    const uint64 pipelineUs = run("pipeline (capture+publish)", [&](uint64 tickStartUs) {
+        for (auto& room : rooms)
+        {
+            WorldState* ws = pipeline.Acquire();
+            if (!ws)
+                continue;
+            room->Capture(*ws, SNAPSHOT_EVERY_TICKS);
+            ws->snapshotInterval = SNAPSHOT_EVERY_TICKS;
+            ws->capturedAt = std::chrono::steady_clock::now();
+            ws->tickOriginUs = tickStartUs - (uint64)ws->serverTick * TICK_INTERVAL_US;
+            pipeline.Publish(ws);
+        }
+        });
+    pipeline.Stop();    // 남은 작업까지 처리
+    const SnapshotPipeline::Stats ps = pipeline.TakeStats();
+    const uint64 encoded = ps.published - ps.encodeFailed;
+
+    std::cout << "tick-thread time saved per snapshot tick: " << (inlineUs > pipelineUs ? inlineUs - pipelineUs : 0) << " us\n";
+    std::cout << "pipeline: published=" << ps.published << " dropped=" << ps.dropped << " frames=" << ps.framesSent
+        << " (inline " << inlineFrames << ") encodeUs/room=" << (encoded > 0 ? ps.encodeNs / encoded / 1000.0 : 0)
+        << " latency capture->last enqueue us(avg/max)=" << (encoded > 0 ? ps.latencyNsSum / encoded / 1000 : 0)
+        << "/" << ps.latencyNsMax / 1000 << "\n";
+
+    epoch.Unregister(pid);
+    clientsRunning.store(false);
+    drain.join();
+    for (SOCKET c : clients)
+        ::closesocket(c);
+    sessionMgr.StopAll();
+    ::closesocket(listenSock);
+    WSACleanup();
+    return ps.dropped == 0 && ps.framesSent == inlineFrames ? 0 : 2;
+}
+
+static constexpr uint32 HISTORY_BENCH_TICKS = 300;
+
+// --bench-history [N]: 방 N개(기본 2000, 플레이어 1명 + 구간 적 ENEMIES_PER_SEGMENT개)의 위치 이력 링 상주 메모리와 tick당 기록/되감기 비용
+// - 상주: 적 수 x sizeof(PositionHistory) (방 N개 생성 전후 private bytes도 같이, 방 전체 비교용)
+// - CPU: 방 안과 같은 Enemy 배열(이력이 적 구조체 안)에 tick마다 전부 Record / 전부 At(1 ~ LAG_COMP_MAX_REWIND_TICKS tick 전)
+//   되감기는 적마다 tick당 1번 = 시전이 모든 적을 후보로 잡는 최악. 같은 방들의 Room::Update tick당 시간과 비교
+static int RunHistoryBench(uint32 roomCount)
+{
+    using History = PositionHistory<LAG_COMP_HISTORY_TICKS>;
+
+    uint64 wsBefore = 0;
+    uint64 privBefore = 0;
+    SampleMemory(wsBefore, privBefore);
+
+    std::vector<std::unique_ptr<Room>> rooms;
+    rooms.reserve(roomCount);
+    for (uint32 r = 0; r < roomCount; ++r)
+    {
+        rooms.push_back(std::make_unique<Room>(r + 1));
+        rooms.back()->AddPlayer(r + 1);
+    }
+
+    uint64 wsAfter = 0;
+    uint64 privAfter = 0;
+    SampleMemory(wsAfter, privAfter);
+
+    const uint64 enemyCount = (uint64)roomCount * ENEMIES_PER_SEGMENT;
+    const uint64 historyBytes = enemyCount * sizeof(History);
+    std::cout << "rooms=" << roomCount << " enemies=" << enemyCount << " sizeof(PositionHistory<" << LAG_COMP_HISTORY_TICKS << ">)="
+        << sizeof(History) << " sizeof(Enemy)=" << sizeof(Enemy) << "\n";
+    std::cout << "resident history " << historyBytes / 1024 << " KB (" << historyBytes / std::max<uint32>(roomCount, 1) << " B/room), rooms total private "
+        << (privAfter > privBefore ? (privAfter - privBefore) / 1024 : 0) << " KB\n";
+
+    // tick마다 fn(tick) 시간 (avg/p99 us)
+    auto timeTicks = [](const char* label, auto fn) {
+        std::vector<uint64> ns;
+        ns.reserve(HISTORY_BENCH_TICKS);
+        for (uint32 t = 0; t < HISTORY_BENCH_TICKS; ++t)
+        {
+            const auto t0 = std::chrono::steady_clock::now();
+            fn(LAG_COMP_HISTORY_TICKS + t);
+            ns.push_back((uint64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count());
+        }
+        uint64 sum = 0;
+        for (uint64 v : ns)
+            sum += v;
+        const uint64 avgNs = sum / ns.size();
+        std::cout << "  " << label << ": " << avgNs / 1000 << "." << (avgNs % 1000) / 100 << " us/tick avg, p99 "
+            << Percentile(ns, 0.99) / 1000 << " us\n";
+        return avgNs;
+    };
+
+    std::vector<Enemy> enemies(enemyCount);
+    for (uint64 i = 0; i < enemyCount; ++i)
+    {
+        for (uint32 t = 0; t < LAG_COMP_HISTORY_TICKS; ++t)
+            enemies[i].history.Record(t, (float)i, (float)t);
+    }
+
+    std::cout << HISTORY_BENCH_TICKS << " ticks:\n";
+    const uint64 recordNs = timeTicks("Record all enemies", [&](uint32 tick) {
+        for (uint64 i = 0; i < enemyCount; ++i)
+            enemies[i].history.Record(tick, (float)i, (float)tick);
+        });
+
+    // 마지막 Record 다음 tick에서 1 ~ LAG_COMP_MAX_REWIND_TICKS tick 전으로 (tick마다 적별 되감기 폭을 돌림)
+    const uint32 now = LAG_COMP_HISTORY_TICKS + HISTORY_BENCH_TICKS;
+    uint64 found = 0;
+    volatile float sink = 0.f;
+    const uint64 rewindNs = timeTicks("At() every enemy once (worst case)", [&](uint32 tick) {
+        float acc = 0.f;
+        for (uint64 i = 0; i < enemyCount; ++i)
+        {
+            float x = 0.f;
+            float y = 0.f;
+            if (enemies[i].history.At(now - 1 - (uint32)((i + tick) % LAG_COMP_MAX_REWIND_TICKS), x, y))
+            {
+                acc += x + y;
+                ++found;
+            }
+        }
+        sink = acc;
+        });
+
+    const uint64 updateNs = timeTicks("Room::Update all rooms (includes Record)", [&](uint32) {
+        for (auto& room : rooms)
+            room->Update(TICK_DT);
+        });
+
+    const uint64 lookups = enemyCount * HISTORY_BENCH_TICKS;
+    std::cout << "record " << (enemyCount > 0 ? recordNs / enemyCount : 0) << " ns/enemy, rewind "
+        << (enemyCount > 0 ? rewindNs / enemyCount : 0) << " ns/lookup (" << found << "/" << lookups << " found), record = "
+        << (updateNs > 0 ? recordNs * 1000 / updateNs / 10.0 : 0) << "% of Update\n";
+    return found == lookups ? 0 : 2;
+}
+
+// Room::SaveState 형식: 플레이어 MAX_PLAYERS_PER_ROOM명(sids, 원점 근처, 이동 방향 moveDirX)인 segment 상태 방
+// - InSegment면 구간 적 ENEMIES_PER_SEGMENT개(원점에서 enemyRadius 둘레), 나머지 단계는 적 없음 + timerTicks 뒤 타이머
+static void WriteSegmentRoomState(ByteWriter& w, SegmentState state, uint32 timerTicks, const SessionId* sids, float enemyRadius, float moveDirX)
+{
+    const uint32 tick = LAG_COMP_HISTORY_TICKS;
+    const uint32 enemies = state == SegmentState::InSegment ? ENEMIES_PER_SEGMENT : 0;
+
+    w.WriteU32LE(tick);
+    w.WriteU8((uint8)state);
+    w.WriteU32LE(1);            // segmentIndex
+    w.WriteU32LE(timerTicks > 0 ? tick + timerTicks : 0);
+    w.WriteU32LE(enemies);      // aliveEnemies
+    w.WriteU8(0);               // lastChoice
+    w.WriteU32LE(tick);         // historyTick
+    w.WriteU32LE(0);            // lastCastTick
+    w.WriteU32LE(0);            // contacts
+    w.WriteU32LE(enemies + 1);  // nextEnemyId
+
+    w.WriteU32LE(MAX_PLAYERS_PER_ROOM);
+    for (uint32 i = 0; i < MAX_PLAYERS_PER_ROOM; ++i)
+    {
+        w.WriteU64LE(sids[i]);
+        w.WriteU64LE(sids[i]);
+        w.WriteF32LE((float)i - 1.5f);
+        w.WriteF32LE(0.f);
+        w.WriteU16LE(PLAYER_MAX_HP);
+        w.WriteU8(ENTITY_STATE_ALIVE);
+        w.WriteF32LE(moveDirX);
+        w.WriteF32LE(0.f);
+        w.WriteU32LE(0);        // skillReadyTick
+        w.WriteI8(-1);          // vote
+        w.WriteU32LE(0);        // rttMs
+        w.WriteU32LE(0);        // rttVarMs
+        InputJitterBuffer().SaveState(w);
+    }
+
+    EnemyAi ai;
+    w.WriteU32LE(enemies);
+    for (uint32 i = 0; i < enemies; ++i)
+    {
+        const float angle = (float)i * 6.2831853f / (float)enemies;
+        const float x = std::cos(angle) * enemyRadius;
+        const float y = std::sin(angle) * enemyRadius;
+
+        w.WriteU32LE(i + 1);
+        w.WriteU16LE(ENEMY_MAX_HP);
+        w.WriteU8(ENTITY_STATE_ALIVE);
+        w.WriteU16LE(0);        // defId
+        w.WriteF32LE(0.4f);     // hitRadius
+
+        PositionHistory<LAG_COMP_HISTORY_TICKS> history;
+        history.Record(tick, x, y);
+        history.SaveState(w);
+
+        ai.Add(i, x, y, ENEMY_MOVE_SPEED, ENEMY_ATTACK_DAMAGE, (uint16)ENEMY_ATTACK_INTERVAL_TICKS);
+    }
+    ai.SaveState(w);
+}
+
+static constexpr uint64 SEGMENT_BENCH_START_TICK = 1000;
+static constexpr uint32 SEGMENT_BENCH_SECONDS = 3;
+static constexpr uint32 SEGMENT_BENCH_ROUNDS = 3;    // 끔/켬 번갈아, 모드마다 가장 낮은 값 (1코어 잡음 제외)
+
+// --bench-segments [N]: 방 N개(기본 2000, 방마다 4명 +x로 이동 중, 적은 어그로 범위 안)를 단계 섞어서 RoomManager로 불러와 tick 스레드를 돌리고
+// 방 Update(RoomManager::UpdateRoom 전체) tick당 CPU를 재우기 끔 / 켬으로 비교
+// - 시작 단계 비율: IN_SEGMENT 65% / CLEAR 4% / CHOICE 26% / TRANSITION 5% (타이머 남은 시간은 방마다 흩뿌림)
+// - 라운드마다 같은 상태에서 새로 시작, SEGMENT_BENCH_SECONDS초 동안 타이머가 끝난 방은 다음 단계로 (적을 죽이는 입력이 없어 IN_SEGMENT는 안 끝남)
+static int RunSegmentBench(uint32 roomCount)
+{
+    uint32 phases[4] = {};
+    ByteWriter blob;
+    blob.WriteU64LE(SEGMENT_BENCH_START_TICK);
+    blob.WriteU32LE(roomCount + 1);     // nextRoomId
+    blob.WriteU32LE(roomCount);
+    for (uint32 i = 0; i < roomCount; ++i)
+    {
+        const uint32 pick = i % 100;
+        const SegmentState state = pick < 65 ? SegmentState::InSegment
+            : pick < 69 ? SegmentState::Clear
+            : pick < 95 ? SegmentState::Choice
+            : SegmentState::Transition;
+        const uint32 duration = state == SegmentState::Clear ? SEGMENT_CLEAR_TICKS
+            : state == SegmentState::Choice ? SEGMENT_CHOICE_TIMEOUT_TICKS
+            : state == SegmentState::Transition ? SEGMENT_TRANSITION_TICKS
+            : 0;
+        ++phases[(size_t)state];
+
+        blob.WriteU32LE(i + 1);
+        blob.WriteU8(0);                                // sleeping
+        blob.WriteU64LE(SEGMENT_BENCH_START_TICK);      // lastUpdateTick
+        blob.WriteU64LE(0);                             // wakeTick
+        blob.WriteU64LE(SEGMENT_BENCH_START_TICK + 1 + i % SNAPSHOT_EVERY_TICKS);
+        blob.WriteU32LE(SNAPSHOT_EVERY_TICKS);
+        SessionId sids[MAX_PLAYERS_PER_ROOM];
+        for (uint32 p = 0; p < MAX_PLAYERS_PER_ROOM; ++p)
+            sids[p] = (SessionId)i * MAX_PLAYERS_PER_ROOM + 1 + p;
+        WriteSegmentRoomState(blob, state, duration > 0 ? 1 + (i * 7919) % duration : 0, sids, ENEMY_AGGRO_RADIUS * 0.5f, 1.f);
+    }
+
+    std::cout << "rooms=" << roomCount << " in-segment=" << phases[0] << " clear=" << phases[1] << " choice=" << phases[2]
+        << " transition=" << phases[3] << " (" << SEGMENT_BENCH_SECONDS * TICK_HZ << " ticks x " << SEGMENT_BENCH_ROUNDS << " rounds each)\n";
+
+    // 같은 blob을 새 RoomManager로 불러와서 재우기 끔/켬 (세션은 없음 -> 스냅샷 수신자 조회만 실패)
+    SessionManager sessionMgr;
+    auto run = [&](const char* label, bool sleep) -> uint64 {
+        RoomManager roomMgr(&sessionMgr);
+        roomMgr.SetRoomSleep(sleep);
+        ByteReader r(blob.buf.data(), blob.Size());
+        if (!roomMgr.ImportState(r) || !roomMgr.Start())
+        {
+            std::cout << label << ": import/start failed\n";
+            return 0;
+        }
+
+        roomMgr.TakeTickCost();
+        std::this_thread::sleep_for(std::chrono::seconds(SEGMENT_BENCH_SECONDS));
+        const RoomManager::TickCost c = roomMgr.TakeTickCost();
+        roomMgr.Stop();
+
+        const uint64 updateNs = c.ticks > 0 ? c.updateNsSum / c.ticks : 0;
+        const uint64 workNs = c.ticks > 0 ? c.workUsSum * 1000 / c.ticks : 0;
+        std::cout << label << ": ticks=" << c.ticks << " updateUs/tick=" << updateNs / 1000 << "." << (updateNs % 1000) / 100
+            << " tickWorkUs(avg/max)=" << workNs / 1000 << "." << (workNs % 1000) / 100 << "/" << c.workUsMax << "\n";
+        return updateNs;
+    };
+
+    std::vector<uint64> awake;
+    std::vector<uint64> asleep;
+    for (uint32 round = 0; round < SEGMENT_BENCH_ROUNDS; ++round)
+    {
+        awake.push_back(run("sleep off (every room Update every tick)", false));
+        asleep.push_back(run("sleep on (dormant/idle rooms sleep)", true));
+    }
+    const uint64 awakeNs = *std::min_element(awake.begin(), awake.end());
+    const uint64 sleepNs = *std::min_element(asleep.begin(), asleep.end());
+    if (awakeNs == 0 || sleepNs == 0)
+    {
+        sessionMgr.StopAll();
+        return 1;
+    }
+
+    std::cout << "best updateUs/tick off=" << awakeNs / 1000 << " on=" << sleepNs / 1000 << ", update CPU saved by sleeping: " << (awakeNs > sleepNs ? (awakeNs - sleepNs) * 1000 / awakeNs / 10.0 : 0) << "%\n";
+    sessionMgr.StopAll();
+    return 0;
+}
+
+static constexpr uint32 RATES_BENCH_WARMUP_SEC = 3;
+static constexpr uint32 RATES_BENCH_MEASURE_SEC = 8;
+static constexpr uint64 RATES_BENCH_START_TICK = 1000;
+
+// --bench-rates [N]: loopback 방 N개(기본 250, 방마다 MAX_PLAYERS_PER_ROOM명)를 활동량 섞어서 적응형 주기 끔/켬 비교
+// - 방 k % 10: 0~3 active(적이 둘러쌈, 100ms마다 이동 방향 바꿈 + 시전) / 4~6 quiet(4초마다 1초 왕복 이동 후 정지) / 7~9 AFK(입력 없음)
+//   quiet/AFK 방의 적은 어그로 범위 밖 -> 접속 순서로 방을 채우면 AFK도 적에게 맞아 전투가 되므로 세션을 먼저 붙이고 방을 ImportState로 배치
+// - 끔: 재우기 없음 + 스냅샷 SNAPSHOT_EVERY_TICKS 고정, 켬: 서버 기본 (RoomManager 설정만 다르고 클라 동작은 같음)
+// - tick당 방 Update / capture+publish CPU, 스냅샷 수(인코더가 1번씩 인코딩), 클라가 받은 바이트(ping 포함, 종류별)
+static int RunRatesBench(uint32 roomCount)
+{
+    WSADATA wsa{};
+    if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0)
+    {
+        std::cout << "WSAStartup failed\n";
+        return 1;
+    }
+
+    sockaddr_in addr{};
+    SOCKET listenSock = OpenLoopbackListener(addr);
+    if (listenSock == INVALID_SOCKET)
+    {
+        std::cout << "bench listen failed err=" << ::WSAGetLastError() << "\n";
+        WSACleanup();
+        return 1;
+    }
+
+    struct Result
+    {
+        RoomManager::TickCost cost;
+        uint64 bytes = 0;
+        uint64 kindBytes[3] = {};   // active / quiet / AFK
+    };
+
+    // 플레이어 i는 방 i / MAX_PLAYERS_PER_ROOM, 방의 활동 종류 (0 active, 1 quiet, 2 AFK)
+    auto kindOf = [](size_t player) -> uint32 {
+        const uint32 k = (uint32)(player / MAX_PLAYERS_PER_ROOM) % 10;
+        return k < 4 ? 0 : k < 7 ? 1 : 2;
+    };
+
+    // 모드마다 새 세션/방 (세션 훅 없이 붙여서 방 배정은 ImportState로만)
+    auto run = [&](bool adaptive, Result& out) {
+        SessionManager sessionMgr;
+        RoomManager roomMgr(&sessionMgr);
+        roomMgr.SetRoomSleep(adaptive);
+        roomMgr.SetAdaptiveSnapshots(adaptive);
+        SessionInputHooks inputHooks;
+        inputHooks.onMoveInput = [&roomMgr](SessionId sid, const C_MoveInput& msg) { roomMgr.OnMoveInput(sid, msg); };
+        inputHooks.onCastSkill = [&roomMgr](SessionId sid, const C_CastSkill& msg) { roomMgr.OnCastSkill(sid, msg); };
+        inputHooks.onRttSample = [&roomMgr](SessionId sid, uint32 rttMs, uint32 rttVarMs) { roomMgr.OnRttSample(sid, rttMs, rttVarMs); };
+        sessionMgr.SetInputHooks(std::move(inputHooks));
+
+        std::vector<SOCKET> players;
+        std::vector<SessionId> sids;
+        for (uint32 i = 0; i < roomCount * MAX_PLAYERS_PER_ROOM; ++i)
+        {
+            SessionId sid = 0;
+            SOCKET c = ConnectLoopbackSession(listenSock, addr, sessionMgr, &sid);
+            if (c == INVALID_SOCKET)
+            {
+                std::cout << "connect failed at " << i << " err=" << ::WSAGetLastError() << "\n";
+                break;
+            }
+            players.push_back(c);
+            sids.push_back(sid);
+        }
+
+        const uint32 rooms = (uint32)players.size() / MAX_PLAYERS_PER_ROOM;
+        ByteWriter blob;
+        blob.WriteU64LE(RATES_BENCH_START_TICK);
+        blob.WriteU32LE(rooms + 1);     // nextRoomId
+        blob.WriteU32LE(rooms);
+        for (uint32 r = 0; r < rooms; ++r)
+        {
+            const bool active = kindOf((size_t)r * MAX_PLAYERS_PER_ROOM) == 0;
+            blob.WriteU32LE(r + 1);
+            blob.WriteU8(0);                                // sleeping
+            blob.WriteU64LE(RATES_BENCH_START_TICK);        // lastUpdateTick
+            blob.WriteU64LE(0);                             // wakeTick
+            blob.WriteU64LE(RATES_BENCH_START_TICK + 1 + r % SNAPSHOT_EVERY_TICKS);
+            blob.WriteU32LE(SNAPSHOT_EVERY_TICKS);
+            WriteSegmentRoomState(blob, SegmentState::InSegment, 0, &sids[(size_t)r * MAX_PLAYERS_PER_ROOM],
+                active ? ENEMY_AGGRO_RADIUS * 0.5f : ENEMY_AGGRO_RADIUS * 4.f, 0.f);
+        }
+
+        ByteReader reader(blob.buf.data(), blob.Size());
+        const bool started = roomMgr.ImportState(reader) && roomMgr.Start();
+
+        std::atomic<uint64> kindBytes[3] = {};
+        std::atomic<bool> clientsRunning{ true };
+        std::thread clients([&]() {
+            std::vector<Byte> buf(64 * 1024);
+            std::vector<uint32> seqs(players.size(), 0);
+            uint32 round = 0;
+            auto nextInput = std::chrono::steady_clock::now();
+            while (clientsRunning.load())
+            {
+                const auto now = std::chrono::steady_clock::now();
+                if (now >= nextInput)
+                {
+                    ++round;
+                    const int8 dirX = (int8)((round / 10) % 3) - 1;
+                    const int8 dirY = (int8)((round / 30) % 3) - 1;
+                    const uint32 phase = round % 40;
+                    const int8 burstDir = (round / 40) % 2 == 0 ? 1 : -1;   // 한 번은 +x, 다음은 -x (제자리 근처)
+                    for (size_t i = 0; i < players.size(); ++i)
+                    {
+                        const uint32 kind = kindOf(i);
+                        ByteBuffer frame;
+                        if (kind == 0)
+                        {
+                            // 시전은 빈 곳에 (적이 안 죽어서 구간이 안 끝남, 전투 판정만)
+                            frame = BuildFrame(C_MoveInput{ ++seqs[i], dirX, (int8)(dirX != 0 || dirY != 0 ? dirY : 1), 100 });
+                            const ByteBuffer cast = BuildFrame(C_CastSkill{ ++seqs[i], 1, 1000.f, 1000.f, 0 });
+                            frame.insert(frame.end(), cast.begin(), cast.end());
+                        }
+                        else if (kind == 1 && phase <= 10)
+                        {
+                            frame = BuildFrame(C_MoveInput{ ++seqs[i], phase < 10 ? burstDir : (int8)0, 0, 100 });
+                        }
+                        if (!frame.empty())
+                            ::send(players[i], (const char*)frame.data(), (int)frame.size(), 0);
+                    }
+                    nextInput = now + std::chrono::milliseconds(100);
+                }
+
+                for (size_t i = 0; i < players.size(); ++i)
+                {
+                    int n = 0;
+                    while ((n = ::recv(players[i], (char*)buf.data(), (int)buf.size(), 0)) > 0)
+                        kindBytes[kindOf(i)].fetch_add((uint64)n, std::memory_order_relaxed);
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+            });
+
+        std::this_thread::sleep_for(std::chrono::seconds(RATES_BENCH_WARMUP_SEC));
+        roomMgr.TakeTickCost();
+        for (auto& b : kindBytes)
+            b.store(0);
+        std::this_thread::sleep_for(std::chrono::seconds(RATES_BENCH_MEASURE_SEC));
+        out.cost = roomMgr.TakeTickCost();
+        for (uint32 k = 0; k < 3; ++k)
+        {
+            out.kindBytes[k] = kindBytes[k].load();
+            out.bytes += out.kindBytes[k];
+        }
+
+        clientsRunning.store(false);
+        clients.join();
+        for (SOCKET c : players)
+            ::closesocket(c);
+        roomMgr.Stop();
+        sessionMgr.StopAll();
+        return started && rooms == roomCount;
+    };
+
+    auto print = [](const char* label, const Result& r) {
+        const uint64 ticks = std::max<uint64>(r.cost.ticks, 1);
+        const uint64 updateNs = r.cost.updateNsSum / ticks;
+        const uint64 captureNs = r.cost.captureNsSum / ticks;
+        std::cout << label << ": ticks=" << r.cost.ticks << " updateUs/tick=" << updateNs / 1000 << "." << (updateNs % 1000) / 100
+            << " captureUs/tick=" << captureNs / 1000 << "." << (captureNs % 1000) / 100
+            << " snapshots/s=" << r.cost.snapshots / RATES_BENCH_MEASURE_SEC
+            << " egressKB/s=" << r.bytes / 1024 / RATES_BENCH_MEASURE_SEC << " (active/quiet/AFK " << r.kindBytes[0] / 1024 / RATES_BENCH_MEASURE_SEC
+            << "/" << r.kindBytes[1] / 1024 / RATES_BENCH_MEASURE_SEC << "/" << r.kindBytes[2] / 1024 / RATES_BENCH_MEASURE_SEC << ")\n";
+    };
+
+    std::cout << "rooms=" << roomCount << " (active 40% / quiet 30% / AFK 30%), " << RATES_BENCH_WARMUP_SEC << "s warm-up, "
+        << RATES_BENCH_MEASURE_SEC << "s measured\n";
+    Result fixed;
+    Result adaptive;
+    const bool ok = run(false, fixed) && run(true, adaptive);
+    print("adaptive off (30Hz sim, every 3 ticks)", fixed);
+    print("adaptive on", adaptive);
+
+    // 음수(켬이 더 씀)도 그대로
+    auto change = [](uint64 before, uint64 after) { return before > 0 ? (double)(int64)(((double)after - (double)before) * 1000.0 / (double)before) / 10.0 : 0.0; };
+    std::cout << "adaptive on vs off: update+capture " << change(fixed.cost.updateNsSum + fixed.cost.captureNsSum, adaptive.cost.updateNsSum + adaptive.cost.captureNsSum)
+        << "%, snapshots " << change(fixed.cost.snapshots, adaptive.cost.snapshots) << "%, egress " << change(fixed.bytes, adaptive.bytes) << "%\n";
+
+    ::closesocket(listenSock);
+    WSACleanup();
+    return ok ? 0 : 2;
+}
+
+
+static constexpr uint32 AI_BENCH_TICKS = 300;
+static constexpr uint32 AI_BENCH_TARGETS = 16;
+
+// 비교용: 적마다 힙 객체 + 가상 Update (EnemyAi 이전 방식). 행동/탐색 주기/거리 규칙은 EnemyAi와 같게
+// 전이는 그 자리에서 (버킷 이동 없음), 탐색은 (tick + index) % AI_SCAN_PERIOD_TICKS로 분산
+class AiBenchEnemy
+{
+public:
+    AiBenchEnemy(uint32 index, float x, float y) : _index(index), _x(x), _y(y) {}
+    virtual ~AiBenchEnemy() = default;
+
+    virtual void Update(uint32 tick, float dt, const ArenaVector<AiTarget>& targets, ArenaVector<AiHit>& outHits) = 0;
+
+    AiBehavior Behavior() const { return _behavior; }
+
+protected:
+    static const AiTarget* Nearest(float x, float y, float radius, const ArenaVector<AiTarget>& targets)
+    {
+        const AiTarget* best = nullptr;
+        float bestD2 = radius * radius;
+        for (const AiTarget& t : targets)
+        {
+            const float dx = t.x - x;
+            const float dy = t.y - y;
+            const float d2 = dx * dx + dy * dy;
+            if (d2 <= bestD2)
+            {
+                best = &t;
+                bestD2 = d2;
+            }
+        }
+        return best;
+    }
+
+    static const AiTarget* Find(uint64 playerId, const ArenaVector<AiTarget>& targets)
+    {
+        for (const AiTarget& t : targets)
+        {
+            if (t.playerId == playerId)
+                return &t;
+        }
+        return nullptr;
+    }
+
+protected:
+    uint32 _index = 0;
+    float _x = 0.f;
+    float _y = 0.f;
+    uint64 _targetId = 0;
+    uint32 _readyTick = 0;
+    AiBehavior _behavior = AiBehavior::Idle;
+};
+
+class AiBenchMelee : public AiBenchEnemy
+{
+public:
+    using AiBenchEnemy::AiBenchEnemy;
+
+    void Update(uint32 tick, float dt, const ArenaVector<AiTarget>& targets, ArenaVector<AiHit>& outHits) override
+    {
+        const bool scanTurn = (tick + _index) % AI_SCAN_PERIOD_TICKS == 0;
+        switch (_behavior)
+        {
+        case AiBehavior::Idle:
+            if (scanTurn)
+            {
+                if (const AiTarget* t = Nearest(_x, _y, ENEMY_AGGRO_RADIUS, targets))
+                {
+                    _targetId = t->playerId;
+                    _behavior = AiBehavior::Chase;
+                }
+            }
+            break;
+
+        case AiBehavior::Chase:
+        {
+            if (scanTurn)
+            {
+                if (const AiTarget* t = Nearest(_x, _y, ENEMY_AGGRO_RADIUS, targets))
+                    _targetId = t->playerId;
+            }
+
+            const AiTarget* t = Find(_targetId, targets);
+            const float dx = t ? t->x - _x : 0.f;
+            const float dy = t ? t->y - _y : 0.f;
+            const float d2 = dx * dx + dy * dy;
+            if (!t || d2 > ENEMY_LEASH_RADIUS * ENEMY_LEASH_RADIUS)
+            {
+                _behavior = AiBehavior::Idle;
+            }
+            else if (d2 <= ENEMY_ATTACK_RANGE * ENEMY_ATTACK_RANGE)
+            {
+                _readyTick = tick + ENEMY_ATTACK_WINDUP_TICKS;
+                _behavior = AiBehavior::Attack;
+            }
+            else
+            {
+                const float d = std::sqrt(d2);
+                const float step = std::min(ENEMY_MOVE_SPEED * dt, d - ENEMY_ATTACK_RANGE * 0.5f);
+                _x += dx / d * step;
+                _y += dy / d * step;
+            }
+            break;
+        }
+
+        case AiBehavior::Attack:
+        {
+            const AiTarget* t = Find(_targetId, targets);
+            const float keep = ENEMY_ATTACK_RANGE * 1.25f;
+            if (!t)
+            {
+                _behavior = AiBehavior::Idle;
+            }
+            else if ((t->x - _x) * (t->x - _x) + (t->y - _y) * (t->y - _y) > keep * keep)
+            {
+                _behavior = AiBehavior::Chase;
+            }
+            else if (tick >= _readyTick)
+            {
+                outHits.push_back(AiHit{ t->playerId, ENEMY_ATTACK_DAMAGE });
+                _readyTick = tick + ENEMY_ATTACK_INTERVAL_TICKS;
+            }
+            break;
+        }
+
+        default:
+            break;
+        }
+    }
+};
+
+// --bench-ai [N]: 적 N개(기본 10000)를 한 스레드에서 EnemyAi::Update로 AI_BENCH_TICKS tick, tick당 시간 (avg/p99)
+// - 대상 AI_BENCH_TARGETS명이 적 격자 위를 원을 그리며 돌아서 Idle -> Chase -> Attack -> Idle 전이가 계속 일어남
+// - 비교: 같은 규칙의 적마다 가상 Update (힙 객체, 생성/소멸이 섞인 것처럼 호출 순서를 섞음)
+static int RunAiBench(uint32 count)
+{
+    const uint32 side = std::max<uint32>((uint32)std::ceil(std::sqrt((double)count)), 1);
+    const float spacing = 2.f;
+    const float half = (float)side * spacing * 0.5f;
+
+    auto spawnX = [&](uint32 i) { return (float)(i % side) * spacing - half; };
+    auto spawnY = [&](uint32 i) { return (float)(i / side) * spacing - half; };
+
+    // tick의 대상 위치: 대상마다 반지름/위상이 다른 원 (격자 전체를 지나감)
+    auto fillTargets = [&](uint32 tick, ArenaVector<AiTarget>& targets) {
+        for (uint32 k = 0; k < AI_BENCH_TARGETS; ++k)
+        {
+            const float r = half * (0.2f + 0.8f * (float)k / AI_BENCH_TARGETS);
+            const float a = (float)tick * PLAYER_MOVE_SPEED * TICK_DT / r + (float)k;
+            targets.push_back(AiTarget{ k + 1, std::cos(a) * r, std::sin(a) * r });
+        }
+    };
+
+    struct Timing
+    {
+        uint64 avgNs = 0;
+        uint64 p99Ns = 0;
+        uint64 hits = 0;
+    };
+
+    // tick마다 fn(tick, targets, hits) 시간
+    auto timeTicks = [&](auto fn) {
+        Timing out;
+        std::vector<uint64> ns;
+        ns.reserve(AI_BENCH_TICKS);
+        uint64 sum = 0;
+        for (uint32 tick = 1; tick <= AI_BENCH_TICKS; ++tick)
+        {
+            {
+                ArenaVector<AiTarget> targets;
+                ArenaVector<AiHit> hits;
+                fillTargets(tick, targets);
+
+                const auto t0 = std::chrono::steady_clock::now();
+                fn(tick, targets, hits);
+                const uint64 v = (uint64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count();
+                ns.push_back(v);
+                sum += v;
+                out.hits += hits.size();
+            }
+            TickArena::ForThread().Reset();
+        }
+        out.avgNs = sum / AI_BENCH_TICKS;
+        out.p99Ns = Percentile(ns, 0.99);
+        return out;
+    };
+
+    EnemyAi ai;
+    for (uint32 i = 0; i < count; ++i)
+        ai.Add(i, spawnX(i), spawnY(i), ENEMY_MOVE_SPEED, ENEMY_ATTACK_DAMAGE, (uint16)ENEMY_ATTACK_INTERVAL_TICKS);
+    const Timing bucketed = timeTicks([&](uint32 tick, const ArenaVector<AiTarget>& targets, ArenaVector<AiHit>& hits) {
+        ai.Update(tick, TICK_DT, targets, hits);
+        });
+
+    std::vector<std::unique_ptr<AiBenchEnemy>> enemies;
+    enemies.reserve(count);
+    for (uint32 i = 0; i < count; ++i)
+        enemies.push_back(std::make_unique<AiBenchMelee>(i, spawnX(i), spawnY(i)));
+    std::shuffle(enemies.begin(), enemies.end(), std::mt19937(20240601));
+    const Timing virtualCalls = timeTicks([&](uint32 tick, const ArenaVector<AiTarget>& targets, ArenaVector<AiHit>& hits) {
+        for (auto& e : enemies)
+            e->Update(tick, TICK_DT, targets, hits);
+        });
+
+    uint64 virtualCounts[(size_t)AiBehavior::Count] = {};
+    for (const auto& e : enemies)
+        ++virtualCounts[(size_t)e->Behavior()];
+
+    auto print = [count](const char* label, const Timing& t) {
+        std::cout << "  " << label << ": " << t.avgNs / 1000 << "." << (t.avgNs % 1000) / 100 << " us/tick avg, p99 " << t.p99Ns / 1000
+            << " us (" << (count > 0 ? t.avgNs * 10 / count / 10.0 : 0) << " ns/enemy), hits=" << t.hits << "\n";
+    };
+
+    std::cout << "enemies=" << count << " targets=" << AI_BENCH_TARGETS << " ticks=" << AI_BENCH_TICKS << " (single thread)\n";
+    print("EnemyAi buckets", bucketed);
+    print("virtual Update per enemy", virtualCalls);
+    std::cout << "end state idle/chase/attack: buckets " << ai.Count(AiBehavior::Idle) << "/" << ai.Count(AiBehavior::Chase) << "/"
+        << ai.Count(AiBehavior::Attack) << ", virtual " << virtualCounts[(size_t)AiBehavior::Idle] << "/"
+        << virtualCounts[(size_t)AiBehavior::Chase] << "/" << virtualCounts[(size_t)AiBehavior::Attack] << "\n";
+    std::cout << "speedup x" << (bucketed.avgNs > 0 ? virtualCalls.avgNs * 100 / bucketed.avgNs / 100.0 : 0) << "\n";
+    return 0;
+}
+
+static constexpr uint32 RING_BENCH_PAYLOAD = 512;   // 스냅샷 크기쯤 (앞 8바이트 = 보낸 시각 ServerTimeUs)
+static constexpr uint32 RING_BENCH_WINDOW = 64;     // 끝까지 안 간 프레임 상한 (send 큐 예산 안쪽, 경로마다 같은 조건)
+static constexpr uint32 RING_BENCH_TIMEOUT_MS = 30000;
+
+// 링에 쓸 메모리 (ShmRing::Control이 캐시 라인 정렬)
+struct alignas(64) RingBenchLine
+{
+    Byte bytes[64];
+};
+
+// --bench-ring [N]: 스냅샷 크기 프레임 N개(기본 20000)를 경로별로 보내 frames/s + 지연 p50/p99 비교
+// - ring: 생산자 -> ShmRing(GameLink::SendSnapshot과 같은 레코드) -> 소비자 스레드가 꺼낼 때까지
+// - direct: 생산자 -> Session::SendRawFrame -> loopback 클라 수신 (단일 프로세스 구성)
+// - ring+send: 생산자 -> ShmRing -> 게이트웨이 역할 스레드가 SendRawFrame -> 클라 수신 (게이트웨이 분리 구성)
+// - 링은 보통 메모리에 Init/Bind (GatewayLink::Create의 이름 있는 공유 메모리 없이, 링 코드는 같음)
+//   소비자 대기는 GatewayLink::Wait/Notify와 같게 (LINK_SPIN번 yield 후 이벤트, waiting 플래그)
+// - 생산자는 끝까지 안 간 프레임이 RING_BENCH_WINDOW개면 기다림 (닫힌 루프라 처리량 = 그 경로가 감당하는 최대)
+static int RunRingBench(uint32 frames)
+{
+    WSADATA wsa{};
+    if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0)
+    {
+        std::cout << "WSAStartup failed\n";
+        return 1;
+    }
+
+    sockaddr_in addr{};
+    SOCKET listenSock = OpenLoopbackListener(addr);
+    if (listenSock == INVALID_SOCKET)
+    {
+        std::cout << "bench listen failed err=" << ::WSAGetLastError() << "\n";
+        WSACleanup();
+        return 1;
+    }
+
+    SessionManager sessionMgr;
+    SessionId sid = 0;
+    SOCKET client = ConnectLoopbackSession(listenSock, addr, sessionMgr, &sid);
+    std::shared_ptr<Session> session = client != INVALID_SOCKET ? sessionMgr.Find(sid) : nullptr;
+    if (!session)
+    {
+        std::cout << "bench connect failed err=" << ::WSAGetLastError() << "\n";
+        sessionMgr.StopAll();
+        ::closesocket(listenSock);
+        WSACleanup();
+        return 1;
+    }
+    u_long nonBlocking = 0;
+    ::ioctlsocket(client, FIONBIO, &nonBlocking); // DrainFrames는 blocking recv
+
+    std::vector<RingBenchLine> ringMem((ShmRing::BytesFor(GatewayLink::LINK_OUT_RING_BYTES) + sizeof(RingBenchLine) - 1) / sizeof(RingBenchLine));
+    Byte* ringBytes = ringMem.front().bytes;
+    NamedEvent wake;
+    if (!wake.Create("GameServerRingBench-" + std::to_string(::GetCurrentProcessId())))
+    {
+        std::cout << "bench event create failed\n";
+        ::closesocket(client);
+        ::closesocket(listenSock);
+        sessionMgr.StopAll();
+        WSACleanup();
+        return 1;
+    }
+
+    struct Result
+    {
+        uint64 elapsedUs = 0;
+        uint32 received = 0;
+        std::vector<uint64> latencyUs;
+    };
+
+    // viaRing: 생산자가 링에 씀 / toClient: 마지막이 클라 수신 (아니면 링 소비자가 끝)
+    auto runPath = [&](bool viaRing, bool toClient) {
+        Result r;
+        r.latencyUs.reserve(frames);
+        std::atomic<uint32> received{ 0 };
+        std::atomic<bool> failed{ false };
+
+        ShmRing::Init(ringBytes, GatewayLink::LINK_OUT_RING_BYTES);
+        ShmRing producerRing;
+        ShmRing consumerRing;
+        producerRing.Bind(ringBytes);
+        consumerRing.Bind(ringBytes);
+        std::atomic<uint32> consumerWaiting{ 0 };
+
+        // 링 소비자 (게이트웨이 수신 스레드 역할): 레코드의 sentUs로 링 지연, toClient면 프레임을 세션으로
+        std::thread consumer;
+        if (viaRing)
+        {
+            consumer = std::thread([&] {
+                ByteBuffer frame;
+                uint32 popped = 0;
+                uint32 idleSpins = 0;
+                while (popped < frames && !failed.load(std::memory_order_relaxed))
+                {
+                    size_t len = 0;
+                    const Byte* p = consumerRing.Peek(len);
+                    if (!p)
+                    {
+                        if (++idleSpins < GatewayLink::LINK_SPIN)
+                        {
+                            std::this_thread::yield();
+                            continue;
+                        }
+                        idleSpins = 0;
+                        consumerWaiting.store(1, std::memory_order_relaxed);
+                        std::atomic_thread_fence(std::memory_order_seq_cst);
+                        if (consumerRing.Empty())
+                            wake.Wait(GatewayLink::LINK_WAIT_MS);
+                        consumerWaiting.store(0, std::memory_order_relaxed);
+                        continue;
+                    }
+                    idleSpins = 0;
+
+                    GatewayLink::Record rec;
+                    if (GatewayLink::LoadRecord(p, len, rec) && rec.kind == GatewayLink::RecordKind::Snapshot)
+                    {
+                        if (toClient)
+                        {
+                            frame.assign(p + GatewayLink::RECORD_SIZE + (size_t)rec.count * sizeof(SessionId), p + len);
+                            if (!session->SendRawFrame(std::move(frame)))
+                                failed.store(true, std::memory_order_relaxed);
+                        }
+                        else
+                        {
+                            const uint64 nowUs = ServerTimeUs();
+                            r.latencyUs.push_back(nowUs > rec.sentUs ? nowUs - rec.sentUs : 0);
+                            received.store(popped + 1, std::memory_order_release);
+                        }
+                    }
+                    consumerRing.Pop();
+                    ++popped;
+                }
+            });
+        }
+
+        // 클라: 프레임 payload의 보낸 시각으로 끝-끝 지연 (ping 등 다른 메시지는 건너뜀)
+        std::thread reader;
+        if (toClient)
+        {
+            reader = std::thread([&] {
+                uint32 count = 0;
+                const bool done = DrainFrames(client, RING_BENCH_TIMEOUT_MS, [&](MsgId id, const Byte* payload, size_t len) {
+                    if (id != S_Snapshot::ID || len != RING_BENCH_PAYLOAD)
+                        return true;
+                    const uint64 nowUs = ServerTimeUs();
+                    const uint64 sentUs = LoadLE<uint64>(payload);
+                    r.latencyUs.push_back(nowUs > sentUs ? nowUs - sentUs : 0);
+                    received.store(++count, std::memory_order_release);
+                    return count < frames;
+                });
+                if (!done)
+                    failed.store(true, std::memory_order_relaxed);
+            });
+        }
+
+        ByteBuffer frame(4 + RING_BENCH_PAYLOAD, 0);
+        StoreLE<uint16>(frame.data(), (uint16)(frame.size() - 2));
+        StoreLE<uint16>(frame.data() + 2, S_Snapshot::ID);
+
+        const auto t0 = std::chrono::steady_clock::now();
+        for (uint32 i = 0; i < frames && !failed.load(std::memory_order_relaxed); ++i)
+        {
+            while (i - received.load(std::memory_order_acquire) >= RING_BENCH_WINDOW && !failed.load(std::memory_order_relaxed))
+                std::this_thread::yield();
+
+            const uint64 nowUs = ServerTimeUs();
+            StoreLE<uint64>(frame.data() + 4, nowUs);
+            if (!viaRing)
+            {
+                if (!session->SendRawFrame(ByteBuffer(frame)))
+                    failed.store(true, std::memory_order_relaxed);
+                continue;
+            }
+
+            // GameLink::SendSnapshot과 같은 레코드: [Record][SessionId x count][frame]
+            const size_t len = GatewayLink::RECORD_SIZE + sizeof(SessionId) + frame.size();
+            Byte* p = producerRing.Reserve(len);
+            while (!p && !failed.load(std::memory_order_relaxed))
+            {
+                std::this_thread::yield();
+                p = producerRing.Reserve(len);
+            }
+            if (!p)
+                break;
+
+            GatewayLink::Record rec;
+            rec.kind = GatewayLink::RecordKind::Snapshot;
+            rec.count = 1;
+            rec.sentUs = nowUs;
+            GatewayLink::StoreRecord(p, rec);
+            std::memcpy(p + GatewayLink::RECORD_SIZE, &sid, sizeof(SessionId));
+            std::memcpy(p + GatewayLink::RECORD_SIZE + sizeof(SessionId), frame.data(), frame.size());
+            producerRing.Commit();
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (consumerWaiting.load(std::memory_order_relaxed) != 0)
+                wake.Signal();
+        }
+
+        while (received.load(std::memory_order_acquire) < frames && !failed.load(std::memory_order_relaxed))
+            std::this_thread::yield();
+        r.elapsedUs = (uint64)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t0).count();
+
+        if (consumer.joinable())
+            consumer.join();
+        if (reader.joinable())
+            reader.join();
+        r.received = received.load(std::memory_order_acquire);
+        return r;
+    };
+
+    auto print = [frames](const char* label, Result& r) {
+        std::cout << "  " << label << ": " << r.received << "/" << frames << " frames, "
+            << (r.elapsedUs > 0 ? (uint64)r.received * 1000000 / r.elapsedUs : 0) << " frames/s, latency p50="
+            << Percentile(r.latencyUs, 0.50) << " us p99=" << Percentile(r.latencyUs, 0.99) << " us\n";
+    };
+
+    Result ring = runPath(true, false);
+    Result direct = runPath(false, true);
+    Result ringSend = runPath(true, true);
+
+    std::cout << "frames=" << frames << " payload=" << RING_BENCH_PAYLOAD << "B window=" << RING_BENCH_WINDOW
+        << " ring=" << GatewayLink::LINK_OUT_RING_BYTES / 1024 << "KB cores=" << std::thread::hardware_concurrency() << "\n";
+    print("ring only          ", ring);
+    print("direct SendRawFrame", direct);
+    print("ring + SendRawFrame", ringSend);
+
+    const bool ok = ring.received == frames && direct.received == frames && ringSend.received == frames;
+    ::closesocket(client);
+    ::closesocket(listenSock);
+    sessionMgr.StopAll();
+    WSACleanup();
+    return ok ? 0 : 2;
+}
+
+static constexpr uint32 OVERLOAD_BENCH_STEPS = 10;
+static constexpr uint32 OVERLOAD_BENCH_STEP_SEC = 2;
+static constexpr uint32 OVERLOAD_BENCH_HOLD_SEC = 6;        // 마지막 단계 뒤 유지 (요약은 이 구간)
+static constexpr uint32 OVERLOAD_BENCH_INPUT_MS = 100;
+static constexpr uint32 OVERLOAD_BENCH_PER_ADDRESS = 16;    // 주소당 접속 수 (IP당 burst 안쪽)
+
+// --bench-overload [N]: 접속을 N/OVERLOAD_BENCH_STEPS개씩 OVERLOAD_BENCH_STEP_SEC마다 N(기본 4000)까지 올리며 과부하 제어 끔/켬 비교
+// - 서버 구성 그대로 (Acceptor + 세션 훅으로 방 배정 + RoomManager), 클라는 100ms마다 이동 + 시전
+// - 켬: OverloadController를 RoomManager/Acceptor에 연결. 끔: 둘 다 없음 (단계 표시 -)
+// - 초마다: 살아 있는 클라 / S_Disconnect(Overloaded) 받은 수 / 단계 / tick 수와 작업 시간 / 첫 단계 클라가 받는 스냅샷 Hz
+//   버티면 넘치는 접속은 거절되고 먼저 들어온 클라의 tick/스냅샷이 유지됨. 무너지면 tick이 밀리고 모두의 스냅샷이 같이 줄어듦
+// - 거절된 클라는 다시 붙지 않음 (tools/load_ramp.py는 backoff 후 재접속)
+static int RunOverloadBench(uint32 maxClients)
+{
+    WSADATA wsa{};
+    if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0)
+    {
+        std::cout << "WSAStartup failed\n";
+        return 1;
+    }
+
+    // 주소는 127.0.0.2 ~ 127.0.0.254
+    maxClients = std::min<uint32>(maxClients, 253 * OVERLOAD_BENCH_PER_ADDRESS);
+    const uint32 perStep = std::max<uint32>(maxClients / OVERLOAD_BENCH_STEPS, 1);
+
+    // Acceptor에 줄 빈 포트
+    sockaddr_in addr{};
+    SOCKET probe = OpenLoopbackListener(addr);
+    if (probe == INVALID_SOCKET)
+    {
+        std::cout << "bench listen failed err=" << ::WSAGetLastError() << "\n";
+        WSACleanup();
+        return 1;
+    }
+    ::closesocket(probe);
+
+    struct Client
+    {
+        SOCKET sock = INVALID_SOCKET;
+        ByteBuffer pending;
+        uint32 seq = 0;
+        uint32 snapshots = 0;   // 이번 1초
+        bool firstWave = false;
+        bool alive = true;
+    };
+
+    struct Summary
+    {
+        uint32 clients = 0;
+        uint32 refused = 0;
+        uint32 closed = 0;
+        uint64 ticks = 0;
+        uint64 workUsSum = 0;
+        uint64 workUsMax = 0;
+        uint64 firstSnapshots = 0;
+        uint32 firstAlive = 0;
+        uint32 holdSeconds = 0;
+        uint32 cpuPercentSum = 0;
+        LoadLevel maxLevel = LoadLevel::Normal;
+    };
+
+    // 프로세스 CPU (클라 포함, 전체 코어 대비 %) - OverloadController의 CPU 기준과 같은 계산
+    const uint64 cores = std::max<uint64>(1, std::thread::hardware_concurrency());
+    auto processCpuNs = []() -> uint64 {
+        FILETIME created, exited, kernel, user;
+        if (!::GetProcessTimes(::GetCurrentProcess(), &created, &exited, &kernel, &user))
+            return 0;
+        auto ns = [](const FILETIME& ft) { return ((uint64)ft.dwHighDateTime << 32 | ft.dwLowDateTime) * 100; };
+        return ns(kernel) + ns(user);
+    };
+
+    auto run = [&](bool controlled, Summary& out) {
+        SessionManager sessionMgr;
+        OverloadController overload(TICK_INTERVAL_US);
+        overload.SetQueueSampler([&sessionMgr](uint32& sessions, uint32& backlogged) {
+            sessionMgr.SampleSendQueues(OverloadController::OVERLOAD_BACKLOG_BYTES, sessions, backlogged);
+            });
+
+        RoomManager roomMgr(&sessionMgr);
+        if (controlled)
+            roomMgr.SetOverload(&overload);
+        sessionMgr.SetSessionHooks([&roomMgr](SessionId sid) { roomMgr.OnSessionOpened(sid); },
+            [&roomMgr](SessionId sid) { roomMgr.OnSessionClosed(sid); });
+        SessionInputHooks inputHooks;
+        inputHooks.onMoveInput = [&roomMgr](SessionId sid, const C_MoveInput& msg) { roomMgr.OnMoveInput(sid, msg); };
+        inputHooks.onCastSkill = [&roomMgr](SessionId sid, const C_CastSkill& msg) { roomMgr.OnCastSkill(sid, msg); };
+        inputHooks.onRttSample = [&roomMgr](SessionId sid, uint32 rttMs, uint32 rttVarMs) { roomMgr.OnRttSample(sid, rttMs, rttVarMs); };
+        sessionMgr.SetInputHooks(std::move(inputHooks));
+
+        Acceptor acceptor(&sessionMgr);
+        if (controlled)
+        {
+            acceptor.SetOverload(&overload);
+            overload.Start();
+        }
+        if (!roomMgr.Start() || !acceptor.Start(ntohs(addr.sin_port)))
+        {
+            acceptor.Stop();
+            roomMgr.Stop();
+            overload.Stop();
+            sessionMgr.StopAll();
+            return false;
+        }
+
+        std::vector<Client> clients;
+        clients.reserve(maxClients);
+        std::vector<Byte> chunk(64 * 1024);
+
+        // 받은 바이트에서 스냅샷 수 / S_Disconnect 이유 (0바이트 = 서버가 닫음)
+        auto drain = [&](Client& c) {
+            int n = 0;
+            while ((n = ::recv(c.sock, (char*)chunk.data(), (int)chunk.size(), 0)) > 0)
+                c.pending.insert(c.pending.end(), chunk.data(), chunk.data() + n);
+            if (n == 0 || (n == SOCKET_ERROR && ::WSAGetLastError() != WSAEWOULDBLOCK))
+            {
+                c.alive = false;
+                ++out.closed;
+            }
+
+            size_t pos = 0;
+            while (c.pending.size() - pos >= 4)
+            {
+                const size_t total = 2 + (size_t)LoadLE<uint16>(c.pending.data() + pos);
+                if (c.pending.size() - pos < total)
+                    break;
+                const MsgId id = LoadLE<uint16>(c.pending.data() + pos + 2);
+                if (id == S_Snapshot::ID)
+                    ++c.snapshots;
+                else if (id == S_Disconnect::ID && total >= 6 && LoadLE<uint16>(c.pending.data() + pos + 4) == (uint16)DisconnectReason::Overloaded)
+                    ++out.refused;
+                pos += total;
+            }
+            c.pending.erase(c.pending.begin(), c.pending.begin() + pos);
+        };
+
+        const auto start = std::chrono::steady_clock::now();
+        const auto end = start + std::chrono::seconds(OVERLOAD_BENCH_STEPS * OVERLOAD_BENCH_STEP_SEC + OVERLOAD_BENCH_HOLD_SEC);
+        auto nextStep = start;
+        auto nextInput = start;
+        auto nextReport = start + std::chrono::seconds(1);
+        uint32 step = 0;
+        uint32 second = 0;
+        uint64 lastCpuNs = processCpuNs();
+        auto lastReport = start;
+        roomMgr.TakeTickCost();
+
+        std::cout << (controlled ? "overload control on\n" : "overload control off\n");
+        while (std::chrono::steady_clock::now() < end)
+        {
+            auto now = std::chrono::steady_clock::now();
+            if (step < OVERLOAD_BENCH_STEPS && now >= nextStep)
+            {
+                for (uint32 k = 0; k < perStep; ++k)
+                {
+                    const uint32 i = (uint32)clients.size();
+                    sockaddr_in local{};
+                    local.sin_family = AF_INET;
+                    local.sin_addr.s_addr = htonl(INADDR_LOOPBACK + 1 + i / OVERLOAD_BENCH_PER_ADDRESS);
+
+                    Client c;
+                    c.sock = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+                    if (c.sock == INVALID_SOCKET || ::bind(c.sock, (sockaddr*)&local, sizeof(local)) == SOCKET_ERROR
+                        || ::connect(c.sock, (const sockaddr*)&addr, sizeof(addr)) == SOCKET_ERROR)
+                    {
+                        if (c.sock != INVALID_SOCKET)
+                            ::closesocket(c.sock);
+                        ++out.closed;
+                        continue;
+                    }
+                    u_long nonBlocking = 1;
+                    ::ioctlsocket(c.sock, FIONBIO, &nonBlocking);
+                    c.firstWave = step == 0;
+                    clients.push_back(std::move(c));
+                }
+                ++step;
+                nextStep += std::chrono::seconds(OVERLOAD_BENCH_STEP_SEC);
+            }
+
+            if (now >= nextInput)
+            {
+                const uint32 round = (uint32)(std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count() / OVERLOAD_BENCH_INPUT_MS);
+                const int8 dirX = (int8)((round / 10) % 3) - 1;
+                for (Client& c : clients)
+                {
+                    if (!c.alive)
+                        continue;
+                    // 시전은 빈 곳에 (적이 안 죽어서 방이 전투 구간에 남음, --bench-rates와 같게)
+                    ByteBuffer frame = BuildFrame(C_MoveInput{ ++c.seq, dirX, 1, 100 });
+                    const ByteBuffer cast = BuildFrame(C_CastSkill{ ++c.seq, 1, 1000.f, 1000.f, 0 });
+                    frame.insert(frame.end(), cast.begin(), cast.end());
+                    ::send(c.sock, (const char*)frame.data(), (int)frame.size(), 0);
+                }
+                nextInput += std::chrono::milliseconds(OVERLOAD_BENCH_INPUT_MS);
+            }
+
+            for (Client& c : clients)
+            {
+                if (c.alive)
+                    drain(c);
+            }
+
+            now = std::chrono::steady_clock::now();
+            if (now >= nextReport)
+            {
+                ++second;
+                const RoomManager::TickCost cost = roomMgr.TakeTickCost();
+                uint32 alive = 0;
+                uint32 firstAlive = 0;
+                uint64 snapshots = 0;
+                uint64 firstSnapshots = 0;
+                for (Client& c : clients)
+                {
+                    alive += c.alive ? 1 : 0;
+                    snapshots += c.snapshots;
+                    if (c.firstWave && c.alive)
+                    {
+                        ++firstAlive;
+                        firstSnapshots += c.snapshots;
+                    }
+                    c.snapshots = 0;
+                }
+
+                const uint64 cpuNs = processCpuNs();
+                const uint64 wallNs = (uint64)std::chrono::duration_cast<std::chrono::nanoseconds>(now - lastReport).count();
+                const uint32 cpuPercent = (uint32)std::min<uint64>(100, (cpuNs - lastCpuNs) * 100 / std::max<uint64>(wallNs * cores, 1));
+                lastCpuNs = cpuNs;
+                lastReport = now;
+
+                const LoadLevel level = overload.Level();
+                if ((uint8)level > (uint8)out.maxLevel)
+                    out.maxLevel = level;
+                if (second > OVERLOAD_BENCH_STEPS * OVERLOAD_BENCH_STEP_SEC)
+                {
+                    out.ticks += cost.ticks;
+                    out.workUsSum += cost.workUsSum;
+                    out.workUsMax = std::max(out.workUsMax, cost.workUsMax);
+                    out.firstSnapshots += firstSnapshots;
+                    out.firstAlive = firstAlive;
+                    out.cpuPercentSum += cpuPercent;
+                    ++out.holdSeconds;
+                }
+                out.clients = alive;
+
+                std::cout << "  t=" << second << "s clients=" << alive << " refused=" << out.refused << " load="
+                    << (controlled ? LoadLevelName(level) : "-") << " cpu=" << cpuPercent << "% ticks=" << cost.ticks << " workUs avg/max="
+                    << cost.workUsSum / std::max<uint64>(cost.ticks, 1) << "/" << cost.workUsMax
+                    << " snapshotHz first/all=" << (firstAlive > 0 ? firstSnapshots * 10 / firstAlive / 10.0 : 0)
+                    << "/" << (alive > 0 ? snapshots * 10 / alive / 10.0 : 0) << "\n";
+                nextReport += std::chrono::seconds(1);
+            }
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+
+        for (Client& c : clients)
+            ::closesocket(c.sock);
+        acceptor.Stop();
+        roomMgr.Stop();
+        overload.Stop();
+        sessionMgr.StopAll();
+        return true;
+    };
+
+    std::cout << "ramp: +" << perStep << " clients every " << OVERLOAD_BENCH_STEP_SEC << "s to " << perStep * OVERLOAD_BENCH_STEPS
+        << ", hold " << OVERLOAD_BENCH_HOLD_SEC << "s, input+cast every " << OVERLOAD_BENCH_INPUT_MS << "ms, tick budget "
+        << TICK_INTERVAL_US << "us\n";
+    Summary off;
+    Summary on;
+    const bool ok = run(false, off) && run(true, on);
+
+    auto print = [](const char* label, const Summary& s, bool controlled) {
+        const uint32 seconds = std::max<uint32>(s.holdSeconds, 1);
+        std::cout << label << ": clients=" << s.clients << " refused=" << s.refused << " closed=" << s.closed
+            << " cpu=" << s.cpuPercentSum / seconds << "% ticks/s=" << s.ticks / seconds << " workUs avg/max=" << s.workUsSum / std::max<uint64>(s.ticks, 1) << "/" << s.workUsMax
+            << " first-wave snapshotHz=" << (s.firstAlive > 0 ? s.firstSnapshots * 10 / s.firstAlive / seconds / 10.0 : 0)
+            << " maxLoad=" << (controlled ? LoadLevelName(s.maxLevel) : "-") << "\n";
+    };
+    std::cout << "hold phase (last " << OVERLOAD_BENCH_HOLD_SEC << "s):\n";
+    print("  control off", off, false);
+    print("  control on ", on, true);
+
+    WSACleanup();
+    return ok ? 0 : 2;
+}
+
+// --name [N]: 있으면 N (생략하면 defaultValue), 없으면 0
+static uint32 BenchArg(int argc, char* argv[], const char* name, uint32 defaultValue)
+{
+    uint32 value = 0;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::string(argv[i]) != name)
+            continue;
+        value = defaultValue;
+        if (i + 1 < argc && argv[i + 1][0] != '-')
+            value = (uint32)std::strtoul(argv[i + 1], nullptr, 10);
+    }
+    return value;
+}
+
+// "a,b,c" -> {a,b,c} (빈 항목은 버림)
+static std::vector<std::string> SplitList(const std::string& value)
+{
+    std::vector<std::string> out;
+    size_t pos = 0;
+    while (pos <= value.size())
+    {
+        size_t comma = value.find(',', pos);
+        if (comma == std::string::npos)
+            comma = value.size();
+        if (comma > pos)
+            out.push_back(value.substr(pos, comma - pos));
+        pos = comma + 1;
+    }
+    return out;
+}
+
+// --gateway <link,link,...>: 클라 연결/프레이밍만 하고 입력/스냅샷은 공유 메모리 링으로 게임 프로세스(--link)와 주고받음
+// 방/콘텐츠/기록/체크포인트는 게임 프로세스 쪽 옵션
+static int RunGateway(const std::vector<std::string>& links, uint16 port, bool udpEnabled)
 {
     WSADATA wsa{};
     int ret = WSAStartup(MAKEWORD(2, 2), &wsa);
@@ -25,29 +3683,380 @@ int main()
 
     SessionManager sessionMgr;
 
-    // Acceptor가 세션매니저를 쓰게 연결
+    // 세션 입/퇴장/입력을 방 대신 링크로 (Acceptor 시작 전에 연결)
+    Gateway gateway(&sessionMgr);
+    sessionMgr.SetSessionHooks(
+        [&gateway](SessionId sid) { gateway.OnSessionOpened(sid); },
+        [&gateway](SessionId sid) { gateway.OnSessionClosed(sid); });
+    sessionMgr.SetInputHooks(gateway.MakeInputHooks());
+
+    UdpTransport udp(&sessionMgr);
+    if (udpEnabled)
+        sessionMgr.SetUdpTransport(&udp);
+
+    // 과부하: 자기 send 큐/CPU + 게임 프로세스들이 알린 단계 (모두 새 방을 못 받으면 accept도 늦춤)
+    OverloadController overload(TICK_INTERVAL_US);
+    overload.SetQueueSampler([&sessionMgr](uint32& sessions, uint32& backlogged) {
+        sessionMgr.SampleSendQueues(OverloadController::OVERLOAD_BACKLOG_BYTES, sessions, backlogged);
+        });
+    overload.SetExternalSampler([&gateway] { return gateway.MinBackendLoad(); });
+
+    // 게임 프로세스가 먼저 떠 있어야 함 (하나라도 붙으면 시작, 나머지는 뒤에서 계속 재시도)
+    if (!gateway.Start(links, 2 * GatewayLink::LINK_PEER_TIMEOUT_MS))
+    {
+        WSACleanup();
+        return 1;
+    }
+
+    overload.Start();
+
     Acceptor acceptor(&sessionMgr);
-    if (!acceptor.Start(7777))
+    acceptor.SetOverload(&overload);
+    if (!acceptor.Start(port))
+    {
+        overload.Stop();
+        gateway.Stop();
+        WSACleanup();
+        return 1;
+    }
+
+    if (udpEnabled && !udp.Start(port))
+        std::cout << "UDP channel not started (TCP only)\n";
+
+    std::cout << "Gateway listening on " << port << "\n";
+    std::cout << "Commands: empty line to quit\n";
+
+    std::string line;
+    while (std::getline(std::cin, line) && !line.empty())
+        std::cout << "Unknown command: " << line << "\n";
+
+    acceptor.Stop();
+    overload.Stop();
+    gateway.Stop();      // 수신 스레드가 세션/UDP 소켓에 접근하므로 먼저
+    udp.Stop();
+    sessionMgr.StopAll();
+
+    WSACleanup();
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    std::string recordPath;
+    std::string replayPath;
+    std::string contentPath = "data/content.bin";
+    std::string checkpointTarget;
+    std::string topologyPath;
+    std::string gatewayLinks;
+    std::string linkName;
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--replay")
+            replayPath = argv[++i];
+        else if (arg == "--record")
+            recordPath = argv[++i];
+        else if (arg == "--content")
+            contentPath = argv[++i];
+        else if (arg == "--checkpoint")
+            checkpointTarget = argv[++i];
+        else if (arg == "--topology")
+            topologyPath = argv[++i];
+        else if (arg == "--gateway")
+            gatewayLinks = argv[++i];
+        else if (arg == "--link")
+            linkName = argv[++i];
+    }
+
+    // --bench-*: 서버 대신 측정만 하고 종료 (Run*Bench)
+    const uint32 idleBench = BenchArg(argc, argv, "--bench-idle", 10000);                     // 조용한 세션 메모리
+    const uint32 churnBench = BenchArg(argc, argv, "--bench-churn", 16);                      // 세션 등록/해제/조회 (스레드 수)
+    const uint32 priorityBench = BenchArg(argc, argv, "--bench-priority", 200);               // 스냅샷 적 선택 비용/신선도
+    const uint32 spectatorBench = BenchArg(argc, argv, "--bench-spectators", 500);            // 관전자 0명 / N명 tick 비용
+    const uint32 slowConsumerBench = BenchArg(argc, argv, "--bench-slow-consumer", 200);      // 안 읽는 클라: 스냅샷 대체/reliable 보존/끊는 시점
+    const uint32 connectStormBench = BenchArg(argc, argv, "--bench-connect-storm", 2000);     // 재접속 폭주: accepts/s, 첫 응답까지
+    const uint32 codecBench = BenchArg(argc, argv, "--bench-codec", 1000000);                 // 메시지 round-trip 검사 + encode/decode/dispatch ns
+    const uint32 snapshotEncodeBench = BenchArg(argc, argv, "--bench-snapshot-encode", 256);  // 엔티티 N개 스냅샷 바이트/인코딩 ns
+    const uint32 checkpointBench = BenchArg(argc, argv, "--bench-checkpoint", 10000);         // 적 N개 방 체크포인트의 tick 스레드 멈춤
+    const uint32 hitBench = BenchArg(argc, argv, "--bench-hits", 1000);                       // 적 N개 x 시전 100개 판정 tick당 시간 (p50/p99)
+    const uint32 arenaBench = BenchArg(argc, argv, "--bench-arena", 48);                      // 세션 N개 부하에서 tick/lane 스레드 operator new 횟수
+    const uint32 udpBench = BenchArg(argc, argv, "--bench-udp", 2);                           // 유실/지연 shim 뒤 스냅샷 나이 (TCP / UDP x 유실 0% / N%)
+    const uint32 pipelineBench = BenchArg(argc, argv, "--bench-pipeline", 100);               // 방 N개 스냅샷: inline 인코딩 vs 파이프라인 tick 스레드 시간 + capture->enqueue 지연
+    const uint32 historyBench = BenchArg(argc, argv, "--bench-history", 2000);                // 방 N개 위치 이력 링 상주 바이트 + tick당 기록/되감기 비용
+    const uint32 segmentBench = BenchArg(argc, argv, "--bench-segments", 2000);               // 방 N개 단계 섞음: 재우기 끔/켬 방 Update tick당 CPU
+    const uint32 ratesBench = BenchArg(argc, argv, "--bench-rates", 250);                     // active/quiet/AFK 방 N개: 적응형 주기 끔/켬 Update/capture CPU + 송신 바이트
+    const uint32 aiBench = BenchArg(argc, argv, "--bench-ai", 10000);                         // 적 N개 EnemyAi::Update tick당 시간 vs 적마다 가상 Update
+    const uint32 ringBench = BenchArg(argc, argv, "--bench-ring", 20000);                     // ShmRing / 직접 SendRawFrame / 링 + SendRawFrame: frames/s + 지연 p50/p99
+    const uint32 overloadBench = BenchArg(argc, argv, "--bench-overload", 4000);              // 접속 N개까지 단계적 증가: 과부하 제어 끔/켬 tick/스냅샷 Hz/거절 수
+
+    // --takeover: 같은 포트에서 돌고 있는 서버의 소켓/세션/방을 넘겨받아 시작 (그쪽 콘솔에서 handoff)
+    bool takeover = false;
+    // --udp: 같은 포트 번호로 UDP 스냅샷 채널도 엶 (클라가 C_UdpOpenReq로 요청한 세션만)
+    bool udpEnabled = false;
+    // --spectate: 관전 포트(게임 포트 + 1)도 엶. 그 포트 세션은 방에 안 들어가고 C_SpectateReq로 방 스냅샷을 늦게 받음
+    bool spectate = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        takeover = takeover || std::string(argv[i]) == "--takeover";
+        udpEnabled = udpEnabled || std::string(argv[i]) == "--udp";
+        spectate = spectate || std::string(argv[i]) == "--spectate";
+    }
+
+    // --topology <file>: 역할별 코어 고정 + large page (ThreadPlacement.h). 스레드 만들기 전에 읽어야 함
+    if (!topologyPath.empty() && !ThreadPlacement::Load(topologyPath))
+        return 1;
+
+    if (!replayPath.empty())
+        return RunReplay(replayPath, contentPath);
+
+    if (idleBench > 0)
+        return RunIdleBench(idleBench);
+
+    if (churnBench > 0)
+        return RunChurnBench(churnBench);
+
+    if (priorityBench > 0)
+        return RunPriorityBench(priorityBench);
+
+    if (spectatorBench > 0)
+        return RunSpectatorBench(spectatorBench);
+
+    if (slowConsumerBench > 0)
+        return RunSlowConsumerBench(slowConsumerBench);
+
+    if (connectStormBench > 0)
+        return RunConnectStormBench(connectStormBench);
+
+    if (codecBench > 0)
+        return RunCodecBench(codecBench);
+
+    if (snapshotEncodeBench > 0)
+        return RunSnapshotEncodeBench(snapshotEncodeBench);
+
+    if (checkpointBench > 0)
+        return RunCheckpointBench(checkpointBench);
+
+    if (hitBench > 0)
+        return RunHitBench(hitBench);
+
+    if (arenaBench > 0)
+        return RunArenaBench(arenaBench);
+
+    if (udpBench > 0)
+        return RunUdpBench(udpBench);
+
+    if (pipelineBench > 0)
+        return RunPipelineBench(pipelineBench);
+
+    if (historyBench > 0)
+        return RunHistoryBench(historyBench);
+
+    if (segmentBench > 0)
+        return RunSegmentBench(segmentBench);
+
+    if (ratesBench > 0)
+        return RunRatesBench(ratesBench);
+
+    if (aiBench > 0)
+        return RunAiBench(aiBench);
+
+    if (ringBench > 0)
+        return RunRingBench(ringBench);
+
+    if (overloadBench > 0)
+        return RunOverloadBench(overloadBench);
+
+    const uint16 port = 7777;
+
+    if (!gatewayLinks.empty())
+        return RunGateway(SplitList(gatewayLinks), port, udpEnabled);
+
+    // --link <name>: 분리 배포의 게임 프로세스 (소켓 없이 방만, 세션은 게이트웨이가 공유 메모리 링으로 넘겨줌)
+    const bool linked = !linkName.empty();
+    if (linked && (takeover || udpEnabled || spectate))
+    {
+        std::cout << "--link cannot be combined with --takeover/--udp/--spectate (those belong to the gateway)\n";
+        return 1;
+    }
+
+    WSADATA wsa{};
+    int ret = WSAStartup(MAKEWORD(2, 2), &wsa);
+    if (ret != 0)
+    {
+        std::cout << "WSAStartup failed: " << ret << "\n";
+        return 1;
+    }
+
+    SessionManager sessionMgr;
+
+    // 관전 세션은 따로 (방 입퇴장 훅 없음, 입력 훅 대신 관전 요청 훅만) -> 릴레이가 방 인코더 스레드 뒤에서 뿌림
+    // 방보다 먼저 만들고 늦게 정리 (인코더가 Offer, lane이 관전 세션을 씀)
+    SessionManager spectatorMgr;
+    SpectatorRelay relay(&spectatorMgr);
+
+    // 과부하: tick 시간 + 세션 send 큐 + CPU -> 스냅샷 주기/부가 작업/새 방/accept 순으로 줄임
+    // (--link는 세션이 없으므로 tick/CPU만 보고 단계를 게이트웨이에 알림)
+    OverloadController overload(TICK_INTERVAL_US);
+    if (!linked)
+    {
+        overload.SetQueueSampler([&sessionMgr](uint32& sessions, uint32& backlogged) {
+            sessionMgr.SampleSendQueues(OverloadController::OVERLOAD_BACKLOG_BYTES, sessions, backlogged);
+            });
+    }
+
+    // 세션 입/퇴장을 방 tick 스레드로 전달 (Acceptor/링크 시작 전에 연결)
+    RoomManager roomMgr(&sessionMgr);
+    roomMgr.SetOverload(&overload);
+    if (spectate)
+    {
+        roomMgr.SetSpectatorRelay(&relay);
+
+        SessionInputHooks spectatorHooks;
+        spectatorHooks.onSpectate = [&roomMgr, &relay](SessionId sid, const C_SpectateReq& msg) {
+            relay.Subscribe(sid, msg.roomId != 0 ? msg.roomId : roomMgr.FeaturedRoom());
+            };
+        spectatorMgr.SetInputHooks(std::move(spectatorHooks));
+    }
+    auto onOpened = [&roomMgr](SessionId sid) { roomMgr.OnSessionOpened(sid); };
+    auto onClosed = [&roomMgr](SessionId sid) { roomMgr.OnSessionClosed(sid); };
+
+    SessionInputHooks inputHooks;
+    inputHooks.onMoveInput = [&roomMgr](SessionId sid, const C_MoveInput& msg) { roomMgr.OnMoveInput(sid, msg); };
+    inputHooks.onCastSkill = [&roomMgr](SessionId sid, const C_CastSkill& msg) { roomMgr.OnCastSkill(sid, msg); };
+    inputHooks.onChoiceVote = [&roomMgr](SessionId sid, const C_ChoiceVote& msg) { roomMgr.OnChoiceVote(sid, msg); };
+    inputHooks.onRttSample = [&roomMgr](SessionId sid, uint32 rttMs, uint32 rttVarMs) { roomMgr.OnRttSample(sid, rttMs, rttVarMs); };
+
+    // 같은 훅을 세션 매니저(단일 프로세스) 또는 게이트웨이 링크에
+    GameLink link;
+    if (linked)
+    {
+        link.SetHooks(onOpened, onClosed, std::move(inputHooks));
+        link.SetOverload(&overload);
+        roomMgr.SetGameLink(&link);
+    }
+    else
+    {
+        sessionMgr.SetSessionHooks(onOpened, onClosed);
+        sessionMgr.SetInputHooks(std::move(inputHooks));
+    }
+
+    // --content <file>: ContentCompiler 출력 (없으면 GameConfig 임시값)
+    if (!roomMgr.Content().LoadInitial(contentPath))
+        std::cout << "Content tables not loaded, using built-in defaults\n";
+
+    // --record <file>: 방별 입력 기록 (tick 루프 밖 writer 스레드에서 씀)
+    if (!recordPath.empty() && !roomMgr.EnableRecording(recordPath))
         return 1;
 
-    std::atomic<bool> reapRun{ true };
-    std::thread reaper([&] {
-        while (reapRun.load())
+    // --checkpoint <host:port>: Go 서비스로 방 체크포인트 업로드 (tools/checkpoint_standin.py로 대체 가능)
+    if (!checkpointTarget.empty())
+    {
+        const size_t colon = checkpointTarget.rfind(':');
+        const std::string host = colon == std::string::npos ? checkpointTarget : checkpointTarget.substr(0, colon);
+        const uint16 port = colon == std::string::npos ? (uint16)8080 : (uint16)std::stoi(checkpointTarget.substr(colon + 1));
+        if (!roomMgr.EnableCheckpoints(host, port))
+            return 1;
+    }
+
+    // 세션이 만들어지기 전에 연결 (인계받는 세션 포함)
+    UdpTransport udp(&sessionMgr);
+    if (udpEnabled)
+        sessionMgr.SetUdpTransport(&udp);
+
+    // Acceptor가 세션매니저를 쓰게 연결
+    Acceptor acceptor(&sessionMgr);
+    acceptor.SetOverload(&overload);
+    Acceptor spectatorAcceptor(&spectatorMgr);
+    spectatorAcceptor.SetOverload(&overload);
+    const uint16 spectatePort = port + 1;
+
+    overload.Start();
+    if (takeover)
+    {
+        // 방 tick/세션 I/O/accept를 넘겨받은 상태로 시작
+        if (!HotRestart::Takeover(port, HotRestart::HANDOFF_WAIT_MS, acceptor, sessionMgr, roomMgr))
+            return 1;
+    }
+    else if (linked)
+    {
+        // 스냅샷 인코더마다 outbound 링 1개. 이전 게임 프로세스를 게이트웨이가 놓을 때까지 잠깐 재시도
+        if (!roomMgr.Start())
+            return 1;
+        if (!link.Start(linkName, SNAPSHOT_ENCODER_THREADS, 2 * GatewayLink::LINK_PEER_TIMEOUT_MS))
+            return 1;
+    }
+    else
+    {
+        if (!roomMgr.Start())
+            return 1;
+        if (!acceptor.Start(port))
+            return 1;
+    }
+
+    // UDP 묶음은 인계되지 않음 (넘겨받은 세션은 TCP로 스냅샷 -> 클라가 다시 요청)
+    // 인계 직후엔 이전 프로세스가 아직 포트를 쥐고 있을 수 있어서 잠깐 재시도
+    if (udpEnabled && !udp.Start(port, takeover ? HotRestart::HANDOFF_IO_TIMEOUT_MS : 0))
+        std::cout << "UDP channel not started (TCP only)\n";
+
+    // 관전은 인계되지 않음 (관전 세션은 이전 프로세스와 같이 끊기고 다시 붙음) -> UDP처럼 포트가 풀릴 때까지 잠깐 재시도
+    if (spectate && relay.Start())
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(takeover ? HotRestart::HANDOFF_IO_TIMEOUT_MS : 0);
+        bool listening = spectatorAcceptor.Start(spectatePort, 1);
+        while (!listening && std::chrono::steady_clock::now() < deadline)
         {
-            sessionMgr.ReapClosed();
-            ::Sleep(50);
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            listening = spectatorAcceptor.Start(spectatePort, 1);
         }
-        });
+        if (!listening)
+            std::cout << "Spectator port not started\n";
+    }
+
+    // 종료된 세션은 SessionManager가 epoch 기반으로 회수 (별도 reaper 스레드 없음)
 
-    std::cout << "Server listening on 7777\n";
-    std::cout << "Press Enter to quit...\n";
-    std::cin.get();
+    if (linked)
+        std::cout << "Game process on link '" << linkName << "'\n";
+    else
+        std::cout << "Server listening on " << port << (spectate ? " (spectators on " + std::to_string(spectatePort) + ")" : std::string()) << "\n";
+    std::cout << "Commands: reload [content file] / handoff [wait ms] / empty line to quit\n";
 
-    reapRun = false;
-    reaper.join();
+    // 리로드는 이 스레드에서 매핑/검증까지 하고 tick 경계에서 교체
+    std::string line;
+    while (std::getline(std::cin, line) && !line.empty())
+    {
+        if (line.rfind("reload", 0) == 0)
+        {
+            const std::string path = line.size() > 7 ? line.substr(7) : "";
+            if (!roomMgr.Content().RequestReload(path))
+                std::cout << "Reload failed (keeping current tables)\n";
+            continue;
+        }
+
+        // 새 프로세스(--takeover)로 넘기고 종료 (실패하면 계속 서비스)
+        if (line.rfind("handoff", 0) == 0 && !linked)
+        {
+            const uint32 waitMs = line.size() > 8 ? (uint32)std::strtoul(line.c_str() + 8, nullptr, 10) : 0;
+            if (HotRestart::Handoff(port, waitMs > 0 ? waitMs : HotRestart::HANDOFF_WAIT_MS, acceptor, sessionMgr, roomMgr))
+            {
+                udp.Stop();     // 새 프로세스가 UDP/관전 포트를 잡게 바로 놓음
+                spectatorAcceptor.Stop();
+                break;
+            }
+            continue;
+        }
+
+        std::cout << "Unknown command: " << line << "\n";
+    }
 
     acceptor.Stop();
+    spectatorAcceptor.Stop();
+    roomMgr.Stop();      // 인코더가 세션에 접근하므로 StopAll 전에 정리
+    relay.Stop();        // 인코더가 멈춘 뒤에 (Offer), 관전 세션 정리 전에 (lane이 세션을 씀)
+    overload.Stop();
+    link.Stop();         // 인코더가 멈춘 뒤에 (SendSnapshot이 outbound 링을 씀)
+    udp.Stop();          // 인코더가 멈춘 뒤에 (SendSnapshot이 소켓을 씀)
     sessionMgr.StopAll();
+    spectatorMgr.StopAll();
 
     WSACleanup();
     return 0;
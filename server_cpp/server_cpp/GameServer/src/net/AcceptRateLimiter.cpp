@@ -0,0 +1,56 @@
+#include "net/AcceptRateLimiter.h"
+
+#include <algorithm>
+
+AcceptRateLimiter::AcceptRateLimiter(double ratePerSec, double burst) : _ratePerSec(ratePerSec), _burst(burst)
+{
+}
+
+void AcceptRateLimiter::Refill(Bucket& b, Clock::time_point now) const
+{
+    if (now <= b.last) return;
+
+    const double sec = std::chrono::duration<double>(now - b.last).count();
+    b.tokens = std::min(_burst, b.tokens + sec * _ratePerSec);
+    b.last = now;
+}
+
+bool AcceptRateLimiter::Allow(uint32 ipv4, Clock::time_point now)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+
+    // 처음 보는 IP는 가득 찬 버킷으로 시작
+    auto it = _buckets.find(ipv4);
+    if (it == _buckets.end())
+        it = _buckets.emplace(ipv4, Bucket{ _burst, now }).first;
+
+    Bucket& b = it->second;
+    Refill(b, now);
+
+    if (b.tokens < 1.0)
+        return false;
+
+    b.tokens -= 1.0;
+    return true;
+}
+
+void AcceptRateLimiter::Prune(Clock::time_point now)
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+
+    // 가득 찬 버킷은 "처음 보는 IP"와 같으므로 지워도 동작 동일
+    for (auto it = _buckets.begin(); it != _buckets.end();)
+    {
+        Refill(it->second, now);
+        if (it->second.tokens >= _burst)
+            it = _buckets.erase(it);
+        else
+            ++it;
+    }
+}
+
+size_t AcceptRateLimiter::TrackedCount() const
+{
+    std::lock_guard<std::mutex> lock(_mtx);
+    return _buckets.size();
+}
\ No newline at end of file
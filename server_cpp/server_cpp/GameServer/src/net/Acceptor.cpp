@@ -1,6 +1,8 @@
 #include "net/Acceptor.h"
+#include "common/ThreadPlacement.h"
 #include "net/SessionManager.h"
 #include "net/Session.h"
+#include "proto/Codec.h"
 
 #include <iostream>
 
@@ -19,7 +21,7 @@ Acceptor::~Acceptor()
     Stop();
 }
 
-bool Acceptor::Start(uint16_t port)
+bool Acceptor::Start(uint16_t port, uint32_t acceptThreads)
 {
     if (_running.exchange(true))
         return false;
@@ -32,28 +34,86 @@ bool Acceptor::Start(uint16_t port)
         return false;
     }
 
-    _acceptThread = std::thread(&Acceptor::AcceptLoop, this);
-    Log(_tag, "Start listening on port " + std::to_string(port));
+    _threadCount = acceptThreads == 0 ? 1 : acceptThreads;
+    StartThreads();
+
+    Log(_tag, "Start listening on port " + std::to_string(port) + " (accept threads=" + std::to_string(_threadCount) + ")");
     return true;
 }
 
-void Acceptor::Stop()
+bool Acceptor::Adopt(SOCKET listenSock, uint16_t port, uint32_t acceptThreads)
+{
+    if (_running.exchange(true))
+        return false;
+
+    // 복제본도 같은 소켓이라 non-blocking은 이미 켜져 있지만 명시적으로
+    u_long nonBlocking = 1;
+    if (::ioctlsocket(listenSock, FIONBIO, &nonBlocking) == SOCKET_ERROR)
+    {
+        Log(_tag, "ioctlsocket(FIONBIO) failed on adopted socket");
+        _running.store(false);
+        return false;
+    }
+
+    _port = port;
+    _listenSock = listenSock;
+    _threadCount = acceptThreads == 0 ? 1 : acceptThreads;
+    StartThreads();
+
+    Log(_tag, "Adopted listen socket on port " + std::to_string(port) + " (accept threads=" + std::to_string(_threadCount) + ")");
+    return true;
+}
+
+void Acceptor::StartThreads()
+{
+    for (uint32_t i = 0; i < _threadCount; ++i)
+        _acceptThreads.emplace_back(&Acceptor::AcceptLoop, this, i);
+}
+
+bool Acceptor::Pause()
 {
-    // 
     if (!_running.exchange(false))
+        return false;
+
+    for (auto& t : _acceptThreads)
+    {
+        if (t.joinable())
+            t.join();
+    }
+    _acceptThreads.clear();
+
+    Log(_tag, "Paused (listen socket kept)");
+    return true;
+}
+
+void Acceptor::Resume()
+{
+    if (_listenSock == INVALID_SOCKET || _running.exchange(true))
         return;
 
-    // accept : listen  ݱ
-    if (_listenSock != INVALID_SOCKET)
+    StartThreads();
+    Log(_tag, "Resumed");
+}
+
+void Acceptor::Stop()
+{
+    // 멱등 (Pause 상태면 스레드는 이미 없고 소켓만 남아 있음)
+    _running.store(false);
+
+    // accept 스레드 정리: poll timeout마다 _running을 보므로 소켓 닫기 전에 먼저 join
+    // (다른 스레드가 쓰는 중인 소켓을 닫지 않기 위해)
+    for (auto& t : _acceptThreads)
     {
-        ::shutdown(_listenSock, SD_BOTH);
-        ::closesocket(_listenSock);
-        _listenSock = INVALID_SOCKET;
+        if (t.joinable())
+            t.join();
     }
+    _acceptThreads.clear();
+
+    if (_listenSock == INVALID_SOCKET)
+        return;
 
-    // accept  
-    if (_acceptThread.joinable())
-        _acceptThread.join();
+    ::closesocket(_listenSock);
+    _listenSock = INVALID_SOCKET;
 
     Log(_tag, "Stopped");
 }
@@ -67,7 +127,7 @@ bool Acceptor::OpenListenSocket(uint16_t port)
         return false;
     }
 
-    //   ɼ
+    // 재시작 편의 옵션
     BOOL opt = TRUE;
     ::setsockopt(s, SOL_SOCKET, SO_REUSEADDR, (const char*)&opt, sizeof(opt));
 
@@ -83,43 +143,131 @@ bool Acceptor::OpenListenSocket(uint16_t port)
         return false;
     }
 
-    if (::listen(s, SOMAXCONN) == SOCKET_ERROR)
+    if (::listen(s, SOMAXCONN_HINT(ACCEPT_BACKLOG)) == SOCKET_ERROR)
     {
         Log(_tag, "listen() failed");
         ::closesocket(s);
         return false;
     }
 
+    // non-blocking: poll로 깨어난 뒤 WSAEWOULDBLOCK까지 한 번에 비우기 위함
+    u_long nonBlocking = 1;
+    if (::ioctlsocket(s, FIONBIO, &nonBlocking) == SOCKET_ERROR)
+    {
+        Log(_tag, "ioctlsocket(FIONBIO) failed");
+        ::closesocket(s);
+        return false;
+    }
+
     _listenSock = s;
     return true;
 }
 
-void Acceptor::AcceptLoop()
+void Acceptor::AcceptLoop(uint32_t index)
 {
-    Log(_tag, "AcceptLoop started");
+    const std::string tag = _tag + "#" + std::to_string(index);
+    ThreadPlacement::Pin(ThreadRole::Accept, index);
+    Log(tag, "AcceptLoop started");
+
+    auto nextPrune = AcceptRateLimiter::Clock::now();
 
     while (_running.load())
     {
-        sockaddr_in caddr{};
-        int clen = sizeof(caddr);
+        WSAPOLLFD pfd{};
+        pfd.fd = _listenSock;
+        pfd.events = POLLRDNORM;
 
-        SOCKET clientSock = ::accept(_listenSock, (sockaddr*)&caddr, &clen);
-        if (clientSock == INVALID_SOCKET)
-        {
-            // Stop() listenSock  accept ϸ  
+        const int r = ::WSAPoll(&pfd, 1, ACCEPT_POLL_TIMEOUT_MS);
+        if (r == SOCKET_ERROR)
             break;
+
+        const auto now = AcceptRateLimiter::Clock::now();
+
+        // 버킷 정리는 한 스레드만
+        if (index == 0 && now >= nextPrune)
+        {
+            _rateLimiter.Prune(now);
+            nextPrune = now + std::chrono::seconds(10);
         }
 
-        //  / Ŵ 
-        auto session = _sessionMgr->CreateAndAdd(clientSock);
-        session->Start();
+        if (r == 0)
+            continue;
 
-        char ipbuf[64]{};
-        inet_ntop(AF_INET, &caddr.sin_addr, ipbuf, (socklen_t)sizeof(ipbuf));
-        uint16_t cport = ntohs(caddr.sin_port);
+        // backlog를 배치로 비우기 (로그도 배치당 1줄)
+        // 새 방을 못 만드는 단계면 조금만 받고 쉼 -> 나머지 접속은 backlog에서 기다림 (클라는 연결이 느린 것으로 봄)
+        const bool delayAccepts = _overload && _overload->Level() == LoadLevel::RejectRooms;
+        const int batch = delayAccepts ? ACCEPT_BATCH_OVERLOADED : ACCEPT_BATCH;
+
+        uint32_t accepted = 0;
+        uint32_t rejected = 0;
+
+        for (int i = 0; i < batch && _running.load(); ++i)
+        {
+            sockaddr_in caddr{};
+            int clen = sizeof(caddr);
+
+            SOCKET clientSock = ::accept(_listenSock, (sockaddr*)&caddr, &clen);
+            if (clientSock == INVALID_SOCKET)
+            {
+                // WSAEWOULDBLOCK: backlog 비었음 (다른 accept 스레드가 먼저 가져갔을 수도 있음)
+                break;
+            }
+
+            if (HandleAccepted(clientSock, caddr, now))
+                ++accepted;
+            else
+                ++rejected;
+        }
+
+        if (accepted > 0 || rejected > 0)
+        {
+            Log(tag, "Accepted " + std::to_string(accepted) + ", rejected " + std::to_string(rejected)
+                + " (sessions=" + std::to_string(_sessionMgr->Count()) + ")");
+        }
 
-        Log(_tag, std::string("Accepted client: ") + ipbuf + ":" + std::to_string(cport));
+        if (delayAccepts && accepted + rejected > 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(ACCEPT_OVERLOAD_DELAY_MS));
     }
 
-    Log(_tag, "AcceptLoop ended");
+    Log(tag, "AcceptLoop ended");
+}
+
+bool Acceptor::HandleAccepted(SOCKET clientSock, const sockaddr_in& caddr, AcceptRateLimiter::Clock::time_point now)
+{
+    // IP당 rate limit: 초과분은 세션/스레드 만들기 전에 바로 닫기
+    if (!_rateLimiter.Allow(caddr.sin_addr.s_addr, now))
+    {
+        ::closesocket(clientSock);
+        _rejected.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // 과부하 마지막 단계: 세션/스레드 없이 이유만 알리고 닫음 (클라는 backoff 후 재접속)
+    // 소켓이 아직 non-blocking이라 안 나가면 그냥 닫힘 -> 이유 없는 끊김과 같음
+    if (_overload && _overload->AtLeast(LoadLevel::RejectAccepts))
+    {
+        Byte frame[FixedCodec<S_Disconnect>::FRAME_SIZE];
+        FixedCodec<S_Disconnect>::EncodeFrame(S_Disconnect{ (uint16)DisconnectReason::Overloaded }, frame);
+        ::send(clientSock, (const char*)frame, (int)sizeof(frame), 0);
+        ::closesocket(clientSock);
+        _rejected.fetch_add(1, std::memory_order_relaxed);
+        _overloadRejected.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // accept된 소켓은 listen 소켓의 non-blocking 속성을 상속함 -> 세션도 non-blocking이라 그대로 (Session::Start가 다시 켬)
+
+    // 세션 생성/등록은 매니저가 담당
+    auto session = _sessionMgr->CreateAndAdd(clientSock);
+    if (!session)
+    {
+        // 슬롯 고갈: 받지 않고 바로 닫기
+        ::closesocket(clientSock);
+        _rejected.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    session->Start();
+
+    _accepted.fetch_add(1, std::memory_order_relaxed);
+    return true;
 }
\ No newline at end of file
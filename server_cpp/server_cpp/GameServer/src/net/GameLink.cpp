@@ -0,0 +1,351 @@
+#include "net/GameLink.h"
+#include "common/ServerClock.h"
+#include "common/ThreadPlacement.h"
+#include "proto/Codec.h"
+
+#include <chrono>
+#include <iostream>
+
+using Side = GatewayLink::Side;
+using State = GatewayLink::State;
+using RecordKind = GatewayLink::RecordKind;
+
+// 링크로 받는 프레임은 게임 입력만 (게이트웨이 Session이 이미 한 번 검증한 것)
+using LinkInputDispatcher = Dispatcher<GameLink::InputHandler, C_MoveInput, C_CastSkill, C_ChoiceVote>;
+
+static void Log(const std::string& tag, const std::string& msg)
+{
+    std::cout << "[" << tag << "] " << msg << "\n";
+}
+
+GameLink::GameLink()
+{
+    _tag = "GameLink";
+}
+
+GameLink::~GameLink()
+{
+    Stop();
+}
+
+void GameLink::SetHooks(SessionEventFn onOpened, SessionEventFn onClosed, SessionInputHooks inputHooks)
+{
+    _onOpened = std::move(onOpened);
+    _onClosed = std::move(onClosed);
+    _inputHooks = std::move(inputHooks);
+}
+
+bool GameLink::Start(const std::string& name, uint32 outRings, uint32 createWaitMs)
+{
+    if (_running.load())
+        return false;
+
+    // 인코더 링 outRings개 + tick 스레드 링 1개
+    if (!_link.Create(name, outRings + 1, createWaitMs))
+        return false;
+
+    _outRings = outRings;
+    _running.store(true);
+    _recvThread = std::thread(&GameLink::RecvLoop, this);
+
+    Log(_tag, "Start on link '" + name + "' (waiting for gateway)");
+    return true;
+}
+
+void GameLink::Stop()
+{
+    // 인코더가 SendSnapshot 중일 수 있음 -> 호출부는 RoomManager::Stop 뒤에 부를 것
+    if (!_running.exchange(false))
+        return;
+
+    if (_recvThread.joinable())
+        _recvThread.join();
+
+    _attached.store(false);
+    _link.Close(Side::Game);
+
+    Log(_tag, "Stopped");
+}
+
+bool GameLink::SendSnapshot(uint32 ring, const SessionId* recipients, size_t count, const ByteBuffer& frame,
+    uint64 tickOriginUs, uint32 tickUs)
+{
+    if (count == 0)
+        return true;
+
+    if (!_attached.load(std::memory_order_acquire) || ring >= _outRings || count > 0xFFFF)
+    {
+        _snapshotsDropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    const size_t idsLen = count * sizeof(SessionId);
+    const size_t len = GatewayLink::RECORD_SIZE + idsLen + frame.size();
+
+    ShmRing& out = _link.Out(ring);
+    Byte* p = out.Reserve(len);
+    if (!p)
+    {
+        // 게이트웨이가 못 따라옴: 스냅샷은 최신 것만 의미 있으므로 버리고 다음 것을 기다림
+        _snapshotsDropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    GatewayLink::Record rec;
+    rec.kind = RecordKind::Snapshot;
+    rec.count = (uint16)count;
+    rec.arg32 = tickUs;
+    rec.arg64 = tickOriginUs;
+    rec.sentUs = ServerTimeUs();
+    GatewayLink::StoreRecord(p, rec);
+
+    std::memcpy(p + GatewayLink::RECORD_SIZE, recipients, idsLen);
+    std::memcpy(p + GatewayLink::RECORD_SIZE + idsLen, frame.data(), frame.size());
+
+    out.Commit();
+    _link.Notify(Side::Gateway);
+
+    _snapshotsOut.fetch_add(1, std::memory_order_relaxed);
+    _bytesOut.fetch_add(len, std::memory_order_relaxed);
+    return true;
+}
+
+bool GameLink::RejectSession(SessionId sid, DisconnectReason reason)
+{
+    if (!_attached.load(std::memory_order_acquire))
+        return false;
+
+    ShmRing& out = _link.Out(_outRings);
+    Byte* p = out.Reserve(GatewayLink::RECORD_SIZE);
+    if (!p)
+        return false;
+
+    GatewayLink::Record rec;
+    rec.kind = RecordKind::Reject;
+    rec.arg32 = (uint32)reason;
+    rec.sid = sid;
+    rec.sentUs = ServerTimeUs();
+    GatewayLink::StoreRecord(p, rec);
+
+    out.Commit();
+    _link.Notify(Side::Gateway);
+    return true;
+}
+
+GameLink::Stats GameLink::TakeStats()
+{
+    Stats s;
+    s.recordsIn = _recordsIn.exchange(0, std::memory_order_relaxed);
+    s.badRecords = _badRecords.exchange(0, std::memory_order_relaxed);
+    s.snapshotsOut = _snapshotsOut.exchange(0, std::memory_order_relaxed);
+    s.snapshotsDropped = _snapshotsDropped.exchange(0, std::memory_order_relaxed);
+    s.bytesOut = _bytesOut.exchange(0, std::memory_order_relaxed);
+    s.ringLatencyUsSum = _ringLatencyUsSum.exchange(0, std::memory_order_relaxed);
+    s.ringLatencyUsMax = _ringLatencyUsMax.exchange(0, std::memory_order_relaxed);
+    return s;
+}
+
+void GameLink::RecvLoop()
+{
+    ThreadPlacement::Pin(ThreadRole::SessionIo, 0);
+
+    auto nextStatLog = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    uint32 idleSpins = 0;
+
+    while (_running.load())
+    {
+        const uint64 nowMs = ServerTimeUs() / 1000;
+        _link.Beat(Side::Game, nowMs);
+        if (_overload)
+            _link.SetGameLoad((uint32)_overload->Level());
+
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= nextStatLog)
+        {
+            LogStats();
+            nextStatLog = now + std::chrono::seconds(10);
+        }
+
+        switch (_link.GetState())
+        {
+        case State::Idle:
+            _link.Wait(Side::Game, GatewayLink::LINK_WAIT_MS);
+            continue;
+
+        case State::AttachRequested:
+            // 새 게이트웨이: 이전 게이트웨이가 남긴 입력은 버리고 받아줌
+            _link.In().SkipAll();
+            _attached.store(true, std::memory_order_release);
+            _link.SetState(State::Attached);
+            Log(_tag, "Gateway attached");
+            continue;
+
+        case State::Attached:
+            break;
+        }
+
+        // 게이트웨이를 잃은 뒤 유예 중: 방이 이전 세션을 뺄 때까지 새 게이트웨이를 받지 않음
+        if (_resetUntilMs != 0)
+        {
+            if (nowMs >= _resetUntilMs)
+            {
+                _resetUntilMs = 0;
+                _link.SetState(State::Idle);
+                Log(_tag, "Ready for gateway");
+            }
+            else
+            {
+                _link.Wait(Side::Game, GatewayLink::LINK_WAIT_MS);
+            }
+            continue;
+        }
+
+        if (Drain() != 0)
+        {
+            idleSpins = 0;
+            continue;
+        }
+
+        if (!_link.PeerAlive(Side::Game, nowMs) || _link.In().Broken())
+        {
+            DropGateway();
+            _resetUntilMs = nowMs + GatewayLink::LINK_RESET_GRACE_MS;
+            continue;
+        }
+
+        // 바로 다음 입력이 올 가능성이 높으니 잠깐 더 보고 잠듦 (잠든 뒤엔 게이트웨이가 이벤트로 깨움)
+        if (++idleSpins < GatewayLink::LINK_SPIN)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        idleSpins = 0;
+        _link.Wait(Side::Game, GatewayLink::LINK_WAIT_MS);
+    }
+
+    // 게이트웨이 세션은 이 프로세스와 함께 끝남 (게이트웨이는 heartbeat 0을 보고 그쪽 세션을 끊음)
+    DropGateway();
+}
+
+size_t GameLink::Drain()
+{
+    ShmRing& in = _link.In();
+
+    size_t n = 0;
+    size_t len = 0;
+    const Byte* p = nullptr;
+    while (n < GatewayLink::LINK_DRAIN_BATCH && (p = in.Peek(len)) != nullptr)
+    {
+        GatewayLink::Record rec;
+        if (GatewayLink::LoadRecord(p, len, rec))
+            Handle(rec, p + GatewayLink::RECORD_SIZE, len - GatewayLink::RECORD_SIZE);
+        else
+            _badRecords.fetch_add(1, std::memory_order_relaxed);
+
+        in.Pop();
+        ++n;
+    }
+
+    if (n != 0)
+        _recordsIn.fetch_add(n, std::memory_order_relaxed);
+    return n;
+}
+
+void GameLink::Handle(const GatewayLink::Record& rec, const Byte* body, size_t bodyLen)
+{
+    const uint64 nowUs = ServerTimeUs();
+    const uint64 latency = nowUs > rec.sentUs ? nowUs - rec.sentUs : 0;
+    _ringLatencyUsSum.fetch_add(latency, std::memory_order_relaxed);
+    if (latency > _ringLatencyUsMax.load(std::memory_order_relaxed))
+        _ringLatencyUsMax.store(latency, std::memory_order_relaxed);
+
+    switch (rec.kind)
+    {
+    case RecordKind::Opened:
+        if (_open.insert(rec.sid).second && _onOpened)
+            _onOpened(rec.sid);
+        return;
+
+    case RecordKind::Closed:
+        if (_open.erase(rec.sid) != 0 && _onClosed)
+            _onClosed(rec.sid);
+        return;
+
+    case RecordKind::Input:
+    {
+        // 닫힌 뒤 늦게 도착한 입력(UDP 등)은 조용히 버림
+        if (_open.count(rec.sid) == 0)
+            return;
+        if (bodyLen < 4)
+            break;
+
+        InputHandler h{ this, rec.sid };
+        const MsgId msgId = LoadLE<uint16>(body + 2);
+        if (LinkInputDispatcher::Dispatch(h, msgId, body + 4, bodyLen - 4) != DispatchResult::Ok)
+            break;
+        return;
+    }
+
+    case RecordKind::Rtt:
+        if (_open.count(rec.sid) != 0 && _inputHooks.onRttSample)
+            _inputHooks.onRttSample(rec.sid, (uint32)rec.arg64, rec.arg32);
+        return;
+
+    default:
+        break;
+    }
+
+    _badRecords.fetch_add(1, std::memory_order_relaxed);
+}
+
+void GameLink::DropGateway()
+{
+    _attached.store(false, std::memory_order_release);
+
+    if (_open.empty())
+        return;
+
+    Log(_tag, "Gateway lost, closing " + std::to_string(_open.size()) + " sessions");
+
+    if (_onClosed)
+    {
+        for (SessionId sid : _open)
+            _onClosed(sid);
+    }
+    _open.clear();
+}
+
+void GameLink::LogStats()
+{
+    const Stats s = TakeStats();
+    if (s.recordsIn == 0 && s.snapshotsOut == 0 && s.snapshotsDropped == 0)
+        return;
+
+    const uint64 avgUs = s.recordsIn ? s.ringLatencyUsSum / s.recordsIn : 0;
+    Log(_tag,
+        "sessions=" + std::to_string(_open.size()) +
+        " recordsIn=" + std::to_string(s.recordsIn) +
+        " bad=" + std::to_string(s.badRecords) +
+        " ringUs(avg/max)=" + std::to_string(avgUs) + "/" + std::to_string(s.ringLatencyUsMax) +
+        " snapshotsOut=" + std::to_string(s.snapshotsOut) +
+        " dropped=" + std::to_string(s.snapshotsDropped) +
+        " egressKB=" + std::to_string(s.bytesOut / 1024));
+}
+
+void GameLink::InputHandler::On(const C_MoveInput& msg)
+{
+    if (link->_inputHooks.onMoveInput)
+        link->_inputHooks.onMoveInput(sid, msg);
+}
+
+void GameLink::InputHandler::On(const C_CastSkill& msg)
+{
+    if (link->_inputHooks.onCastSkill)
+        link->_inputHooks.onCastSkill(sid, msg);
+}
+
+void GameLink::InputHandler::On(const C_ChoiceVote& msg)
+{
+    if (link->_inputHooks.onChoiceVote)
+        link->_inputHooks.onChoiceVote(sid, msg);
+}
\ No newline at end of file
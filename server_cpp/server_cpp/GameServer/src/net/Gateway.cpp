@@ -0,0 +1,505 @@
+#include "net/Gateway.h"
+#include "common/ServerClock.h"
+#include "common/ThreadPlacement.h"
+#include "net/SessionManager.h"
+#include "proto/Codec.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+using Side = GatewayLink::Side;
+using RecordKind = GatewayLink::RecordKind;
+
+static void Log(const std::string& tag, const std::string& msg)
+{
+    std::cout << "[" << tag << "] " << msg << "\n";
+}
+
+static uint64 NowMs()
+{
+    return ServerTimeUs() / 1000;
+}
+
+Gateway::Gateway(SessionManager* mgr) : _sessionMgr(mgr)
+{
+    _tag = "Gateway";
+}
+
+Gateway::~Gateway()
+{
+    Stop();
+}
+
+bool Gateway::Start(const std::vector<std::string>& links, uint32 attachWaitMs)
+{
+    if (_running.load() || links.empty())
+        return false;
+
+    for (const std::string& name : links)
+    {
+        auto b = std::make_unique<Backend>();
+        b->name = name;
+        _backends.push_back(std::move(b));
+    }
+
+    _running.store(true);
+    for (uint32 i = 0; i < (uint32)_backends.size(); ++i)
+        _backends[i]->thread = std::thread(&Gateway::RecvLoop, this, i);
+
+    // 게임 프로세스가 아직 안 떴을 수 있음 -> 하나라도 붙을 때까지
+    const auto giveUp = std::chrono::steady_clock::now() + std::chrono::milliseconds(attachWaitMs);
+    for (;;)
+    {
+        size_t attached = 0;
+        for (const auto& b : _backends)
+            attached += b->attached.load() ? 1 : 0;
+
+        if (attached != 0)
+        {
+            Log(_tag, "Start with " + std::to_string(attached) + "/" + std::to_string(_backends.size()) + " game processes");
+            return true;
+        }
+        if (std::chrono::steady_clock::now() >= giveUp)
+            break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    Log(_tag, "No game process attached");
+    Stop();
+    return false;
+}
+
+void Gateway::Stop()
+{
+    if (!_running.exchange(false))
+        return;
+
+    for (auto& b : _backends)
+    {
+        if (b->thread.joinable())
+            b->thread.join();
+
+        std::lock_guard<std::mutex> lock(b->produceMutex);
+        b->attached.store(false);
+        if (b->link)
+        {
+            b->link->Close(Side::Gateway);
+            b->link.reset();
+        }
+    }
+
+    Log(_tag, "Stopped");
+}
+
+// ---- inbound (세션 I/O 스레드) -------------------------------------------------
+
+template <typename WriteFn>
+bool Gateway::Post(uint32 backend, GatewayLink::Record& rec, size_t bodyLen, WriteFn&& write)
+{
+    Backend& b = *_backends[backend];
+
+    std::lock_guard<std::mutex> lock(b.produceMutex);
+    if (!b.attached.load(std::memory_order_relaxed))
+        return false;
+
+    ShmRing& in = b.link->In();
+    Byte* p = in.Reserve(GatewayLink::RECORD_SIZE + bodyLen);
+    if (!p)
+    {
+        _recordsDropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    rec.sentUs = ServerTimeUs();
+    GatewayLink::StoreRecord(p, rec);
+    write(p + GatewayLink::RECORD_SIZE);
+
+    in.Commit();
+    b.link->Notify(Side::Game);
+
+    _recordsOut.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool Gateway::PostSimple(uint32 backend, RecordKind kind, SessionId sid, uint64 arg64, uint32 arg32)
+{
+    GatewayLink::Record rec;
+    rec.kind = kind;
+    rec.sid = sid;
+    rec.arg64 = arg64;
+    rec.arg32 = arg32;
+    return Post(backend, rec, 0, [](Byte*) {});
+}
+
+template <typename Msg>
+void Gateway::PostInput(SessionId sid, const Msg& msg)
+{
+    uint32 backend = 0;
+    if (!BackendOf(sid, backend))
+        return;
+
+    // 세션이 decode한 메시지를 링 자리에 바로 다시 프레임으로 (할당 없음)
+    GatewayLink::Record rec;
+    rec.kind = RecordKind::Input;
+    rec.sid = sid;
+    Post(backend, rec, FixedCodec<Msg>::FRAME_SIZE, [&msg](Byte* out) { FixedCodec<Msg>::EncodeFrame(msg, out); });
+}
+
+bool Gateway::BackendOf(SessionId sid, uint32& out)
+{
+    std::lock_guard<std::mutex> lock(_assignMutex);
+    auto it = _assigned.find(sid);
+    if (it == _assigned.end())
+        return false;
+    out = it->second;
+    return true;
+}
+
+void Gateway::OnSessionOpened(SessionId sid)
+{
+    bool assigned = false;
+    bool overloaded = false;
+    uint32 backend = 0;
+    {
+        std::lock_guard<std::mutex> lock(_assignMutex);
+        for (uint32 tries = 0; tries < (uint32)_backends.size(); ++tries)
+        {
+            backend = _nextBackend++ % (uint32)_backends.size();
+            const Backend& b = *_backends[backend];
+            if (!b.attached.load())
+                continue;
+
+            // 새 방을 못 만드는 게임 프로세스는 건너뜀 (자리 있는 방이 있어도 어느 쪽인지 모름)
+            if (b.load.load(std::memory_order_relaxed) >= (uint32)LoadLevel::RejectRooms)
+            {
+                overloaded = true;
+                continue;
+            }
+
+            _assigned[sid] = backend;
+            assigned = true;
+            break;
+        }
+    }
+
+    if (!assigned || !PostSimple(backend, RecordKind::Opened, sid))
+    {
+        {
+            std::lock_guard<std::mutex> lock(_assignMutex);
+            _assigned.erase(sid);
+        }
+
+        if (!assigned && overloaded)
+        {
+            _overloaded.fetch_add(1, std::memory_order_relaxed);
+            Kick(sid, DisconnectReason::Overloaded);
+        }
+        else
+        {
+            Kick(sid);
+        }
+    }
+}
+
+void Gateway::OnSessionClosed(SessionId sid)
+{
+    uint32 backend = 0;
+    {
+        std::lock_guard<std::mutex> lock(_assignMutex);
+        auto it = _assigned.find(sid);
+        if (it == _assigned.end())
+            return;     // 배정 전에 끊었거나 게임 프로세스를 잃어서 이미 정리됨
+        backend = it->second;
+        _assigned.erase(it);
+    }
+
+    PostSimple(backend, RecordKind::Closed, sid);
+}
+
+SessionInputHooks Gateway::MakeInputHooks()
+{
+    SessionInputHooks hooks;
+    hooks.onMoveInput = [this](SessionId sid, const C_MoveInput& msg) { PostInput(sid, msg); };
+    hooks.onCastSkill = [this](SessionId sid, const C_CastSkill& msg) { PostInput(sid, msg); };
+    hooks.onChoiceVote = [this](SessionId sid, const C_ChoiceVote& msg) { PostInput(sid, msg); };
+    hooks.onRttSample = [this](SessionId sid, uint32 rttMs, uint32 rttVarMs)
+    {
+        uint32 backend = 0;
+        if (BackendOf(sid, backend))
+            PostSimple(backend, RecordKind::Rtt, sid, rttMs, rttVarMs);
+    };
+    return hooks;
+}
+
+void Gateway::Kick(SessionId sid, DisconnectReason reason)
+{
+    // 세션 Start 전이어도 소켓 shutdown으로 recv가 바로 끝남 -> 평소 종료 경로(onClose)
+    // 이유가 있으면 S_Disconnect를 큐에 넣고 송신 완료 뒤 끊음
+    if (std::shared_ptr<Session> s = _sessionMgr->Find(sid))
+    {
+        if (reason != DisconnectReason::None)
+        {
+            s->Disconnect(reason);
+            return;
+        }
+        s->RequestStop();
+        _kicked.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+LoadLevel Gateway::MinBackendLoad() const
+{
+    uint32 level = (uint32)LoadLevel::RejectAccepts;
+    bool any = false;
+    for (const auto& b : _backends)
+    {
+        if (!b->attached.load(std::memory_order_relaxed))
+            continue;
+        level = std::min(level, b->load.load(std::memory_order_relaxed));
+        any = true;
+    }
+    return any ? (LoadLevel)level : LoadLevel::Normal;
+}
+
+Gateway::Stats Gateway::TakeStats()
+{
+    Stats s;
+    s.recordsOut = _recordsOut.exchange(0, std::memory_order_relaxed);
+    s.recordsDropped = _recordsDropped.exchange(0, std::memory_order_relaxed);
+    s.snapshotsIn = _snapshotsIn.exchange(0, std::memory_order_relaxed);
+    s.framesDelivered = _framesDelivered.exchange(0, std::memory_order_relaxed);
+    s.ringLatencyUsSum = _ringLatencyUsSum.exchange(0, std::memory_order_relaxed);
+    s.ringLatencyUsMax = _ringLatencyUsMax.exchange(0, std::memory_order_relaxed);
+    s.kicked = _kicked.exchange(0, std::memory_order_relaxed);
+    s.overloaded = _overloaded.exchange(0, std::memory_order_relaxed);
+    return s;
+}
+
+// ---- outbound (게임 프로세스별 수신 스레드) ----------------------------------
+
+void Gateway::RecvLoop(uint32 index)
+{
+    ThreadPlacement::Pin(ThreadRole::SessionIo, index);
+
+    Backend& b = *_backends[index];
+
+    // 세션 raw 포인터를 쓰므로 epoch 참가자로 등록
+    EpochManager& epoch = _sessionMgr->Epoch();
+    const EpochManager::ParticipantId pid = epoch.Register();
+    if (pid == EpochManager::INVALID_PARTICIPANT)
+    {
+        Log(_tag, "epoch register failed");
+        return;
+    }
+
+    // 스레드마다 프레임 버퍼 1개 재사용 (Session::SendSnapshotFrame이 ByteBuffer를 받음)
+    ByteBuffer frame;
+    frame.reserve(MAX_FRAME_TOTAL);
+
+    auto nextStatLog = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    uint64 nextAttachMs = 0;
+    uint32 idleSpins = 0;
+
+    while (_running.load())
+    {
+        const uint64 nowMs = NowMs();
+
+        if (index == 0)
+        {
+            const auto now = std::chrono::steady_clock::now();
+            if (now >= nextStatLog)
+            {
+                LogStats();
+                nextStatLog = now + std::chrono::seconds(10);
+            }
+        }
+
+        if (!b.attached.load())
+        {
+            if (nowMs >= nextAttachMs)
+            {
+                TryAttach(b);
+                nextAttachMs = nowMs + LINK_ATTACH_RETRY_MS;
+            }
+            else
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+            continue;
+        }
+
+        // link 포인터는 이 스레드만 바꿈 -> 여기서는 락 없이 읽어도 됨
+        GatewayLink& link = *b.link;
+        link.Beat(Side::Gateway, nowMs);
+        b.load.store(std::min<uint32>(link.GameLoad(), (uint32)LoadLevel::RejectAccepts), std::memory_order_relaxed);
+
+        if (Drain(link, frame, pid) != 0)
+        {
+            idleSpins = 0;
+            continue;
+        }
+
+        bool broken = false;
+        for (uint32 i = 0; i < link.OutRings(); ++i)
+            broken = broken || link.Out(i).Broken();
+
+        if (!link.PeerAlive(Side::Gateway, nowMs) || broken)
+        {
+            LoseBackend(index);
+            nextAttachMs = nowMs + LINK_ATTACH_RETRY_MS;
+            continue;
+        }
+
+        if (++idleSpins < GatewayLink::LINK_SPIN)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        idleSpins = 0;
+        link.Wait(Side::Gateway, GatewayLink::LINK_WAIT_MS);
+    }
+
+    epoch.Unregister(pid);
+}
+
+size_t Gateway::Drain(GatewayLink& link, ByteBuffer& frame, uint32 pid)
+{
+    size_t n = 0;
+    uint64 delivered = 0;
+
+    EpochGuard guard(_sessionMgr->Epoch(), pid);
+
+    for (uint32 r = 0; r < link.OutRings(); ++r)
+    {
+        ShmRing& out = link.Out(r);
+
+        size_t len = 0;
+        const Byte* p = nullptr;
+        for (size_t batch = 0; batch < GatewayLink::LINK_DRAIN_BATCH && (p = out.Peek(len)) != nullptr; ++batch)
+        {
+            GatewayLink::Record rec;
+            if (GatewayLink::LoadRecord(p, len, rec) && rec.kind == RecordKind::Reject)
+            {
+                // 배정 뒤 게임 프로세스가 새 방을 못 만듦 (공개된 단계를 보기 전의 경합분)
+                _overloaded.fetch_add(1, std::memory_order_relaxed);
+                Kick(rec.sid, (DisconnectReason)rec.arg32);
+            }
+            else if (GatewayLink::LoadRecord(p, len, rec) && rec.kind == RecordKind::Snapshot
+                && len >= GatewayLink::RECORD_SIZE + (size_t)rec.count * sizeof(SessionId) + 4)
+            {
+                const uint64 nowUs = ServerTimeUs();
+                const uint64 latency = nowUs > rec.sentUs ? nowUs - rec.sentUs : 0;
+                _ringLatencyUsSum.fetch_add(latency, std::memory_order_relaxed);
+                uint64 prevMax = _ringLatencyUsMax.load(std::memory_order_relaxed);
+                while (latency > prevMax && !_ringLatencyUsMax.compare_exchange_weak(prevMax, latency, std::memory_order_relaxed))
+                {
+                }
+
+                const Byte* ids = p + GatewayLink::RECORD_SIZE;
+                const size_t idsLen = (size_t)rec.count * sizeof(SessionId);
+                frame.assign(ids + idsLen, p + len);
+
+                for (uint16 i = 0; i < rec.count; ++i)
+                {
+                    SessionId sid;
+                    std::memcpy(&sid, ids + i * sizeof(SessionId), sizeof(SessionId));
+
+                    Session* s = _sessionMgr->Lookup(sid);
+                    if (!s)
+                        continue; // 이미 나간 세션
+
+                    s->SendSnapshotFrame(frame);
+                    s->SetTickOrigin(rec.arg64, rec.arg32);
+                    ++delivered;
+                }
+            }
+
+            out.Pop();
+            ++n;
+        }
+    }
+
+    if (n != 0)
+    {
+        _snapshotsIn.fetch_add(n, std::memory_order_relaxed);
+        _framesDelivered.fetch_add(delivered, std::memory_order_relaxed);
+    }
+    return n;
+}
+
+bool Gateway::TryAttach(Backend& b)
+{
+    // 붙기(최대 LINK_ATTACH_TIMEOUT_MS)는 락 밖에서 -> 성공하면 바꿔 끼움
+    auto link = std::make_unique<GatewayLink>();
+    if (!link->Attach(b.name))
+        return false;
+
+    std::lock_guard<std::mutex> lock(b.produceMutex);
+    b.load.store(std::min<uint32>(link->GameLoad(), (uint32)LoadLevel::RejectAccepts));
+    b.link = std::move(link);
+    b.attached.store(true);
+
+    Log(_tag, "Game process '" + b.name + "' attached");
+    return true;
+}
+
+void Gateway::LoseBackend(uint32 index)
+{
+    Backend& b = *_backends[index];
+    {
+        std::lock_guard<std::mutex> lock(b.produceMutex);
+        b.attached.store(false);
+        b.load.store(0);
+        b.link->Close(Side::Gateway);
+        b.link.reset();
+    }
+
+    std::vector<SessionId> orphans;
+    {
+        std::lock_guard<std::mutex> lock(_assignMutex);
+        for (auto it = _assigned.begin(); it != _assigned.end();)
+        {
+            if (it->second == index)
+            {
+                orphans.push_back(it->first);
+                it = _assigned.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    Log(_tag, "Game process '" + b.name + "' lost, closing " + std::to_string(orphans.size()) + " sessions");
+
+    // 방이 없어졌으니 클라는 다시 접속해서 다른 게임 프로세스로
+    for (SessionId sid : orphans)
+        Kick(sid);
+}
+
+void Gateway::LogStats()
+{
+    const Stats s = TakeStats();
+    if (s.recordsOut == 0 && s.snapshotsIn == 0 && s.kicked == 0 && s.overloaded == 0)
+        return;
+
+    size_t sessions = 0;
+    {
+        std::lock_guard<std::mutex> lock(_assignMutex);
+        sessions = _assigned.size();
+    }
+
+    const uint64 avgUs = s.snapshotsIn ? s.ringLatencyUsSum / s.snapshotsIn : 0;
+    Log(_tag,
+        "sessions=" + std::to_string(sessions) +
+        " recordsOut=" + std::to_string(s.recordsOut) +
+        " dropped=" + std::to_string(s.recordsDropped) +
+        " snapshotsIn=" + std::to_string(s.snapshotsIn) +
+        " framesDelivered=" + std::to_string(s.framesDelivered) +
+        " ringUs(avg/max)=" + std::to_string(avgUs) + "/" + std::to_string(s.ringLatencyUsMax) +
+        " kicked=" + std::to_string(s.kicked) +
+        " overloaded=" + std::to_string(s.overloaded) +
+        " minBackendLoad=" + LoadLevelName(MinBackendLoad()));
+}
\ No newline at end of file
@@ -0,0 +1,243 @@
+#include "net/GatewayLink.h"
+#include "common/ServerClock.h"
+
+#include <winsock2.h>
+#include <windows.h>
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+static void Log(const std::string& tag, const std::string& msg)
+{
+    std::cout << "[" << tag << "] " << msg << "\n";
+}
+
+static uint64 NowMs()
+{
+    return ServerTimeUs() / 1000;
+}
+
+static size_t MappingBytes(uint32 outRings)
+{
+    return sizeof(GatewayLink::Header)
+        + ShmRing::BytesFor(GatewayLink::LINK_IN_RING_BYTES)
+        + (size_t)outRings * ShmRing::BytesFor(GatewayLink::LINK_OUT_RING_BYTES);
+}
+
+bool GatewayLink::Create(const std::string& name, uint32 outRings, uint32 waitMs)
+{
+    if (outRings == 0 || outRings > LINK_MAX_OUT_RINGS)
+        return false;
+
+    // 이전 게임 프로세스의 매핑을 게이트웨이가 아직 쥐고 있으면 그쪽이 놓을 때까지 (죽은 것으로 보는 데 LINK_PEER_TIMEOUT_MS)
+    const std::string mapping = MappingName(name);
+    const auto giveUp = std::chrono::steady_clock::now() + std::chrono::milliseconds(waitMs);
+    while (!_shm.Create(mapping, MappingBytes(outRings)))
+    {
+        if (std::chrono::steady_clock::now() >= giveUp)
+        {
+            Log("GatewayLink", "Create failed (in use?): " + mapping);
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    Byte* base = _shm.Data();
+    _hdr = new (base) Header;
+    _hdr->version = LINK_VERSION;
+    _hdr->outRings = (uint16)outRings;
+    _hdr->headerSize = (uint32)sizeof(Header);
+    _hdr->recordSize = (uint32)sizeof(Record);
+    _hdr->inCapacity = LINK_IN_RING_BYTES;
+    _hdr->outCapacity = LINK_OUT_RING_BYTES;
+    _hdr->gamePid = (uint32)::GetCurrentProcessId();
+    _hdr->state.store((uint32)State::Idle, std::memory_order_relaxed);
+    _hdr->gatewayPid.store(0, std::memory_order_relaxed);
+    _hdr->gameBeatMs.store(NowMs(), std::memory_order_relaxed);
+    _hdr->gatewayBeatMs.store(0, std::memory_order_relaxed);
+    _hdr->gameLoad.store(0, std::memory_order_relaxed);
+    _hdr->gameWaiting.store(0, std::memory_order_relaxed);
+    _hdr->gatewayWaiting.store(0, std::memory_order_relaxed);
+
+    Byte* p = base + sizeof(Header);
+    ShmRing::Init(p, LINK_IN_RING_BYTES);
+    p += ShmRing::BytesFor(LINK_IN_RING_BYTES);
+    for (uint32 i = 0; i < outRings; ++i)
+    {
+        ShmRing::Init(p, LINK_OUT_RING_BYTES);
+        p += ShmRing::BytesFor(LINK_OUT_RING_BYTES);
+    }
+
+    // magic은 마지막에 -> 여는 쪽이 반쯤 초기화된 헤더를 보지 않음
+    std::atomic_thread_fence(std::memory_order_release);
+    _hdr->magic = LINK_MAGIC;
+
+    _name = name;
+    if (!BindRings())
+    {
+        Close(Side::Game);
+        return false;
+    }
+
+    Log("GatewayLink", "Created " + mapping + " outRings=" + std::to_string(outRings)
+        + " sizeMB=" + std::to_string(MappingBytes(outRings) >> 20));
+    return true;
+}
+
+bool GatewayLink::Attach(const std::string& name)
+{
+    const std::string mapping = MappingName(name);
+    if (!_shm.Open(mapping))
+        return false;
+
+    _hdr = (Header*)_shm.Data();
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    const bool valid = _shm.Size() >= sizeof(Header)
+        && _hdr->magic == LINK_MAGIC
+        && _hdr->version == LINK_VERSION
+        && _hdr->headerSize == sizeof(Header)
+        && _hdr->recordSize == sizeof(Record)
+        && _hdr->inCapacity == LINK_IN_RING_BYTES
+        && _hdr->outCapacity == LINK_OUT_RING_BYTES
+        && _hdr->outRings >= 1 && _hdr->outRings <= LINK_MAX_OUT_RINGS
+        && _shm.Size() >= MappingBytes(_hdr->outRings);
+    if (!valid)
+    {
+        Log("GatewayLink", "Attach rejected (different build?): " + mapping);
+        _hdr = nullptr;
+        _shm.Close();
+        return false;
+    }
+
+    _name = name;
+
+    // 게임 프로세스가 살아 있고 게이트웨이가 없을 때만
+    const uint64 now = NowMs();
+    uint32 idle = (uint32)State::Idle;
+    if (!PeerAlive(Side::Gateway, now) || !_hdr->state.compare_exchange_strong(idle, (uint32)State::AttachRequested))
+    {
+        _hdr = nullptr;
+        _shm.Close();
+        return false;
+    }
+
+    _hdr->gatewayPid.store((uint32)::GetCurrentProcessId(), std::memory_order_relaxed);
+    Beat(Side::Gateway, now);
+
+    if (!BindRings())
+    {
+        Close(Side::Gateway);
+        return false;
+    }
+
+    // 게임 쪽 수신 스레드가 inbound 잔여물을 버리고 Attached로 바꿀 때까지
+    Notify(Side::Game);
+    const auto giveUp = std::chrono::steady_clock::now() + std::chrono::milliseconds(LINK_ATTACH_TIMEOUT_MS);
+    while (GetState() != State::Attached)
+    {
+        if (std::chrono::steady_clock::now() >= giveUp)
+        {
+            uint32 requested = (uint32)State::AttachRequested;
+            _hdr->state.compare_exchange_strong(requested, (uint32)State::Idle);
+            Close(Side::Gateway);
+            return false;
+        }
+        Beat(Side::Gateway, NowMs());
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // 이전 게이트웨이 앞으로 쌓였던 스냅샷은 버림 (그쪽 세션 id)
+    for (uint32 i = 0; i < _outRings; ++i)
+        _out[i].SkipAll();
+
+    Log("GatewayLink", "Attached " + mapping + " gamePid=" + std::to_string(_hdr->gamePid)
+        + " outRings=" + std::to_string(_outRings));
+    return true;
+}
+
+bool GatewayLink::BindRings()
+{
+    _outRings = _hdr->outRings;
+
+    Byte* p = _shm.Data() + sizeof(Header);
+    _in.Bind(p);
+    p += ShmRing::BytesFor(LINK_IN_RING_BYTES);
+    for (uint32 i = 0; i < _outRings; ++i)
+    {
+        _out[i].Bind(p);
+        p += ShmRing::BytesFor(LINK_OUT_RING_BYTES);
+    }
+
+    const std::string mapping = MappingName(_name);
+    return _wake[(size_t)Side::Game].Create(mapping + "-game")
+        && _wake[(size_t)Side::Gateway].Create(mapping + "-gateway");
+}
+
+void GatewayLink::Close(Side self)
+{
+    if (_hdr)
+    {
+        Beat(self, 0);
+
+        // 상대가 자고 있으면 깨워서 바로 끊김을 보게
+        Notify(self == Side::Game ? Side::Gateway : Side::Game);
+        _hdr = nullptr;
+    }
+
+    for (NamedEvent& e : _wake)
+        e.Close();
+
+    _in = ShmRing();
+    for (ShmRing& r : _out)
+        r = ShmRing();
+    _outRings = 0;
+
+    _shm.Close();
+}
+
+void GatewayLink::Beat(Side self, uint64 nowMs)
+{
+    std::atomic<uint64>& beat = self == Side::Game ? _hdr->gameBeatMs : _hdr->gatewayBeatMs;
+    beat.store(nowMs, std::memory_order_relaxed);
+}
+
+bool GatewayLink::PeerAlive(Side self, uint64 nowMs) const
+{
+    const uint64 beat = (self == Side::Game ? _hdr->gatewayBeatMs : _hdr->gameBeatMs).load(std::memory_order_relaxed);
+    return beat != 0 && nowMs < beat + LINK_PEER_TIMEOUT_MS;
+}
+
+void GatewayLink::Notify(Side peer)
+{
+    // 생산자 Commit(tail store) -> waiting load 순서 보장 (Wait 쪽은 waiting store -> tail load)
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (Waiting(peer).load(std::memory_order_relaxed) != 0)
+        _wake[(size_t)peer].Signal();
+}
+
+bool GatewayLink::HasInput(Side self)
+{
+    if (self == Side::Game)
+        return !_in.Empty();
+
+    for (uint32 i = 0; i < _outRings; ++i)
+    {
+        if (!_out[i].Empty())
+            return true;
+    }
+    return false;
+}
+
+void GatewayLink::Wait(Side self, uint32 timeoutMs)
+{
+    std::atomic<uint32>& waiting = Waiting(self);
+    waiting.store(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (!HasInput(self))
+        _wake[(size_t)self].Wait(timeoutMs);
+
+    waiting.store(0, std::memory_order_relaxed);
+}
\ No newline at end of file
@@ -0,0 +1,470 @@
+#include "net/HotRestart.h"
+#include "common/ByteIO.h"
+#include "game/RoomManager.h"
+#include "net/Acceptor.h"
+#include "net/Session.h"
+#include "net/SessionManager.h"
+
+#include <winsock2.h>
+#include <windows.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+static void Log(const std::string& tag, const std::string& msg)
+{
+    std::cout << "[" << tag << "] " << msg << "\n";
+}
+
+static const std::string s_tag = "HotRestart";
+
+static uint64 NowNs()
+{
+    return (uint64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static std::string PipeName(uint16 port)
+{
+    return "\\\\.\\pipe\\GameServer-handoff-" + std::to_string(port);
+}
+
+// 한 방향 전송을 timeout 안에 끝까지 (pipe를 overlapped로 열어서 대기에 한도를 둠 -> 상대가 멈춰도 안 걸림)
+static bool PipeTransfer(HANDLE pipe, bool write, Byte* data, size_t len, uint32 timeoutMs)
+{
+    HANDLE ev = ::CreateEventA(nullptr, TRUE, FALSE, nullptr);
+    if (!ev)
+        return false;
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    size_t done = 0;
+    bool ok = true;
+    while (ok && done < len)
+    {
+        OVERLAPPED ov{};
+        ov.hEvent = ev;
+
+        const DWORD chunk = (DWORD)std::min<size_t>(len - done, 1u << 20);
+        const BOOL issued = write
+            ? ::WriteFile(pipe, data + done, chunk, nullptr, &ov)
+            : ::ReadFile(pipe, data + done, chunk, nullptr, &ov);
+        if (!issued && ::GetLastError() != ERROR_IO_PENDING)
+        {
+            ok = false;
+            break;
+        }
+
+        const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+        DWORD n = 0;
+        if (::WaitForSingleObject(ev, (DWORD)std::max<int64>(0, left)) != WAIT_OBJECT_0)
+        {
+            // 취소가 끝나야 ov를 버릴 수 있음
+            ::CancelIoEx(pipe, &ov);
+            ::GetOverlappedResult(pipe, &ov, &n, TRUE);
+            ok = false;
+            break;
+        }
+
+        if (!::GetOverlappedResult(pipe, &ov, &n, FALSE) || n == 0)
+        {
+            ok = false;
+            break;
+        }
+        done += n;
+    }
+
+    ::CloseHandle(ev);
+    return ok;
+}
+
+// 메시지 = [u32 length][body]
+static bool PipeWrite(HANDLE pipe, ByteBuffer& body)
+{
+    Byte header[4];
+    StoreLE<uint32>(header, (uint32)body.size());
+    return PipeTransfer(pipe, true, header, sizeof(header), HotRestart::HANDOFF_IO_TIMEOUT_MS)
+        && PipeTransfer(pipe, true, body.data(), body.size(), HotRestart::HANDOFF_IO_TIMEOUT_MS);
+}
+
+static bool PipeRead(HANDLE pipe, ByteBuffer& out)
+{
+    Byte header[4];
+    if (!PipeTransfer(pipe, false, header, sizeof(header), HotRestart::HANDOFF_IO_TIMEOUT_MS))
+        return false;
+
+    const uint32 len = LoadLE<uint32>(header);
+    if (len > HotRestart::HANDOFF_MAX_MESSAGE)
+        return false;
+
+    out.resize(len);
+    return PipeTransfer(pipe, false, out.data(), len, HotRestart::HANDOFF_IO_TIMEOUT_MS);
+}
+
+static bool PipeWriteOk(HANDLE pipe, bool ok)
+{
+    ByteBuffer body{ (Byte)(ok ? 1 : 0) };
+    return PipeWrite(pipe, body);
+}
+
+static bool PipeReadOk(HANDLE pipe)
+{
+    ByteBuffer body;
+    return PipeRead(pipe, body) && body.size() == 1 && body[0] == 1;
+}
+
+// 이전 프로세스 쪽: 새 프로세스가 붙을 때까지 waitMs 대기
+static HANDLE ListenPipe(uint16 port, uint32 waitMs)
+{
+    HANDLE pipe = ::CreateNamedPipeA(PipeName(port).c_str(),
+        PIPE_ACCESS_DUPLEX | FILE_FLAG_OVERLAPPED | FILE_FLAG_FIRST_PIPE_INSTANCE,
+        PIPE_TYPE_BYTE | PIPE_READMODE_BYTE | PIPE_WAIT | PIPE_REJECT_REMOTE_CLIENTS,
+        1, 64 * 1024, 64 * 1024, 0, nullptr);
+    if (pipe == INVALID_HANDLE_VALUE)
+        return INVALID_HANDLE_VALUE;
+
+    OVERLAPPED ov{};
+    ov.hEvent = ::CreateEventA(nullptr, TRUE, FALSE, nullptr);
+
+    bool connected = false;
+    if (ov.hEvent && ::ConnectNamedPipe(pipe, &ov))
+    {
+        connected = true;
+    }
+    else if (ov.hEvent)
+    {
+        const DWORD err = ::GetLastError();
+        DWORD n = 0;
+        if (err == ERROR_PIPE_CONNECTED)
+        {
+            connected = true;
+        }
+        else if (err == ERROR_IO_PENDING)
+        {
+            if (::WaitForSingleObject(ov.hEvent, waitMs) == WAIT_OBJECT_0)
+            {
+                connected = ::GetOverlappedResult(pipe, &ov, &n, FALSE) != 0;
+            }
+            else
+            {
+                ::CancelIoEx(pipe, &ov);
+                ::GetOverlappedResult(pipe, &ov, &n, TRUE);
+            }
+        }
+    }
+
+    if (ov.hEvent)
+        ::CloseHandle(ov.hEvent);
+
+    if (!connected)
+    {
+        ::CloseHandle(pipe);
+        return INVALID_HANDLE_VALUE;
+    }
+    return pipe;
+}
+
+// 새 프로세스 쪽: 이전 프로세스가 아직 "handoff" 전이면 pipe가 없음 -> waitMs까지 재시도
+static HANDLE ConnectPipe(uint16 port, uint32 waitMs)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(waitMs);
+    for (;;)
+    {
+        HANDLE pipe = ::CreateFileA(PipeName(port).c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr,
+            OPEN_EXISTING, FILE_FLAG_OVERLAPPED, nullptr);
+        if (pipe != INVALID_HANDLE_VALUE)
+            return pipe;
+
+        if (std::chrono::steady_clock::now() >= deadline)
+            return INVALID_HANDLE_VALUE;
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+}
+
+struct PipeCloser
+{
+    HANDLE h;
+    ~PipeCloser()
+    {
+        if (h != INVALID_HANDLE_VALUE)
+            ::CloseHandle(h);
+    }
+};
+
+static bool DuplicateTo(SOCKET s, DWORD pid, ByteWriter& w)
+{
+    WSAPROTOCOL_INFOW info{};
+    if (::WSADuplicateSocketW(s, pid, &info) != 0)
+    {
+        Log(s_tag, "WSADuplicateSocket failed err=" + std::to_string(::WSAGetLastError()));
+        return false;
+    }
+
+    // 같은 바이너리끼리만 주고받음 (hello에서 버전 확인) -> 구조체 그대로
+    w.WriteBytes((const Byte*)&info, sizeof(info));
+    return true;
+}
+
+static SOCKET SocketFrom(ByteReader& r)
+{
+    const Byte* bytes = nullptr;
+    if (!r.ReadBytes(sizeof(WSAPROTOCOL_INFOW), bytes))
+        return INVALID_SOCKET;
+
+    WSAPROTOCOL_INFOW info;
+    std::memcpy(&info, bytes, sizeof(info));
+    return ::WSASocketW(FROM_PROTOCOL_INFO, FROM_PROTOCOL_INFO, FROM_PROTOCOL_INFO, &info, 0, WSA_FLAG_OVERLAPPED);
+}
+
+bool HotRestart::Handoff(uint16 port, uint32 waitMs, Acceptor& acceptor, SessionManager& sessions, RoomManager& rooms)
+{
+    Log(s_tag, "Waiting for --takeover process on " + PipeName(port) + " (" + std::to_string(waitMs) + "ms)");
+
+    PipeCloser pipe{ ListenPipe(port, waitMs) };
+    if (pipe.h == INVALID_HANDLE_VALUE)
+    {
+        Log(s_tag, "No takeover process, keep serving");
+        return false;
+    }
+
+    // 1) hello: 상태 레이아웃이 다르면 아무것도 멈추기 전에 거절
+    ByteBuffer msg;
+    uint32 magic = 0;
+    uint16 version = 0;
+    uint32 pid = 0;
+    {
+        if (!PipeRead(pipe.h, msg))
+            return false;
+        ByteReader r(msg.data(), msg.size());
+        if (!r.ReadU32LE(magic) || !r.ReadU16LE(version) || !r.ReadU32LE(pid))
+            return false;
+    }
+
+    const bool compatible = magic == HANDOFF_MAGIC && version == HANDOFF_VERSION;
+    PipeWriteOk(pipe.h, compatible);
+    if (!compatible)
+    {
+        Log(s_tag, "Takeover process version " + std::to_string(version) + " != " + std::to_string(HANDOFF_VERSION) + ", keep serving");
+        return false;
+    }
+
+    // 2) 멈춤: 새 세션 -> 방 상태 -> 세션 send 순서 (recv는 계속, 입력은 방 큐에 쌓임)
+    const auto t0 = std::chrono::steady_clock::now();
+    acceptor.Pause();
+    rooms.Freeze();
+    const uint64 frozenAtNs = NowNs();
+
+    std::vector<SessionId> ids;
+    sessions.ForEach([&](const Session& s) { ids.push_back(s.Id()); });
+
+    std::vector<std::shared_ptr<Session>> live;
+    live.reserve(ids.size());
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(HANDOFF_FREEZE_TIMEOUT_MS);
+    bool ok = true;
+    for (SessionId id : ids)
+    {
+        std::shared_ptr<Session> s = sessions.Find(id);
+        if (!s || !s->IsRunning())
+            continue;   // 닫히는 중 -> 새 프로세스로 안 넘김
+
+        live.push_back(s);
+        if (!s->Freeze(deadline))
+        {
+            Log(s_tag, "Session " + std::to_string(id) + " send did not settle");
+            ok = false;
+            break;
+        }
+    }
+
+    // 3) 소켓 복제: listen + 세션 (새 프로세스 pid 앞으로)
+    if (ok)
+    {
+        ByteWriter w;
+        w.WriteU32LE((uint32)live.size());
+        ok = DuplicateTo(acceptor.ListenSocket(), pid, w);
+        for (size_t i = 0; ok && i < live.size(); ++i)
+        {
+            w.WriteU64LE(live[i]->Id());
+            ok = DuplicateTo(live[i]->Socket(), pid, w);
+        }
+
+        ok = ok && PipeWrite(pipe.h, w.buf) && PipeReadOk(pipe.h);
+    }
+
+    if (!ok)
+    {
+        // 아직 핸들을 안 닫았음 -> 그대로 재개
+        for (auto& s : live)
+            s->Thaw();
+        rooms.Resume();
+        acceptor.Resume();
+        Log(s_tag, "Handoff aborted, resumed after "
+            + std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t0).count()) + "ms");
+        return false;
+    }
+
+    // 4) 여기부터 되돌릴 수 없음: recv 멈추고 이 프로세스 핸들만 닫음 (마지막으로 읽은 바이트까지 아래 상태에 들어감)
+    for (auto& s : live)
+        s->Detach();
+
+    // 5) 상태: 세션(길이 붙임 -> 새 프로세스가 못 받은 세션은 건너뜀) + 방
+    ByteWriter state(1 << 20);
+    state.WriteU64LE(frozenAtNs);
+    state.WriteU32LE((uint32)live.size());
+    for (auto& s : live)
+    {
+        ByteWriter one;
+        s->ExportState(one);
+        state.WriteU32LE((uint32)one.Size());
+        state.WriteBytes(one.buf.data(), one.Size());
+    }
+    rooms.ExportState(state);
+
+    const size_t stateBytes = state.Size();
+    const bool delivered = PipeWrite(pipe.h, state.buf) && PipeReadOk(pipe.h);
+
+    // 넘긴 방은 새 프로세스 소유 -> Stop에서 닫거나 FINAL 체크포인트 하지 않음
+    rooms.DiscardRooms();
+
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t0).count();
+    if (!delivered)
+    {
+        // 소켓은 이미 넘어갔으므로 되돌릴 수 없음 (새 프로세스가 받은 만큼만 이어감)
+        Log(s_tag, "State not confirmed by takeover process (sessions=" + std::to_string(live.size()) + ", " + std::to_string(ms) + "ms)");
+        return true;
+    }
+
+    Log(s_tag, "Handed off " + std::to_string(live.size()) + " sessions, state " + std::to_string(stateBytes / 1024) + "KB in " + std::to_string(ms) + "ms");
+    return true;
+}
+
+bool HotRestart::Takeover(uint16 port, uint32 waitMs, Acceptor& acceptor, SessionManager& sessions, RoomManager& rooms)
+{
+    PipeCloser pipe{ ConnectPipe(port, waitMs) };
+    if (pipe.h == INVALID_HANDLE_VALUE)
+    {
+        Log(s_tag, "No running server on " + PipeName(port));
+        return false;
+    }
+
+    {
+        ByteWriter hello;
+        hello.WriteU32LE(HANDOFF_MAGIC);
+        hello.WriteU16LE(HANDOFF_VERSION);
+        hello.WriteU32LE((uint32)::GetCurrentProcessId());
+        if (!PipeWrite(pipe.h, hello.buf) || !PipeReadOk(pipe.h))
+        {
+            Log(s_tag, "Handoff rejected by running server");
+            return false;
+        }
+    }
+
+    // 1) 소켓: 확인(ok)을 보내기 전까지는 이전 프로세스가 되살아날 수 있음
+    //    -> 실패하면 복제본 핸들만 닫음 (shutdown 금지: 같은 연결이라 클라가 끊김)
+    ByteBuffer msg;
+    if (!PipeRead(pipe.h, msg))
+        return false;
+
+    ByteReader sr(msg.data(), msg.size());
+    uint32 count = 0;
+    SOCKET listenSock = INVALID_SOCKET;
+    std::vector<std::pair<SessionId, SOCKET>> socks;
+
+    bool ok = sr.ReadU32LE(count) && count <= sr.Remaining();
+    if (ok)
+    {
+        listenSock = SocketFrom(sr);
+        ok = listenSock != INVALID_SOCKET;
+    }
+    for (uint32 i = 0; ok && i < count; ++i)
+    {
+        SessionId id = 0;
+        ok = sr.ReadU64LE(id);
+        const SOCKET s = ok ? SocketFrom(sr) : INVALID_SOCKET;
+        ok = ok && s != INVALID_SOCKET;
+        if (ok)
+            socks.emplace_back(id, s);
+    }
+
+    if (!ok || !PipeWriteOk(pipe.h, true))
+    {
+        Log(s_tag, "Socket duplication failed err=" + std::to_string(::WSAGetLastError()));
+        PipeWriteOk(pipe.h, false);
+        for (auto& p : socks)
+            ::closesocket(p.second);
+        if (listenSock != INVALID_SOCKET)
+            ::closesocket(listenSock);
+        return false;
+    }
+
+    // 2) 세션 등록 (같은 id). 여기부터는 이 프로세스가 연결 주인
+    std::vector<std::shared_ptr<Session>> adopted(socks.size());
+    std::vector<SessionId> lost;
+    for (size_t i = 0; i < socks.size(); ++i)
+    {
+        adopted[i] = sessions.Adopt(socks[i].second, socks[i].first);
+        if (!adopted[i])
+            lost.push_back(socks[i].first);
+    }
+
+    // 3) 상태: 세션(수신 잔여/send 큐) + 방
+    uint64 frozenAtNs = 0;
+    bool stateOk = PipeRead(pipe.h, msg);
+
+    ByteReader r(msg.data(), stateOk ? msg.size() : 0);
+    uint32 stateCount = 0;
+    stateOk = stateOk && r.ReadU64LE(frozenAtNs) && r.ReadU32LE(stateCount) && stateCount == adopted.size();
+
+    for (uint32 i = 0; stateOk && i < stateCount; ++i)
+    {
+        uint32 len = 0;
+        const Byte* bytes = nullptr;
+        stateOk = r.ReadU32LE(len) && r.ReadBytes(len, bytes);
+        if (!stateOk || !adopted[i])
+            continue;
+
+        ByteReader one(bytes, len);
+        if (!adopted[i]->ImportState(one))
+            Log(s_tag, "Session " + std::to_string(adopted[i]->Id()) + " state dropped");
+    }
+
+    stateOk = stateOk && rooms.ImportState(r);
+    if (!stateOk)
+    {
+        // 연결은 살림: 방 상태 없이 새로 입장한 것처럼
+        Log(s_tag, "State transfer failed, sessions rejoin fresh rooms");
+        for (auto& s : adopted)
+        {
+            if (s)
+                rooms.OnSessionOpened(s->Id());
+        }
+    }
+    for (SessionId id : lost)
+        rooms.OnSessionClosed(id);
+
+    // 4) 재개: tick -> 세션 I/O -> accept
+    if (!rooms.Start())
+        return false;
+
+    size_t started = 0;
+    for (auto& s : adopted)
+    {
+        if (!s)
+            continue;
+        s->Start();
+        ++started;
+    }
+
+    acceptor.Adopt(listenSock, port);
+
+    const double gapMs = stateOk ? (double)(NowNs() - frozenAtNs) / 1e6 : 0.0;
+    PipeWriteOk(pipe.h, stateOk);
+
+    Log(s_tag, "Took over " + std::to_string(started) + " sessions (lost " + std::to_string(lost.size()) + ")"
+        + (stateOk ? ", gameplay gap " + std::to_string(gapMs) + "ms" : ", without room state"));
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,431 @@
+#include "net/HttpUploader.h"
+#include "common/ThreadPlacement.h"
+
+#include <algorithm>
+#include <iostream>
+
+static void Log(const std::string& tag, const std::string& msg)
+{
+    std::cout << "[" << tag << "] " << msg << "\n";
+}
+
+HttpUploader::HttpUploader()
+{
+    _tag = "HttpUploader";
+}
+
+HttpUploader::~HttpUploader()
+{
+    Stop(0);
+}
+
+bool HttpUploader::Start(const std::string& host, uint16 port)
+{
+    if (_running.load())
+        return false;
+
+    _addr = sockaddr_in{};
+    _addr.sin_family = AF_INET;
+    _addr.sin_port = htons(port);
+
+    if (::inet_pton(AF_INET, host.c_str(), &_addr.sin_addr) != 1)
+    {
+        // 호스트명: 시작 시 1회만 resolve (워커에서 blocking DNS 안 함)
+        addrinfo hints{};
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_STREAM;
+
+        addrinfo* result = nullptr;
+        if (::getaddrinfo(host.c_str(), nullptr, &hints, &result) != 0 || !result)
+        {
+            Log(_tag, "Resolve failed: " + host);
+            return false;
+        }
+        _addr.sin_addr = ((const sockaddr_in*)result->ai_addr)->sin_addr;
+        ::freeaddrinfo(result);
+    }
+
+    _hostHeader = host + ":" + std::to_string(port);
+
+    _running.store(true);
+    _worker = std::thread(&HttpUploader::WorkerLoop, this);
+
+    Log(_tag, "Upload target http://" + _hostHeader);
+    return true;
+}
+
+void HttpUploader::Stop(uint32 drainMs)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        // 멱등
+        if (!_running.exchange(false))
+            return;
+
+        _drainUntil = Clock::now() + std::chrono::milliseconds(drainMs);
+    }
+    _cv.notify_one();
+
+    if (_worker.joinable())
+        _worker.join();
+
+    // drain 시간 안에 못 보낸 것
+    size_t left = 0;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        left = _queued.size();
+        _stats.dropped += left;
+        _queued.clear();
+    }
+
+    Log(_tag, "Stopped (unsent=" + std::to_string(left) + ")");
+}
+
+void HttpUploader::Post(uint64 key, const std::string& path, ByteBuffer&& body)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_running.load())
+            return;
+
+        ++_stats.posted;
+
+        auto it = _queued.find(key);
+        if (it != _queued.end())
+        {
+            // 아직 안 보낸 이전 body는 의미 없음 -> 최신으로 교체
+            // notBefore는 유지 (backoff 중이면 새 body도 같이 기다림)
+            ++_stats.coalesced;
+            it->second.path = path;
+            it->second.body = std::move(body);
+            it->second.attempts = 0;
+        }
+        else
+        {
+            Job job;
+            job.key = key;
+            job.path = path;
+            job.body = std::move(body);
+            job.notBefore = Clock::now();
+            _queued.emplace(key, std::move(job));
+        }
+    }
+    _cv.notify_one();
+}
+
+HttpUploader::Stats HttpUploader::TakeStats()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    Stats s = _stats;
+    _stats = Stats{};
+    return s;
+}
+
+void HttpUploader::WorkerLoop()
+{
+    ThreadPlacement::Pin(ThreadRole::Helper, 1);
+
+    std::vector<WSAPOLLFD> pfds;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+
+            const auto now = Clock::now();
+            if (!_running.load() && ((_queued.empty() && _conns.empty()) || now >= _drainUntil))
+                break;
+
+            if (_conns.empty())
+            {
+                // 진행 중인 요청이 없으면 다음 재시도 시각이나 새 Post까지 잠듦
+                auto wakeAt = now + std::chrono::milliseconds(100);
+                for (const auto& kv : _queued)
+                    wakeAt = std::min(wakeAt, kv.second.notBefore);
+
+                if (wakeAt > now)
+                {
+                    _cv.wait_until(lock, wakeAt);
+                    continue;
+                }
+            }
+        }
+
+        StartReadyJobs(Clock::now());
+        if (_conns.empty())
+            continue;
+
+        pfds.resize(_conns.size());
+        for (size_t i = 0; i < _conns.size(); ++i)
+        {
+            pfds[i].fd = _conns[i].sock;
+            pfds[i].events = _conns[i].state == ConnState::Receiving ? POLLRDNORM : POLLWRNORM;
+            pfds[i].revents = 0;
+        }
+
+        if (::WSAPoll(pfds.data(), (ULONG)pfds.size(), HTTP_POLL_TIMEOUT_MS) == SOCKET_ERROR)
+        {
+            Log(_tag, "WSAPoll failed");
+            for (Conn& c : _conns)
+                Finish(c, 0, "poll failed");
+        }
+        else
+        {
+            const auto now = Clock::now();
+            for (size_t i = 0; i < _conns.size(); ++i)
+            {
+                Conn& c = _conns[i];
+                const short rev = pfds[i].revents;
+
+                int status = 0;
+                bool finished = false;
+                const char* reason = nullptr;
+
+                if (c.state != ConnState::Receiving && (rev & (POLLERR | POLLHUP | POLLNVAL)))
+                {
+                    finished = true;
+                    reason = "connect/send failed";
+                }
+                else if (rev & POLLWRNORM)
+                {
+                    finished = OnWritable(c);
+                }
+                else if (rev & (POLLRDNORM | POLLHUP | POLLERR))
+                {
+                    finished = OnReadable(c, status);
+                }
+
+                // 연결 실패를 WSAPoll이 못 알려주는 구버전 Windows도 여기서 걸림
+                if (!finished && now >= c.deadline)
+                {
+                    finished = true;
+                    reason = "timeout";
+                }
+
+                if (finished)
+                    Finish(c, status, reason);
+            }
+        }
+
+        _conns.erase(std::remove_if(_conns.begin(), _conns.end(), [](const Conn& c) { return c.done; }), _conns.end());
+    }
+
+    for (Conn& c : _conns)
+        ::closesocket(c.sock);
+    _conns.clear();
+}
+
+void HttpUploader::StartReadyJobs(Clock::time_point now)
+{
+    const size_t first = _conns.size();
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        for (auto it = _queued.begin(); it != _queued.end() && _conns.size() < HTTP_MAX_CONNECTIONS;)
+        {
+            // 같은 key는 한 번에 하나만 (순서 뒤집힘 방지)
+            const uint64 key = it->first;
+            const bool inFlight = std::any_of(_conns.begin(), _conns.end(), [key](const Conn& c) { return c.job.key == key; });
+            if (inFlight || it->second.notBefore > now)
+            {
+                ++it;
+                continue;
+            }
+
+            Conn c;
+            c.job = std::move(it->second);
+            it = _queued.erase(it);
+            _conns.push_back(std::move(c));
+        }
+    }
+
+    for (size_t i = first; i < _conns.size(); ++i)
+    {
+        if (!BeginConn(_conns[i]))
+            Finish(_conns[i], 0, "connect failed");
+    }
+
+    _conns.erase(std::remove_if(_conns.begin() + first, _conns.end(), [](const Conn& c) { return c.done; }), _conns.end());
+}
+
+bool HttpUploader::BeginConn(Conn& c)
+{
+    const std::string head =
+        "POST " + c.job.path + " HTTP/1.1\r\n"
+        "Host: " + _hostHeader + "\r\n"
+        "Content-Type: application/octet-stream\r\n"
+        "Content-Length: " + std::to_string(c.job.body.size()) + "\r\n"
+        "Connection: close\r\n"
+        "\r\n";
+
+    // 재시도 때 다시 써야 하므로 body는 job에 남겨두고 복사
+    c.request.clear();
+    c.request.reserve(head.size() + c.job.body.size());
+    c.request.insert(c.request.end(), head.begin(), head.end());
+    c.request.insert(c.request.end(), c.job.body.begin(), c.job.body.end());
+    c.sentBytes = 0;
+    c.response.clear();
+    c.deadline = Clock::now() + std::chrono::milliseconds(HTTP_REQUEST_TIMEOUT_MS);
+
+    c.sock = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (c.sock == INVALID_SOCKET)
+        return false;
+
+    u_long nonBlocking = 1;
+    if (::ioctlsocket(c.sock, FIONBIO, &nonBlocking) == SOCKET_ERROR)
+        return false;
+
+    if (::connect(c.sock, (const sockaddr*)&_addr, sizeof(_addr)) == SOCKET_ERROR)
+    {
+        if (::WSAGetLastError() != WSAEWOULDBLOCK)
+            return false;
+
+        c.state = ConnState::Connecting;
+        return true;
+    }
+
+    c.state = ConnState::Sending;
+    return true;
+}
+
+bool HttpUploader::OnWritable(Conn& c)
+{
+    if (c.state == ConnState::Connecting)
+    {
+        int err = 0;
+        int len = sizeof(err);
+        if (::getsockopt(c.sock, SOL_SOCKET, SO_ERROR, (char*)&err, &len) == SOCKET_ERROR || err != 0)
+            return true;
+
+        c.state = ConnState::Sending;
+    }
+
+    while (c.sentBytes < c.request.size())
+    {
+        const int n = ::send(c.sock, (const char*)c.request.data() + c.sentBytes, (int)(c.request.size() - c.sentBytes), 0);
+        if (n > 0)
+        {
+            c.sentBytes += (size_t)n;
+            continue;
+        }
+
+        if (n == SOCKET_ERROR && ::WSAGetLastError() == WSAEWOULDBLOCK)
+            return false;   // 송신 버퍼 참 -> 다음 POLLWRNORM
+
+        return true;
+    }
+
+    c.state = ConnState::Receiving;
+    return false;
+}
+
+bool HttpUploader::OnReadable(Conn& c, int& status)
+{
+    char buf[1024];
+
+    while (true)
+    {
+        const int n = ::recv(c.sock, buf, (int)sizeof(buf), 0);
+        if (n > 0)
+        {
+            c.response.append(buf, (size_t)n);
+
+            // 상태 줄만 있으면 됨 -> 헤더 끝까지 받으면 종료 (body는 안 읽음)
+            if (c.response.find("\r\n\r\n") != std::string::npos || c.response.size() >= HTTP_MAX_RESPONSE_BYTES)
+            {
+                status = ParseStatus(c.response);
+                return true;
+            }
+            continue;
+        }
+
+        if (n == 0)
+        {
+            // 서버가 먼저 닫음 (받은 데까지로 판정)
+            status = ParseStatus(c.response);
+            return true;
+        }
+
+        if (::WSAGetLastError() == WSAEWOULDBLOCK)
+            return false;
+
+        return true;
+    }
+}
+
+void HttpUploader::Finish(Conn& c, int status, const char* reason)
+{
+    if (c.sock != INVALID_SOCKET)
+    {
+        ::closesocket(c.sock);
+        c.sock = INVALID_SOCKET;
+    }
+    c.done = true;
+    c.request.clear();
+
+    std::string dropReason;
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (status >= 200 && status < 300)
+        {
+            ++_stats.succeeded;
+            _stats.bytesSent += c.job.body.size();
+            return;
+        }
+
+        // 실패했지만 그새 새 body가 들어옴 -> 이전 것은 재시도할 필요 없음
+        if (_queued.count(c.job.key) != 0)
+        {
+            ++_stats.coalesced;
+            return;
+        }
+
+        // 4xx는 재시도해도 같음 (요청 자체가 잘못됨)
+        const bool retryable = status == 0 || status >= 500;
+        ++c.job.attempts;
+
+        if (!retryable || c.job.attempts >= HTTP_MAX_ATTEMPTS)
+        {
+            ++_stats.dropped;
+            dropReason = reason ? reason : ("status " + std::to_string(status));
+        }
+        else
+        {
+            ++_stats.retries;
+
+            const uint32 shift = std::min<uint32>(c.job.attempts - 1, 16);
+            const uint32 backoffMs = std::min<uint32>(HTTP_RETRY_BASE_MS << shift, HTTP_RETRY_MAX_MS);
+            c.job.notBefore = Clock::now() + std::chrono::milliseconds(backoffMs);
+
+            const uint64 key = c.job.key;
+            _queued.emplace(key, std::move(c.job));
+        }
+    }
+
+    if (!dropReason.empty())
+        Log(_tag, "Give up key=" + std::to_string(c.job.key) + " after " + std::to_string(c.job.attempts) + " attempt(s): " + dropReason);
+}
+
+int HttpUploader::ParseStatus(const std::string& response)
+{
+    // "HTTP/1.1 200 OK"
+    if (response.compare(0, 5, "HTTP/") != 0)
+        return 0;
+
+    const size_t sp = response.find(' ');
+    if (sp == std::string::npos || sp + 4 > response.size())
+        return 0;
+
+    int code = 0;
+    for (size_t i = sp + 1; i < sp + 4; ++i)
+    {
+        if (response[i] < '0' || response[i] > '9')
+            return 0;
+        code = code * 10 + (response[i] - '0');
+    }
+    return code;
+}
\ No newline at end of file
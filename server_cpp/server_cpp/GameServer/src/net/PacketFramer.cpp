@@ -1,18 +1,58 @@
 #include "net/PacketFramer.h"
-#include <algorithm>
+#include "net/RecvBlockPool.h"
+
+#include <cstring>
+#include <new>
+
+PacketFramer::~PacketFramer()
+{
+    ReleaseBlock();
+}
+
+Byte* PacketFramer::WritePtr(size_t& space)
+{
+    if (!_block)
+    {
+        _block = _pool ? _pool->Acquire() : (Byte*)::operator new(RECV_BLOCK_BYTES, std::nothrow);
+        if (!_block)
+        {
+            SetError(FrameError::OutOfMemory, "recv block allocation failed");
+            space = 0;
+            return nullptr;
+        }
+        _begin = 0;
+        _end = 0;
+    }
+    else if (_begin > 0)
+    {
+        // 덜 된 프레임을 앞으로 (< MAX_FRAME_TOTAL바이트)
+        std::memmove(_block, _block + _begin, _end - _begin);
+        _end -= _begin;
+        _begin = 0;
+    }
+
+    space = RECV_BLOCK_BYTES - _end;
+    return _block + _end;
+}
 
 bool PacketFramer::Append(const Byte* data, size_t len)
 {
     if (len == 0) return true;
 
-    // overflow / abuse : push   üũ
-    if (_buf.size() + len > MAX_RECV_BUFFER)
+    size_t space = 0;
+    Byte* dst = WritePtr(space);
+    if (!dst)
+        return false;
+
+    // overflow / abuse 방지: 프레임 1개 이상이 남아 있을 수는 없음
+    if (len > space)
     {
-        SetError(FrameError::RecvBufferTooLarge, "recv buffer exceeded MAX_RECV_BUFFER");
+        SetError(FrameError::RecvBufferTooLarge, "appended bytes exceed RECV_BLOCK_BYTES");
         return false;
     }
 
-    _buf.insert(_buf.end(), data, data + len);
+    std::memcpy(dst, data, len);
+    Commit(len);
     return true;
 }
 
@@ -20,11 +60,14 @@ PopResult PacketFramer::TryPopFrame(Frame& outFrame)
 {
     outFrame = Frame{}; // reset
 
-    // ּ length(2Ʈ)   ʿ
-    if (_buf.size() < 2)
+    const size_t avail = BufferedSize();
+
+    // 최소 length(2바이트) 없으면 더 필요
+    if (avail < 2)
         return PopResult::NeedMore;
 
-    const uint16 length = PeekU16LE(_buf, 0); // msg_id(2) + payload
+    const Byte* p = _block + _begin;
+    const uint16 length = PeekU16LE(p); // msg_id(2) + payload
 
     if (length < 2)
     {
@@ -32,57 +75,59 @@ PopResult PacketFramer::TryPopFrame(Frame& outFrame)
         return PopResult::Error;
     }
 
-    const size_t total = 2u + static_cast<size_t>(length); // length field  ü
+    const size_t total = 2u + static_cast<size_t>(length); // length field 포함 전체
     if (total > MAX_FRAME_TOTAL)
     {
         SetError(FrameError::FrameTooLarge, "frame total size exceeded MAX_FRAME_TOTAL");
         return PopResult::Error;
     }
 
-    if (_buf.size() < total)
+    if (avail < total)
         return PopResult::NeedMore;
 
-    // msg_id б (length  2Ʈ)
-    const MsgId msgId = PeekU16LE(_buf, 2);
-    const size_t payloadLen = static_cast<size_t>(length) - 2u;
+    // payload 시작 오프셋: 2(length) + 2(msg_id) = 4
+    outFrame.msgId = PeekU16LE(p + 2);
+    outFrame.payload = p + 4;
+    outFrame.payloadLen = static_cast<size_t>(length) - 2u;
 
-    outFrame.msgId = msgId;
-    outFrame.payload.resize(payloadLen);
-
-    if (payloadLen > 0)
-    {
-        // payload  : 2(length) + 2(msg_id) = 4
-        std::copy(_buf.begin() + 4, _buf.begin() + 4 + payloadLen, outFrame.payload.begin());
-    }
-
-    Consume(total);
+    _begin += (uint32)total;
     return PopResult::Ok;
 }
 
+void PacketFramer::ReleaseIfEmpty()
+{
+    if (_block && _begin == _end)
+        ReleaseBlock();
+}
+
 void PacketFramer::Clear()
 {
-    _buf.clear();
+    ReleaseBlock();
     _lastError = FrameError::None;
-    _lastErrorMsg.clear();
+    _lastErrorMsg = "";
 }
 
-uint16 PacketFramer::PeekU16LE(const ByteBuffer& buf, size_t off)
+uint16 PacketFramer::PeekU16LE(const Byte* p)
 {
-    // ȣο   Ȯ Ѵٰ 
-    const uint16 lo = static_cast<uint16>(buf[off]);
-    const uint16 hi = static_cast<uint16>(buf[off + 1]);
+    // 호출부에서 충분한 길이 확인을 보장한다고 가정
+    const uint16 lo = static_cast<uint16>(p[0]);
+    const uint16 hi = static_cast<uint16>(p[1]);
     return static_cast<uint16>(lo | (hi << 8));
 }
 
-void PacketFramer::Consume(size_t n)
+void PacketFramer::ReleaseBlock()
 {
-    if (n == 0) return;
-    if (n >= _buf.size())
-    {
-        _buf.clear();
+    if (!_block)
         return;
-    }
-    _buf.erase(_buf.begin(), _buf.begin() + static_cast<std::ptrdiff_t>(n));
+
+    if (_pool)
+        _pool->Release(_block);
+    else
+        ::operator delete(_block);
+
+    _block = nullptr;
+    _begin = 0;
+    _end = 0;
 }
 
 void PacketFramer::SetError(FrameError err, const char* msg)
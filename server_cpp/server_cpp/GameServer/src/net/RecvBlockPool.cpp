@@ -0,0 +1,68 @@
+#include "net/RecvBlockPool.h"
+
+#include <new>
+
+RecvBlockPool::~RecvBlockPool()
+{
+    // 세션이 들고 있던 블록은 세션(PacketFramer) 소멸 때 먼저 돌아와 있어야 함
+    while (_free)
+    {
+        FreeBlock* next = _free->next;
+        ::operator delete(_free);
+        _free = next;
+    }
+}
+
+Byte* RecvBlockPool::Acquire()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_free)
+        {
+            FreeBlock* b = _free;
+            _free = b->next;
+            --_freeCount;
+            _inUse.fetch_add(1, std::memory_order_relaxed);
+            return (Byte*)b;
+        }
+    }
+
+    void* p = ::operator new(RECV_BLOCK_BYTES, std::nothrow);
+    if (!p)
+        return nullptr;
+
+    _allocs.fetch_add(1, std::memory_order_relaxed);
+    _inUse.fetch_add(1, std::memory_order_relaxed);
+    return (Byte*)p;
+}
+
+void RecvBlockPool::Release(Byte* block)
+{
+    if (!block)
+        return;
+
+    _inUse.fetch_sub(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_freeCount < RECV_POOL_MAX_FREE)
+        {
+            FreeBlock* b = (FreeBlock*)block;
+            b->next = _free;
+            _free = b;
+            ++_freeCount;
+            return;
+        }
+    }
+    ::operator delete(block);
+}
+
+RecvBlockPool::Stats RecvBlockPool::GetStats() const
+{
+    Stats s;
+    s.inUse = _inUse.load(std::memory_order_relaxed);
+    s.allocs = _allocs.load(std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    s.free = _freeCount;
+    return s;
+}
\ No newline at end of file
@@ -1,225 +1,989 @@
 #include "net/Session.h"
 #include "common/ByteIO.h"
+#include "common/ServerClock.h"
+#include "net/SessionIo.h"
+#include "net/UdpTransport.h"
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <thread>
 
-static constexpr MsgId C_Ping = 1101;
-static constexpr MsgId S_Pong = 1102;
+// 세션이 직접 처리하는 메시지 (여기 없는 msgId는 Tier1 정책상 disconnect)
+using SessionDispatcher = Dispatcher<Session, C_Ping, C_Pong, C_UdpOpenReq, C_SpectateReq, C_MoveInput, C_CastSkill, C_ChoiceVote>;
+
+// UDP 데이터그램으로 받는 건 게임 입력만 (응답이 필요한 메시지는 TCP로)
+using UdpInputDispatcher = Dispatcher<Session, C_MoveInput, C_CastSkill, C_ChoiceVote>;
+
+// 조용한 세션 예산의 나머지: make_shared 제어 블록, 슬롯맵 자리, 풀/epoch 몫 (--bench-idle로 실측)
+static_assert(sizeof(Session) <= SESSION_IDLE_BUDGET_BYTES / 2, "Session object exceeds half of SESSION_IDLE_BUDGET_BYTES");
 
 static void Log(const std::string& tag, const std::string& msg)
 {
     std::cout << "[" << tag << "] " << msg << "\n";
 }
 
-Session::Session(SOCKET sock, SessionId id, OnCloseFn onClose) : _sock(sock), _onClose(std::move(onClose)), _id(id)
+Session::Session(SOCKET sock, SessionId id, SessionIo* io, const OnCloseFn* onClose, const SessionInputHooks* inputHooks, UdpTransport* udp)
+    : _id(id), _io(io), _onClose(onClose), _inputHooks(inputHooks), _sock(sock), _framer(io ? &io->RecvPool() : nullptr), _udp(udp)
 {
-    _tag = "Session #" + std::to_string(_id);
+}
+
+Session::~Session()
+{
+    // 마지막 참조는 epoch 회수(임의 스레드) 또는 I/O 완료 처리 끝에서 끊김
+    // 걸린 I/O가 있으면 _recvRef/_sendRef가 참조를 들고 있으므로 여기선 없음
+    RequestStop();
+
+    while (_sendHead)
+    {
+        SendNode* next = _sendHead->next;
+        delete _sendHead;
+        _sendHead = next;
+    }
+    delete _sending;
+
+    if (_sock != INVALID_SOCKET)
+    {
+        ::closesocket(_sock);
+        _sock = INVALID_SOCKET;
+    }
 }
 
 void Session::Start()
 {
     if (_running.exchange(true)) return;
 
-    _recvThread = std::thread(&Session::RecvLoop, this);
-    _sendThread = std::thread(&Session::SendLoop, this);
+    // 0바이트 수신 완료 뒤엔 쌓인 만큼만 non-blocking recv (I/O 스레드가 한 세션에 막히지 않게)
+    u_long nonBlocking = 1;
+    if (!_io || ::ioctlsocket(_sock, FIONBIO, &nonBlocking) != 0 || !_io->Associate(_sock, this))
+    {
+        Log(Tag(), "IOCP associate failed err=" + std::to_string(::WSAGetLastError()) + " -> disconnect");
+        _running.store(false, std::memory_order_relaxed);
+        ShutdownSocket();
+        if (_onClose && *_onClose)
+            (*_onClose)(_id);
+        return;
+    }
+
+    Log(Tag(), "Started");
+
+    // Start 전에 들어온 프레임 (인계받은 큐, Disconnect)
+    bool issue = false;
+    {
+        std::lock_guard<std::mutex> lock(_sendMutex);
+        issue = TakeNextSend();
+    }
+    if (issue)
+        IssueSend();
+
+    // 걸어 둔 I/O가 자기 참조를 들고 있음 -> 매니저에서 빠져도 완료 처리 도중 소멸하지 않음
+    PostRecv(shared_from_this());
 }
 
 void Session::Stop()
 {
     RequestStop();
 
-    // ܺο ȣϸ  join
-    if (_recvThread.joinable())
-        _recvThread.join();
-    if (_sendThread.joinable())
-        _sendThread.join();
+    // 걸린 I/O는 취소됐으므로 완료가 곧 옴 (완료 스레드가 돌고 있어야 함)
+    if (!_io || !_io->IsRunning())
+        return;
+
+    for (;;)
+    {
+        bool sendBusy = false;
+        {
+            std::lock_guard<std::mutex> lock(_sendMutex);
+            sendBusy = _sendBusy;
+        }
+        if (!sendBusy && !_recvPending.load(std::memory_order_acquire))
+            break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
 }
 
 void Session::RequestStop()
 {
-    // /ܺ 𼭵 ȣ  ()
+    // 내부/외부 어디서든 호출 가능 (멱등)
     _running.store(false, std::memory_order_relaxed);
 
-    // send thread  ->  send    (wait   Ȯ  ť  break ->  )
-    _sendCv.notify_all();
-
-    // recv    ݱ(ؾ )
-    CloseSocket();
+    // 걸린 수신/송신을 끝내기 위해 소켓 shutdown + 취소 (멱등해야 함)
+    ShutdownSocket();
 }
 
-bool Session::SendFrame(MsgId msgId, const Byte* payload, size_t payloadLen)
+bool Session::SendFrame(MsgId msgId, const Byte* payload, size_t payloadLen, SendKind kind)
 {
     if (!_running.load(std::memory_order_relaxed))
         return false;
 
-    ByteBuffer frame = BuildFrame(msgId, payload, payloadLen);
+    return SendRawFrame(BuildFrame(msgId, payload, payloadLen), kind);
+}
 
+uint32 Session::DropQueuedSnapshots()
+{
+    uint32 dropped = 0;
+    SendNode* prev = nullptr;
+    for (SendNode* n = _sendHead; n;)
     {
-        std::lock_guard<std::mutex> lock(_sendMutex);
-        _sendQ.emplace_back(std::move(frame));
+        SendNode* next = n->next;
+        if (n->kind == SendKind::Snapshot)
+        {
+            (prev ? prev->next : _sendHead) = next;
+            if (_sendTail == n)
+                _sendTail = prev;
+            _sendQBytes -= n->Size();
+            --_sendQFrames;
+            delete n;
+            ++dropped;
+        }
+        else
+        {
+            prev = n;
+        }
+        n = next;
     }
+    return dropped;
+}
 
-    _sendCv.notify_one();
-    return true;
+bool Session::SendRawFrame(ByteBuffer&& frame, SendKind kind)
+{
+    if (!_running.load(std::memory_order_relaxed) || frame.empty())
+        return false;
+
+    SendNode* node = new SendNode;
+    node->kind = kind;
+    node->bytes = std::move(frame);
+
+    uint32 dropped = 0;
+    return Enqueue(node, dropped);
 }
 
-void Session::RecvLoop()
+bool Session::SendSharedFrame(std::shared_ptr<const ByteBuffer> frame, uint32& skipped)
 {
-    Log(_tag, "RecvLoop started");
+    skipped = 0;
+    if (!_running.load(std::memory_order_relaxed) || !frame || frame->empty())
+        return false;
 
-    Byte temp[4096];
+    SendNode* node = new SendNode;
+    node->kind = SendKind::Snapshot;
+    node->shared = std::move(frame);
+    return Enqueue(node, skipped);
+}
+
+bool Session::Enqueue(SendNode* node, uint32& dropped)
+{
+    const char* overflowReason = nullptr;
+    uint32 discarded = 0;
+    bool issue = false;
 
-    while (_running.load(std::memory_order_relaxed))
     {
-        int n = ::recv(_sock, (char*)temp, (int)sizeof(temp), 0);
-        if (n > 0)
+        std::lock_guard<std::mutex> lock(_sendMutex);
+
+        // S_Disconnect 뒤로는 아무것도 안 보냄
+        if (_closing)
         {
-            OnRecv(temp, (size_t)n);
+            delete node;
+            return false;
+        }
+
+        // 1) 이전 스냅샷은 새 스냅샷으로 대체 (이미 send 중인 건 큐에 없으므로 안전)
+        if (node->kind == SendKind::Snapshot)
+        {
+            dropped = DropQueuedSnapshots();
+            _droppedSnapshots += dropped;
+        }
+
+        _sendQBytes += node->Size();
+        ++_sendQFrames;
+        (_sendTail ? _sendTail->next : _sendHead) = node;
+        _sendTail = node;
+
+        // 2) 예산 검사: 남은 건 최신 스냅샷 1개 + reliable뿐이라 더 버릴 수 없음
+        //    -> 초과 상태가 일정 시간 이어지면 느린 클라로 보고 끊기
+        const bool over = _sendQBytes > MAX_SEND_QUEUE_BYTES || _sendQFrames > MAX_SEND_QUEUE_FRAMES;
+        if (!over)
+        {
+            _overflowing = false;
         }
         else
         {
-            // n == 0:  , n < 0: 
-            break;
+            ++_overflowEnqueues;
+
+            const auto now = std::chrono::steady_clock::now();
+            if (!_overflowing)
+            {
+                _overflowing = true;
+                _overflowSince = now;
+            }
+
+            const auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(now - _overflowSince).count();
+            if (_sendQBytes > SEND_QUEUE_HARD_LIMIT_BYTES)
+                overflowReason = "send queue hard limit exceeded";
+            else if (elapsedMs >= SEND_OVERFLOW_DISCONNECT_MS)
+                overflowReason = "send queue overflow sustained";
         }
+
+        // 못 따라오는 클라: 쌓인 건 어차피 못 보냄 -> 버리고 이유만 (보내던 프레임 바로 뒤, 그것도 안 나가면 타이머가 끊음)
+        if (overflowReason)
+            issue = QueueDisconnect(DisconnectReason::SlowConsumer, true, discarded);
+        else
+            issue = TakeNextSend();
     }
 
-    //  
-    _running.store(false, std::memory_order_relaxed);
-    _sendCv.notify_all(); // send loop 
+    if (overflowReason)
+    {
+        Log(Tag(), std::string("Slow consumer: ") + overflowReason + " -> disconnect (dropped " + std::to_string(discarded) + " queued frames)");
+        if (issue)
+            IssueSend();
+        return false;
+    }
+
+    if (issue)
+        IssueSend();
+    return true;
+}
 
-    CloseSocket();
+void Session::Disconnect(DisconnectReason reason)
+{
+    bool issue = false;
+    {
+        std::lock_guard<std::mutex> lock(_sendMutex);
+        if (_closing)
+            return;
 
-    Log(_tag, "RecvLoop ended");
+        uint32 dropped = 0;
+        issue = QueueDisconnect(reason, false, dropped);
+    }
 
-    //   ˸
-    if (_onClose)
-        _onClose(_id);
+    Log(Tag(), "Disconnect (reason=" + std::to_string((uint16)reason) + ")");
+    if (issue)
+        IssueSend();
 }
 
-void Session::SendLoop()
+bool Session::QueueDisconnect(DisconnectReason reason, bool dropAll, uint32& dropped)
 {
-    Log(_tag, "SendLoop started");
+    if (_closing)
+        return false;
 
-    for (;;)
+    // 클라가 이유를 먼저 받게 스냅샷은 버림 (reliable은 순서대로 다 나감, dropAll이면 그것도 버림)
+    if (dropAll)
     {
-        ByteBuffer toSend;
+        while (_sendHead)
+        {
+            SendNode* next = _sendHead->next;
+            delete _sendHead;
+            _sendHead = next;
+            ++dropped;
+        }
+        _sendTail = nullptr;
+        _sendQBytes = 0;
+        _sendQFrames = 0;
+    }
+    else
+    {
+        dropped += DropQueuedSnapshots();
+    }
+
+    SendNode* node = new SendNode;
+    node->bytes.resize(FixedCodec<S_Disconnect>::FRAME_SIZE);
+    FixedCodec<S_Disconnect>::EncodeFrame(S_Disconnect{ (uint16)reason }, node->bytes.data());
+    _sendQBytes += node->Size();
+    ++_sendQFrames;
+    (_sendTail ? _sendTail->next : _sendHead) = node;
+    _sendTail = node;
+    _closing = true;
+    _closeByMs.store(ServerTimeUs() / 1000 + DISCONNECT_LINGER_MS, std::memory_order_relaxed);
+
+    return TakeNextSend();
+}
 
+bool Session::SendSnapshotFrame(const ByteBuffer& frame)
+{
+    const uint64 peer = _udpPeer.load(std::memory_order_acquire);
+    if (peer != 0)
+    {
+        const uint64 nowMs = ServerTimeUs() / 1000;
+        if (nowMs - _udpLastRecvMs.load(std::memory_order_relaxed) <= UdpTransport::UDP_PEER_TIMEOUT_MS)
         {
-            std::unique_lock<std::mutex> lock(_sendMutex);
+            // 송신 실패(버퍼 참)도 유실과 같게 취급 (다음 스냅샷이 덮음)
+            _udp->SendSnapshot(peer, _udpSeq.fetch_add(1, std::memory_order_relaxed) + 1, frame);
+            return true;
+        }
 
-            // ť   running̸ 
-            _sendCv.wait(lock, [&] {
-                return !_sendQ.empty() || !_running.load(std::memory_order_relaxed);
-                });
+        // 클라 UDP가 끊긴 것으로 봄 (NAT 만료/방화벽) -> TCP로. 인코더 여럿 중 하나만 로그
+        uint64 expected = peer;
+        if (_udpPeer.compare_exchange_strong(expected, 0, std::memory_order_relaxed))
+            Log(Tag(), "UDP peer silent -> snapshots back on TCP");
+    }
 
-            // running=falsḛ  ͵  
-            if (_sendQ.empty() && !_running.load(std::memory_order_relaxed))
-                break;
+    return SendRawFrame(ByteBuffer(frame), SendKind::Snapshot);
+}
 
-            // ϳ 
-            if (!_sendQ.empty())
-            {
-                toSend = std::move(_sendQ.front());
-                _sendQ.pop_front();
-            }
-        }
+bool Session::OnUdpDatagram(uint64 token, uint64 peer, uint8 count, const Byte* frames, size_t len)
+{
+    // token을 발급한 세션만, TCP와 같은 IP에서 온 것만 (token이 새도 남의 주소로 스냅샷을 돌리지 못하게)
+    const uint64 expectToken = _udpToken.load(std::memory_order_acquire);
+    if (expectToken == 0 || token != expectToken || UdpTransport::PeerAddr(peer) != _udpAddr.load(std::memory_order_relaxed))
+        return false;
 
-        if (!toSend.empty())
-        {
-            //  send send thread ܵ  =>   
-            if (!SendAll(toSend.data(), toSend.size()))
-            {
-                // send и  û
-                RequestStop();
-                break;
-            }
-        }
+    _udpLastRecvMs.store(ServerTimeUs() / 1000, std::memory_order_relaxed);
+
+    // 첫 데이터그램 또는 포트가 바뀜(NAT 재바인딩) -> 이 주소로 보냄
+    const uint64 prev = _udpPeer.exchange(peer, std::memory_order_release);
+    if (prev == 0)
+    {
+        Log(Tag(), "UDP bound -> snapshots over UDP");
+        Send(S_UdpBound{ (uint16)UdpTransport::UDP_MAX_SEND });
     }
 
-    Log(_tag, "SendLoop ended");
+    // 입력 프레임: TCP와 같은 [len][msgId][payload]. 틀린 게 있으면 나머지는 버림 (UDP는 끊지 않음)
+    size_t off = 0;
+    for (uint8 i = 0; i < count; ++i)
+    {
+        if (len - off < 4)
+            return false;
+
+        const uint16 frameLen = LoadLE<uint16>(frames + off);
+        if (frameLen < 2 || len - off - 2 < frameLen)
+            return false;
+
+        const MsgId msgId = LoadLE<uint16>(frames + off + 2);
+        if (UdpInputDispatcher::Dispatch(*this, msgId, frames + off + 4, frameLen - 2u) != DispatchResult::Ok)
+            return false;
+
+        off += 2u + frameLen;
+    }
+    return true;
+}
+
+SendQueueStats Session::GetSendStats() const
+{
+    std::lock_guard<std::mutex> lock(_sendMutex);
+
+    SendQueueStats st;
+    st.queuedBytes = _sendQBytes;
+    st.queuedFrames = _sendQFrames;
+    st.droppedSnapshots = _droppedSnapshots;
+    st.overflowEnqueues = _overflowEnqueues;
+    return st;
+}
+
+void Session::OnIoCompleted(OVERLAPPED* ov, uint32 bytes, bool ok)
+{
+    if (ov == &_recvOv)
+        OnRecvReady(std::move(_recvRef), ok);
+    else
+        OnSendCompleted(bytes, ok);
+}
+
+void Session::PostRecv(std::shared_ptr<Session> self)
+{
+    _recvPending.store(true, std::memory_order_release);
+    _recvRef = std::move(self);
+
+    // 0바이트: 읽을 게 생겼다는 알림만 (버퍼를 안 주므로 조용한 동안 잠긴 메모리 없음)
+    std::memset(&_recvOv, 0, sizeof(_recvOv));
+    WSABUF buf;
+    buf.len = 0;
+    buf.buf = nullptr;
+    DWORD flags = 0;
+    if (::WSARecv(_sock, &buf, 1, nullptr, &flags, &_recvOv, nullptr) == 0 || ::WSAGetLastError() == WSA_IO_PENDING)
+        return;
+
+    // 안 걸렸으면 완료도 안 옴 -> 여기서 정리 (참조는 함수 끝에서 놓음)
+    std::shared_ptr<Session> keep = std::move(_recvRef);
+    EndRecv();
 }
 
-void Session::OnRecv(const Byte* data, size_t len)
+void Session::OnRecvReady(std::shared_ptr<Session> self, bool ok)
 {
-    if (!_framer.Append(data, len))
+    // 인계 중이면 읽지 않음 (소켓 버퍼에 남은 바이트는 새 프로세스가 읽음)
+    if (ok && _running.load(std::memory_order_relaxed) && !_detached.load(std::memory_order_relaxed) && ReadAvailable())
     {
-        Log(_tag, std::string("Framer Append error: ") + _framer.LastErrorMessage());
-        RequestStop();
+        PostRecv(std::move(self));
         return;
     }
 
-    while (_running.load(std::memory_order_relaxed))
+    EndRecv();
+}
+
+bool Session::ReadAvailable()
+{
+    // 완료 1번에 SESSION_RECV_ROUNDS 블록까지만 (더 있으면 다시 건 0바이트 수신이 바로 완료 -> 다른 세션과 번갈아)
+    for (uint32 round = 0; round < SESSION_RECV_ROUNDS; ++round)
     {
-        Frame frame;
-        auto r = _framer.TryPopFrame(frame);
+        size_t space = 0;
+        Byte* dst = _framer.WritePtr(space);
+        if (!dst)
+        {
+            Log(Tag(), std::string("Framer error: ") + _framer.LastErrorMessage());
+            RequestStop();
+            return false;
+        }
 
-        if (r == PopResult::Ok)
+        const int n = ::recv(_sock, (char*)dst, (int)space, 0);
+        if (n == 0)
+            return false;   // 정상 종료
+
+        if (n < 0)
         {
+            // 다 읽음 -> 덜 된 프레임이 없으면 블록 반납
+            _framer.ReleaseIfEmpty();
+            return ::WSAGetLastError() == WSAEWOULDBLOCK;
+        }
+
+        _framer.Commit((size_t)n);
+
+        PopResult r = PopResult::NeedMore;
+        Frame frame;
+        while (_running.load(std::memory_order_relaxed) && !_recvDiscard && (r = _framer.TryPopFrame(frame)) == PopResult::Ok)
             Dispatch(frame);
+
+        // 프로토콜 오류 뒤: S_Disconnect가 나갈 때까지 연결은 두고 들어온 건 해석하지 않음
+        if (_recvDiscard)
+        {
+            _framer.Clear();
+            continue;
         }
-        else if (r == PopResult::NeedMore)
+
+        if (r == PopResult::Error)
         {
+            // 길이 초과 등: 모르는 msg와 같은 프로토콜 오류
+            Log(Tag(), std::string("Framer pop error: ") + _framer.LastErrorMessage() + " -> disconnect");
+            _recvDiscard = true;
+            _framer.Clear();
+            Disconnect(DisconnectReason::ProtocolError);
+            continue;
+        }
+
+        // 자리보다 덜 왔으면 소켓 버퍼가 빈 것 -> recv를 한 번 더 부르지 않고 0바이트 수신으로
+        if ((size_t)n < space)
             break;
+    }
+
+    _framer.ReleaseIfEmpty();
+    return _running.load(std::memory_order_relaxed);
+}
+
+void Session::EndRecv()
+{
+    // 소켓이 새 프로세스로 넘어감: 연결은 살아 있어야 하므로 shutdown/onClose 없이 끝 (덜 된 수신 바이트는 인계)
+    if (_detached.load(std::memory_order_relaxed))
+    {
+        Log(Tag(), "Recv detached");
+        _recvPending.store(false, std::memory_order_release);
+        return;
+    }
+
+    // 종료 정리
+    _running.store(false, std::memory_order_relaxed);
+    ShutdownSocket();
+    _framer.Clear();
+
+    Log(Tag(), "Recv ended");
+
+    // 세션 종료 알림
+    if (_onClose && *_onClose)
+        (*_onClose)(_id);
+
+    _recvPending.store(false, std::memory_order_release);
+}
+
+bool Session::TakeNextSend()
+{
+    // 한 번에 WSASend 1개 (프레임 섞임 없음). 종료/인계 중이면 안 꺼냄
+    if (_sendBusy || _frozen || !_running.load(std::memory_order_relaxed))
+        return false;
+
+    if (!_closing && _pingDue.exchange(false, std::memory_order_acquire))
+    {
+        // ping은 프레임 사이에 끼움 (큐에 안 넣음 -> 스냅샷 대체/예산과 무관). 인코딩은 IssueSend에서 락 밖으로
+        _sendingPing = true;
+        _sendingLast = false;
+        _sendOffset = 0;
+        _sendBusy = true;
+        _sendRef = shared_from_this();
+        return true;
+    }
+
+    SendNode* node = nullptr;
+    if (_sendHead)
+    {
+        node = _sendHead;
+        _sendHead = node->next;
+        if (!_sendHead)
+            _sendTail = nullptr;
+        node->next = nullptr;
+        _sendQBytes -= node->Size();
+        --_sendQFrames;
+        _sendingLast = _closing && !_sendHead;
+    }
+
+    if (!node)
+        return false;
+
+    _sending = node;
+    _sendOffset = 0;
+    _sendBusy = true;
+    _sendRef = shared_from_this();
+    return true;
+}
+
+void Session::EncodePing()
+{
+    const uint64 now = ServerTimeUs();
+    const uint32 seq = ++_pingSeq;
+    _pingSentUs[seq % PING_RING_SIZE].store(now, std::memory_order_relaxed);
+
+    S_Ping ping;
+    ping.seq = seq;
+    ping.serverTimeUs = now;
+    ping.srttUs = _srttUs.load(std::memory_order_relaxed);
+    ping.rttVarUs = _rttVarUs.load(std::memory_order_relaxed);
+    ping.clockOffsetUs = _clockOffsetUs.load(std::memory_order_relaxed);
+    ping.tickOriginUs = _tickOriginUs.load(std::memory_order_relaxed);
+    ping.tickUs = _tickUs.load(std::memory_order_relaxed);
+
+    FixedCodec<S_Ping>::EncodeFrame(ping, _pingFrame.data());
+}
+
+const Byte* Session::SendingData() const
+{
+    return _sendingPing ? _pingFrame.data() : _sending->Data();
+}
+
+size_t Session::SendingSize() const
+{
+    return _sendingPing ? _pingFrame.size() : _sending->Size();
+}
+
+void Session::IssueSend()
+{
+    // _sending은 완료가 오기 전까지 TakeNextSend로 넘겨받은 이 스레드만 만짐
+    if (_sendingPing && _sendOffset == 0)
+        EncodePing();
+
+    WSABUF buf;
+    buf.len = (ULONG)(SendingSize() - _sendOffset);
+    buf.buf = (CHAR*)(SendingData() + _sendOffset);
+
+    std::memset(&_sendOv, 0, sizeof(_sendOv));
+    if (::WSASend(_sock, &buf, 1, nullptr, 0, &_sendOv, nullptr) == 0 || ::WSAGetLastError() == WSA_IO_PENDING)
+        return;     // 바로 끝나도 완료는 포트로 옴
+
+    // 안 걸렸으면 완료도 안 옴 -> 여기서 정리 후 종료
+    std::shared_ptr<Session> self;
+    {
+        std::lock_guard<std::mutex> lock(_sendMutex);
+        delete _sending;
+        _sending = nullptr;
+        _sendingPing = false;
+        _sendOffset = 0;
+        _sendBusy = false;
+        self = std::move(_sendRef);
+    }
+    RequestStop();
+}
+
+void Session::OnSendCompleted(uint32 bytes, bool ok)
+{
+    // 더 안 걸면 자기 참조를 놓음 (함수 끝에서, 마지막 참조일 수 있음)
+    std::shared_ptr<Session> self;
+    bool issue = false;
+    bool stop = false;
+    {
+        std::lock_guard<std::mutex> lock(_sendMutex);
+
+        ok = ok && bytes > 0;
+        _sendOffset += bytes;
+        if (ok && _sendOffset < SendingSize())
+        {
+            // 남은 부분 (overlapped send는 보통 한 번에 끝남)
+            issue = true;
         }
         else
         {
-            Log(_tag, std::string("Framer pop error: ") + _framer.LastErrorMessage());
-            RequestStop();
-            break;
+            const bool last = _sendingLast;
+            delete _sending;
+            _sending = nullptr;
+            _sendingPing = false;
+            _sendOffset = 0;
+            _sendBusy = false;
+            _sendingLast = false;
+
+            // send 실패 / Disconnect: S_Disconnect까지 나갔으면 끊음
+            stop = !ok || last;
+            if (!stop)
+                issue = TakeNextSend();
+            if (!issue)
+                self = std::move(_sendRef);
         }
     }
+
+    if (stop)
+        RequestStop();
+    if (issue)
+        IssueSend();
 }
 
-void Session::Dispatch(const Frame& frame)
+void Session::OnIoTimer(uint64 nowMs)
 {
-    if (frame.msgId == C_Ping)
+    if (!_running.load(std::memory_order_relaxed))
+        return;
+
+    // 닫는 중인데 S_Disconnect가 안 나감 (보내던 프레임을 클라가 안 받음) -> 기다리지 않고 끊음
+    const uint64 closeByMs = _closeByMs.load(std::memory_order_relaxed);
+    if (closeByMs != 0 && nowMs >= closeByMs)
+    {
+        Log(Tag(), "Disconnect frame not flushed in " + std::to_string(DISCONNECT_LINGER_MS) + "ms -> close");
+        RequestStop();
+        return;
+    }
+
+    SampleRtt(nowMs);
+
+    // 첫 ping은 Start 뒤 첫 타이머에 바로 (시계 오프셋/RTT를 빨리 잡게). 표시만 (락 없음)
+    // 보내는 중이면 그 프레임이 끝난 직후 완료 처리가 꺼냄 (큐에서 기다린 시간도 RTT에 안 들어감)
+    if (nowMs >= _nextPingMs)
+    {
+        _nextPingMs = nowMs + PING_INTERVAL_MS;
+        _pingDue.store(true, std::memory_order_release);
+    }
+
+    // 아직 안 나간 ping: 쉬고 있는 세션만 여기서 시작
+    // 락을 못 잡으면 잡은 쪽(enqueue/완료)이 꺼내거나, 놓쳤으면 다음 타이머에 다시 봄
+    if (!_pingDue.load(std::memory_order_acquire))
+        return;
+
+    std::unique_lock<std::mutex> lock(_sendMutex, std::try_to_lock);
+    if (!lock.owns_lock() || _sendBusy)
+        return;
+
+    const bool issue = TakeNextSend();
+    lock.unlock();
+    if (issue)
+        IssueSend();
+}
+
+bool Session::Freeze(std::chrono::steady_clock::time_point deadline)
+{
+    {
+        // 완료 처리의 다음 프레임 꺼내기와 엇갈리지 않게 락 안에서
+        std::lock_guard<std::mutex> lock(_sendMutex);
+        _frozen = true;
+    }
+
+    // 보내던 프레임은 끝까지 (느린 클라면 deadline에 걸림)
+    for (;;)
     {
-        // payload = u32 seq
-        ByteReader br(frame.payload.data(), frame.payload.size());
-        uint32 seq = 0;
-        if (!br.ReadU32LE(seq))
         {
-            Log(_tag, "C_Ping malformed payload (need u32)");
-            RequestStop();
+            std::lock_guard<std::mutex> lock(_sendMutex);
+            if (!_sendBusy)
+                return true;
+        }
+        if (std::chrono::steady_clock::now() >= deadline)
+            return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+void Session::Thaw()
+{
+    // Freeze가 시간 초과로 실패했으면 아직 보내는 중 -> 그 완료가 이어서 꺼냄
+    bool issue = false;
+    {
+        std::lock_guard<std::mutex> lock(_sendMutex);
+        if (!_frozen)
             return;
+        _frozen = false;
+        issue = TakeNextSend();
+    }
+    if (issue)
+        IssueSend();
+}
+
+void Session::Detach()
+{
+    _detached.store(true, std::memory_order_relaxed);
+
+    // 걸린 0바이트 수신 취소: 데이터를 안 가져가므로 그 사이 온 바이트는 소켓에 남아 새 프로세스가 읽음
+    // (완료 처리 중이었으면 다시 걸지 않고 끝날 때까지 반복)
+    // 취소가 안 먹으면 이 프로세스 핸들을 먼저 닫음 (복제본이 있어서 연결은 유지, accept가 멈춰 있어 번호 재사용도 없음)
+    const auto giveUp = std::chrono::steady_clock::now() + std::chrono::milliseconds(100);
+    bool closed = false;
+    while (_recvPending.load(std::memory_order_acquire))
+    {
+        if (std::chrono::steady_clock::now() < giveUp)
+        {
+            ::CancelIoEx((HANDLE)_sock, &_recvOv);
+        }
+        else if (!closed)
+        {
+            SessionIo::Disassociate(_sock);
+            ::closesocket(_sock);
+            closed = true;
         }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // 이 프로세스 포트에서 떼고 핸들만 닫음 (복제본이 남아 있으므로 연결은 유지). 이후 Stop/소멸자는 소켓을 안 건드림
+    // 못 떼면 새 프로세스 쪽 Start(포트 연결)가 실패 -> 그 세션만 끊김
+    _running.store(false, std::memory_order_relaxed);
+    _shutdown.store(true);
+    if (!closed)
+    {
+        if (!SessionIo::Disassociate(_sock))
+            Log(Tag(), "IOCP disassociate failed (needs Windows 8.1+)");
+        ::closesocket(_sock);
+    }
+    _sock = INVALID_SOCKET;
+}
 
-        Log(_tag, "C_Ping Received!");
+void Session::ExportState(ByteWriter& w) const
+{
+    w.WriteU64LE(_id);
+    w.WriteU32LE(_rttMs.load(std::memory_order_relaxed));
+    w.WriteU32LE(_srttUs.load(std::memory_order_relaxed));
+    w.WriteU32LE(_rttVarUs.load(std::memory_order_relaxed));
+    w.WriteU64LE((uint64)_clockOffsetUs.load(std::memory_order_relaxed));
+
+    w.WriteU32LE((uint32)_framer.BufferedSize());
+    w.WriteBytes(_framer.BufferedData(), _framer.BufferedSize());
+
+    std::lock_guard<std::mutex> lock(_sendMutex);
+    w.WriteU32LE(_sendQFrames);
+    for (const SendNode* n = _sendHead; n; n = n->next)
+    {
+        w.WriteU8((uint8)n->kind);
+        w.WriteU32LE((uint32)n->Size());
+        w.WriteBytes(n->Data(), n->Size());
+    }
+}
 
-        // reply: S_Pong(seq)
-        ByteWriter w;
-        w.WriteU32LE(seq);
-        SendFrame(S_Pong, w.buf.data(), w.buf.size());
+bool Session::ImportState(ByteReader& r)
+{
+    uint64 id = 0;
+    uint32 rttMs = 0;
+    uint32 srttUs = 0;
+    uint32 rttVarUs = 0;
+    uint64 clockOffsetUs = 0;
+    uint32 pendingLen = 0;
+    const Byte* pending = nullptr;
+    if (!r.ReadU64LE(id) || id != _id || !r.ReadU32LE(rttMs) || !r.ReadU32LE(srttUs) || !r.ReadU32LE(rttVarUs)
+        || !r.ReadU64LE(clockOffsetUs) || !r.ReadU32LE(pendingLen) || !r.ReadBytes(pendingLen, pending))
+        return false;
+
+    // 방 쪽 RTT는 Room 상태로 따로 넘어옴 -> 같은 값을 이미 알린 것으로
+    _rttMs.store(rttMs, std::memory_order_relaxed);
+    _srttUs.store(srttUs, std::memory_order_relaxed);
+    _rttVarUs.store(rttVarUs, std::memory_order_relaxed);
+    _clockOffsetUs.store((int64)clockOffsetUs, std::memory_order_relaxed);
+    _reportedRttMs = srttUs != 0 ? rttMs : 0;
+    _reportedRttVarMs = rttVarUs / 1000;
+    if (pendingLen > 0 && !_framer.Append(pending, pendingLen))
+        return false;
 
-        Log(_tag, "S_Pong Sent!");
+    uint32 frames = 0;
+    if (!r.ReadU32LE(frames))
+        return false;
+
+    std::lock_guard<std::mutex> lock(_sendMutex);
+    for (uint32 i = 0; i < frames; ++i)
+    {
+        uint8 kind = 0;
+        uint32 len = 0;
+        const Byte* bytes = nullptr;
+        if (!r.ReadU8(kind) || !r.ReadU32LE(len) || !r.ReadBytes(len, bytes))
+            return false;
+
+        SendNode* node = new SendNode;
+        node->kind = (SendKind)kind;
+        node->bytes.assign(bytes, bytes + len);
+        (_sendTail ? _sendTail->next : _sendHead) = node;
+        _sendTail = node;
+        _sendQBytes += len;
+        ++_sendQFrames;
+    }
+    return true;
+}
+
+void Session::SampleRtt(uint64 nowMs)
+{
+    // C_Pong으로 추정 중이면 그게 더 정확 (앱 레벨 왕복 = 클라가 실제로 겪는 지연)
+    if (_rttUnsupported || _srttUs.load(std::memory_order_relaxed) != 0)
+        return;
+
+    if (nowMs < _nextRttSampleMs)
+        return;
+    _nextRttSampleMs = nowMs + RTT_SAMPLE_INTERVAL_MS;
+
+    DWORD version = 0;
+    TCP_INFO_v0 info{};
+    DWORD bytes = 0;
+    if (::WSAIoctl(_sock, SIO_TCP_INFO, &version, (DWORD)sizeof(version), &info, (DWORD)sizeof(info), &bytes, nullptr, nullptr) != 0)
+    {
+        _rttUnsupported = true;
+        Log(Tag(), "SIO_TCP_INFO failed err=" + std::to_string(::WSAGetLastError()) + " -> RTT sampling off");
         return;
     }
 
-    // Tier1 å: 𸣴 msg -> disconnect
-    Log(_tag, "Unknown msgId=" + std::to_string(frame.msgId) + " -> disconnect");
-    RequestStop();
+    // 1ms 미만(로컬)은 1로 -> 0은 "모름"으로 남겨 둠
+    const uint32 rttMs = std::max<uint32>(1, (uint32)(info.RttUs / 1000));
+    _rttMs.store(rttMs, std::memory_order_relaxed);
+
+    if (_inputHooks && _inputHooks->onRttSample)
+        _inputHooks->onRttSample(_id, rttMs, 0);
 }
 
-bool Session::SendAll(const Byte* data, size_t len)
+void Session::Dispatch(const Frame& frame)
 {
-    size_t sent = 0;
-    while (sent < len && _running.load(std::memory_order_relaxed))
+    switch (SessionDispatcher::Dispatch(*this, frame.msgId, frame.payload, frame.payloadLen))
     {
-        int n = ::send(_sock, (const char*)(data + sent), (int)(len - sent), 0);
-        if (n <= 0)
-            return false;
+    case DispatchResult::Ok:
+        return;
 
-        sent += (size_t)n;
+    case DispatchResult::Malformed:
+        Log(Tag(), "Malformed payload msgId=" + std::to_string(frame.msgId) + " -> disconnect");
+        break;
+
+    case DispatchResult::UnknownMsg:
+        // Tier1 정책: 모르는 msg -> disconnect
+        Log(Tag(), "Unknown msgId=" + std::to_string(frame.msgId) + " -> disconnect");
+        break;
     }
-    return sent == len;
+
+    // 이유를 알리고 끊음 (그 뒤로 받은 건 버림)
+    _recvDiscard = true;
+    Disconnect(DisconnectReason::ProtocolError);
 }
 
-void Session::CloseSocket()
+void Session::On(const C_Ping& msg)
 {
-    if (_sock == INVALID_SOCKET) return;
+    Log(Tag(), "C_Ping Received!");
 
-    _sock = INVALID_SOCKET;
+    // reply: S_Pong(seq)
+    Send(S_Pong{ msg.seq });
+
+    Log(Tag(), "S_Pong Sent!");
+}
+
+void Session::On(const C_Pong& msg)
+{
+    const uint64 now = ServerTimeUs();
+
+    // 우리가 보낸 ping의 echo인지: 슬롯의 송신 시각과 같아야 하고 한 번만 인정
+    // (늦어서 슬롯이 덮였거나 위조/중복이면 표본만 버림, 끊지는 않음)
+    uint64 sentUs = msg.serverTimeUs;
+    if (sentUs == 0 || sentUs > now
+        || !_pingSentUs[msg.seq % PING_RING_SIZE].compare_exchange_strong(sentUs, 0, std::memory_order_relaxed))
+        return;
+
+    const uint64 rtt64 = now - sentUs;
+    if (rtt64 > (uint64)PING_MAX_RTT_MS * 1000)
+        return;
+    const uint32 rtt = std::max<uint32>(1, (uint32)rtt64);
+
+    // RFC 6298: RTTVAR는 이전 SRTT 기준 편차로 먼저 (beta 1/4), SRTT는 alpha 1/8
+    uint32 srtt = _srttUs.load(std::memory_order_relaxed);
+    uint32 var = _rttVarUs.load(std::memory_order_relaxed);
+    const bool first = srtt == 0;
+    if (first)
+    {
+        srtt = rtt;
+        var = rtt / 2;
+    }
+    else
+    {
+        const uint32 delta = srtt > rtt ? srtt - rtt : rtt - srtt;
+        var = var - var / 4 + delta / 4;
+        srtt = std::max<uint32>(1, srtt - srtt / 8 + rtt / 8);
+    }
+    _srttUs.store(srtt, std::memory_order_relaxed);
+    _rttVarUs.store(var, std::memory_order_relaxed);
+
+    // 시계 오프셋 (NTP 방식, 클라 처리 시간 0 가정): 클라가 받은 순간 = 서버 송신 + 왕복 절반
+    // 큐/재전송에 걸린 표본(RTT가 평소보다 큼)은 경로가 비대칭일 가능성이 커서 오프셋에는 안 씀
+    const int64 offsetSample = (int64)(sentUs + rtt / 2) - (int64)msg.clientTimeUs;
+    if (first)
+    {
+        _clockOffsetUs.store(offsetSample, std::memory_order_relaxed);
+    }
+    else if (rtt <= srtt + var)
+    {
+        const int64 offset = _clockOffsetUs.load(std::memory_order_relaxed);
+        _clockOffsetUs.store(offset + (offsetSample - offset) / 8, std::memory_order_relaxed);
+    }
+
+    // 게임 레이어 알림은 RoomManager 큐(락)를 거치므로 값이 의미 있게 바뀔 때만
+    const uint32 rttMs = std::max<uint32>(1, srtt / 1000);
+    const uint32 rttVarMs = var / 1000;
+    _rttMs.store(rttMs, std::memory_order_relaxed);
+
+    const uint32 rttDelta = rttMs > _reportedRttMs ? rttMs - _reportedRttMs : _reportedRttMs - rttMs;
+    const uint32 varDelta = rttVarMs > _reportedRttVarMs ? rttVarMs - _reportedRttVarMs : _reportedRttVarMs - rttVarMs;
+    if (_reportedRttMs != 0 && rttDelta < RTT_REPORT_MIN_DELTA_MS && varDelta < RTT_REPORT_MIN_DELTA_MS)
+        return;
+
+    _reportedRttMs = rttMs;
+    _reportedRttVarMs = rttVarMs;
+    if (_inputHooks && _inputHooks->onRttSample)
+        _inputHooks->onRttSample(_id, rttMs, rttVarMs);
+}
+
+void Session::On(const C_UdpOpenReq& msg)
+{
+    (void)msg;
+
+    sockaddr_in addr{};
+    int addrLen = sizeof(addr);
+    if (!_udp || !_udp->IsRunning() || ::getpeername(_sock, (sockaddr*)&addr, &addrLen) != 0 || addr.sin_family != AF_INET)
+    {
+        Send(S_UdpOpenRes{ 0, 0, 0 });
+        return;
+    }
+
+    // 다시 요청하면 새 token (이전 주소 묶음도 풀림 -> 새 token 데이터그램이 올 때까지 TCP)
+    const uint64 token = _udp->MakeToken();
+    _udpPeer.store(0, std::memory_order_relaxed);
+    _udpAddr.store(addr.sin_addr.s_addr, std::memory_order_relaxed);
+    _udpToken.store(token, std::memory_order_release);
+
+    Send(S_UdpOpenRes{ 1, _udp->Port(), token });
+}
+
+void Session::On(const C_SpectateReq& msg)
+{
+    // 관전 세션만 훅이 있음 (구독/응답은 SpectatorRelay가)
+    if (_inputHooks && _inputHooks->onSpectate)
+        _inputHooks->onSpectate(_id, msg);
+}
+
+void Session::On(const C_MoveInput& msg)
+{
+    // 입력은 tick 스레드의 jitter buffer로 (seq 정렬/중복 제거는 거기서)
+    if (_inputHooks && _inputHooks->onMoveInput)
+        _inputHooks->onMoveInput(_id, msg);
+}
+
+void Session::On(const C_CastSkill& msg)
+{
+    if (_inputHooks && _inputHooks->onCastSkill)
+        _inputHooks->onCastSkill(_id, msg);
+}
+
+void Session::On(const C_ChoiceVote& msg)
+{
+    if (_inputHooks && _inputHooks->onChoiceVote)
+        _inputHooks->onChoiceVote(_id, msg);
+}
+
+void Session::ShutdownSocket()
+{
+    // 다른 스레드가 recv/send 중일 수 있으므로 여기서 핸들을 close하지 않음
+    // (close 후 핸들 번호가 재사용되면 엉뚱한 소켓에 recv할 수 있음)
+    if (_shutdown.exchange(true) || _sock == INVALID_SOCKET) return;
 
     ::shutdown(_sock, SD_BOTH);
-    ::closesocket(_sock);
+
+    // 느린 클라 앞으로 걸린 WSASend는 shutdown으로 안 끝날 수 있음 -> 취소 (완료는 실패로 옴)
+    ::CancelIoEx((HANDLE)_sock, nullptr);
 }
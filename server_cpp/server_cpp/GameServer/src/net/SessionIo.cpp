@@ -0,0 +1,192 @@
+#include "net/SessionIo.h"
+#include "common/ServerClock.h"
+#include "common/ThreadPlacement.h"
+#include "net/Session.h"
+
+#include <windows.h>
+
+#include <iostream>
+
+static void Log(const std::string& tag, const std::string& msg)
+{
+    std::cout << "[" << tag << "] " << msg << "\n";
+}
+
+static uint64 NowMs()
+{
+    return ServerTimeUs() / 1000;
+}
+
+SessionIo::SessionIo()
+{
+    _tag = "SessionIo";
+}
+
+SessionIo::~SessionIo()
+{
+    Stop();
+}
+
+bool SessionIo::Start(uint32 threads)
+{
+    if (_running.exchange(true))
+        return false;
+
+    _port = ::CreateIoCompletionPort(INVALID_HANDLE_VALUE, nullptr, 0, threads);
+    if (_port == nullptr)
+    {
+        Log(_tag, "CreateIoCompletionPort failed err=" + std::to_string(::GetLastError()));
+        _running.store(false);
+        return false;
+    }
+
+    for (uint32 i = 0; i < threads; ++i)
+        _threads.emplace_back(&SessionIo::WorkerLoop, this, i);
+
+    Log(_tag, "Started (threads=" + std::to_string(threads) + ")");
+    return true;
+}
+
+void SessionIo::Stop()
+{
+    if (!_running.exchange(false))
+        return;
+
+    // key 0 = 종료 (스레드마다 1개)
+    for (size_t i = 0; i < _threads.size(); ++i)
+        ::PostQueuedCompletionStatus(_port, 0, 0, nullptr);
+
+    for (std::thread& t : _threads)
+    {
+        if (t.joinable())
+            t.join();
+    }
+    _threads.clear();
+
+    ::CloseHandle(_port);
+    _port = nullptr;
+}
+
+bool SessionIo::Associate(SOCKET sock, Session* session)
+{
+    return _port != nullptr && ::CreateIoCompletionPort((HANDLE)sock, _port, (ULONG_PTR)session, 0) == _port;
+}
+
+bool SessionIo::Disassociate(SOCKET sock)
+{
+    // winternl.h 없이 필요한 것만
+    struct IoStatusBlock
+    {
+        union
+        {
+            LONG Status;
+            PVOID Pointer;
+        };
+        ULONG_PTR Information;
+    };
+    struct FileCompletionInformation
+    {
+        HANDLE Port;
+        PVOID Key;
+    };
+    using NtSetInformationFileFn = LONG(NTAPI*)(HANDLE, IoStatusBlock*, PVOID, ULONG, int);
+    constexpr int FILE_REPLACE_COMPLETION_INFORMATION = 61;
+
+    static const NtSetInformationFileFn setInfo =
+        (NtSetInformationFileFn)::GetProcAddress(::GetModuleHandleA("ntdll.dll"), "NtSetInformationFile");
+    if (!setInfo)
+        return false;
+
+    IoStatusBlock status{};
+    FileCompletionInformation info{ nullptr, nullptr };
+    return setInfo((HANDLE)sock, &status, &info, (ULONG)sizeof(info), FILE_REPLACE_COMPLETION_INFORMATION) >= 0;
+}
+
+SessionIo::Stats SessionIo::TakeStats()
+{
+    Stats s;
+    s.completions = _completions.exchange(0, std::memory_order_relaxed);
+    s.wakeups = _wakeups.exchange(0, std::memory_order_relaxed);
+    return s;
+}
+
+void SessionIo::WorkerLoop(uint32 index)
+{
+    ThreadPlacement::Pin(ThreadRole::SessionIo, index);
+
+    const bool timerThread = index == 0;
+    uint64 nextTimerMs = NowMs() + IO_TIMER_MS;
+    uint64 nextStatLogMs = NowMs() + 10000;
+
+    OVERLAPPED_ENTRY entries[IO_BATCH];
+    for (;;)
+    {
+        DWORD timeoutMs = INFINITE;
+        if (timerThread)
+        {
+            const uint64 now = NowMs();
+            timeoutMs = now >= nextTimerMs ? 0 : (DWORD)(nextTimerMs - now);
+        }
+
+        ULONG count = 0;
+        if (!::GetQueuedCompletionStatusEx(_port, entries, IO_BATCH, &count, timeoutMs, FALSE))
+            count = 0;  // 시간 초과 (타이머 스레드)
+
+        uint32 quits = 0;
+        for (ULONG i = 0; i < count; ++i)
+        {
+            const OVERLAPPED_ENTRY& e = entries[i];
+            if (e.lpCompletionKey == 0)
+            {
+                ++quits;
+                continue;
+            }
+
+            // Internal = NTSTATUS (0이면 성공). 0바이트 수신은 성공이어도 bytes = 0
+            Session* session = (Session*)e.lpCompletionKey;
+            session->OnIoCompleted(e.lpOverlapped, (uint32)e.dwNumberOfBytesTransferred, e.lpOverlapped->Internal == 0);
+        }
+        if (count > 0)
+        {
+            _wakeups.fetch_add(1, std::memory_order_relaxed);
+            _completions.fetch_add(count, std::memory_order_relaxed);
+        }
+
+        if (quits > 0)
+        {
+            // 한 번에 여러 개를 꺼냈으면 나머지는 다른 스레드 몫
+            for (uint32 i = 1; i < quits; ++i)
+                ::PostQueuedCompletionStatus(_port, 0, 0, nullptr);
+            break;
+        }
+
+        // 완료가 계속 들어와도 타이머는 밀리지 않게 (대기 시간만이 아니라 배치마다 확인)
+        if (timerThread)
+        {
+            const uint64 now = NowMs();
+            if (now >= nextTimerMs)
+            {
+                nextTimerMs = now + IO_TIMER_MS;
+                if (_timer)
+                    _timer(now);
+            }
+            if (now >= nextStatLogMs)
+            {
+                nextStatLogMs = now + 10000;
+                LogStats();
+            }
+        }
+    }
+}
+
+void SessionIo::LogStats()
+{
+    const Stats s = TakeStats();
+    const RecvBlockPool::Stats pool = _recvPool.GetStats();
+    if (s.completions == 0 && pool.inUse == 0)
+        return;
+
+    Log(_tag, "completions=" + std::to_string(s.completions) +
+        " perWakeup=" + std::to_string(s.wakeups > 0 ? s.completions / s.wakeups : 0) +
+        " recvBlocks(inUse/free/allocs)=" + std::to_string(pool.inUse) + "/" + std::to_string(pool.free) + "/" + std::to_string(pool.allocs));
+}
\ No newline at end of file
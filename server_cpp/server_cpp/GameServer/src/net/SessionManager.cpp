@@ -1,92 +1,276 @@
 #include "net/SessionManager.h"
 #include "net/Session.h"
 
+#include <chrono>
+#include <thread>
+
+SessionManager::SessionManager()
+{
+    _removeFn = [this](SessionId sid) { this->Remove(sid); };
+
+    // 새 EpochManager의 첫 참가자라 실패하지 않음
+    _timerPid = _epoch.Register();
+    _io.SetTimer([this](uint64 nowMs) { OnIoTimer(nowMs); });
+    _io.Start(SESSION_IO_THREADS);
+}
+
 SessionManager::~SessionManager()
 {
     StopAll();
+    _io.Stop();
+    _epoch.Unregister(_timerPid);
+
+    // reader 스레드가 다 멈춘 뒤
+    for (Shard& shard : _shards)
+    {
+        for (auto& chunk : shard.dir)
+            delete[] chunk.load(std::memory_order_relaxed);
+    }
+}
+
+SessionId SessionManager::MakeId(uint32 shard, Handle h)
+{
+    return ((SessionId)h.gen << 32) | ((SessionId)shard << SLOT_BITS) | (SessionId)h.slot;
+}
+
+uint32 SessionManager::ShardOf(SessionId id)
+{
+    return (uint32)(id >> SLOT_BITS) & 0xFF;
+}
+
+SessionManager::Handle SessionManager::HandleOf(SessionId id)
+{
+    return Handle{ (uint32)id & (MAX_SLOTS_PER_SHARD - 1), (uint32)(id >> 32) };
+}
+
+void SessionManager::SetSessionHooks(SessionEventFn onOpened, SessionEventFn onClosed)
+{
+    _onOpened = std::move(onOpened);
+    _onClosed = std::move(onClosed);
+}
+
+void SessionManager::SetInputHooks(SessionInputHooks hooks)
+{
+    _inputHooks = std::move(hooks);
+}
+
+void SessionManager::SetUdpTransport(UdpTransport* udp)
+{
+    _udp = udp;
 }
 
 std::shared_ptr<Session> SessionManager::CreateAndAdd(SOCKET clientSock)
 {
-    const SessionId id = ++_idGen;
-
-    // onClose Session 忡 ȣ  ,
-    // Remove "map ⸸" ϰ, join (StopAll) ϵ ص .
-    //   Session::~Session Stop() ȣϹǷ,
-    // Remove ٷ shared_ptr  " 尡 ڱ ڽ join"  .
-    //
-    // ׷ Tier1 Remove  ı ,
-    //    'ܺο StopAll(Ǵ  GC)' ϴ   .
-    //
-    // ⼭ "  + Stop RequestStop"  Ÿ:
-    // Remove shared_ptr   RequestStop ȣϰ, ı ܺο.
-    // (Ʒ  )
-
-    auto session = std::make_shared<Session>(
+    // 샤드는 라운드로빈으로 분배 (Remove는 id에서 샤드를 바로 꺼냄)
+    const uint32 shardIdx = _nextShard.fetch_add(1, std::memory_order_relaxed) % SHARD_COUNT;
+    Shard& shard = _shards[shardIdx];
+
+    // onClose는 SessionIo 완료 스레드에서 호출됨.
+    // Remove는 "슬롯에서 빼서 retire"만 하고, 실제 소멸은 epoch이 안전해진 뒤.
+    // 걸린 I/O는 자기 shared_ptr을 들고 있으므로 마지막 참조가 어디서 끊기든
+    // 완료 처리 도중 소멸하지 않음
+
+    std::shared_ptr<Session> session;
+    {
+        std::lock_guard<std::mutex> lock(shard.mtx);
+
+        // id가 슬롯/세대로 정해지므로 슬롯부터 잡고 세션 생성
+        const Handle h = shard.sessions.Insert(nullptr);
+        if (!h.IsValid())
+            return nullptr;
+
+        const SessionId id = MakeId(shardIdx, h);
+        session = std::make_shared<Session>(
+            clientSock,
+            id,
+            &_io,
+            &_removeFn,
+            &_inputHooks,
+            _udp
+        );
+
+        *shard.sessions.Get(h) = session;
+        Publish(shard, id, session.get());
+    }
+
+    _count.fetch_add(1, std::memory_order_relaxed);
+
+    if (_onOpened)
+        _onOpened(session->Id());
+
+    // 접속 폭주 중에도 종료된 세션이 쌓이지 않게 여기서도 회수
+    _epoch.Collect();
+    return session;
+}
+
+std::shared_ptr<Session> SessionManager::Adopt(SOCKET clientSock, SessionId id)
+{
+    Shard& shard = _shards[ShardOf(id) % SHARD_COUNT];
+
+    std::shared_ptr<Session> session = std::make_shared<Session>(
         clientSock,
         id,
-        [this](SessionId sid) { this->Remove(sid); }
+        &_io,
+        &_removeFn,
+        &_inputHooks,
+        _udp
     );
 
     {
-        std::lock_guard<std::mutex> lock(_mtx);
-        _sessions.emplace(id, session);
+        std::lock_guard<std::mutex> lock(shard.mtx);
+        // 실패하면 세션 소멸자가 소켓을 닫음 (그 클라는 끊김)
+        if (!shard.sessions.InsertAt(HandleOf(id), session))
+            return nullptr;
+        Publish(shard, id, session.get());
     }
 
+    _count.fetch_add(1, std::memory_order_relaxed);
     return session;
 }
 
 void SessionManager::Remove(SessionId id)
 {
-    std::lock_guard<std::mutex> lock(_mtx);
-    auto it = _sessions.find(id);
-    if (it == _sessions.end())
-        return;
+    Shard& shard = _shards[ShardOf(id) % SHARD_COUNT];
+
+    std::shared_ptr<Session> session;
+    {
+        std::lock_guard<std::mutex> lock(shard.mtx);
+
+        // stale id(이미 제거됨/StopAll로 비워짐)면 gen 불일치로 실패
+        if (!shard.sessions.Remove(HandleOf(id), &session))
+            return;
+        Publish(shard, id, nullptr);
+    }
+    _count.fetch_sub(1, std::memory_order_relaxed);
 
-    // map  zombies ̵ ( Ҹ )
-    _zombies.emplace_back(std::move(it->second));
-    _sessions.erase(it);
+    if (_onClosed)
+        _onClosed(id);
 
-    // ⼭ RequestStop/Stop/join ƹ͵  
-    // (̹ RecvLoop  ȣǹǷ   Ȯ ,
-    //  " 忡  " ־ )
+    // 슬롯에서 빠졌어도 tick/I-O 스레드가 raw 포인터를 들고 있을 수 있음
+    // -> 바로 놓지 않고 retire, reader가 없으면 Collect에서 즉시 해제
+    _epoch.Retire(std::move(session));
+    _epoch.Collect();
 }
 
-void SessionManager::StopAll()
+std::shared_ptr<Session> SessionManager::Find(SessionId id) const
 {
-    std::vector<std::shared_ptr<Session>> local;
+    const Shard& shard = _shards[ShardOf(id) % SHARD_COUNT];
+
+    std::lock_guard<std::mutex> lock(shard.mtx);
+    const auto* p = shard.sessions.Get(HandleOf(id));
+    return p ? *p : nullptr;
+}
 
+Session* SessionManager::Lookup(SessionId id) const
+{
+    const Shard& shard = _shards[ShardOf(id) % SHARD_COUNT];
+    const uint32 slot = HandleOf(id).slot;
+
+    const DirChunk* chunk = shard.dir[slot >> DIR_CHUNK_BITS].load(std::memory_order_acquire);
+    if (!chunk)
+        return nullptr;
+
+    // 슬롯이 재사용됐으면 다른 세대의 세션 -> id 비교로 거름 (읽은 포인터는 호출부 EpochGuard가 retire에서 지킴)
+    Session* s = chunk[slot & (DIR_CHUNK_SLOTS - 1)].load(std::memory_order_acquire);
+    return s && s->Id() == id ? s : nullptr;
+}
+
+void SessionManager::Publish(Shard& shard, SessionId id, Session* session)
+{
+    const uint32 slot = HandleOf(id).slot;
+    std::atomic<DirChunk*>& entry = shard.dir[slot >> DIR_CHUNK_BITS];
+
+    DirChunk* chunk = entry.load(std::memory_order_relaxed);
+    if (!chunk)
     {
-        std::lock_guard<std::mutex> lock(_mtx);
-        for (auto& kv : _sessions)
-            local.push_back(kv.second);
-        _sessions.clear();
-
-        // zombies  
-        for (auto& z : _zombies)
-            local.push_back(z);
-        _zombies.clear();
+        if (!session)
+            return;
+        chunk = new DirChunk[DIR_CHUNK_SLOTS]();
+        entry.store(chunk, std::memory_order_release);
     }
 
-    for (auto& s : local)
-        s->Stop();
+    // 비울 때는 retire(epoch 기록)보다 먼저 보이게 seq_cst
+    chunk[slot & (DIR_CHUNK_SLOTS - 1)].store(session, session ? std::memory_order_release : std::memory_order_seq_cst);
 }
 
-size_t SessionManager::Count() const
+void SessionManager::SampleSendQueues(size_t backlogBytes, uint32& sessions, uint32& backlogged) const
 {
-    std::lock_guard<std::mutex> lock(_mtx);
-    return _sessions.size();
+    sessions = 0;
+    backlogged = 0;
+    ForEach([&](const Session& s) {
+        ++sessions;
+        if (s.GetSendStats().queuedBytes > backlogBytes)
+            ++backlogged;
+        });
 }
 
-void SessionManager::ReapClosed()
+void SessionManager::OnIoTimer(uint64 nowMs)
+{
+    // 샤드 락 안에서는 포인터만 복사, 세션 호출(ping이면 send 락 + WSASend)은 락 밖에서
+    // -> 세션 수만큼 걸리는 동안 같은 샤드의 접속/종료가 안 막힘. 그 사이 Remove된 세션은 guard가 끝날 때까지 안 풀림
+    {
+        EpochGuard guard(_epoch, _timerPid);
+        for (Shard& shard : _shards)
+        {
+            _timerSessions.clear();
+            {
+                std::lock_guard<std::mutex> lock(shard.mtx);
+                for (const auto& s : shard.sessions.Values())
+                    _timerSessions.push_back(s.get());
+            }
+            for (Session* s : _timerSessions)
+                s->OnIoTimer(nowMs);
+        }
+    }
+
+    // 회수 시점: 마지막 Remove 때 reader가 있어서 남은 세션도 여기서 풀림 (접속/종료가 없어도 IO_TIMER_MS 간격)
+    Collect();
+}
+
+void SessionManager::StopAll()
 {
     std::vector<std::shared_ptr<Session>> local;
 
+    for (Shard& shard : _shards)
     {
-        std::lock_guard<std::mutex> lock(_mtx);
-        local.swap(_zombies);
+        std::lock_guard<std::mutex> lock(shard.mtx);
+
+        auto& live = shard.sessions.Values();
+        for (const auto& s : live)
+            Publish(shard, s->Id(), nullptr);
+        local.insert(local.end(), live.begin(), live.end());
+        _count.fetch_sub(live.size(), std::memory_order_relaxed);
+        shard.sessions.Clear();
     }
 
+    // 살아 있는 세션에는 이유를 알리고 SHUTDOWN_FLUSH_MS까지 나가길 기다림 (나가면 세션이 스스로 멈춤)
+    // 인계로 떼어 낸 세션(Detach)은 연결이 새 프로세스에 있으므로 건드리지 않음
+    bool flushing = false;
     for (auto& s : local)
-        s->Stop();  // ܺ 忡 join
-}
+    {
+        if (!s->IsRunning())
+            continue;
+        s->Disconnect(DisconnectReason::ServerShutdown);
+        flushing = true;
+    }
+
+    const auto flushDeadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(SHUTDOWN_FLUSH_MS);
+    while (flushing && std::chrono::steady_clock::now() < flushDeadline)
+    {
+        flushing = false;
+        for (auto& s : local)
+            flushing = flushing || s->IsRunning();
+        if (flushing)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // 먼저 전부 취소를 걸고 기다림 (하나씩 기다리면 세션 수만큼 완료 왕복)
+    for (auto& s : local)
+        s->RequestStop();
+    for (auto& s : local)
+        s->Stop();
+    local.clear();
+
+    // 종료 시점: reader 스레드는 이미 멈췄다는 전제에서 retire 대기분 전부 해제
+    _epoch.DrainAll();
+}
\ No newline at end of file
@@ -0,0 +1,254 @@
+#include "net/UdpTransport.h"
+#include "common/ByteIO.h"
+#include "common/ThreadPlacement.h"
+#include "net/SessionManager.h"
+#include "net/Session.h"
+
+#include <mstcpip.h>
+
+#include <array>
+#include <chrono>
+#include <iostream>
+
+static void Log(const std::string& tag, const std::string& msg)
+{
+    std::cout << "[" << tag << "] " << msg << "\n";
+}
+
+UdpTransport::UdpTransport(SessionManager* mgr) : _sessionMgr(mgr)
+{
+    _tag = "UdpTransport";
+
+    std::random_device rd;
+    _tokenRng.seed(((uint64)rd() << 32) ^ (uint64)rd() ^ (uint64)std::chrono::steady_clock::now().time_since_epoch().count());
+}
+
+UdpTransport::~UdpTransport()
+{
+    Stop();
+}
+
+bool UdpTransport::Start(uint16 port, uint32 bindWaitMs)
+{
+    if (_running.load())
+        return false;
+
+    const auto giveUp = std::chrono::steady_clock::now() + std::chrono::milliseconds(bindWaitMs);
+    while (!OpenSocket(port))
+    {
+        if (std::chrono::steady_clock::now() >= giveUp)
+            return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    _port = port;
+    _running.store(true);
+    _recvThread = std::thread(&UdpTransport::RecvLoop, this);
+
+    Log(_tag, "Start on udp port " + std::to_string(port));
+    return true;
+}
+
+void UdpTransport::Stop()
+{
+    // 멱등. poll timeout마다 _running을 보므로 join 후 소켓 닫기
+    if (!_running.exchange(false))
+        return;
+
+    if (_recvThread.joinable())
+        _recvThread.join();
+
+    // 인코더 스레드가 SendSnapshot 중일 수 있음 -> 호출부는 RoomManager::Stop 뒤에 부를 것
+    ::closesocket(_sock);
+    _sock = INVALID_SOCKET;
+
+    Log(_tag, "Stopped");
+}
+
+bool UdpTransport::OpenSocket(uint16 port)
+{
+    SOCKET s = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (s == INVALID_SOCKET)
+    {
+        Log(_tag, "socket() failed");
+        return false;
+    }
+
+    // 스냅샷 몰림(인코더 여럿이 동시에 씀) 대비
+    int buf = UDP_SOCKET_BUFFER;
+    ::setsockopt(s, SOL_SOCKET, SO_SNDBUF, (const char*)&buf, sizeof(buf));
+    ::setsockopt(s, SOL_SOCKET, SO_RCVBUF, (const char*)&buf, sizeof(buf));
+
+    // 상대가 닫힌 포트(ICMP port unreachable)면 Windows는 다음 recvfrom을 WSAECONNRESET으로 실패시킴 -> 끔
+    BOOL off = FALSE;
+    DWORD bytes = 0;
+    ::WSAIoctl(s, SIO_UDP_CONNRESET, &off, sizeof(off), nullptr, 0, &bytes, nullptr, nullptr);
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port);
+
+    if (::bind(s, (sockaddr*)&addr, sizeof(addr)) == SOCKET_ERROR)
+    {
+        Log(_tag, "bind() failed err=" + std::to_string(::WSAGetLastError()));
+        ::closesocket(s);
+        return false;
+    }
+
+    u_long nonBlocking = 1;
+    if (::ioctlsocket(s, FIONBIO, &nonBlocking) == SOCKET_ERROR)
+    {
+        Log(_tag, "ioctlsocket(FIONBIO) failed");
+        ::closesocket(s);
+        return false;
+    }
+
+    _sock = s;
+    return true;
+}
+
+uint64 UdpTransport::MakeToken()
+{
+    std::lock_guard<std::mutex> lock(_tokenMutex);
+
+    uint64 token = 0;
+    while (token == 0)
+        token = _tokenRng();
+    return token;
+}
+
+bool UdpTransport::SendSnapshot(uint64 peer, uint32 seq, const ByteBuffer& frame)
+{
+    if (frame.size() > MAX_FRAME_TOTAL)
+        return false;
+
+    std::array<Byte, UDP_MAX_SEND> dgram;
+    StoreLE<uint32>(dgram.data(), seq);
+    std::memcpy(dgram.data() + UDP_SEND_HEADER, frame.data(), frame.size());
+
+    sockaddr_in to{};
+    to.sin_family = AF_INET;
+    to.sin_addr.s_addr = PeerAddr(peer);
+    to.sin_port = (u_short)(peer & 0xFFFF);
+
+    const int len = (int)(UDP_SEND_HEADER + frame.size());
+    if (::sendto(_sock, (const char*)dgram.data(), len, 0, (const sockaddr*)&to, sizeof(to)) != len)
+    {
+        // 송신 버퍼가 찼으면(WSAEWOULDBLOCK) 이번 스냅샷만 버림 -> 다음 것이 덮음
+        _sendFailed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    _snapshotsOut.fetch_add(1, std::memory_order_relaxed);
+    _bytesOut.fetch_add((uint64)len, std::memory_order_relaxed);
+    return true;
+}
+
+UdpTransport::Stats UdpTransport::TakeStats()
+{
+    Stats s;
+    s.datagramsIn = _datagramsIn.exchange(0, std::memory_order_relaxed);
+    s.rejected = _rejected.exchange(0, std::memory_order_relaxed);
+    s.snapshotsOut = _snapshotsOut.exchange(0, std::memory_order_relaxed);
+    s.sendFailed = _sendFailed.exchange(0, std::memory_order_relaxed);
+    s.bytesOut = _bytesOut.exchange(0, std::memory_order_relaxed);
+    return s;
+}
+
+void UdpTransport::RecvLoop()
+{
+    ThreadPlacement::Pin(ThreadRole::SessionIo, 0);
+
+    // 세션 raw 포인터를 쓰므로 epoch 참가자로 등록
+    EpochManager& epoch = _sessionMgr->Epoch();
+    const EpochManager::ParticipantId pid = epoch.Register();
+    if (pid == EpochManager::INVALID_PARTICIPANT)
+    {
+        Log(_tag, "epoch register failed");
+        return;
+    }
+
+    Log(_tag, "RecvLoop started");
+
+    auto nextStatLog = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    std::array<Byte, UDP_MAX_RECV> buf;
+
+    while (_running.load())
+    {
+        WSAPOLLFD pfd{};
+        pfd.fd = _sock;
+        pfd.events = POLLRDNORM;
+
+        const int r = ::WSAPoll(&pfd, 1, UDP_POLL_TIMEOUT_MS);
+        if (r == SOCKET_ERROR)
+            break;
+
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= nextStatLog)
+        {
+            LogStats();
+            nextStatLog = now + std::chrono::seconds(10);
+        }
+
+        if (r == 0)
+            continue;
+
+        // 쌓인 만큼 비우기
+        for (;;)
+        {
+            sockaddr_in from{};
+            int fromLen = sizeof(from);
+            const int n = ::recvfrom(_sock, (char*)buf.data(), (int)buf.size(), 0, (sockaddr*)&from, &fromLen);
+            if (n == SOCKET_ERROR)
+            {
+                // WSAEMSGSIZE: 한도보다 큰 데이터그램 (잘린 채로 버림)
+                if (::WSAGetLastError() == WSAEMSGSIZE)
+                {
+                    _rejected.fetch_add(1, std::memory_order_relaxed);
+                    continue;
+                }
+                break;  // WSAEWOULDBLOCK
+            }
+
+            _datagramsIn.fetch_add(1, std::memory_order_relaxed);
+            HandleDatagram(buf.data(), (size_t)n, from, pid);
+        }
+    }
+
+    epoch.Unregister(pid);
+    Log(_tag, "RecvLoop ended");
+}
+
+void UdpTransport::HandleDatagram(const Byte* data, size_t len, const sockaddr_in& from, uint32 pid)
+{
+    if (len < UDP_RECV_HEADER)
+    {
+        _rejected.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    const SessionId sid = LoadLE<uint64>(data);
+    const uint64 token = LoadLE<uint64>(data + 8);
+    const uint8 count = data[16];
+
+    EpochGuard guard(_sessionMgr->Epoch(), pid);
+
+    Session* s = _sessionMgr->Lookup(sid);
+    if (!s || !s->OnUdpDatagram(token, PackPeer(from), count, data + UDP_RECV_HEADER, len - UDP_RECV_HEADER))
+        _rejected.fetch_add(1, std::memory_order_relaxed);
+}
+
+void UdpTransport::LogStats()
+{
+    const Stats s = TakeStats();
+    if (s.datagramsIn == 0 && s.snapshotsOut == 0)
+        return;
+
+    Log(_tag,
+        "datagramsIn=" + std::to_string(s.datagramsIn) +
+        " rejected=" + std::to_string(s.rejected) +
+        " snapshotsOut=" + std::to_string(s.snapshotsOut) +
+        " sendFailed=" + std::to_string(s.sendFailed) +
+        " egressKB=" + std::to_string(s.bytesOut / 1024));
+}
\ No newline at end of file
@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+# Go 서비스 체크포인트 API 로컬 대역 (개발/부하 확인용)
+#   POST /internal/rooms/{roomId}/checkpoint  (body = GSCP blob, GameServer/inc/game/Checkpoint.h)
+# 사용: python checkpoint_standin.py [--port 8080] [--fail-rate 0.3] [--delay-ms 200] [--out dir]
+# - fail-rate: 그 비율만큼 503 응답 -> 서버 재시도/coalescing 확인
+# - delay-ms: 응답 지연 -> 업로드 밀림 상황 재현
+import argparse
+import os
+import random
+import re
+import struct
+import sys
+import threading
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+CHECKPOINT_MAGIC = 0x50435347  # "GSCP"
+HEADER = struct.Struct("<IHIIBBHI")
+PATH_RE = re.compile(r"^/internal/rooms/(\d+)/checkpoint$")
+
+lock = threading.Lock()
+latest = {}  # roomId -> (tick, bytes)
+stats = {"ok": 0, "failed": 0, "bad": 0, "stale": 0}
+
+
+def parse_header(body):
+    if len(body) < HEADER.size:
+        return None
+    magic, version, room_id, tick, segment, flags, players, enemies = HEADER.unpack_from(body)
+    if magic != CHECKPOINT_MAGIC:
+        return None
+    expected = HEADER.size + players * 19 + enemies * 9
+    if len(body) != expected:
+        return None
+    return room_id, tick, flags, players, enemies
+
+
+class Handler(BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"
+
+    def do_POST(self):
+        m = PATH_RE.match(self.path)
+        length = int(self.headers.get("Content-Length", "0"))
+        body = self.rfile.read(length)
+
+        if self.server.delay_ms > 0:
+            time.sleep(self.server.delay_ms / 1000.0)
+
+        if not m:
+            return self.reply(404)
+
+        if random.random() < self.server.fail_rate:
+            with lock:
+                stats["failed"] += 1
+            return self.reply(503)
+
+        parsed = parse_header(body)
+        if not parsed or parsed[0] != int(m.group(1)):
+            with lock:
+                stats["bad"] += 1
+            return self.reply(400)
+
+        room_id, tick, flags, players, enemies = parsed
+        with lock:
+            # 재시도로 늦게 도착한 옛 체크포인트는 무시 (Go 서비스도 tick으로 같은 판정)
+            prev = latest.get(room_id)
+            if prev and prev[0] > tick:
+                stats["stale"] += 1
+            else:
+                latest[room_id] = (tick, body)
+                stats["ok"] += 1
+
+        if self.server.out_dir:
+            with open(os.path.join(self.server.out_dir, "room_%d.bin" % room_id), "wb") as f:
+                f.write(body)
+
+        print("room=%d tick=%d players=%d enemies=%d bytes=%d%s"
+              % (room_id, tick, players, enemies, len(body), " FINAL" if flags & 1 else ""))
+        self.reply(200)
+
+    def reply(self, code):
+        self.send_response(code)
+        self.send_header("Content-Length", "0")
+        self.send_header("Connection", "close")
+        self.end_headers()
+
+    def log_message(self, fmt, *args):
+        pass
+
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("--port", type=int, default=8080)
+    ap.add_argument("--fail-rate", type=float, default=0.0)
+    ap.add_argument("--delay-ms", type=int, default=0)
+    ap.add_argument("--out", default="")
+    args = ap.parse_args()
+
+    if args.out:
+        os.makedirs(args.out, exist_ok=True)
+
+    server = ThreadingHTTPServer(("127.0.0.1", args.port), Handler)
+    server.fail_rate = args.fail_rate
+    server.delay_ms = args.delay_ms
+    server.out_dir = args.out
+
+    print("checkpoint stand-in on 127.0.0.1:%d (fail-rate=%.2f delay=%dms)" % (args.port, args.fail_rate, args.delay_ms))
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+    with lock:
+        print("ok=%d failed=%d bad=%d stale=%d rooms=%d" % (stats["ok"], stats["failed"], stats["bad"], stats["stale"], len(latest)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
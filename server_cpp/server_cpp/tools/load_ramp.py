@@ -0,0 +1,173 @@
+#!/usr/bin/env python3
+# 단계적 접속 부하 (과부하 단계/admission 확인용)
+# 사용: python load_ramp.py [--host 127.0.0.1] [--port 7777] [--start 50] [--step 50] [--max 2000] [--step-secs 10]
+#                           [--input-hz 20] [--connect-rate 15]
+# - step-secs마다 목표 접속 수를 step만큼 올림. 클라마다 input-hz로 C_MoveInput, 받은 S_Snapshot 간격을 잼
+# - S_Disconnect(4=overloaded)를 받은 클라는 backoff(2~4s) 후 다시 접속 -> 목표 수를 계속 밀어 넣음
+# - 단계마다 1줄: 연결 수 / 거절 / 스냅샷 Hz / 스냅샷 간격 p50,p99 / 서버가 알린 주기(snapshotInterval)
+#   버티는 서버: 연결된 클라의 간격 p99가 유지되고 넘치는 접속은 reason=4로 빠짐
+#   무너지는 서버: 간격 p99가 모든 클라에서 같이 늘고 slow_consumer/연결 실패가 쏟아짐
+import argparse
+import asyncio
+import random
+import struct
+import sys
+import time
+
+C_MOVE_INPUT = 2001
+S_SNAPSHOT = 3001
+S_DISCONNECT = 9001
+REASONS = {0: "none", 1: "protocol_error", 2: "slow_consumer", 3: "server_shutdown", 4: "overloaded"}
+
+stats = {}
+
+
+def reset_stats():
+    stats.clear()
+    stats.update({"snapshots": 0, "gaps": [], "intervals": [], "refused": 0, "failed": 0, "closed": 0, "reasons": {}})
+
+
+def frame(msg_id, payload):
+    return struct.pack("<HH", 2 + len(payload), msg_id) + payload
+
+
+class Client:
+    def __init__(self, args):
+        self.args = args
+        self.connected = False
+        self.stop = False
+
+    async def run(self):
+        while not self.stop:
+            reason = await self.session()
+            if self.stop:
+                return
+            # 거절/끊김 뒤엔 backoff (클라 정책: protocol_v0.md §8)
+            await asyncio.sleep(2.0 + random.random() * 2.0 if reason == 4 else 1.0)
+
+    async def session(self):
+        try:
+            reader, writer = await asyncio.wait_for(asyncio.open_connection(self.args.host, self.args.port), 5.0)
+        except Exception:
+            stats["failed"] += 1
+            return None
+
+        self.connected = True
+        sender = asyncio.ensure_future(self.send_inputs(writer))
+        reason = None
+        got_snapshot = False
+        last = None
+        try:
+            while not self.stop:
+                hdr = await reader.readexactly(2)
+                (length,) = struct.unpack("<H", hdr)
+                body = await reader.readexactly(length)
+                (msg_id,) = struct.unpack_from("<H", body)
+                if msg_id == S_SNAPSHOT:
+                    now = time.monotonic()
+                    stats["snapshots"] += 1
+                    stats["intervals"].append(body[-1])
+                    if last is not None:
+                        stats["gaps"].append((now - last) * 1000.0)
+                    last = now
+                    got_snapshot = True
+                elif msg_id == S_DISCONNECT:
+                    (reason,) = struct.unpack_from("<H", body, 2)
+        except (asyncio.IncompleteReadError, ConnectionError, OSError):
+            pass
+        finally:
+            self.connected = False
+            sender.cancel()
+            writer.close()
+
+        if reason is not None:
+            name = REASONS.get(reason, str(reason))
+            stats["reasons"][name] = stats["reasons"].get(name, 0) + 1
+            if reason == 4 and not got_snapshot:
+                stats["refused"] += 1
+        elif not self.stop:
+            stats["closed"] += 1
+        return reason
+
+    async def send_inputs(self, writer):
+        seq = 0
+        period = 1.0 / self.args.input_hz
+        dx, dy = 0, 0
+        try:
+            while True:
+                if seq % 20 == 0:
+                    dx, dy = random.choice((-1, 0, 1)), random.choice((-1, 0, 1))
+                seq += 1
+                writer.write(frame(C_MOVE_INPUT, struct.pack("<IbbH", seq, dx, dy, int(period * 1000))))
+                await asyncio.sleep(period)
+        except (asyncio.CancelledError, ConnectionError, OSError):
+            pass
+
+
+def pct(values, p):
+    if not values:
+        return 0.0
+    values = sorted(values)
+    return values[min(len(values) - 1, int(len(values) * p))]
+
+
+async def ramp(args):
+    clients = []
+    tasks = []
+    target = args.start
+    print("target connected refused failed closed snapHz/client gapMs(p50/p99) interval(avg) reasons")
+    while True:
+        while len(clients) < target:
+            c = Client(args)
+            clients.append(c)
+            tasks.append(asyncio.ensure_future(c.run()))
+            # 한 IP에서 오므로 Acceptor IP당 rate limit(초당 20) 아래로 나눠서 접속
+            await asyncio.sleep(1.0 / args.connect_rate)
+
+        reset_stats()
+        await asyncio.sleep(args.step_secs)
+
+        connected = sum(1 for c in clients if c.connected)
+        hz = stats["snapshots"] / args.step_secs / max(1, connected)
+        intervals = stats["intervals"]
+        print("%6d %9d %7d %6d %6d %14.1f %9.0f/%-6.0f %6.1f %s" % (
+            target, connected, stats["refused"], stats["failed"], stats["closed"], hz,
+            pct(stats["gaps"], 0.5), pct(stats["gaps"], 0.99),
+            sum(intervals) / len(intervals) if intervals else 0.0,
+            " ".join("%s=%d" % kv for kv in sorted(stats["reasons"].items()))))
+        sys.stdout.flush()
+
+        if target >= args.max:
+            break
+        target = min(args.max, target + args.step)
+
+    for c in clients:
+        c.stop = True
+    for t in tasks:
+        t.cancel()
+    await asyncio.gather(*tasks, return_exceptions=True)
+
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("--host", default="127.0.0.1")
+    ap.add_argument("--port", type=int, default=7777)
+    ap.add_argument("--start", type=int, default=50)
+    ap.add_argument("--step", type=int, default=50)
+    ap.add_argument("--max", type=int, default=2000)
+    ap.add_argument("--step-secs", type=float, default=10.0)
+    ap.add_argument("--input-hz", type=float, default=20.0)
+    ap.add_argument("--connect-rate", type=float, default=15.0)
+    args = ap.parse_args()
+
+    print("load ramp -> %s:%d (%d..%d step %d every %.0fs, input %.0fHz, connect %.0f/s)"
+          % (args.host, args.port, args.start, args.max, args.step, args.step_secs, args.input_hz, args.connect_rate))
+    try:
+        asyncio.get_event_loop().run_until_complete(ramp(args))
+    except KeyboardInterrupt:
+        pass
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())